@@ -0,0 +1,117 @@
+// =============================================================================
+// allocationcounter.cpp — Interposicion de malloc y compania (glibc)
+// =============================================================================
+
+#include "allocationcounter.h"
+#include <cerrno>
+#include <cstdlib>
+
+#if defined(__SANITIZE_ADDRESS__)
+#  define STANAG_ALLOCATION_COUNTER 0
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#    define STANAG_ALLOCATION_COUNTER 0
+#  endif
+#endif
+
+#ifndef STANAG_ALLOCATION_COUNTER
+#  if defined(__GLIBC__)
+#    define STANAG_ALLOCATION_COUNTER 1
+#  else
+#    define STANAG_ALLOCATION_COUNTER 0
+#  endif
+#endif
+
+#if STANAG_ALLOCATION_COUNTER
+
+// =============================================================================
+// Contador thread_local en modelo "initial-exec"
+// =============================================================================
+// El acceso a TLS con el modelo general puede reservar memoria la primera
+// vez (__tls_get_addr) y volver a entrar en malloc. Con initial-exec el
+// contador es un desplazamiento fijo desde el registro de hilo: sin
+// llamadas, sin reservas.
+// =============================================================================
+namespace {
+__attribute__((tls_model("initial-exec"))) thread_local quint64 t_allocations = 0;
+} // namespace
+
+extern "C" {
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+
+void *malloc(std::size_t size)
+{
+    ++t_allocations;
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size)
+{
+    ++t_allocations;
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, std::size_t size)
+{
+    ++t_allocations;
+    return __libc_realloc(ptr, size);
+}
+
+// Las tres variantes alineadas acaban en __libc_memalign (glibc no exporta
+// un __libc_ para las otras dos). posix_memalign() valida la alineacion
+// como pide POSIX: potencia de 2 y multiplo de sizeof(void *).
+void *memalign(std::size_t alignment, std::size_t size)
+{
+    ++t_allocations;
+    return __libc_memalign(alignment, size);
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size)
+{
+    ++t_allocations;
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **out, std::size_t alignment, std::size_t size)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0
+        || alignment % sizeof(void *) != 0)
+        return EINVAL;
+
+    ++t_allocations;
+    void *ptr = __libc_memalign(alignment, size);
+    if (!ptr && size != 0)
+        return ENOMEM;
+    *out = ptr;
+    return 0;
+}
+
+} // extern "C"
+
+bool AllocationCounter::isSupported()
+{
+    return true;
+}
+
+quint64 AllocationCounter::threadAllocations()
+{
+    return t_allocations;
+}
+
+#else
+
+bool AllocationCounter::isSupported()
+{
+    return false;
+}
+
+quint64 AllocationCounter::threadAllocations()
+{
+    return 0;
+}
+
+#endif
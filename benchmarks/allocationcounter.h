@@ -0,0 +1,56 @@
+// =============================================================================
+// allocationcounter.h — Contador de reservas de memoria por hilo
+// =============================================================================
+//
+// PATRON: Clase utilitaria con metodos estaticos (igual que StanagBenchmark).
+//
+// SOLO PARA LOS BENCHMARKS: allocationcounter.cpp define malloc() y
+// compania con enlace C, asi que sustituye el allocator de TODO el proceso
+// que lo enlaza. Por eso vive aqui y se compila dentro de cada ejecutable
+// de benchmarks/, nunca en un plugin de la app.
+//
+// Para afirmar "el decode no reserva memoria" hace falta contarlo, no
+// suponerlo. Los contenedores de Qt (QList, QString, QByteArray) reservan
+// con malloc()/realloc() directamente, no con operator new, asi que
+// sustituir operator new no bastaria: se interceptan malloc, calloc,
+// realloc y las variantes alineadas (aligned_alloc, posix_memalign,
+// memalign). operator new, tambien el alineado, acaba en ellas.
+//
+// COMO:
+//   En glibc, una definicion de malloc() en el ejecutable tiene prioridad
+//   sobre la de la libc (interposicion de simbolos ELF), tambien para las
+//   llamadas desde las librerias de Qt. La nuestra suma 1 a un contador
+//   thread_local y llama a __libc_malloc(): el reparto de memoria es
+//   exactamente el mismo de siempre. free() no se toca.
+//
+// USO (en el benchmark, alrededor del bucle medido):
+//   const quint64 before = AllocationCounter::threadAllocations();
+//   ... bucle ...
+//   const quint64 allocs = AllocationCounter::threadAllocations() - before;
+//
+// LIMITES:
+//   - Solo Linux/glibc. En otras plataformas isSupported() es false y el
+//     contador se queda a 0 (el benchmark lo indica y no publica numero).
+//   - Desactivado con AddressSanitizer, que necesita interceptar malloc
+//     el mismo.
+//   - Cuenta el hilo que llama, no el proceso: threadAllocations() en cada
+//     hilo del pipeline da el reparto por etapa.
+// =============================================================================
+
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+class AllocationCounter
+{
+public:
+    // ¿Se estan contando las reservas en esta plataforma/compilacion?
+    static bool isSupported();
+
+    // malloc, calloc, realloc y reservas alineadas del hilo actual desde
+    // que empezo
+    static quint64 threadAllocations();
+};
+
+#endif // ALLOCATIONCOUNTER_H
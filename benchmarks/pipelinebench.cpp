@@ -0,0 +1,115 @@
+// =============================================================================
+// pipelinebench.cpp — Reservas de memoria del pipeline de hilos (threads)
+// =============================================================================
+//
+// Lo que la app no puede medir: cuantas reservas de heap hace cada camino.
+// La app no sustituye malloc(); este ejecutable si (AllocationCounter) y
+// pasa AllocationCounter::threadAllocations a los mismos metodos de
+// PipelineBenchmark que usa la tarjeta, asi que el codigo medido es el
+// mismo en los dos sitios.
+//
+// generatorAllocations: una fila por metodo de compareGenerators(). Las dos
+// filas se cuentan igual (probe() antes y despues del bucle) y se publican
+// como "events per iteration" = reservas por chunk. Falla si el pool
+// reserva en regimen.
+//
+// handoffAllocations: compareHandoffs() con los workers reales en sus
+// hilos, una fila por transporte. Cada hilo lee su propio contador, asi
+// que se ve que etapa reserva; el numero publicado es la suma por chunk y
+// el reparto sale por qInfo().
+//
+// Compilar en Release (ver benchmarks/CMakeLists.txt):
+//   ./build/benchmarks/pipelinebench generatorAllocations
+//   ./build/benchmarks/pipelinebench handoffAllocations
+// =============================================================================
+
+#include <QtTest>
+#include "allocationcounter.h"
+#include "pipelinebenchmark.h"
+
+namespace {
+
+constexpr int kGeneratorChunks = 200000;
+constexpr int kHandoffChunks = 200000;
+constexpr int kInFlight = 1024;        // Cola del Filtro por defecto
+
+} // namespace
+
+class PipelineBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void generatorAllocations_data();
+    void generatorAllocations();
+    void handoffAllocations_data();
+    void handoffAllocations();
+
+private:
+    // Las dos filas salen de una sola llamada a compareHandoffs()
+    QVariantList m_handoffRows;
+};
+
+void PipelineBench::generatorAllocations_data()
+{
+    QTest::addColumn<int>("row");
+    QTest::newRow("mt19937 per byte") << 0;
+    QTest::newRow("xoshiro256** + pool") << 1;
+}
+
+void PipelineBench::generatorAllocations()
+{
+    if (!AllocationCounter::isSupported())
+        QSKIP("AllocationCounter no esta disponible (no glibc, o ASan)");
+
+    QFETCH(int, row);
+    const QVariantMap result = PipelineBenchmark::compareGenerators(
+        kGeneratorChunks, kInFlight, &AllocationCounter::threadAllocations).at(row).toMap();
+
+    const double allocations = result.value(QStringLiteral("allocationsPerChunk")).toDouble();
+    qInfo("%s: %.0f chunks/s, %.3f allocs/chunk",
+          qPrintable(result.value(QStringLiteral("method")).toString()),
+          result.value(QStringLiteral("chunksPerSec")).toDouble(), allocations);
+
+    QTest::setBenchmarkResult(allocations, QTest::Events);
+    // El pool solo reserva mientras llena sus inFlight+1 huecos
+    if (row == 1)
+        QVERIFY(allocations * kGeneratorChunks <= 2.0 * (kInFlight + 1));
+}
+
+void PipelineBench::handoffAllocations_data()
+{
+    QTest::addColumn<int>("row");
+    QTest::newRow("signal/slot") << 0;
+    QTest::newRow("SPSC rings") << 1;
+}
+
+void PipelineBench::handoffAllocations()
+{
+    if (!AllocationCounter::isSupported())
+        QSKIP("AllocationCounter no esta disponible (no glibc, o ASan)");
+
+    if (m_handoffRows.isEmpty()) {
+        m_handoffRows = PipelineBenchmark::compareHandoffs(
+            kHandoffChunks, kInFlight, &AllocationCounter::threadAllocations);
+    }
+    QFETCH(int, row);
+    const QVariantMap result = m_handoffRows.at(row).toMap();
+
+    qInfo("%s: %.0f chunks/s, %d matches, allocs/chunk generator %.3f, "
+          "filter %.3f, collector %.3f",
+          qPrintable(result.value(QStringLiteral("method")).toString()),
+          result.value(QStringLiteral("chunksPerSec")).toDouble(),
+          result.value(QStringLiteral("matches")).toInt(),
+          result.value(QStringLiteral("generatorAllocationsPerChunk")).toDouble(),
+          result.value(QStringLiteral("filterAllocationsPerChunk")).toDouble(),
+          result.value(QStringLiteral("collectorAllocationsPerChunk")).toDouble());
+
+    QVERIFY(result.value(QStringLiteral("chunks")).toDouble() >= kHandoffChunks);
+    QVERIFY(result.value(QStringLiteral("matches")).toInt() > 0);
+    QTest::setBenchmarkResult(result.value(QStringLiteral("allocationsPerChunk")).toDouble(),
+                              QTest::Events);
+}
+
+QTEST_GUILESS_MAIN(PipelineBench)
+#include "pipelinebench.moc"
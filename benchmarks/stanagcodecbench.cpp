@@ -0,0 +1,229 @@
+// =============================================================================
+// stanagcodecbench.cpp — Benchmark del codec STANAG con QBENCHMARK
+// =============================================================================
+//
+// Mide encode/decode segun cuantos campos lleva la trama (presenceMask con
+// 1, 2, 4, 7, 10 y 14 bits activos). Cada funcion es data-driven: una fila
+// por densidad, asi una regresion en el hot path se ve como un numero en
+// la fila que toca.
+//
+// UNA ITERACION = UNA TRAMA, salvo streamDecoder (un datagrama con
+// kPackedFrames tramas). Qt Test informa "msecs per iteration":
+//   ns por trama = msecs x 1e6      tramas/s = 1000 / msecs
+// Con -median 5 se repite cada medida y se publica la mediana; con
+// -tickcounter se cuentan ciclos en lugar de tiempo de pared.
+//
+// Las tramas se preparan FUERA de QBENCHMARK (StanagBenchmark::
+// sampleMessages, las mismas que usa la tarjeta de la app) y se recorren en
+// bucle. El resultado de cada iteracion se acumula en un sink que se
+// publica al final para que el optimizador no pueda eliminar el trabajo.
+//
+// allocations no mide tiempo: cuenta con AllocationCounter las reservas de
+// heap por trama de cada camino de decode y las publica como "events per
+// iteration". Falla si el pool o decodeView() reservan algo.
+// =============================================================================
+
+#include <QtTest>
+#include "allocationcounter.h"
+#include "stanagbenchmark.h"
+#include "stanagcatalog.h"
+#include "stanagcodec.h"
+#include "stanagmessagepool.h"
+#include "stanagstreamdecoder.h"
+
+namespace {
+
+constexpr int kSampleCount = 64;       // Potencia de 2: indice con mascara
+constexpr int kPackedFrames = 64;      // Tramas por datagrama en streamDecoder
+constexpr int kCountedFrames = 10000;  // Tramas por fila en allocations
+
+volatile double g_sink = 0.0;
+
+QList<QByteArray> encodeAll(const QList<StanagMessage> &messages)
+{
+    QList<QByteArray> frames;
+    frames.reserve(messages.size());
+    for (const StanagMessage &msg : messages)
+        frames.append(StanagCodec::encode(msg));
+    return frames;
+}
+
+} // namespace
+
+class StanagCodecBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void encode_data() { densityRows(); }
+    void encode();
+    void decode_data() { densityRows(); }
+    void decode();
+    void decodePooled_data() { densityRows(); }
+    void decodePooled();
+    void decodeView_data() { densityRows(); }
+    void decodeView();
+    void streamDecoder_data() { densityRows(); }
+    void streamDecoder();
+    void allocations_data();
+    void allocations();
+
+private:
+    static void densityRows();
+};
+
+void StanagCodecBench::densityRows()
+{
+    QTest::addColumn<int>("fieldCount");
+    for (int fields : { 1, 2, 4, 7, 10, 14 })
+        QTest::addRow("%d fields", fields) << fields;
+}
+
+// encode() sobre mensajes ya construidos: no cuenta crear el StanagMessage
+void StanagCodecBench::encode()
+{
+    QFETCH(int, fieldCount);
+    const QList<StanagMessage> messages =
+        StanagBenchmark::sampleMessages(kSampleCount, fieldCount);
+
+    double sink = 0.0;
+    int n = 0;
+    QBENCHMARK {
+        sink += StanagCodec::encode(messages[n++ & (kSampleCount - 1)]).size();
+    }
+    g_sink = sink;
+}
+
+// decode() a un StanagMessage nuevo por trama (el camino original)
+void StanagCodecBench::decode()
+{
+    QFETCH(int, fieldCount);
+    const QList<QByteArray> frames =
+        encodeAll(StanagBenchmark::sampleMessages(kSampleCount, fieldCount));
+
+    double sink = 0.0;
+    int n = 0;
+    QBENCHMARK {
+        StanagMessage msg;
+        if (StanagCodec::decode(frames[n++ & (kSampleCount - 1)], msg))
+            sink += msg.fields.constFirst().value;
+    }
+    g_sink = sink;
+}
+
+// decode() sobre un mensaje de StanagMessagePool (capacidad reutilizada)
+void StanagCodecBench::decodePooled()
+{
+    QFETCH(int, fieldCount);
+    const QList<QByteArray> frames =
+        encodeAll(StanagBenchmark::sampleMessages(kSampleCount, fieldCount));
+
+    StanagMessagePool pool(1);
+    StanagMessagePool::Handle msg = pool.acquire();
+    double sink = 0.0;
+    int n = 0;
+    QBENCHMARK {
+        if (StanagCodec::decode(frames[n++ & (kSampleCount - 1)], *msg))
+            sink += msg->fields.constFirst().value;
+    }
+    g_sink = sink;
+}
+
+// decodeView(): sin copias ni reservas, valores en un array fijo
+void StanagCodecBench::decodeView()
+{
+    QFETCH(int, fieldCount);
+    const QList<QByteArray> frames =
+        encodeAll(StanagBenchmark::sampleMessages(kSampleCount, fieldCount));
+
+    double sink = 0.0;
+    int n = 0;
+    QBENCHMARK {
+        StanagFrameView view;
+        if (StanagCodec::decodeView(frames[n++ & (kSampleCount - 1)], view))
+            sink += view.values[qCountTrailingZeroBits(quint32(view.presenceMask))];
+    }
+    g_sink = sink;
+}
+
+// StanagStreamDecoder sobre un datagrama con kPackedFrames tramas seguidas
+// (lo que hace el receptor con datagramas empaquetados)
+void StanagCodecBench::streamDecoder()
+{
+    QFETCH(int, fieldCount);
+    const QList<QByteArray> frames =
+        encodeAll(StanagBenchmark::sampleMessages(kPackedFrames, fieldCount));
+
+    QByteArray datagram;
+    for (const QByteArray &frame : frames)
+        datagram += frame;
+
+    StanagCatalog catalog;
+    StanagStreamDecoder decoder;
+    decoder.setCatalog(&catalog);
+
+    double sink = 0.0;
+    QBENCHMARK {
+        decoder.feed(datagram, true);
+        StanagFrameView view;
+        while (decoder.next(view))
+            sink += view.sequenceNum;
+    }
+    QCOMPARE(decoder.skippedBytes(), quint64(0));
+    g_sink = sink;
+}
+
+void StanagCodecBench::allocations_data()
+{
+    QTest::addColumn<QString>("path");
+    QTest::addColumn<int>("fieldCount");
+    for (const char *path : { "decode", "decodePooled", "decodeView" }) {
+        for (int fields : { 1, 14 })
+            QTest::addRow("%s, %d fields", path, fields) << QString::fromLatin1(path) << fields;
+    }
+}
+
+// Reservas por trama del hilo que decodifica. El pool se calienta con una
+// pasada por todas las tramas: lo que se cuenta es el regimen estable.
+void StanagCodecBench::allocations()
+{
+    if (!AllocationCounter::isSupported())
+        QSKIP("AllocationCounter no esta disponible (no glibc, o ASan)");
+
+    QFETCH(QString, path);
+    QFETCH(int, fieldCount);
+    const QList<QByteArray> frames =
+        encodeAll(StanagBenchmark::sampleMessages(kSampleCount, fieldCount));
+
+    StanagMessagePool pool(1);
+    for (const QByteArray &frame : frames)
+        StanagCodec::decode(frame, *pool.acquire());
+
+    double sink = 0.0;
+    const quint64 before = AllocationCounter::threadAllocations();
+    for (int n = 0; n < kCountedFrames; ++n) {
+        const QByteArray &frame = frames[n & (kSampleCount - 1)];
+        if (path == QLatin1String("decode")) {
+            StanagMessage msg;
+            if (StanagCodec::decode(frame, msg))
+                sink += msg.fields.constFirst().value;
+        } else if (path == QLatin1String("decodePooled")) {
+            StanagMessagePool::Handle msg = pool.acquire();
+            if (StanagCodec::decode(frame, *msg))
+                sink += msg->fields.constFirst().value;
+        } else {
+            StanagFrameView view;
+            if (StanagCodec::decodeView(frame, view))
+                sink += view.values[qCountTrailingZeroBits(quint32(view.presenceMask))];
+        }
+    }
+    const quint64 allocations = AllocationCounter::threadAllocations() - before;
+    g_sink = sink;
+
+    QTest::setBenchmarkResult(double(allocations) / kCountedFrames, QTest::Events);
+    if (path != QLatin1String("decode"))
+        QCOMPARE(allocations, quint64(0));
+}
+
+QTEST_GUILESS_MAIN(StanagCodecBench)
+#include "stanagcodecbench.moc"
@@ -0,0 +1,107 @@
+// =============================================================================
+// CaptureCard.qml — Captura pcap de lo recibido + replay de capturas
+// =============================================================================
+// "Capture" graba cada datagrama recibido en controller.capturePath (pcap
+// con timestamps en ns, abrible con Wireshark). Si el fichero ya existe se
+// continua al final.
+//
+// "Replay" reenvia el mismo fichero a sendPort con ReplayEngine:
+//   x1 / x2 / x10 → respetando los tiempos originales (escalados)
+//   Max           → sin esperas, lo mas rapido que acepte el socket
+// Sirve para reproducir trafico real (bugs de campo) o estresar el
+// receptor con rafagas realistas.
+// =============================================================================
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    // --- API publica ---
+    property var controller: null
+
+    // --- Estado interno ---
+    readonly property bool capturing: controller ? controller.capturing : false
+    readonly property bool replaying: controller ? controller.replaying : false
+    readonly property var speeds: [1, 2, 10, 0]
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(12)
+        spacing: Style.resize(6)
+
+        Label {
+            text: "Capture / Replay"
+            font.pixelSize: Style.resize(16)
+            font.bold: true
+            color: Style.mainColor
+            Layout.fillWidth: true
+        }
+
+        TextField {
+            text: root.controller ? root.controller.capturePath : ""
+            font.pixelSize: Style.resize(11)
+            enabled: root.controller !== null && !root.capturing
+            Layout.fillWidth: true
+            onEditingFinished: root.controller.capturePath = text
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            Button {
+                text: root.capturing ? "Stop" : "Capture"
+                enabled: root.controller !== null
+                onClicked: root.capturing ? root.controller.stopCapture()
+                                          : root.controller.startCapture()
+            }
+
+            Label {
+                text: (root.controller ? root.controller.capturedCount : 0) + " pkts"
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: root.capturing ? Style.mainColor : Style.fontSecondaryColor
+                Layout.fillWidth: true
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            ComboBox {
+                id: speedCombo
+                model: ["x1", "x2", "x10", "Max"]
+                enabled: !root.replaying
+                Layout.preferredWidth: Style.resize(80)
+            }
+
+            Button {
+                text: root.replaying ? "Stop" : "Replay"
+                enabled: root.controller !== null && root.controller.bound
+                onClicked: {
+                    if (root.replaying)
+                        root.controller.stopReplay()
+                    else
+                        root.controller.startReplay(root.controller.capturePath,
+                                                    root.speeds[speedCombo.currentIndex])
+                }
+            }
+
+            ProgressBar {
+                from: 0
+                to: Math.max(1, root.controller ? root.controller.replayTotal : 1)
+                value: root.controller ? root.controller.replaySent : 0
+                Layout.fillWidth: true
+            }
+        }
+
+        Item { Layout.fillHeight: true }
+    }
+}
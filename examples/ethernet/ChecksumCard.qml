@@ -0,0 +1,150 @@
+// =============================================================================
+// ChecksumCard.qml — Modo de checksum de la trama + benchmark de kernels
+// =============================================================================
+// TX: controller.checksumMode elige con que se codifican las tramas
+// enviadas (XOR 1 byte, CRC-16-CCITT 2 bytes, CRC-32 4 bytes).
+// Peer: el receptor deduce el modo de cada trama por el tamano del trailer
+// (controller.peerChecksumMode). Con "Follow" activo, el modo de envio
+// adopta el del peer en cuanto llega una trama valida; elegir un modo TX a
+// mano lo desactiva.
+//
+// "Bench" lanza controller.runChecksumBenchmark(): MB/s de cada kernel para
+// tramas de 13 B (trama minima) a 64 KB. "XOR 1B" es el bucle original
+// byte a byte; "XOR wide" la reduccion por palabras / SSE2 / AVX2.
+// =============================================================================
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    // --- API publica ---
+    property var controller: null
+
+    // --- Estado interno ---
+    readonly property var modeNames: ["XOR-8", "CRC-16", "CRC-32"]
+    property var rows: []
+
+    function formatSize(bytes) {
+        return bytes >= 1024 ? (bytes / 1024) + " KB" : bytes + " B"
+    }
+
+    function formatRate(mbps) {
+        return mbps >= 1024 ? (mbps / 1024).toFixed(1) + "G" : mbps.toFixed(0) + "M"
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(12)
+        spacing: Style.resize(6)
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            Label {
+                text: "Checksum"
+                font.pixelSize: Style.resize(16)
+                font.bold: true
+                color: Style.mainColor
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: mbSpin
+                from: 1
+                to: 256
+                value: 16
+                editable: true
+                Layout.preferredWidth: Style.resize(100)
+            }
+
+            Button {
+                text: "Bench"
+                enabled: root.controller !== null
+                onClicked: root.rows = root.controller.runChecksumBenchmark(mbSpin.value)
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            Label {
+                text: "TX:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+
+            ComboBox {
+                model: root.modeNames
+                currentIndex: root.controller ? root.controller.checksumMode : 0
+                enabled: root.controller !== null
+                Layout.preferredWidth: Style.resize(110)
+                onActivated: function(index) {
+                    root.controller.checksumMode = index
+                }
+            }
+
+            Label {
+                text: "Peer: " + (root.controller && root.controller.peerChecksumMode >= 0
+                                  ? root.modeNames[root.controller.peerChecksumMode] : "—")
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: Style.fontPrimaryColor
+                Layout.fillWidth: true
+            }
+
+            Switch {
+                text: "Follow"
+                checked: root.controller ? root.controller.followPeerChecksum : false
+                enabled: root.controller !== null
+                onToggled: root.controller.followPeerChecksum = checked
+            }
+        }
+
+        // --- Tabla de resultados (MB/s por kernel y tamano) ---
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 5
+            columnSpacing: Style.resize(10)
+            rowSpacing: Style.resize(2)
+            visible: root.rows.length > 0
+
+            Repeater {
+                model: ["Size", "XOR 1B", "XOR wide", "CRC-16", "CRC-32"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(11)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            Repeater {
+                model: root.rows.length * 5
+                Label {
+                    required property int index
+                    readonly property var row: root.rows[Math.floor(index / 5)]
+                    readonly property int column: index % 5
+                    text: column === 0 ? root.formatSize(row.size)
+                        : column === 1 ? root.formatRate(row.xorBytewiseMBps)
+                        : column === 2 ? root.formatRate(row.xorWideMBps)
+                        : column === 3 ? root.formatRate(row.crc16MBps)
+                                       : root.formatRate(row.crc32MBps)
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Courier New"
+                    color: column === 2 ? Style.mainColor : Style.fontPrimaryColor
+                }
+            }
+        }
+
+        Item { Layout.fillHeight: true }
+    }
+}
@@ -0,0 +1,277 @@
+// =============================================================================
+// CodecBenchmarkCard.qml — Benchmark del codec STANAG (decode, densidad, fuzzing)
+// =============================================================================
+// Lanza EthernetController.runDecodeBenchmark() y muestra las tramas por
+// segundo de cada implementacion de decode:
+//   - Legacy: StanagCodec::decode() a un StanagMessage nuevo por trama
+//   - Pool:   decode() a mensajes reciclados (StanagMessagePool)
+//   - Fast:   StanagCodec::decodeView() sin copias (StanagFrameView)
+// y cuantas tramas del camino Pool reutilizaron un mensaje sin crear otro
+// (las reservas de heap por trama se cuentan en benchmarks/stanagcodecbench).
+//
+// "Hex" mide lo mismo para el hex dump (runHexBenchmark):
+//   - Legacy: QString::fromLatin1(toHex(' ')).toUpper()
+//   - Fast:   HexFormatter::format() (una reserva, SSE2)
+//
+// "Masks" (runDensityBenchmark) mide encode, decode y decodeView con 1 a
+// 14 campos presentes: una fila por densidad, en M tramas/s.
+//
+// "Fuzz" (runFuzzer) lanza N entradas mutadas contra el decode y el
+// parseo de sendRawHex con la semilla indicada. Un fallo muestra la
+// entrada que lo provoca para reproducirlo.
+//
+// El benchmark es sincrono: la UI se congela unos milisegundos mientras
+// mide. Es intencionado — medir en otro hilo compartiria CPU con el render.
+// =============================================================================
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    // --- API publica ---
+    // EthernetController que ejecuta el benchmark (devuelve un QVariantMap)
+    property var controller: null
+
+    // --- Estado interno ---
+    property var result: null
+    property string mode: "decode"   // "decode" | "hex" | "density"
+    property var densityRows: []
+    property var fuzzResult: null
+
+    function formatReuse(rate, messages) {
+        return (rate * 100).toFixed(1) + "% (" + messages + " msgs)"
+    }
+
+    function formatRate(fps) {
+        if (fps >= 1e6)
+            return (fps / 1e6).toFixed(2) + " M frames/s"
+        return (fps / 1e3).toFixed(1) + " k frames/s"
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(12)
+        spacing: Style.resize(6)
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            Label {
+                text: "Codec Benchmark"
+                font.pixelSize: Style.resize(16)
+                font.bold: true
+                color: Style.mainColor
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: framesSpin
+                from: 10000
+                to: 2000000
+                stepSize: 10000
+                value: 200000
+                editable: true
+                Layout.preferredWidth: Style.resize(130)
+            }
+
+            Button {
+                text: "Run"
+                enabled: root.controller !== null
+                onClicked: {
+                    root.mode = "decode"
+                    root.result = root.controller.runDecodeBenchmark(framesSpin.value)
+                }
+            }
+
+            Button {
+                text: "Hex"
+                enabled: root.controller !== null
+                onClicked: {
+                    root.mode = "hex"
+                    root.result = root.controller.runHexBenchmark(framesSpin.value)
+                }
+            }
+
+            Button {
+                text: "Masks"
+                enabled: root.controller !== null
+                onClicked: {
+                    root.mode = "density"
+                    root.densityRows = root.controller.runDensityBenchmark(framesSpin.value)
+                }
+            }
+        }
+
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 2
+            columnSpacing: Style.resize(12)
+            rowSpacing: Style.resize(2)
+            visible: root.result !== null && root.mode !== "density"
+
+            Label {
+                text: root.mode === "hex" ? "toHex().toUpper():" : "decode() (new msg):"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+            Label {
+                text: root.result ? root.formatRate(root.result.legacyFramesPerSec) : ""
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: Style.fontPrimaryColor
+            }
+
+            Label {
+                text: "decode() (pool):"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+                visible: root.mode === "decode"
+            }
+            Label {
+                text: root.result && root.mode === "decode"
+                      ? root.formatRate(root.result.pooledFramesPerSec) : ""
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: Style.fontPrimaryColor
+                visible: root.mode === "decode"
+            }
+
+            Label {
+                text: root.mode === "hex" ? "HexFormatter (SSE2):" : "decodeView() (zero-copy):"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+            Label {
+                text: root.result ? root.formatRate(root.result.fastFramesPerSec) : ""
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: Style.mainColor
+            }
+
+            Label {
+                text: "Speedup:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+            Label {
+                text: root.result ? "x" + root.result.speedup.toFixed(2) : ""
+                font.pixelSize: Style.resize(12)
+                font.bold: true
+                color: Style.mainColor
+            }
+
+            // Contadores del pool durante la medicion
+            Label {
+                text: "Pool reuse:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+                visible: root.mode === "decode"
+            }
+            Label {
+                text: root.result && root.mode === "decode"
+                      ? root.formatReuse(root.result.pooledReuseRate, root.result.pooledMessages)
+                      : ""
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: Style.fontPrimaryColor
+                visible: root.mode === "decode"
+            }
+        }
+
+        // --- Densidad de campos: M tramas/s por camino ---
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 5
+            columnSpacing: Style.resize(10)
+            rowSpacing: Style.resize(2)
+            visible: root.mode === "density" && root.densityRows.length > 0
+
+            Repeater {
+                model: ["Fields", "Bytes", "encode", "decode", "view"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(11)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            Repeater {
+                model: root.densityRows.length * 5
+                Label {
+                    required property int index
+                    readonly property var row: root.densityRows[Math.floor(index / 5)]
+                    readonly property int column: index % 5
+                    text: column === 0 ? row.fields
+                        : column === 1 ? row.frameSize.toFixed(0)
+                        : column === 2 ? (row.encodeFramesPerSec / 1e6).toFixed(2)
+                        : column === 3 ? (row.decodeFramesPerSec / 1e6).toFixed(2)
+                                       : (row.decodeViewFramesPerSec / 1e6).toFixed(2)
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Courier New"
+                    color: column === 4 ? Style.mainColor : Style.fontPrimaryColor
+                }
+            }
+        }
+
+        // --- Fuzzing ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            SpinBox {
+                id: fuzzSpin
+                from: 1000
+                to: 10000000
+                stepSize: 10000
+                value: 100000
+                editable: true
+                Layout.preferredWidth: Style.resize(130)
+            }
+
+            SpinBox {
+                id: seedSpin
+                from: 0
+                to: 999999
+                value: 1
+                editable: true
+                Layout.preferredWidth: Style.resize(100)
+            }
+
+            Button {
+                text: "Fuzz"
+                enabled: root.controller !== null
+                onClicked: root.fuzzResult = root.controller.runFuzzer(fuzzSpin.value, seedSpin.value)
+            }
+
+            Label {
+                text: root.fuzzResult
+                      ? root.fuzzResult.failures + " failures, "
+                        + (root.fuzzResult.execsPerSec / 1e3).toFixed(0) + " k/s"
+                      : ""
+                font.pixelSize: Style.resize(12)
+                font.family: "Courier New"
+                color: root.fuzzResult && root.fuzzResult.failures > 0 ? "#F44336" : Style.mainColor
+                Layout.fillWidth: true
+            }
+        }
+
+        Label {
+            visible: root.fuzzResult !== null && root.fuzzResult.failures > 0
+            text: root.fuzzResult ? root.fuzzResult.firstFailure + "\n" + root.fuzzResult.firstFailureHex : ""
+            font.pixelSize: Style.resize(11)
+            font.family: "Courier New"
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WrapAnywhere
+            Layout.fillWidth: true
+        }
+    }
+}
@@ -26,6 +26,10 @@ Rectangle {
     property int sentCount: 0
     property int receivedCount: 0
     property int errorCount: 0
+    property bool batchReceive: false
+    property bool threadedReceive: false
+    property int droppedCount: 0
+    property int mergedCount: 0
 
     // Puertos configurados (leidos desde los SpinBox)
     readonly property int listenPort: listenPortSpin.value
@@ -33,6 +37,8 @@ Rectangle {
 
     signal bindClicked()
     signal unbindClicked()
+    signal batchReceiveToggled(bool enabled)
+    signal threadedReceiveToggled(bool enabled)
 
     ColumnLayout {
         anchors.left: parent.left
@@ -129,6 +135,42 @@ Rectangle {
             }
         }
 
+        // --- Modo de recepcion ---
+        // Batch RX: UdpTransport lee hasta 64 datagramas por llamada al
+        // sistema (recvmmsg en Linux) y emite una senal por lote.
+        // RX thread: socket + decode en un hilo propio; la GUI solo vacia
+        // una cola lock-free una vez por frame (el worker siempre usa batch).
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(4)
+
+            Label {
+                text: "Batch RX (recvmmsg)"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+                Layout.fillWidth: true
+            }
+
+            Switch {
+                checked: root.batchReceive
+                enabled: !root.threadedReceive
+                onToggled: root.batchReceiveToggled(checked)
+                scale: 0.6
+            }
+
+            Label {
+                text: "RX thread"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+
+            Switch {
+                checked: root.threadedReceive
+                onToggled: root.threadedReceiveToggled(checked)
+                scale: 0.6
+            }
+        }
+
         // --- Contadores ---
         RowLayout {
             Layout.fillWidth: true
@@ -178,6 +220,38 @@ Rectangle {
                     color: Style.fontSecondaryColor
                 }
             }
+
+            // Recibidos pero no publicados uno a uno (coalescidos por tick)
+            Row {
+                spacing: Style.resize(4)
+                visible: root.mergedCount > 0
+                Rectangle {
+                    width: Style.resize(8); height: Style.resize(8)
+                    radius: 2; color: Style.inactiveColor
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                Label {
+                    text: "Merged: " + root.mergedCount
+                    font.pixelSize: Style.resize(12)
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            // Descartados por cola llena (solo con RX thread)
+            Row {
+                spacing: Style.resize(4)
+                visible: root.droppedCount > 0
+                Rectangle {
+                    width: Style.resize(8); height: Style.resize(8)
+                    radius: 2; color: "#FF9800"
+                    anchors.verticalCenter: parent.verticalCenter
+                }
+                Label {
+                    text: "Drop: " + root.droppedCount
+                    font.pixelSize: Style.resize(12)
+                    color: Style.fontSecondaryColor
+                }
+            }
         }
     }
 }
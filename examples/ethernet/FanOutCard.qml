@@ -0,0 +1,153 @@
+// =============================================================================
+// FanOutCard.qml — Grupo multicast de escucha + destinos de fan-out
+// =============================================================================
+// Group: grupo multicast que se escucha en listenPort ("" = unicast en
+// 127.0.0.1). Varias instancias pueden escuchar el mismo grupo y puerto en
+// la misma maquina: todas reciben cada trama. Iface: interfaz del grupo
+// ("" = la del kernel, "lo" para multicast solo local).
+//
+// Destinations: con al menos un destino, lo que se envia (mensajes, hex,
+// rafagas) se codifica UNA vez y se reparte a todos con un sendmmsg().
+// Cada fila muestra sus contadores (enviados / fallidos), que el
+// controlador publica una vez por tick de UI.
+// =============================================================================
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    // --- API publica ---
+    property var controller: null
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(12)
+        spacing: Style.resize(6)
+
+        Label {
+            text: "Multicast / Fan-out"
+            font.pixelSize: Style.resize(16)
+            font.bold: true
+            color: Style.mainColor
+            Layout.fillWidth: true
+        }
+
+        // --- Grupo de escucha ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(6)
+
+            TextField {
+                text: root.controller ? root.controller.multicastGroup : ""
+                placeholderText: "Group (239.1.2.3)"
+                font.pixelSize: Style.resize(11)
+                enabled: root.controller !== null
+                Layout.fillWidth: true
+                onEditingFinished: root.controller.multicastGroup = text
+            }
+
+            TextField {
+                text: root.controller ? root.controller.multicastInterface : ""
+                placeholderText: "Iface"
+                font.pixelSize: Style.resize(11)
+                enabled: root.controller !== null
+                Layout.preferredWidth: Style.resize(60)
+                onEditingFinished: root.controller.multicastInterface = text
+            }
+        }
+
+        // --- Nuevo destino ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(6)
+
+            TextField {
+                id: addressField
+                text: "127.0.0.1"
+                font.pixelSize: Style.resize(11)
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: portSpin
+                from: 1
+                to: 65535
+                value: 5002
+                editable: true
+                Layout.preferredWidth: Style.resize(110)
+            }
+
+            Button {
+                text: "Add"
+                enabled: root.controller !== null
+                onClicked: root.controller.addDestination(addressField.text, portSpin.value)
+            }
+        }
+
+        // --- Destinos registrados ---
+        ListView {
+            id: destinationList
+            model: root.controller ? root.controller.destinations : []
+            clip: true
+            spacing: Style.resize(2)
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+
+            delegate: RowLayout {
+                required property int index
+                required property var modelData
+                width: destinationList.width
+                spacing: Style.resize(6)
+
+                Label {
+                    text: modelData.address + ":" + modelData.port
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Courier New"
+                    color: Style.fontPrimaryColor
+                    Layout.fillWidth: true
+                }
+
+                Label {
+                    text: modelData.sent + (modelData.failed > 0 ? " / " + modelData.failed + " failed" : "")
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Courier New"
+                    color: modelData.failed > 0 ? "#F44336" : Style.fontSecondaryColor
+                }
+
+                ToolButton {
+                    text: "✕"
+                    onClicked: root.controller.removeDestination(index)
+                }
+            }
+
+            Label {
+                anchors.centerIn: parent
+                visible: destinationList.count === 0
+                text: "No destinations → sendPort"
+                font.pixelSize: Style.resize(11)
+                color: Style.fontSecondaryColor
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            visible: destinationList.count > 0
+
+            Button {
+                text: "Reset counters"
+                onClicked: root.controller.resetDestinationCounters()
+            }
+
+            Button {
+                text: "Clear"
+                onClicked: root.controller.clearDestinations()
+            }
+        }
+    }
+}
@@ -0,0 +1,163 @@
+// =============================================================================
+// LatencyCard.qml — Latencia de recepcion socket → QML
+// =============================================================================
+// Muestra EthernetController.latencyStats: el tiempo desde que el kernel
+// recibe un datagrama hasta que sus datos llegan a QML.
+//   - Sin RX thread: el datagrama espera en el socket mientras la GUI esta
+//     ocupada (render, layouts...), asi que la cola del histograma crece.
+//   - Con RX thread: el worker lo lee al momento y la espera queda acotada
+//     por el tick de refresco (~16 ms).
+//
+// Las barras agrupan las muestras por potencias de 2 (1 us, 2 us, 4 us...).
+// La propiedad se notifica como mucho una vez por tick de UI.
+//
+// "UI Hz" ajusta controller.uiUpdateRateHz: cuantas veces por segundo se
+// publican contadores, ultima trama y log (0 = una vez por vuelta del
+// event loop, sin tick fijo).
+// =============================================================================
+
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    // --- API publica ---
+    property var controller: null
+
+    // --- Estado interno ---
+    readonly property var stats: controller ? controller.latencyStats : null
+    readonly property var octaves: stats ? stats.octaves : []
+    readonly property real maxOctave: {
+        var m = 1
+        for (var i = 0; i < octaves.length; ++i)
+            m = Math.max(m, octaves[i])
+        return m
+    }
+
+    function formatUs(us) {
+        if (us >= 1000000)
+            return (us / 1000000).toFixed(2) + " s"
+        if (us >= 1000)
+            return (us / 1000).toFixed(2) + " ms"
+        return us + " us"
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(12)
+        spacing: Style.resize(6)
+
+        RowLayout {
+            Layout.fillWidth: true
+
+            Label {
+                text: "RX Latency"
+                font.pixelSize: Style.resize(16)
+                font.bold: true
+                color: Style.mainColor
+                Layout.fillWidth: true
+            }
+
+            Button {
+                text: "Reset"
+                enabled: root.controller !== null
+                onClicked: root.controller.resetLatency()
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            Label {
+                text: "UI Hz:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+
+            SpinBox {
+                from: 0
+                to: 240
+                stepSize: 10
+                editable: true
+                value: root.controller ? root.controller.uiUpdateRateHz : 60
+                onValueModified: root.controller.uiUpdateRateHz = value
+                Layout.preferredWidth: Style.resize(110)
+            }
+        }
+
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 2
+            columnSpacing: Style.resize(12)
+            rowSpacing: Style.resize(2)
+
+            Repeater {
+                model: [
+                    { label: "Samples:", key: "samples" },
+                    { label: "p50:",     key: "p50Us" },
+                    { label: "p99:",     key: "p99Us" },
+                    { label: "p99.9:",   key: "p999Us" },
+                    { label: "max:",     key: "maxUs" }
+                ]
+
+                delegate: RowLayout {
+                    required property var modelData
+                    Layout.columnSpan: 2
+                    spacing: Style.resize(8)
+
+                    Label {
+                        text: modelData.label
+                        font.pixelSize: Style.resize(12)
+                        color: Style.fontSecondaryColor
+                        Layout.preferredWidth: Style.resize(60)
+                    }
+                    Label {
+                        text: !root.stats ? "-"
+                              : modelData.key === "samples" ? root.stats.samples
+                              : root.formatUs(root.stats[modelData.key])
+                        font.pixelSize: Style.resize(12)
+                        font.family: "Courier New"
+                        color: Style.fontPrimaryColor
+                    }
+                }
+            }
+        }
+
+        // --- Barras por potencia de 2 ---
+        Row {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            spacing: 1
+
+            Repeater {
+                model: root.octaves.length
+
+                delegate: Rectangle {
+                    required property int index
+                    readonly property real count: root.octaves[index]
+                    width: Math.max(2, (parent.width - root.octaves.length)
+                                        / Math.max(1, root.octaves.length))
+                    height: parent.height * count / root.maxOctave
+                    y: parent.height - height
+                    color: "#4A90D9"
+                    opacity: count > 0 ? 0.9 : 0.2
+
+                    ToolTip.visible: barArea.containsMouse
+                    ToolTip.text: root.formatUs(Math.pow(2, index)) + ": " + count
+
+                    MouseArea {
+                        id: barArea
+                        anchors.fill: parent
+                        hoverEnabled: true
+                    }
+                }
+            }
+        }
+    }
+}
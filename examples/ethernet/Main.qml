@@ -7,15 +7,23 @@
 //
 // Estructura:
 //   - EthernetController (C++): fachada que engloba UDP + codec STANAG
-//   - ListModel (logModel): almacen central de mensajes (sent/received/error)
+//   - controller.logModel: historial de mensajes (QAbstractListModel en C++,
+//     ring buffer que se actualiza una vez por tick de UI)
 //   - ConnectionCard: configuracion de puertos y bind/unbind
-//   - SendMessageCard: constructor de mensajes con bitmask de campos
+//   - SendMessageCard: constructor de mensajes con bitmask de campos (los
+//     del catalogo de mensajes segun el Msg ID)
 //   - MessageLogCard: historial de comunicacion con hex dumps
 //   - HexViewCard: visor hexadecimal + campos decodificados
+//   - StatsCard: estadisticas por flujo (msg/s, huecos, jitter) + JSON
+//   - CodecBenchmarkCard: decode clasico vs decodeView(), densidad de campos, fuzzing
+//   - LatencyCard: histograma de latencia socket → QML (p50/p99/max)
+//   - ChecksumCard: modo de checksum (XOR / CRC-16 / CRC-32) + benchmark
+//   - CaptureCard: captura pcap de lo recibido + replay (x1, x2, x10, max)
+//   - FanOutCard: grupo multicast de escucha + destinos de fan-out
 //
 // Flujo de datos:
-//   SEND: QML → sendMessage() → encode BigEndian → UDP localhost
-//   RECV: UDP localhost → decode BigEndian → signals → QML ListModel
+//   SEND: QML → sendMessage() → encode BigEndian → UDP localhost (o fan-out)
+//   RECV: UDP localhost → decode BigEndian → tick de UI → logModel + signals
 // =============================================================================
 
 import QtQuick
@@ -48,61 +56,16 @@ Item {
     // Las propiedades listenPort y sendPort se vinculan bidireccionalmente con
     // los SpinBox del ConnectionCard.
     //
-    // Los handlers de senales (onMessageSent, etc.) reciben los datos
-    // ya parseados como tipos simples (QString, int, bool) e insertan
-    // entries en el ListModel para que el log se actualice reactivamente.
+    // El log ya no se construye aqui: el controlador alimenta su propio
+    // modelo (controller.logModel) y lo publica una vez por tick de UI.
+    // Solo queda el handler de campos decodificados para HexViewCard.
     // =========================================================================
     EthernetController {
         id: controller
 
-        onMessageSent: function(timestamp, hexDump, messageId, fieldCount, byteSize) {
-            logModel.insert(0, {
-                time: timestamp,
-                direction: "sent",
-                msgId: messageId,
-                fields: fieldCount,
-                size: byteSize,
-                hex: hexDump,
-                checksumOk: true,
-                errorText: ""
-            })
-        }
-
-        onMessageReceived: function(timestamp, hexDump, messageId, sourcePort,
-                                     fieldCount, byteSize, checksumOk) {
-            logModel.insert(0, {
-                time: timestamp,
-                direction: "received",
-                msgId: messageId,
-                fields: fieldCount,
-                size: byteSize,
-                hex: hexDump,
-                checksumOk: checksumOk,
-                errorText: ""
-            })
-        }
-
         onFieldsDecoded: function(fields) {
             hexViewCard.decodedFields = fields
         }
-
-        onProtocolError: function(timestamp, error, hexDump) {
-            logModel.insert(0, {
-                time: timestamp,
-                direction: "error",
-                msgId: 0,
-                fields: 0,
-                size: 0,
-                hex: hexDump,
-                checksumOk: false,
-                errorText: error
-            })
-        }
-    }
-
-    // Modelo central de mensajes
-    ListModel {
-        id: logModel
     }
 
     Rectangle {
@@ -138,23 +101,46 @@ Item {
                 Layout.maximumHeight: Style.resize(350)
                 spacing: Style.resize(15)
 
-                ConnectionCard {
-                    id: connectionCard
+                // Columna izquierda: conexion + benchmark del codec
+                ColumnLayout {
                     Layout.fillWidth: true
-                    Layout.preferredHeight: Style.resize(170)
-                    Layout.alignment: Qt.AlignTop
+                    Layout.fillHeight: true
                     Layout.preferredWidth: 1
-                    bound: controller.bound
-                    statusText: controller.statusText
-                    sentCount: controller.sentCount
-                    receivedCount: controller.receivedCount
-                    errorCount: controller.errorCount
-                    onBindClicked: {
-                        controller.listenPort = connectionCard.listenPort
-                        controller.sendPort = connectionCard.sendPort
-                        controller.startListening()
+                    spacing: Style.resize(15)
+
+                    ConnectionCard {
+                        id: connectionCard
+                        Layout.fillWidth: true
+                        Layout.preferredHeight: Style.resize(200)
+                        Layout.alignment: Qt.AlignTop
+                        bound: controller.bound
+                        batchReceive: controller.batchReceive
+                        threadedReceive: controller.threadedReceive
+                        droppedCount: controller.droppedCount
+                        mergedCount: controller.mergedCount
+                        statusText: controller.statusText
+                        sentCount: controller.sentCount
+                        receivedCount: controller.receivedCount
+                        errorCount: controller.errorCount
+                        onBindClicked: {
+                            controller.listenPort = connectionCard.listenPort
+                            controller.sendPort = connectionCard.sendPort
+                            controller.startListening()
+                        }
+                        onUnbindClicked: controller.stopListening()
+                        onBatchReceiveToggled: function(enabled) {
+                            controller.batchReceive = enabled
+                        }
+                        onThreadedReceiveToggled: function(enabled) {
+                            controller.threadedReceive = enabled
+                        }
+                    }
+
+                    CodecBenchmarkCard {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        controller: controller
                     }
-                    onUnbindClicked: controller.stopListening()
                 }
 
                 SendMessageCard {
@@ -164,17 +150,32 @@ Item {
                     Layout.preferredWidth: 1
                     Layout.alignment: Qt.AlignTop
                     enabled: controller.bound
-                    fieldDefinitions: controller.getFieldDefinitions()
+                    catalogMessages: controller.catalogMessages
+                    fieldDefinitions: {
+                        controller.catalogMessages   // Re-evaluar tras loadCatalog()
+                        return controller.getFieldDefinitions(sendCard.messageId)
+                    }
                     onSendMessageRequested: function(messageId, presenceMask, fieldValues) {
                         controller.sendMessage(messageId, presenceMask, fieldValues)
                     }
                     onSendRawHexRequested: function(hexString) {
                         controller.sendRawHex(hexString)
                     }
+                    bursting: controller.bursting
+                    onSendBurstRequested: function(messageId, presenceMask, fieldValues,
+                                                   count, rateHz) {
+                        controller.sendBurst(messageId, presenceMask, fieldValues,
+                                             count, rateHz)
+                    }
+                    onStopBurstRequested: controller.stopBurst()
+                    framesPerDatagram: controller.framesPerDatagram
+                    onFramesPerDatagramRequested: function(frames) {
+                        controller.framesPerDatagram = frames
+                    }
                 }
             }
 
-            // --- Fila inferior: Log + Hex View ---
+            // --- Fila inferior: Log + Hex View / Stats + Latencia / Captura / Checksum / Fan-out ---
             RowLayout {
                 Layout.fillWidth: true
                 Layout.fillHeight: true
@@ -184,23 +185,67 @@ Item {
                     Layout.fillWidth: true
                     Layout.fillHeight: true
                     Layout.preferredWidth: 1
-                    logModel: logModel
+                    logModel: controller.logModel
                     onEntrySelected: function(hex) {
                         hexViewCard.currentHex = hex
                     }
                 }
 
-                HexViewCard {
-                    id: hexViewCard
+                // Columna central: hex view + estadisticas por flujo
+                ColumnLayout {
                     Layout.fillWidth: true
                     Layout.fillHeight: true
                     Layout.preferredWidth: 1
+                    spacing: Style.resize(15)
+
+                    HexViewCard {
+                        id: hexViewCard
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                    }
+
+                    StatsCard {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        controller: controller
+                    }
+                }
+
+                ColumnLayout {
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+                    Layout.preferredWidth: 0.6
+                    spacing: Style.resize(15)
+
+                    LatencyCard {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        controller: controller
+                    }
+
+                    CaptureCard {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        controller: controller
+                    }
+
+                    ChecksumCard {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        controller: controller
+                    }
+
+                    FanOutCard {
+                        Layout.fillWidth: true
+                        Layout.fillHeight: true
+                        controller: controller
+                    }
                 }
             }
 
             // --- Pie de pagina ---
             Label {
-                text: "C++ EthernetController (QML_ELEMENT) wraps StanagCodec (QDataStream BigEndian) + UdpTransport (QUdpSocket). Protocol: 12B header + variable payload (bitmask) + XOR checksum."
+                text: "C++ EthernetController (QML_ELEMENT) wraps StanagCodec (qToBigEndian / qFromBigEndian) + UdpTransport (QUdpSocket). Protocol: 12B header + variable payload (bitmask) + XOR / CRC-16 / CRC-32 checksum."
                 font.pixelSize: Style.resize(11)
                 color: Style.fontSecondaryColor
                 wrapMode: Text.WordWrap
@@ -8,8 +8,13 @@
 // Al hacer click en una entrada, se emite entrySelected con el hex dump
 // para que HexViewCard lo muestre en detalle.
 //
+// logModel es EthernetController.logModel (QAbstractListModel en C++): expone
+// los mismos roles que un ListModel, mas 'count' y clear(). Las entradas
+// "received" pueden traer una nota ("+N merged") cuando varias tramas
+// llegaron en el mismo tick de UI.
+//
 // Patron de colores:
-//   - Teal (#00D1A9): mensajes enviados
+//   - Teal (#00D1A9): mensajes enviados (y lotes de rafaga, "burst")
 //   - Azul (#4A90D9): mensajes recibidos
 //   - Rojo (#F44336): errores de protocolo
 // =============================================================================
@@ -111,9 +116,11 @@ Rectangle {
                     // Flecha de direccion
                     Label {
                         text: delegateRoot.direction === "sent" ? "\u2192" :
+                              delegateRoot.direction === "burst" ? "\u21C9" :
                               delegateRoot.direction === "received" ? "\u2190" : "\u26A0"
                         font.pixelSize: Style.resize(14)
                         color: delegateRoot.direction === "sent" ? Style.mainColor :
+                               delegateRoot.direction === "burst" ? Style.mainColor :
                                delegateRoot.direction === "received" ? "#4A90D9" : "#F44336"
                         Layout.preferredWidth: Style.resize(16)
                         horizontalAlignment: Text.AlignHCenter
@@ -123,9 +130,15 @@ Rectangle {
                     Label {
                         text: delegateRoot.direction === "error"
                                   ? delegateRoot.errorText
-                                  : "ID:%1  Fields:%2  %3B".arg(delegateRoot.msgId)
-                                                            .arg(delegateRoot.fields)
-                                                            .arg(delegateRoot.size)
+                                  : delegateRoot.direction === "burst"
+                                    ? "ID:%1  %2  %3B".arg(delegateRoot.msgId)
+                                                      .arg(delegateRoot.errorText)
+                                                      .arg(delegateRoot.size)
+                                    : "ID:%1  Fields:%2  %3B".arg(delegateRoot.msgId)
+                                                              .arg(delegateRoot.fields)
+                                                              .arg(delegateRoot.size)
+                                      + (delegateRoot.errorText !== ""
+                                             ? "  " + delegateRoot.errorText : "")
                         font.pixelSize: Style.resize(12)
                         font.family: delegateRoot.direction === "error" ? "" : "Courier New"
                         color: delegateRoot.direction === "error"
@@ -158,6 +171,7 @@ Rectangle {
                         Layout.preferredHeight: Style.resize(18)
                         radius: Style.resize(3)
                         color: delegateRoot.direction === "sent" ? "#1B3A2A" :
+                               delegateRoot.direction === "burst" ? "#1B3A2A" :
                                delegateRoot.direction === "received" ? "#1A2A3A" : "#3A1A1A"
 
                         Label {
@@ -165,6 +179,7 @@ Rectangle {
                             text: delegateRoot.direction
                             font.pixelSize: Style.resize(9)
                             color: delegateRoot.direction === "sent" ? "#4CAF50" :
+                                   delegateRoot.direction === "burst" ? "#4CAF50" :
                                    delegateRoot.direction === "received" ? "#42A5F5" : "#EF5350"
                         }
                     }
@@ -3,12 +3,16 @@
 // =============================================================================
 // Permite construir y enviar mensajes STANAG con:
 //   - Message ID (SpinBox)
-//   - Bitmask de presencia: checkboxes para los 14 campos de telemetria
+//   - Bitmask de presencia: un checkbox por campo del mensaje (los de su
+//     entrada en el catalogo, o los 14 de telemetria si no tiene)
 //   - Valores editables para cada campo activo
 //   - Modo "Raw Hex" para enviar tramas manuales
+//   - Rafagas (Burst): N copias del mensaje a un ritmo dado (0 = maximo)
+//     y, opcionalmente, varias tramas por datagrama ("x N")
 //
 // Los checkboxes se generan dinamicamente desde la tabla de fieldDefinitions
-// que viene del C++ (EthernetController.getFieldDefinitions()).
+// que viene del C++ (EthernetController.getFieldDefinitions(messageId)):
+// al cambiar el Msg ID cambian los campos.
 //
 // Al pulsar "Send", se recopilan los valores de los campos activos en un
 // QVariantList y se pasan a EthernetController.sendMessage() junto con
@@ -27,15 +31,32 @@ Rectangle {
 
     // --- API publica ---
     property var fieldDefinitions: []
+    property var catalogMessages: []
+    readonly property int messageId: msgIdSpin.value
+    property bool bursting: false
+    property int framesPerDatagram: 1
 
     signal sendMessageRequested(int messageId, int presenceMask, var fieldValues)
     signal sendRawHexRequested(string hexString)
+    signal sendBurstRequested(int messageId, int presenceMask, var fieldValues,
+                              int count, int rateHz)
+    signal stopBurstRequested()
+    signal framesPerDatagramRequested(int frames)
 
     // --- Estado interno ---
     property bool rawMode: false
 
+    // Nombre del mensaje en el catalogo ("Telemetry" si no esta)
+    function messageName(id) {
+        for (var i = 0; i < catalogMessages.length; ++i) {
+            if (catalogMessages[i].id === id)
+                return catalogMessages[i].name
+        }
+        return "Telemetry"
+    }
+
     // Recopilar el bitmask y los valores de los campos activos
-    function collectAndSend() {
+    function collectFields() {
         var presenceMask = 0
         var values = []
 
@@ -47,7 +68,18 @@ Rectangle {
             }
         }
 
-        root.sendMessageRequested(msgIdSpin.value, presenceMask, values)
+        return { presenceMask: presenceMask, values: values }
+    }
+
+    function collectAndSend() {
+        var f = collectFields()
+        root.sendMessageRequested(msgIdSpin.value, f.presenceMask, f.values)
+    }
+
+    function collectAndBurst() {
+        var f = collectFields()
+        root.sendBurstRequested(msgIdSpin.value, f.presenceMask, f.values,
+                                burstCountSpin.value, burstRateSpin.value)
     }
 
     ColumnLayout {
@@ -131,7 +163,13 @@ Rectangle {
                     Layout.preferredWidth: Style.resize(100)
                 }
 
-                Item { Layout.fillWidth: true }
+                Label {
+                    text: root.messageName(msgIdSpin.value)
+                    font.pixelSize: Style.resize(12)
+                    color: Style.inactiveColor
+                    elide: Text.ElideRight
+                    Layout.fillWidth: true
+                }
 
                 Button {
                     text: "Send"
@@ -139,6 +177,68 @@ Rectangle {
                 }
             }
 
+            // Rafaga: count tramas a rateHz (0 = lo mas rapido posible)
+            RowLayout {
+                Layout.fillWidth: true
+                spacing: Style.resize(8)
+
+                Label {
+                    text: "Burst:"
+                    font.pixelSize: Style.resize(13)
+                    color: Style.fontSecondaryColor
+                }
+
+                SpinBox {
+                    id: burstCountSpin
+                    from: 1
+                    to: 1000000
+                    stepSize: 1000
+                    value: 10000
+                    editable: true
+                    Layout.preferredWidth: Style.resize(120)
+                }
+
+                Label {
+                    text: "@ Hz:"
+                    font.pixelSize: Style.resize(13)
+                    color: Style.fontSecondaryColor
+                }
+
+                SpinBox {
+                    id: burstRateSpin
+                    from: 0
+                    to: 1000000
+                    stepSize: 1000
+                    value: 0
+                    editable: true
+                    Layout.preferredWidth: Style.resize(120)
+                }
+
+                // Tramas por datagrama (> 1 = empaquetadas)
+                Label {
+                    text: "x"
+                    font.pixelSize: Style.resize(13)
+                    color: Style.fontSecondaryColor
+                }
+
+                SpinBox {
+                    from: 1
+                    to: 64
+                    value: root.framesPerDatagram
+                    editable: true
+                    Layout.preferredWidth: Style.resize(90)
+                    onValueModified: root.framesPerDatagramRequested(value)
+                }
+
+                Item { Layout.fillWidth: true }
+
+                Button {
+                    text: root.bursting ? "Stop" : "Burst"
+                    onClicked: root.bursting ? root.stopBurstRequested()
+                                             : root.collectAndBurst()
+                }
+            }
+
             // --- Campos de telemetria (7 filas x 2 columnas) ---
             // GridLayout con 2 columnas: cada celda es un Row con
             // checkbox + nombre + spinbox. 14 campos / 2 = 7 filas.
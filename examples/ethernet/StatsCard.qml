@@ -0,0 +1,140 @@
+// =============================================================================
+// StatsCard.qml — Estadisticas por flujo (messageId, sourcePort)
+// =============================================================================
+// Muestra controller.statsModel (QAbstractTableModel en C++) con un
+// TableView + HorizontalHeaderView. Los titulos de columna vienen de
+// headerData() del modelo, asi que la cabecera no repite nada en QML.
+//
+// El modelo se refresca una vez por tick de UI: ritmo (msg/s, bytes/s),
+// huecos de secuencia, desorden, duplicados, checksums invalidos y jitter
+// entre llegadas (p50/p99 en us).
+//
+// "JSON" vuelca la instantanea completa (incluye p99.9 y max) a la consola,
+// el mismo texto que devuelve controller.statsSnapshotJson() para
+// monitorizacion externa.
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    // --- API publica ---
+    property var controller: null
+
+    // --- Formato de celda ---
+    // Columnas 3-4 son ritmos (double), 9-10 jitter en us; el resto enteros
+    function formatCell(column, value) {
+        if (value === undefined || value === null)
+            return ""
+        if (column === 4 && value >= 1000)
+            return (value / 1000).toFixed(1) + "k"
+        if (column === 3)
+            return value.toFixed(1)
+        return Math.round(value).toString()
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(12)
+        spacing: Style.resize(6)
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            Label {
+                text: "Streams (" + (root.controller ? root.controller.statsModel.streamCount : 0) + ")"
+                font.pixelSize: Style.resize(16)
+                font.bold: true
+                color: Style.mainColor
+                Layout.fillWidth: true
+            }
+
+            Button {
+                text: "JSON"
+                enabled: root.controller !== null
+                onClicked: console.log(root.controller.statsSnapshotJson(true))
+            }
+
+            Button {
+                text: "Reset"
+                enabled: root.controller !== null
+                onClicked: root.controller.resetStats()
+            }
+        }
+
+        Item {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+
+            HorizontalHeaderView {
+                id: statsHeader
+                anchors.top: parent.top
+                anchors.left: statsTable.left
+                anchors.right: statsTable.right
+                syncView: statsTable
+                clip: true
+
+                delegate: Rectangle {
+                    required property var model
+                    implicitWidth: Style.resize(60)
+                    implicitHeight: Style.resize(24)
+                    color: Style.bgColor
+
+                    Label {
+                        anchors.fill: parent
+                        anchors.leftMargin: Style.resize(4)
+                        verticalAlignment: Text.AlignVCenter
+                        text: parent.model.display
+                        color: Style.mainColor
+                        font.pixelSize: Style.resize(10)
+                        font.bold: true
+                        elide: Text.ElideRight
+                    }
+                }
+            }
+
+            TableView {
+                id: statsTable
+                anchors.top: statsHeader.bottom
+                anchors.left: parent.left
+                anchors.right: parent.right
+                anchors.bottom: parent.bottom
+                model: root.controller ? root.controller.statsModel : null
+                clip: true
+                boundsBehavior: Flickable.StopAtBounds
+
+                columnWidthProvider: function(col) {
+                    return Style.resize(col < 2 ? 48 : 60)
+                }
+
+                delegate: Rectangle {
+                    required property int row
+                    required property int column
+                    required property var display
+                    implicitHeight: Style.resize(22)
+                    color: row % 2 === 0 ? Style.cardColor : Style.bgColor
+
+                    Label {
+                        anchors.fill: parent
+                        anchors.leftMargin: Style.resize(4)
+                        verticalAlignment: Text.AlignVCenter
+                        text: root.formatCell(parent.column, parent.display)
+                        font.pixelSize: Style.resize(11)
+                        font.family: "Courier New"
+                        // Contadores de error en rojo en cuanto dejan de ser 0
+                        color: parent.column >= 5 && parent.column <= 8 && parent.display > 0
+                               ? "#F44336" : Style.fontPrimaryColor
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+// =============================================================================
+// BackpressureCard.qml — Colas acotadas y politica de desbordamiento
+// =============================================================================
+// Muestra la cola de entrada de cada etapa (Filter y Collector): cuantos
+// chunks esperan, el pico alcanzado y cuantos se han descartado. Permite
+// elegir capacidad y politica antes de arrancar el pipeline.
+//
+// Conexion QML <-> C++:
+//   - ThreadPipeline expone:
+//     - overflowPolicy (Q_PROPERTY enum): Block (0), DropOldest (1),
+//       DropNewest (2). Se aplica en el siguiente start().
+//     - filterQueueCapacity / collectorQueueCapacity (Q_PROPERTY int):
+//       chunks pendientes maximos por etapa. Tambien en el siguiente start().
+//     - filterQueueDepth / filterQueuePeak / filterDropped y sus
+//       equivalentes collector*: muestreados cada 100 ms en C++ y
+//       notificados con queueStatsChanged.
+//
+// Patrones clave:
+//   - Repeater sobre un modelo JS con prefijos: root.pipeline[prefix +
+//     "QueueDepth"] lee la propiedad de cada etapa por nombre, como
+//     ThreadInfoCard con los IDs de hilo.
+//   - Barra de ocupacion: un Rectangle cuyo ancho es depth / capacity.
+//     Roja cuando la cola esta casi llena (saturacion visible).
+//   - Controles deshabilitados con el pipeline en marcha: capacidad y
+//     politica solo cambian al crear las colas.
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    required property var pipeline
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(20)
+        spacing: Style.resize(12)
+
+        Label {
+            text: "Backpressure"
+            font.pixelSize: Style.resize(20)
+            font.bold: true
+            color: Style.mainColor
+        }
+
+        // Politica de desbordamiento
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "When full:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontPrimaryColor
+            }
+
+            ComboBox {
+                Layout.fillWidth: true
+                enabled: !root.pipeline.running
+                model: ["Block producer", "Drop oldest", "Drop newest"]
+                currentIndex: root.pipeline.overflowPolicy
+                onActivated: root.pipeline.overflowPolicy = currentIndex
+            }
+        }
+
+        // Una fila por cola de entrada
+        Repeater {
+            model: [
+                { label: "Filter queue", prefix: "filter", stageColor: "#4A90D9" },
+                { label: "Collector queue", prefix: "collector", stageColor: "#FEA601" }
+            ]
+
+            ColumnLayout {
+                id: stageRow
+                Layout.fillWidth: true
+                spacing: Style.resize(4)
+
+                required property var modelData
+                readonly property int capacity: root.pipeline[modelData.prefix + "QueueCapacity"]
+                readonly property int depth: root.pipeline[modelData.prefix + "QueueDepth"]
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: Style.resize(10)
+
+                    Label {
+                        text: stageRow.modelData.label
+                        font.pixelSize: Style.resize(12)
+                        font.bold: true
+                        color: stageRow.modelData.stageColor
+                        Layout.fillWidth: true
+                    }
+
+                    SpinBox {
+                        from: 1
+                        to: 65536   // ThreadPipeline::MaxQueueCapacity
+                        stepSize: 256
+                        editable: true
+                        enabled: !root.pipeline.running
+                        value: stageRow.capacity
+                        onValueModified: root.pipeline[stageRow.modelData.prefix + "QueueCapacity"] = value
+                        Layout.preferredWidth: Style.resize(130)
+                    }
+                }
+
+                // Ocupacion de la cola
+                Rectangle {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: Style.resize(8)
+                    radius: height / 2
+                    color: Style.bgColor
+
+                    Rectangle {
+                        width: parent.width * Math.min(1, stageRow.depth / Math.max(1, stageRow.capacity))
+                        height: parent.height
+                        radius: height / 2
+                        color: stageRow.depth >= stageRow.capacity * 0.9 ? "#F44336" : stageRow.modelData.stageColor
+                        Behavior on width { NumberAnimation { duration: 90 } }
+                    }
+                }
+
+                Label {
+                    text: "depth " + stageRow.depth
+                          + "  peak " + root.pipeline[stageRow.modelData.prefix + "QueuePeak"]
+                          + "  dropped " + root.pipeline[stageRow.modelData.prefix + "Dropped"].toLocaleString()
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Consolas, monospace"
+                    color: Style.fontSecondaryColor
+                }
+            }
+        }
+
+        Item { Layout.fillHeight: true }
+
+        Label {
+            text: "Each hop holds at most 'capacity' pending chunks, with either transport. " +
+                  "Lower the generation interval to 1 ms to watch the queues saturate."
+            font.pixelSize: Style.resize(11)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+    }
+}
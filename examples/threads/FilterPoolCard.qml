@@ -0,0 +1,216 @@
+// =============================================================================
+// FilterPoolCard.qml — Etapa de filtrado en paralelo (N FilterWorker)
+// =============================================================================
+// Elige cuantos Filters corren en paralelo y muestra la carga de cada uno,
+// el rendimiento agregado y cuantas coincidencias retiene el Collector para
+// devolverlas en orden. Incluye el benchmark de escalado 1, 2, 4... hilos.
+//
+// Conexion QML <-> C++:
+//   - ThreadPipeline expone:
+//     - filterWorkers (Q_PROPERTY int): numero de Filters, de 1 a
+//       maxFilterWorkers (nucleos). Se aplica en el siguiente start().
+//     - filterWorkerStats (Q_PROPERTY list): por Filter { index, threadId,
+//       processed, matched, chunksPerSec, load, queueDepth }, muestreado
+//       cada 100 ms en C++ (filterStatsChanged).
+//     - filterThroughput (Q_PROPERTY double): suma de chunksPerSec.
+//     - reorderPending (Q_PROPERTY int): coincidencias que esperan a un
+//       Filter mas lento antes de guardarse.
+//     - runFilterScalingBenchmark(N) (Q_INVOKABLE list): una fila por
+//       numero de Filters con chunks/s agregados, speedup y si el orden
+//       se mantuvo.
+//
+// Patrones clave:
+//   - Repeater sobre una lista de QVariantMap que C++ regenera en cada
+//     muestra: el delegate solo lee modelData.
+//   - Barra de carga: fraccion del intervalo que el hilo paso filtrando.
+//     Roja cerca de 1.0: ese Filter es el cuello de botella.
+//   - Tabla con GridLayout + Repeater de celdas (como PatternMatcherCard).
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    required property var pipeline
+
+    property var rows: []
+
+    function formatRate(cps) {
+        if (cps >= 1e6)
+            return (cps / 1e6).toFixed(2) + " M"
+        if (cps >= 1e3)
+            return (cps / 1e3).toFixed(1) + " k"
+        return cps.toFixed(0) + " "
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(20)
+        spacing: Style.resize(10)
+
+        Label {
+            text: "Parallel Filters"
+            font.pixelSize: Style.resize(20)
+            font.bold: true
+            color: Style.mainColor
+        }
+
+        // Numero de Filters y resumen agregado
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "Workers:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontPrimaryColor
+            }
+
+            SpinBox {
+                from: 1
+                to: root.pipeline.maxFilterWorkers
+                value: root.pipeline.filterWorkers
+                enabled: !root.pipeline.running
+                onValueModified: root.pipeline.filterWorkers = value
+                Layout.preferredWidth: Style.resize(110)
+            }
+
+            Label {
+                text: root.formatRate(root.pipeline.filterThroughput) + "chunks/s"
+                      + "   reorder held " + root.pipeline.reorderPending
+                font.pixelSize: Style.resize(12)
+                font.family: "Consolas, monospace"
+                color: Style.fontSecondaryColor
+                Layout.fillWidth: true
+            }
+        }
+
+        // Una fila por Filter: carga, ritmo y cola de entrada
+        Repeater {
+            model: root.pipeline.filterWorkerStats
+
+            RowLayout {
+                id: workerRow
+                Layout.fillWidth: true
+                spacing: Style.resize(10)
+
+                required property var modelData
+
+                Label {
+                    text: "F" + workerRow.modelData.index
+                    font.pixelSize: Style.resize(12)
+                    font.bold: true
+                    color: "#4A90D9"
+                    Layout.preferredWidth: Style.resize(30)
+                }
+
+                Rectangle {
+                    Layout.fillWidth: true
+                    Layout.preferredHeight: Style.resize(8)
+                    radius: height / 2
+                    color: Style.bgColor
+
+                    Rectangle {
+                        width: parent.width * workerRow.modelData.load
+                        height: parent.height
+                        radius: height / 2
+                        color: workerRow.modelData.load >= 0.9 ? "#F44336" : "#4A90D9"
+                        Behavior on width { NumberAnimation { duration: 90 } }
+                    }
+                }
+
+                Label {
+                    text: (workerRow.modelData.load * 100).toFixed(0) + "%  "
+                          + root.formatRate(workerRow.modelData.chunksPerSec) + "/s  q "
+                          + workerRow.modelData.queueDepth
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Consolas, monospace"
+                    color: Style.fontSecondaryColor
+                    Layout.preferredWidth: Style.resize(170)
+                }
+            }
+        }
+
+        // --- Benchmark de escalado ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "Scaling (active patterns, 1 KiB chunks):"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontPrimaryColor
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: chunksSpin
+                from: 10000
+                to: 2000000
+                stepSize: 10000
+                value: 200000
+                editable: true
+                Layout.preferredWidth: Style.resize(130)
+            }
+
+            Button {
+                text: "Benchmark"
+                onClicked: root.rows = root.pipeline.runFilterScalingBenchmark(chunksSpin.value)
+            }
+        }
+
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 5
+            columnSpacing: Style.resize(12)
+            rowSpacing: Style.resize(2)
+            visible: root.rows.length > 0
+
+            Repeater {
+                model: ["Workers", "Chunks/s", "Speedup", "Efficiency", "Order"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(11)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            Repeater {
+                model: root.rows.length * 5
+                Label {
+                    required property int index
+                    readonly property var row: root.rows[Math.floor(index / 5)]
+                    readonly property int column: index % 5
+                    text: column === 0 ? row.workers
+                        : column === 1 ? root.formatRate(row.chunksPerSec)
+                        : column === 2 ? "x" + row.speedup.toFixed(2)
+                        : column === 3 ? (row.efficiency * 100).toFixed(0) + "%"
+                                       : (row.ordered ? "ok" : "BROKEN")
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Consolas, monospace"
+                    color: column === 1 ? Style.mainColor
+                         : column === 4 && !row.ordered ? "#F44336" : Style.fontPrimaryColor
+                }
+            }
+        }
+
+        Item { Layout.fillHeight: true }
+
+        Label {
+            text: "The Generator deals chunks round-robin by sequence number; the Collector " +
+                  "holds early matches until every slower Filter has caught up, so records stay in order."
+            font.pixelSize: Style.resize(11)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+    }
+}
@@ -14,8 +14,9 @@
 // 2. Pipeline de 3 hilos:
 //    - Generator (hilo 1): produce arrays de bytes aleatorios a un ritmo
 //      configurable y los emite via senal.
-//    - Filter (hilo 2): recibe los arrays, busca un patron de bytes
-//      especifico y emite solo las coincidencias.
+//    - Filter (hilo 2): recibe los arrays, busca un conjunto de patrones
+//      de bytes (Aho-Corasick, con comodines) y emite solo las
+//      coincidencias con el patron y el offset encontrados.
 //    - Collector (hilo 3): almacena las coincidencias con timestamps
 //      y las expone a QML como modelo.
 //
@@ -34,7 +35,32 @@
 //    - En C++, el destructor de ThreadPipeline debe llamar quit() y wait()
 //      en cada QThread para asegurar una terminacion limpia.
 //
-// 5. Actualizacion de UI desde hilos:
+// 5. Transporte alternativo (ring SPSC):
+//    - ThreadPipeline.transport = SpscRings sustituye las senales entre
+//      etapas por rings lock-free: un evento Qt por rafaga, no por chunk.
+//    - TransportBenchmarkCard compara ambos transportes lado a lado.
+//
+// 6. Backpressure:
+//    - Cada salto tiene una cola acotada (PipelineChannel). Al llenarse,
+//      overflowPolicy decide: bloquear al productor o descartar el chunk
+//      mas antiguo / el mas nuevo. BackpressureCard muestra la saturacion.
+//
+// 7. Filters en paralelo:
+//    - filterWorkers = N reparte los chunks entre N hilos de Filter por
+//      numero de secuencia; el Collector los devuelve al orden original.
+//    - FilterPoolCard muestra la carga de cada hilo y el ritmo agregado.
+//
+// 8. Colocacion de hilos:
+//    - Cada etapa puede fijarse a una CPU y usar SCHED_FIFO o SCHED_IDLE
+//      (ThreadPipeline.setStagePlacement). ThreadPlacementCard compara la
+//      latencia entre hilos en la misma CPU, nucleo o nodo NUMA.
+//
+// 9. Registros en disco:
+//    - pipeline.recordLog guarda cada coincidencia en segmentos mapeados
+//      en memoria (SegmentLog). RecordLogCard recorre millones de ellos,
+//      tambien los de ejecuciones anteriores, y salta por tiempo.
+//
+// 10. Actualizacion de UI desde hilos:
 //    - QML siempre corre en el hilo principal (GUI thread).
 //    - Los workers emiten senales que, via QueuedConnection, llegan al
 //      hilo principal donde ThreadPipeline actualiza sus Q_PROPERTYs.
@@ -119,7 +145,7 @@ Item {
                     PipelineFlowCard {
                         Layout.fillWidth: true
                         Layout.preferredWidth: 1
-                        Layout.preferredHeight: Style.resize(380)
+                        Layout.preferredHeight: Style.resize(540)
                         pipeline: pipeline
                     }
 
@@ -128,7 +154,7 @@ Item {
                     PipelineControlCard {
                         Layout.fillWidth: true
                         Layout.preferredWidth: 1
-                        Layout.preferredHeight: Style.resize(380)
+                        Layout.preferredHeight: Style.resize(540)
                         pipeline: pipeline
                     }
                 }
@@ -158,6 +184,78 @@ Item {
                     }
                 }
 
+                // Fila 3: Colas acotadas + comparativa de transportes
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: Style.resize(20)
+
+                    // Card de backpressure: profundidad, pico y descartes de
+                    // la cola de cada etapa; capacidad y politica al llenarse.
+                    BackpressureCard {
+                        Layout.fillWidth: true
+                        Layout.preferredWidth: 1
+                        Layout.preferredHeight: Style.resize(320)
+                        pipeline: pipeline
+                    }
+
+                    // Card de transportes: signal/slot frente a ring SPSC
+                    // con vaciado por lotes.
+                    TransportBenchmarkCard {
+                        Layout.fillWidth: true
+                        Layout.preferredWidth: 1
+                        Layout.preferredHeight: Style.resize(320)
+                        pipeline: pipeline
+                    }
+                }
+
+                // Fila 4: Patrones del Filter y Filters en paralelo
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: Style.resize(20)
+
+                    // Card de patrones: conjunto del Filter (Aho-Corasick)
+                    // y su benchmark frente a contains() por patron.
+                    PatternMatcherCard {
+                        Layout.fillWidth: true
+                        Layout.preferredWidth: 1
+                        Layout.preferredHeight: Style.resize(400)
+                        pipeline: pipeline
+                    }
+
+                    // Card de Filters en paralelo: carga por hilo, ritmo
+                    // agregado y escalado con 1, 2, 4... hilos.
+                    FilterPoolCard {
+                        Layout.fillWidth: true
+                        Layout.preferredWidth: 1
+                        Layout.preferredHeight: Style.resize(400)
+                        pipeline: pipeline
+                    }
+                }
+
+                // Fila 5: Colocacion de los hilos y registros en disco
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: Style.resize(20)
+
+                    // Card de colocacion: CPU, politica y prioridad por
+                    // etapa y la latencia de ida y vuelta entre CPUs.
+                    ThreadPlacementCard {
+                        Layout.fillWidth: true
+                        Layout.preferredWidth: 1
+                        Layout.preferredHeight: Style.resize(440)
+                        pipeline: pipeline
+                    }
+
+                    // Card del log en disco: todos los registros, con
+                    // retencion por segmentos y salto por tiempo.
+                    RecordLogCard {
+                        Layout.fillWidth: true
+                        Layout.preferredWidth: 1
+                        Layout.preferredHeight: Style.resize(440)
+                        pipeline: pipeline
+                    }
+                }
+
                 Item { Layout.preferredHeight: Style.resize(20) }
             }
         }
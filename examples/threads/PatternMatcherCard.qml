@@ -0,0 +1,156 @@
+// =============================================================================
+// PatternMatcherCard.qml — Conjunto de patrones del Filter y su benchmark
+// =============================================================================
+// Edita el conjunto de patrones que busca el FilterWorker (uno por linea) y
+// mide cuanto cuesta filtrar segun cuantos patrones haya.
+//
+// Conexion QML <-> C++:
+//   - ThreadPipeline expone:
+//     - setFilterPatterns(list) (Q_INVOKABLE bool): valida y aplica. Cada
+//       patron es hex con espacios opcionales; "??" es un byte comodin y
+//       "D?" fija solo el nibble alto. false = algun patron invalido.
+//     - filterPatterns (Q_PROPERTY list): patrones activos normalizados.
+//     - runMatcherBenchmark(N) (Q_INVOKABLE list): una fila por numero de
+//       patrones (1 a 1000) con chunks/s de contains() por patron frente al
+//       automata de Aho-Corasick (PatternMatcher).
+//
+// Patrones clave:
+//   - TextArea multilinea -> split("\n") -> QStringList en C++.
+//   - Feedback de validacion: el resultado booleano del Q_INVOKABLE colorea
+//     el texto de estado sin excepciones ni dialogos.
+//   - Tabla con GridLayout + Repeater de celdas (como CodecBenchmarkCard):
+//     contains() cae linealmente con los patrones; el automata no.
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    required property var pipeline
+
+    property var rows: []
+    property bool patternsValid: true
+
+    function formatRate(cps) {
+        if (cps >= 1e6)
+            return (cps / 1e6).toFixed(2) + " M"
+        return (cps / 1e3).toFixed(1) + " k"
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(20)
+        spacing: Style.resize(10)
+
+        Label {
+            text: "Filter Patterns"
+            font.pixelSize: Style.resize(20)
+            font.bold: true
+            color: Style.mainColor
+        }
+
+        // Editor de patrones: uno por linea
+        ScrollView {
+            Layout.fillWidth: true
+            Layout.preferredHeight: Style.resize(80)
+
+            TextArea {
+                id: patternsEdit
+                text: root.pipeline.filterPatterns.join("\n")
+                placeholderText: "DE AD BE EF\nFF ?? FF\n0? 01 02"
+                font.family: "Consolas, monospace"
+                font.pixelSize: Style.resize(12)
+                wrapMode: TextEdit.NoWrap
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Button {
+                text: "Apply"
+                onClicked: root.patternsValid = root.pipeline.setFilterPatterns(patternsEdit.text.split("\n"))
+            }
+
+            Label {
+                text: root.patternsValid
+                      ? root.pipeline.filterPatterns.length + " pattern(s) active"
+                      : "Invalid pattern: use hex bytes, ?? for any byte"
+                font.pixelSize: Style.resize(11)
+                color: root.patternsValid ? Style.fontSecondaryColor : "#F44336"
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: chunksSpin
+                from: 10000
+                to: 2000000
+                stepSize: 10000
+                value: 100000
+                editable: true
+                Layout.preferredWidth: Style.resize(130)
+            }
+
+            Button {
+                text: "Benchmark"
+                onClicked: root.rows = root.pipeline.runMatcherBenchmark(chunksSpin.value)
+            }
+        }
+
+        // --- Chunks/s segun el numero de patrones ---
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 5
+            columnSpacing: Style.resize(12)
+            rowSpacing: Style.resize(2)
+            visible: root.rows.length > 0
+
+            Repeater {
+                model: ["Patterns", "States", "contains()/s", "Aho-Corasick/s", "Speedup"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(11)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            Repeater {
+                model: root.rows.length * 5
+                Label {
+                    required property int index
+                    readonly property var row: root.rows[Math.floor(index / 5)]
+                    readonly property int column: index % 5
+                    text: column === 0 ? row.patterns
+                        : column === 1 ? row.states
+                        : column === 2 ? root.formatRate(row.containsChunksPerSec)
+                        : column === 3 ? root.formatRate(row.matcherChunksPerSec)
+                                       : "x" + row.speedup.toFixed(1) + (row.agree ? "" : " !")
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Consolas, monospace"
+                    color: column === 3 ? Style.mainColor
+                         : column === 4 && !row.agree ? "#F44336" : Style.fontPrimaryColor
+                }
+            }
+        }
+
+        Item { Layout.fillHeight: true }
+
+        Label {
+            text: "Aho-Corasick walks each chunk once whatever the pattern count. " +
+                  "Wildcard patterns anchor on their longest literal run and are verified with their mask."
+            font.pixelSize: Style.resize(11)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+    }
+}
@@ -16,6 +16,17 @@
 //     - filterPatternHex (Q_PROPERTY string): representacion hex del patron
 //       activo para mostrar en la UI.
 //     - clear() (Q_INVOKABLE): resetea contadores y limpia registros.
+//     - transport (Q_PROPERTY enum): SignalSlot (0) o SpscRings (1). Se
+//       aplica en el siguiente start(); el ComboBox se bloquea en marcha.
+//     - generatorMode (Q_PROPERTY enum): TimerTicks (0), un chunk por
+//       disparo del QTimer, o FreeRunning (1), lotes de generatorBatchSize
+//       chunks sin esperar. Tambien se aplica en el siguiente start().
+//     - generatorPoolHitRate: fraccion de chunks que reutilizaron un buffer
+//       del pool del Generator (1.0 = ninguna reserva de memoria).
+//     - runGeneratorBenchmark(chunks) (Q_INVOKABLE): mt19937 por byte vs
+//       xoshiro256** + pool; devuelve dos filas que se resumen en un Label.
+//       Las reservas por chunk de cada metodo no se miden en la app: ver
+//       benchmarks/pipelinebench (funcion generatorAllocations).
 //
 // Patrones clave:
 //   - Indicador de estado con punto coloreado: un circulo verde/rojo con
@@ -100,12 +111,70 @@ Rectangle {
                 Slider {
                     id: speedSlider
                     anchors.fill: parent
+                    // En modo libre no hay intervalo: el ritmo lo marcan las colas
+                    enabled: root.pipeline.generatorMode === 0
                     from: 1; to: 200; value: 10; stepSize: 1
                     onMoved: root.pipeline.generationInterval = value
                 }
             }
         }
 
+        // Generator mode (se aplica al arrancar)
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "Generator:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontPrimaryColor
+            }
+
+            ComboBox {
+                Layout.fillWidth: true
+                enabled: !root.pipeline.running
+                model: ["QTimer ticks (1 chunk)", "Free-running batches"]
+                currentIndex: root.pipeline.generatorMode
+                onActivated: root.pipeline.generatorMode = currentIndex
+            }
+
+            SpinBox {
+                enabled: !root.pipeline.running && root.pipeline.generatorMode === 1
+                from: 1
+                to: 65536
+                stepSize: 512
+                value: root.pipeline.generatorBatchSize
+                editable: true
+                onValueModified: root.pipeline.generatorBatchSize = value
+                Layout.preferredWidth: Style.resize(120)
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Button {
+                text: "Benchmark generator"
+                onClicked: {
+                    var rows = root.pipeline.runGeneratorBenchmark(1000000)
+                    genBenchLabel.text = rows[0].method + ": " + Math.round(rows[0].chunksPerSec).toLocaleString() + "/s   "
+                        + rows[1].method + ": " + Math.round(rows[1].chunksPerSec).toLocaleString() + "/s (x"
+                        + rows[1].speedup.toFixed(1) + ")   "
+                        + rows[0].megabytesPerSec.toFixed(0) + " -> " + rows[1].megabytesPerSec.toFixed(0) + " MB/s"
+                }
+            }
+            Label {
+                id: genBenchLabel
+                text: "Pool reuse: " + (root.pipeline.generatorPoolHitRate * 100).toFixed(1) + "%"
+                font.pixelSize: Style.resize(11)
+                font.family: "Consolas, monospace"
+                color: Style.fontSecondaryColor
+                wrapMode: Text.WordWrap
+                Layout.fillWidth: true
+            }
+        }
+
         // Filter pattern selector
         RowLayout {
             Layout.fillWidth: true
@@ -138,6 +207,26 @@ Rectangle {
             }
         }
 
+        // Transport selector (se aplica al arrancar)
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "Transport:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontPrimaryColor
+            }
+
+            ComboBox {
+                Layout.fillWidth: true
+                enabled: !root.pipeline.running
+                model: ["Signal/slot (QueuedConnection)", "SPSC rings (batch pop)"]
+                currentIndex: root.pipeline.transport
+                onActivated: root.pipeline.transport = currentIndex
+            }
+        }
+
         // Current pattern display
         Label {
             text: "Active pattern: " + root.pipeline.filterPatternHex
@@ -149,7 +238,7 @@ Rectangle {
         Item { Layout.fillHeight: true }
 
         Label {
-            text: "QTimer drives generation rate. setInterval() is called cross-thread via QueuedConnection."
+            text: "QTimer drives generation rate (free-running: a 0 ms timer and one batch per event-loop turn). setInterval() is called cross-thread via QueuedConnection."
             font.pixelSize: Style.resize(11)
             color: Style.fontSecondaryColor
             wrapMode: Text.WordWrap
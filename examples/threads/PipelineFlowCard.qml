@@ -14,6 +14,12 @@
 //   - Los contadores se actualizan via señales que cruzan hilos. Los workers
 //     emiten señales en su hilo, ThreadPipeline las recibe en el hilo GUI
 //     via QueuedConnection, actualiza las Q_PROPERTYs y QML reacciona.
+//   - stageMetrics / endToEndLatency: items/s y percentiles (p50, p99,
+//     p99.9) del tiempo de servicio y de la espera en cola de cada etapa,
+//     y de la latencia desde que se genera un chunk hasta que se guarda.
+//     Se muestrean a 10 Hz (metricsChanged), en nanosegundos.
+//   - metricsSnapshotJson(true): las mismas metricas en JSON (boton "Log
+//     JSON"), para comparar ejecuciones.
 //
 // Patrones clave:
 //   - SequentialAnimation on x: anima un circulo ("packet") de izquierda a
@@ -28,6 +34,8 @@
 //     porcentaje de coincidencias. Math.max(1, ...) evita division por cero.
 //   - toLocaleString(): formatea numeros grandes con separadores de miles
 //     (ej: 1,234,567) para mejorar la legibilidad.
+//   - Tabla con Repeater sobre una lista de mapas: cada etapa es una fila
+//     del GridLayout y formatNs() elige ns, us o ms segun la magnitud.
 // =============================================================================
 
 import QtQuick
@@ -42,6 +50,27 @@ Rectangle {
 
     required property var pipeline
 
+    function formatNs(ns) {
+        if (ns < 1000)
+            return Math.round(ns) + " ns"
+        if (ns < 1000000)
+            return (ns / 1000).toFixed(1) + " us"
+        return (ns / 1000000).toFixed(2) + " ms"
+    }
+
+    function formatPercentiles(h) {
+        if (!h || h.samples === 0)
+            return "-"
+        return root.formatNs(h.p50Ns) + " / " + root.formatNs(h.p99Ns)
+               + " / " + root.formatNs(h.p999Ns)
+    }
+
+    readonly property var stageColors: ({
+        "generator": "#00D1A9",
+        "filter": "#4A90D9",
+        "collector": "#FEA601"
+    })
+
     ColumnLayout {
         anchors.fill: parent
         anchors.margins: Style.resize(20)
@@ -310,6 +339,65 @@ Rectangle {
             }
         }
 
+        // Per-stage latency (p50 / p99 / p99.9)
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 4
+            columnSpacing: Style.resize(12)
+            rowSpacing: Style.resize(2)
+
+            Repeater {
+                model: ["Stage", "Items/s", "Service p50 / p99 / p99.9", "Queue wait p50 / p99 / p99.9"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(10)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            Repeater {
+                model: root.pipeline.stageMetrics.length * 4
+                Label {
+                    required property int index
+                    readonly property var row: root.pipeline.stageMetrics[Math.floor(index / 4)]
+                    readonly property int column: index % 4
+                    text: column === 0 ? row.stage
+                        : column === 1 ? Math.round(row.itemsPerSec).toLocaleString()
+                        : column === 2 ? root.formatPercentiles(row.service)
+                                       : root.formatPercentiles(row.queueWait)
+                    font.pixelSize: Style.resize(10)
+                    font.family: "Consolas, monospace"
+                    color: column === 0 ? root.stageColors[row.stage] : Style.fontPrimaryColor
+                    Layout.fillWidth: column >= 2
+                }
+            }
+        }
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "End-to-end p50 / p99 / p99.9: "
+                      + root.formatPercentiles(root.pipeline.endToEndLatency)
+                      + "   max " + root.formatNs(root.pipeline.endToEndLatency.maxNs)
+                font.pixelSize: Style.resize(11)
+                font.bold: true
+                color: Style.fontPrimaryColor
+                Layout.fillWidth: true
+            }
+            Button {
+                text: "Reset"
+                onClicked: root.pipeline.resetMetrics()
+            }
+            Button {
+                text: "Log JSON"
+                onClicked: console.log(root.pipeline.metricsSnapshotJson(true))
+            }
+        }
+
         Label {
             text: "Cross-thread signal/slot connections replace the Actia SafeQueue pattern"
             font.pixelSize: Style.resize(11)
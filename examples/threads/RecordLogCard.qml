@@ -0,0 +1,259 @@
+// =============================================================================
+// RecordLogCard.qml — Registros guardados en disco (log de segmentos)
+// =============================================================================
+// Con el log activado, el Collector guarda cada coincidencia en disco ademas
+// de en RAM: sin limite de memoria y disponibles en la siguiente ejecucion.
+// La lista recorre todo lo guardado, del mas antiguo al mas nuevo, y el
+// slider salta a un instante concreto.
+//
+// Conexion QML <-> C++:
+//   - El modelo es C++: pipeline.recordLog (RecordLogModel). El Collector
+//     llama a SegmentLog::append() (un memcpy a un fichero mapeado con
+//     QFile::map); el hilo GUI llama a refresh() cada 100 ms como con
+//     pipeline.records.
+//   - Roles: recordId (posicion en el log) y los de RecordsCard.
+//   - recordLog.enabled abre el log en recordLog.path y recupera lo que
+//     hubiera; segmentMegabytes y maxSegments fijan el tamano de cada
+//     segmento y cuantos se conservan (los mas antiguos se borran).
+//   - recordLog.rowForTime(ms) (Q_INVOKABLE): fila del primer registro con
+//     timestamp >= ms, buscada en el indice disperso de cada segmento.
+//   - segmentCount, diskBytes, firstTimestampMs, lastTimestampMs y
+//     errorString se actualizan en cada refresh().
+//
+// Patrones clave:
+//   - Orden cronologico: lo nuevo entra abajo y la retencion borra arriba,
+//     asi que las filas que se estan leyendo no se mueven. "Follow" pega
+//     la vista al final mientras llegan registros.
+//   - Formateo perezoso como en RecordsCard, pero leyendo del mapeo: solo
+//     las filas visibles tocan el disco (o la cache de paginas del SO).
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    required property var pipeline
+
+    readonly property var log: pipeline.recordLog
+
+    function formatBytes(bytes) {
+        if (bytes >= 1024 * 1024 * 1024)
+            return (bytes / (1024 * 1024 * 1024)).toFixed(2) + " GB"
+        if (bytes >= 1024 * 1024)
+            return (bytes / (1024 * 1024)).toFixed(1) + " MB"
+        return (bytes / 1024).toFixed(1) + " KB"
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(20)
+        spacing: Style.resize(8)
+
+        RowLayout {
+            Layout.fillWidth: true
+            Label {
+                text: "Record Log"
+                font.pixelSize: Style.resize(20)
+                font.bold: true
+                color: Style.mainColor
+                Layout.fillWidth: true
+            }
+            Switch {
+                text: "Persist"
+                checked: root.log.enabled
+                onToggled: root.log.enabled = checked
+            }
+            Button {
+                text: "Purge"
+                enabled: root.log.count > 0
+                onClicked: root.log.purge()
+            }
+        }
+
+        // --- Configuracion ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+
+            TextField {
+                text: root.log.path
+                enabled: !root.log.enabled
+                font.pixelSize: Style.resize(11)
+                onEditingFinished: root.log.path = text
+                Layout.fillWidth: true
+            }
+            SpinBox {
+                from: 1
+                to: 1024
+                value: root.log.segmentMegabytes
+                enabled: !root.log.enabled
+                editable: true
+                textFromValue: function(value) { return value + " MB" }
+                valueFromText: function(text) { return parseInt(text) }
+                onValueModified: root.log.segmentMegabytes = value
+                Layout.preferredWidth: Style.resize(110)
+            }
+            SpinBox {
+                from: 1
+                to: 100000
+                value: root.log.maxSegments
+                editable: true
+                textFromValue: function(value) { return "keep " + value }
+                valueFromText: function(text) { return parseInt(text.replace("keep", "")) }
+                onValueModified: root.log.maxSegments = value
+                Layout.preferredWidth: Style.resize(120)
+            }
+        }
+
+        Label {
+            text: root.log.errorString !== ""
+                  ? root.log.errorString
+                  : root.log.count + " records in " + root.log.segmentCount + " segments, "
+                    + root.formatBytes(root.log.diskBytes) + " written"
+            font.pixelSize: Style.resize(12)
+            font.family: "Consolas, monospace"
+            color: root.log.errorString !== "" ? "#F44336" : Style.fontPrimaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+
+        // --- Salto en el tiempo ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(8)
+            enabled: root.log.count > 0
+
+            Slider {
+                id: timeSlider
+                from: root.log.firstTimestampMs
+                to: Math.max(root.log.lastTimestampMs, root.log.firstTimestampMs + 1)
+                onMoved: {
+                    followCheck.checked = false
+                    logListView.positionViewAtIndex(root.log.rowForTime(value), ListView.Beginning)
+                }
+                Layout.fillWidth: true
+            }
+            Label {
+                text: root.log.count > 0
+                      ? new Date(timeSlider.value).toISOString().substring(11, 23)
+                      : "--:--:--"
+                font.pixelSize: Style.resize(11)
+                font.family: "Consolas, monospace"
+                color: Style.fontSecondaryColor
+            }
+            CheckBox {
+                id: followCheck
+                text: "Follow"
+                checked: true
+            }
+        }
+
+        // Records list
+        Item {
+            Layout.fillWidth: true
+            Layout.fillHeight: true
+            clip: true
+
+            // Empty state
+            Label {
+                anchors.centerIn: parent
+                text: root.log.enabled ? "Log is empty.\nStart the pipeline to write records."
+                                       : "Log is off.\nEnable Persist to keep every record on disk."
+                font.pixelSize: Style.resize(13)
+                color: Style.inactiveColor
+                horizontalAlignment: Text.AlignHCenter
+                visible: root.log.count === 0
+            }
+
+            ListView {
+                id: logListView
+                anchors.fill: parent
+                model: root.log
+                visible: root.log.count > 0
+                clip: true
+                spacing: 1
+
+                onCountChanged: {
+                    if (followCheck.checked)
+                        positionViewAtEnd()
+                }
+
+                delegate: Rectangle {
+                    id: logDelegate
+                    width: logListView.width
+                    height: Style.resize(40)
+                    color: index % 2 === 0 ? Style.surfaceColor : "transparent"
+                    radius: Style.resize(4)
+
+                    required property int index
+                    required property real recordId
+                    required property string timestamp
+                    required property string hexData
+                    required property int byteSize
+                    required property int patternIndex
+                    required property int matchOffset
+
+                    ColumnLayout {
+                        anchors.fill: parent
+                        anchors.leftMargin: Style.resize(10)
+                        anchors.rightMargin: Style.resize(10)
+                        anchors.topMargin: Style.resize(3)
+                        anchors.bottomMargin: Style.resize(3)
+                        spacing: Style.resize(1)
+
+                        RowLayout {
+                            Layout.fillWidth: true
+                            Label {
+                                text: "#" + logDelegate.recordId
+                                font.pixelSize: Style.resize(10)
+                                font.family: "Consolas, monospace"
+                                color: Style.fontSecondaryColor
+                            }
+                            Label {
+                                text: logDelegate.timestamp
+                                font.pixelSize: Style.resize(10)
+                                color: Style.fontSecondaryColor
+                                Layout.fillWidth: true
+                            }
+                            Label {
+                                text: "P" + logDelegate.patternIndex + " @ " + logDelegate.matchOffset
+                                font.pixelSize: Style.resize(10)
+                                font.family: "Consolas, monospace"
+                                color: "#4A90D9"
+                            }
+                            Label {
+                                text: logDelegate.byteSize + " bytes"
+                                font.pixelSize: Style.resize(10)
+                                font.bold: true
+                                color: "#FEA601"
+                            }
+                        }
+                        Label {
+                            text: logDelegate.hexData
+                            font.pixelSize: Style.resize(10)
+                            font.family: "Consolas, monospace"
+                            color: Style.fontPrimaryColor
+                            elide: Text.ElideRight
+                            Layout.fillWidth: true
+                        }
+                    }
+                }
+            }
+        }
+
+        Label {
+            text: "Segments are memory-mapped files: the Collector only copies into the mapping, the OS writes pages back. " +
+                  "Records survive a restart; a sparse index per segment makes seeking by time cheap."
+            font.pixelSize: Style.resize(11)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+    }
+}
@@ -6,27 +6,34 @@
 // y tamano en bytes. Los registros mas recientes aparecen arriba.
 //
 // Conexion QML <-> C++:
-//   - ThreadPipeline emite la senal onRecordAdded(timestamp, hexData, size)
-//     cada vez que el Collector encuentra una coincidencia. Esta senal
-//     cruza la frontera de hilos via QueuedConnection: el Collector la
-//     emite en el hilo 3, Qt la encola en el event loop del hilo GUI,
-//     y QML la recibe aqui en Connections.
-//   - Los datos llegan como tipos simples (string, string, int) porque
-//     los tipos complejos requieren registro adicional para cruzar hilos.
+//   - El modelo es C++: pipeline.records (RecordListModel, un
+//     QAbstractListModel). El Collector guarda cada coincidencia en un
+//     RecordStore (ring de cabeceras + arena de bytes reservados al
+//     arrancar) sin emitir ninguna senal; el hilo GUI llama a refresh()
+//     cada 100 ms y el modelo publica en bloque las filas nuevas (arriba)
+//     y las descartadas (abajo).
+//   - Roles: timestamp, hexData, byteSize, patternIndex, matchOffset y
+//     sequence. pattern es el indice del patron que encontro el Filter
+//     (en filterPatterns), offset el byte donde empieza y sequence el
+//     numero de orden del chunk en el Generator: baja de arriba abajo
+//     aunque haya varios Filters en paralelo.
+//   - records.capacity fija cuantos registros se guardan (hasta millones).
+//     Cambiarla descarta los actuales.
+//   - runHandoffBenchmark(N) (Q_INVOKABLE list): N chunks de Generador a
+//     Colector con workers e hilos reales, por signal/slot y por rings
+//     SPSC: chunks/s y reutilizacion del pool. Las reservas de heap por
+//     hilo solo se miden en benchmarks/pipelinebench (handoffAllocations).
 //
 // Patrones clave:
-//   - ListModel como buffer de QML: los registros del C++ se insertan en
-//     un ListModel de QML (no un modelo C++). Esto simplifica la
-//     implementacion porque ListModel tiene insert/remove/clear nativos.
-//   - insert(0, ...) + limite de 500: los registros nuevos se insertan al
-//     inicio (mas recientes arriba). Si superan 500, se eliminan los mas
-//     antiguos. Esto evita que la lista crezca indefinidamente en memoria.
+//   - Formateo perezoso: el C++ guarda bytes y milisegundos; el texto hex
+//     y la fecha ISO solo se generan en data(), es decir, para las filas
+//     que el ListView esta mostrando. Con un millon de registros se
+//     formatean unas pocas decenas.
+//   - Descarte O(1): al llenarse, el registro mas antiguo se pisa en el
+//     ring y su hueco en la arena se reutiliza (nada de removeFirst()).
 //   - Empty state pattern: cuando no hay registros, se muestra un Label
 //     centrado con instrucciones. El ListView y el Label usan "visible"
 //     mutuamente excluyente para alternar.
-//   - Connections con funcion nombrada: Connections { function onRecordAdded }
-//     es la sintaxis moderna de Qt 6 para conectar senales a handlers.
-//     Reemplaza al antiguo onRecordAdded: { ... } que es menos type-safe.
 // =============================================================================
 pragma ComponentBehavior: Bound
 import QtQuick
@@ -41,35 +48,6 @@ Rectangle {
 
     required property var pipeline
 
-    // ListModel local de QML como buffer para los registros del Collector.
-    // Se usa un modelo QML en lugar de exponer el vector del C++ porque
-    // es mas simple para una vista de solo lectura con limite de tamano.
-    ListModel {
-        id: recordsModel
-    }
-
-    // ── Conexion con la senal del pipeline ──
-    // onRecordAdded cruza la frontera de hilos: el Collector emite la senal
-    // en su hilo, Qt la encola en el event loop del GUI thread, y QML
-    // la recibe aqui de forma segura.
-    Connections {
-        target: root.pipeline
-        function onRecordAdded(timestamp, hexData, size) {
-            recordsModel.insert(0, {
-                "timestamp": timestamp,
-                "hexData": hexData,
-                "byteSize": size
-            })
-            if (recordsModel.count > 500)
-                recordsModel.remove(500, recordsModel.count - 500)
-        }
-        function onRunningChanged() {
-            if (!root.pipeline.running) {
-                // stopped — keep records visible
-            }
-        }
-    }
-
     ColumnLayout {
         anchors.fill: parent
         anchors.margins: Style.resize(20)
@@ -89,22 +67,33 @@ Rectangle {
                 Layout.preferredHeight: Style.resize(22)
                 radius: Style.resize(11)
                 color: "#00D1A9"
-                visible: recordsModel.count > 0
+                visible: root.pipeline.records.count > 0
                 Label {
                     id: countLabel
                     anchors.centerIn: parent
-                    text: recordsModel.count
+                    text: root.pipeline.records.count
                     font.pixelSize: Style.resize(11)
                     font.bold: true
                     color: "#1a1a2e"
                 }
             }
+            Label {
+                text: "Keep"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontSecondaryColor
+            }
+            SpinBox {
+                from: 100
+                to: 5000000
+                stepSize: 100000
+                value: root.pipeline.records.capacity
+                editable: true
+                onValueModified: root.pipeline.records.capacity = value
+                Layout.preferredWidth: Style.resize(140)
+            }
             Button {
                 text: "Clear"
-                onClicked: {
-                    root.pipeline.clear()
-                    recordsModel.clear()
-                }
+                onClicked: root.pipeline.clear()
             }
         }
 
@@ -121,14 +110,14 @@ Rectangle {
                 font.pixelSize: Style.resize(13)
                 color: Style.inactiveColor
                 horizontalAlignment: Text.AlignHCenter
-                visible: recordsModel.count === 0
+                visible: root.pipeline.records.count === 0
             }
 
             ListView {
                 id: recordsListView
                 anchors.fill: parent
-                model: recordsModel
-                visible: recordsModel.count > 0
+                model: root.pipeline.records
+                visible: root.pipeline.records.count > 0
                 clip: true
                 spacing: 1
 
@@ -143,6 +132,9 @@ Rectangle {
                     required property string timestamp
                     required property string hexData
                     required property int byteSize
+                    required property int patternIndex
+                    required property int matchOffset
+                    required property real sequence
 
                     ColumnLayout {
                         anchors.fill: parent
@@ -160,6 +152,18 @@ Rectangle {
                                 color: Style.fontSecondaryColor
                                 Layout.fillWidth: true
                             }
+                            Label {
+                                text: "#" + recordDelegate.sequence
+                                font.pixelSize: Style.resize(10)
+                                font.family: "Consolas, monospace"
+                                color: Style.fontSecondaryColor
+                            }
+                            Label {
+                                text: "P" + recordDelegate.patternIndex + " @ " + recordDelegate.matchOffset
+                                font.pixelSize: Style.resize(10)
+                                font.family: "Consolas, monospace"
+                                color: "#4A90D9"
+                            }
                             Label {
                                 text: recordDelegate.byteSize + " bytes"
                                 font.pixelSize: Style.resize(10)
@@ -180,8 +184,36 @@ Rectangle {
             }
         }
 
+        // --- Benchmark de Generador a Colector por cada transporte ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Button {
+                text: "Benchmark hand-off"
+                onClicked: {
+                    var rows = root.pipeline.runHandoffBenchmark(1000000)
+                    var parts = []
+                    for (var i = 0; i < rows.length; ++i)
+                        parts.push(rows[i].method + ": " + Math.round(rows[i].chunksPerSec).toLocaleString()
+                                   + "/s, " + rows[i].matches + " records, pool reuse "
+                                   + (rows[i].poolHitRate * 100).toFixed(1) + "%")
+                    handoffLabel.text = parts.join("\n")
+                }
+            }
+            Label {
+                id: handoffLabel
+                text: "Generator -> Filter -> Collector on real threads, per transport"
+                font.pixelSize: Style.resize(11)
+                font.family: "Consolas, monospace"
+                color: Style.fontSecondaryColor
+                wrapMode: Text.WordWrap
+                Layout.fillWidth: true
+            }
+        }
+
         Label {
-            text: "CollectorWorker stores records with QMutex protection. Data arrives via QueuedConnection."
+            text: "CollectorWorker appends into a preallocated record ring; the C++ model publishes it every 100 ms and formats hex only for visible rows."
             font.pixelSize: Style.resize(11)
             color: Style.fontSecondaryColor
             wrapMode: Text.WordWrap
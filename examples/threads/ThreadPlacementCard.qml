@@ -0,0 +1,249 @@
+// =============================================================================
+// ThreadPlacementCard.qml — CPU, politica y prioridad de cada etapa
+// =============================================================================
+// Fija cada etapa del pipeline a una CPU y elige su politica de planificacion
+// (SCHED_OTHER con nice, SCHED_FIFO de tiempo real o SCHED_IDLE). Muestra
+// donde acabo cada hilo y el benchmark de ida y vuelta entre dos hilos segun
+// compartan CPU, nucleo fisico, nodo NUMA o nada.
+//
+// Conexion QML <-> C++:
+//   - ThreadPipeline expone:
+//     - setStagePlacement(stage, cpu, policy, priority) (Q_INVOKABLE): se
+//       aplica en el siguiente start(). cpu = -1 deja la etapa sin fijar;
+//       con N Filters, el Filter i va a la i-esima CPU permitida desde cpu.
+//     - stagePlacement (Q_PROPERTY list): por etapa { stage, cpu, policy,
+//       priority, threads: [{ name, cpu, numaNode, summary, error, ok }] }.
+//       threads lo rellena cada hilo al arrancar (stagePlacementChanged).
+//     - cpuCount, allowedCpus, placementSupported (Q_PROPERTY CONSTANT).
+//       allowedCpus es el cpuset del proceso (taskset, contenedores): el
+//       SpinBox recorre sus posiciones, no 0..cpuCount-1.
+//     - runPlacementBenchmark(N) (Q_INVOKABLE list): ping-pong de N idas y
+//       vueltas por colocacion { placement, cpuA, cpuB, p50Ns, p99Ns, maxNs }.
+//
+// Patrones clave:
+//   - Controles ligados a la lista de C++ y un unico setter por fila: cada
+//     cambio reenvia los tres valores de la etapa.
+//   - El rango de la prioridad depende de la politica (nice o 1..99).
+//   - Rojo en el estado: el sistema rechazo algo (SCHED_FIFO sin
+//     CAP_SYS_NICE, CPU fuera del cpuset) y el hilo siguio como estaba.
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    required property var pipeline
+
+    property var rows: []
+
+    function formatNs(ns) {
+        if (ns >= 1e6)
+            return (ns / 1e6).toFixed(2) + " ms"
+        if (ns >= 1e3)
+            return (ns / 1e3).toFixed(2) + " us"
+        return ns.toFixed(0) + " ns"
+    }
+
+    function threadStatus(threads) {
+        if (threads.length === 0)
+            return "applied on next start"
+        var parts = []
+        for (var i = 0; i < threads.length; ++i) {
+            var t = threads[i]
+            parts.push(t.summary ? t.summary + (t.ok ? "" : "  [" + t.error + "]")
+                                 : "not pinned (OS scheduling)")
+        }
+        return parts.join("\n")
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(20)
+        spacing: Style.resize(10)
+
+        Label {
+            text: "Thread Placement"
+            font.pixelSize: Style.resize(20)
+            font.bold: true
+            color: Style.mainColor
+        }
+
+        Label {
+            text: root.pipeline.placementSupported
+                  ? root.pipeline.cpuCount + " CPUs online, " + root.pipeline.allowedCpus.length
+                    + " allowed for this process. Settings apply on the next Start."
+                  : "CPU affinity is Linux only: here only the policy maps to a Qt thread priority."
+            font.pixelSize: Style.resize(12)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+
+        // Una fila por etapa: CPU, politica, prioridad y donde acabo
+        Repeater {
+            model: root.pipeline.stagePlacement
+
+            ColumnLayout {
+                id: stageRow
+                Layout.fillWidth: true
+                spacing: Style.resize(2)
+
+                required property var modelData
+                required property int index
+
+                function apply() {
+                    root.pipeline.setStagePlacement(stageRow.index,
+                                                    cpuSpin.value < 0 ? -1 : root.pipeline.allowedCpus[cpuSpin.value],
+                                                    policyCombo.currentIndex, prioritySpin.value)
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+                    spacing: Style.resize(8)
+
+                    Label {
+                        text: stageRow.modelData.stage
+                        font.pixelSize: Style.resize(12)
+                        font.bold: true
+                        color: "#4A90D9"
+                        Layout.preferredWidth: Style.resize(70)
+                    }
+
+                    SpinBox {
+                        id: cpuSpin
+                        enabled: !root.pipeline.running
+                        // value es la posicion en allowedCpus (-1 = sin fijar)
+                        from: -1
+                        to: root.pipeline.allowedCpus.length - 1
+                        value: root.pipeline.allowedCpus.indexOf(stageRow.modelData.cpu)
+                        textFromValue: function(value) { return value < 0 ? "any" : "cpu " + root.pipeline.allowedCpus[value] }
+                        valueFromText: function(text) {
+                            return text === "any" ? -1 : root.pipeline.allowedCpus.indexOf(parseInt(text.replace("cpu", "")))
+                        }
+                        onValueModified: stageRow.apply()
+                        Layout.preferredWidth: Style.resize(120)
+                    }
+
+                    ComboBox {
+                        id: policyCombo
+                        enabled: !root.pipeline.running
+                        model: ["SCHED_OTHER", "SCHED_FIFO", "SCHED_IDLE"]
+                        currentIndex: stageRow.modelData.policy
+                        onActivated: {
+                            // Prioridad valida para la politica nueva
+                            if (currentIndex === 1 && prioritySpin.value < 1)
+                                prioritySpin.value = 10
+                            else if (currentIndex !== 1)
+                                prioritySpin.value = 0
+                            stageRow.apply()
+                        }
+                        Layout.fillWidth: true
+                    }
+
+                    SpinBox {
+                        id: prioritySpin
+                        enabled: !root.pipeline.running && policyCombo.currentIndex !== 2
+                        from: policyCombo.currentIndex === 1 ? 1 : -20
+                        to: policyCombo.currentIndex === 1 ? 99 : 19
+                        value: stageRow.modelData.priority
+                        onValueModified: stageRow.apply()
+                        Layout.preferredWidth: Style.resize(100)
+                    }
+                }
+
+                Label {
+                    text: root.threadStatus(stageRow.modelData.threads)
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Consolas, monospace"
+                    color: stageRow.modelData.threads.some(function(t) { return !t.ok })
+                           ? "#F44336" : Style.fontSecondaryColor
+                    wrapMode: Text.WordWrap
+                    Layout.fillWidth: true
+                    Layout.leftMargin: Style.resize(78)
+                }
+            }
+        }
+
+        // --- Benchmark de colocacion ---
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "Cross-CPU round trip:"
+                font.pixelSize: Style.resize(12)
+                color: Style.fontPrimaryColor
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: tripsSpin
+                from: 1000
+                to: 1000000
+                stepSize: 10000
+                value: 100000
+                editable: true
+                Layout.preferredWidth: Style.resize(130)
+            }
+
+            Button {
+                text: "Benchmark"
+                onClicked: root.rows = root.pipeline.runPlacementBenchmark(tripsSpin.value)
+            }
+        }
+
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 5
+            columnSpacing: Style.resize(12)
+            rowSpacing: Style.resize(2)
+            visible: root.rows.length > 0
+
+            Repeater {
+                model: ["Placement", "CPUs", "p50", "p99", "max"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(11)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                }
+            }
+
+            Repeater {
+                model: root.rows.length * 5
+                Label {
+                    required property int index
+                    readonly property var row: root.rows[Math.floor(index / 5)]
+                    readonly property int column: index % 5
+                    text: column === 0 ? row.placement
+                        : column === 1 ? (row.cpuA < 0 ? "any" : row.cpuA + " / " + row.cpuB)
+                        : column === 2 ? root.formatNs(row.p50Ns)
+                        : column === 3 ? root.formatNs(row.p99Ns)
+                                       : root.formatNs(row.maxNs)
+                    font.pixelSize: Style.resize(11)
+                    font.family: "Consolas, monospace"
+                    color: column === 0 && !row.pinned ? "#F44336"
+                         : column === 2 ? Style.mainColor : Style.fontPrimaryColor
+                }
+            }
+        }
+
+        Item { Layout.fillHeight: true }
+
+        Label {
+            text: "Each chunk that crosses a queue moves its cache lines to the next stage's CPU. " +
+                  "Same-core neighbours share L1/L2, another NUMA node pays for the socket link."
+            font.pixelSize: Style.resize(11)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+    }
+}
@@ -0,0 +1,155 @@
+// =============================================================================
+// TransportBenchmarkCard.qml — Signal/slot vs ring SPSC entre hilos
+// =============================================================================
+// Lanza ThreadPipeline.runTransportBenchmark(N) y muestra, lado a lado, los
+// dos transportes entre etapas que soporta el pipeline:
+//   - Signal/slot: emit -> QueuedConnection -> slot. Un QMetaCallEvent en
+//     heap por chunk, encolado con mutex en el event loop del receptor.
+//   - SPSC ring:   PipelineChannel. El chunk se mueve a un hueco del ring y
+//     solo se encola un drainInput() por rafaga; el consumidor vacia por
+//     lotes de 64.
+//
+// Columnas: chunks/s, latencia productor -> consumidor (p50 / p99 / max en
+// microsegundos) y eventos Qt encolados ("Wakeups"). La fila de wakeups
+// explica la diferencia: N eventos frente a unos pocos.
+//
+// Patrones clave:
+//   - Q_INVOKABLE que devuelve QVariantMap: en QML llega como objeto JS,
+//     se guarda en una propiedad y los Labels enlazan a sus claves.
+//   - Tabla con GridLayout + Repeater: un modelo plano de celdas
+//     (filas * columnas) indexado con Math.floor(index / columns).
+//   - El benchmark es sincrono: la UI se congela mientras mide.
+// =============================================================================
+pragma ComponentBehavior: Bound
+import QtQuick
+import QtQuick.Controls
+import QtQuick.Layouts
+import utils
+
+Rectangle {
+    id: root
+    color: Style.cardColor
+    radius: Style.resize(8)
+
+    required property var pipeline
+
+    property var result: null
+
+    function formatRate(cps) {
+        if (cps >= 1e6)
+            return (cps / 1e6).toFixed(2) + " M/s"
+        return (cps / 1e3).toFixed(1) + " k/s"
+    }
+
+    // Filas de la tabla: [etiqueta, sufijo de la clave, formato]
+    // ("signal" + sufijo y "ring" + sufijo en el resultado)
+    readonly property var rows: [
+        ["Chunks/s", "ChunksPerSec", "rate"],
+        ["p50 latency", "P50Us", "us"],
+        ["p99 latency", "P99Us", "us"],
+        ["Max latency", "MaxUs", "us"],
+        ["Wakeups", "Wakeups", "count"]
+    ]
+
+    function cell(prefix, row) {
+        if (!root.result)
+            return "-"
+        var value = root.result[prefix + row[1]]
+        if (row[2] === "rate")
+            return root.formatRate(value)
+        if (row[2] === "us")
+            return value.toFixed(1) + " us"
+        return Number(value).toLocaleString(Qt.locale(), "f", 0)
+    }
+
+    ColumnLayout {
+        anchors.fill: parent
+        anchors.margins: Style.resize(20)
+        spacing: Style.resize(12)
+
+        RowLayout {
+            Layout.fillWidth: true
+            spacing: Style.resize(10)
+
+            Label {
+                text: "Transport Benchmark"
+                font.pixelSize: Style.resize(20)
+                font.bold: true
+                color: Style.mainColor
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                id: chunksSpin
+                from: 10000
+                to: 5000000
+                stepSize: 10000
+                value: 200000
+                editable: true
+                Layout.preferredWidth: Style.resize(140)
+            }
+
+            Button {
+                text: "Run"
+                onClicked: root.result = root.pipeline.runTransportBenchmark(chunksSpin.value)
+            }
+        }
+
+        GridLayout {
+            Layout.fillWidth: true
+            columns: 3
+            columnSpacing: Style.resize(16)
+            rowSpacing: Style.resize(4)
+
+            Repeater {
+                model: ["", "Signal/slot", "SPSC ring"]
+                Label {
+                    required property string modelData
+                    text: modelData
+                    font.pixelSize: Style.resize(12)
+                    font.bold: true
+                    color: Style.fontSecondaryColor
+                    Layout.fillWidth: true
+                }
+            }
+
+            Repeater {
+                model: root.rows.length * 3
+                Label {
+                    required property int index
+                    readonly property var row: root.rows[Math.floor(index / 3)]
+                    readonly property int column: index % 3
+                    text: column === 0 ? row[0]
+                        : column === 1 ? root.cell("signal", row)
+                                       : root.cell("ring", row)
+                    font.pixelSize: Style.resize(12)
+                    font.family: column === 0 ? Qt.application.font.family : "Consolas, monospace"
+                    color: column === 0 ? Style.fontSecondaryColor
+                         : column === 2 ? Style.mainColor : Style.fontPrimaryColor
+                }
+            }
+        }
+
+        Label {
+            visible: root.result !== null
+            text: root.result
+                  ? "Speedup x" + root.result.speedup.toFixed(2)
+                    + "  (ring capacity " + root.result.ringCapacity + ")"
+                  : ""
+            font.pixelSize: Style.resize(13)
+            font.bold: true
+            color: Style.mainColor
+        }
+
+        Item { Layout.fillHeight: true }
+
+        Label {
+            text: "Signal/slot queues are unbounded: the producer runs ahead and latency grows with the queue. " +
+                  "The ring is bounded and throttles the producer instead."
+            font.pixelSize: Style.resize(11)
+            color: Style.fontSecondaryColor
+            wrapMode: Text.WordWrap
+            Layout.fillWidth: true
+        }
+    }
+}
@@ -0,0 +1,27 @@
+// =============================================================================
+// stanagcodecfuzz.cpp — Entrada de libFuzzer para el codec STANAG
+// =============================================================================
+//
+// libFuzzer llama a LLVMFuzzerTestOneInput() con cada entrada que genera.
+// Las comprobaciones son las de StanagFuzzer::checkInput() (ver
+// stanagfuzzer.h): el primer byte elige entre una trama binaria para
+// decode()/decodeView()/StanagStreamDecoder y un texto para el parseo de
+// sendRawHex. Una invariante rota aborta con la descripcion; los accesos
+// fuera de buffer los detecta ASan por su cuenta.
+// =============================================================================
+
+#include <QString>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include "stanagfuzzer.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    QString failure;
+    if (!StanagFuzzer::checkInput(QByteArrayView(data, qsizetype(size)), &failure)) {
+        std::fprintf(stderr, "stanagcodecfuzz: %s\n", qPrintable(failure));
+        std::abort();
+    }
+    return 0;
+}
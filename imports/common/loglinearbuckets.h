@@ -0,0 +1,88 @@
+// =============================================================================
+// loglinearbuckets.h — Cubetas log-lineales compartidas por los histogramas
+// =============================================================================
+//
+// PATRON: Plantilla header-only con metodos estaticos. LatencyHistogram
+// (ethernet, microsegundos) y StageHistogram (threads, nanosegundos) usan
+// el mismo esquema; solo cambia hasta donde llegan (TopBits). Aqui vive la
+// aritmetica de indices y el recorrido de percentiles, una sola vez.
+//
+// CUBETAS (en la unidad que use el histograma):
+//   0..15          → una cubeta por unidad (exactas)
+//   >= 16          → cada potencia de 2 se divide en 8 sub-cubetas iguales
+//                    (error relativo maximo de 1/8 = 12.5%)
+//   kBucketCount = 16 + (TopBits - 4) * 8 cubren hasta 2^TopBits.
+//
+// Ejemplo: 200 = 0b11001000 → e = 7 (bit mas alto), sub = 0b100 = 4
+//          → cubeta 16 + (7 - 4) * 8 + 4 = 44, que cubre [192, 207]
+// =============================================================================
+
+#ifndef LOGLINEARBUCKETS_H
+#define LOGLINEARBUCKETS_H
+
+#include <QtCore/qalgorithms.h>
+#include <QtGlobal>
+#include <array>
+
+template <int TopBits>
+struct LogLinearBuckets
+{
+    static constexpr int kLinearBuckets = 16;
+    static constexpr int kSubBuckets = 8;      // por potencia de 2
+    static constexpr int kSubBits = 3;         // log2(kSubBuckets)
+    static constexpr int kBucketCount = kLinearBuckets + (TopBits - 4) * kSubBuckets;
+
+    using Counts = std::array<quint64, kBucketCount>;
+
+    // Valor → indice de cubeta (lo que pase de 2^TopBits va a la ultima)
+    static int index(quint64 value)
+    {
+        if (value < quint64(kLinearBuckets))
+            return int(value);
+
+        const int e = 63 - qCountLeadingZeroBits(value);
+        const int sub = int((value >> (e - kSubBits)) & (kSubBuckets - 1));
+        return qMin(kLinearBuckets + (e - 4) * kSubBuckets + sub, kBucketCount - 1);
+    }
+
+    static quint64 lower(int index)
+    {
+        if (index < kLinearBuckets)
+            return quint64(index);
+
+        const int e = (index - kLinearBuckets) / kSubBuckets + 4;
+        const int sub = (index - kLinearBuckets) % kSubBuckets;
+        return quint64(kSubBuckets + sub) << (e - kSubBits);
+    }
+
+    static quint64 upper(int index)
+    {
+        if (index < kLinearBuckets)
+            return quint64(index);
+
+        const int e = (index - kLinearBuckets) / kSubBuckets + 4;
+        return lower(index) + (quint64(1) << (e - kSubBits)) - 1;
+    }
+
+    // Percentil en [0, 100]: limite SUPERIOR de la cubeta donde se alcanza
+    // el rango pedido (estimacion pesimista), sin pasar del maximo visto
+    static qint64 percentile(const Counts &buckets, quint64 count, qint64 max,
+                             double percentile)
+    {
+        if (count == 0)
+            return 0;
+
+        const double clamped = qBound(0.0, percentile, 100.0);
+        const quint64 rank = qMax<quint64>(1, quint64(clamped / 100.0 * double(count) + 0.5));
+
+        quint64 seen = 0;
+        for (int i = 0; i < kBucketCount; ++i) {
+            seen += buckets[std::size_t(i)];
+            if (seen >= rank)
+                return qMin(qint64(upper(i)), max);
+        }
+        return max;
+    }
+};
+
+#endif // LOGLINEARBUCKETS_H
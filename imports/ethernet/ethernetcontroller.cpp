@@ -3,13 +3,20 @@
 // =============================================================================
 
 #include "ethernetcontroller.h"
+#include "hexformatter.h"
+#include "stanagbenchmark.h"
+#include "stanagfuzzer.h"
 #include <QDateTime>
-#include <QVariantMap>
+#include <QDir>
+#include <QJsonDocument>
+#include <QtEndian>
+#include <cstring>
 
 // =============================================================================
 // Constructor
 // =============================================================================
-// Conecta las senales de UdpTransport a nuestros slots.
+// Conecta las senales de UdpTransport a nuestros slots. La de recepcion
+// depende del modo (por datagrama o por lotes): updateReceiveConnection().
 // m_transport es miembro directo (no puntero), asi que su lifetime esta
 // ligado al lifetime de EthernetController. No necesitamos delete manual.
 //
@@ -19,27 +26,68 @@
 // =============================================================================
 EthernetController::EthernetController(QObject *parent)
     : QObject(parent)
+    , m_capturePath(QDir::tempPath() + QStringLiteral("/stanag_capture.pcap"))
+    , m_replay(&m_transport, this)
+    , m_logModel(this)   // Con parent: QML nunca toma su ownership
+    , m_statsModel(this)
 {
-    connect(&m_transport, &UdpTransport::datagramReceived,
-            this, &EthernetController::onDatagramReceived);
+    updateReceiveConnection();
+
+    // Catalogo embebido (qrc). Si no se pudiera cargar, todos los
+    // messageId se decodifican como la telemetria de siempre.
+    auto catalog = std::make_shared<StanagCatalog>();
+    QString error;
+    if (!catalog->loadFile(QStringLiteral(":/ethernet/stanagcatalog.json"), &error))
+        m_statusText = QStringLiteral("Message catalogue not loaded: %1").arg(error);
+    m_catalog = std::move(catalog);
+    m_packetSplitter.setCatalog(m_catalog.get());
+
+    // Temporizador de rafagas: kBurstTickMs con ritmo, 0 ms (una vez por
+    // vuelta del event loop) sin el. PreciseTimer pide al event loop la
+    // maxima precision disponible para intervalos cortos.
+    m_burstTimer.setInterval(kBurstTickMs);
+    m_burstTimer.setTimerType(Qt::PreciseTimer);
+    connect(&m_burstTimer, &QTimer::timeout,
+            this, &EthernetController::sendBurstChunk);
 
     connect(&m_transport, &UdpTransport::errorOccurred,
-            this, [this](const QString &error) {
-                m_errorCount++;
-                emit errorCountChanged();
+            this, &EthernetController::onTransportError);
 
-                QString timestamp = QDateTime::currentDateTime()
-                                        .toString(QStringLiteral("hh:mm:ss.zzz"));
-                emit protocolError(timestamp, error, QString());
-            });
+    connect(&m_replay, &ReplayEngine::finished,
+            this, &EthernetController::onReplayFinished);
+
+    // Refresco de UI: corre solo mientras el socket esta bindeado
+    m_uiTimer.setInterval(1000 / m_uiUpdateRateHz);
+    connect(&m_uiTimer, &QTimer::timeout,
+            this, &EthernetController::onUiTick);
 }
 
 EthernetController::~EthernetController()
 {
+    m_capture.close();
+    stopReceiveThread();
     if (m_bound)
         m_transport.unbind();
 }
 
+void EthernetController::onTransportError(const QString &error)
+{
+    m_errorCount++;
+    emit errorCountChanged();
+
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(nowMs)
+                            .toString(QStringLiteral("hh:mm:ss.zzz"));
+    emit protocolError(timestamp, error, QString());
+
+    MessageLogModel::Entry entry;
+    entry.timestampMs = nowMs;
+    entry.direction = MessageLogModel::Direction::Error;
+    entry.checksumOk = false;
+    entry.text = error;
+    appendLog(std::move(entry));
+}
+
 // =============================================================================
 // Getters — Funciones READ de Q_PROPERTY
 // =============================================================================
@@ -47,11 +95,46 @@ bool EthernetController::bound() const { return m_bound; }
 quint16 EthernetController::listenPort() const { return m_listenPort; }
 quint16 EthernetController::sendPort() const { return m_sendPort; }
 QString EthernetController::statusText() const { return m_statusText; }
+bool EthernetController::batchReceive() const { return m_batchReceive; }
+bool EthernetController::threadedReceive() const { return m_threadedReceive; }
+QString EthernetController::multicastGroup() const { return m_multicastGroup; }
+QString EthernetController::multicastInterface() const { return m_multicastInterface; }
+int EthernetController::checksumMode() const { return int(m_checksumMode); }
+int EthernetController::peerChecksumMode() const { return m_peerChecksumMode; }
+bool EthernetController::followPeerChecksum() const { return m_followPeerChecksum; }
+bool EthernetController::bursting() const { return m_bursting; }
+int EthernetController::framesPerDatagram() const { return m_framesPerDatagram; }
+bool EthernetController::capturing() const { return m_capture.isOpen(); }
+QString EthernetController::capturePath() const { return m_capturePath; }
+int EthernetController::capturedCount() const { return int(m_capture.packetCount()); }
+bool EthernetController::replaying() const { return m_replay.isRunning(); }
+int EthernetController::replaySent() const { return m_replay.sentCount(); }
+int EthernetController::replayTotal() const { return m_replay.totalCount(); }
 int EthernetController::sentCount() const { return m_sentCount; }
 int EthernetController::receivedCount() const { return m_receivedCount; }
 int EthernetController::errorCount() const { return m_errorCount; }
-QString EthernetController::lastSentHex() const { return m_lastSentHex; }
-QString EthernetController::lastReceivedHex() const { return m_lastReceivedHex; }
+int EthernetController::droppedCount() const { return m_droppedCount; }
+int EthernetController::mergedCount() const { return m_mergedCount; }
+int EthernetController::uiUpdateRateHz() const { return m_uiUpdateRateHz; }
+MessageLogModel *EthernetController::logModel() { return &m_logModel; }
+
+QVariantList EthernetController::catalogMessages() const
+{
+    QVariantList result;
+    const QList<StanagMessagePlan> &plans = m_catalog->plans();
+    for (qsizetype i = 1; i < plans.size(); ++i) {
+        QVariantMap entry;
+        entry[QStringLiteral("id")] = plans[i].messageId;
+        entry[QStringLiteral("name")] = plans[i].name;
+        entry[QStringLiteral("fieldCount")] = int(plans[i].fields.size());
+        result.append(entry);
+    }
+    return result;
+}
+MessageStatsModel *EthernetController::statsModel() { return &m_statsModel; }
+QVariantMap EthernetController::latencyStats() const { return m_latency.toVariantMap(); }
+QString EthernetController::lastSentHex() const { return HexFormatter::format(m_lastSentFrame); }
+QString EthernetController::lastReceivedHex() const { return HexFormatter::format(m_lastReceivedFrame); }
 
 // =============================================================================
 // Setters — Con guard clause para evitar bucles de binding
@@ -72,6 +155,192 @@ void EthernetController::setSendPort(quint16 port)
     }
 }
 
+void EthernetController::setCapturePath(const QString &path)
+{
+    if (m_capturePath != path) {
+        m_capturePath = path;
+        emit capturePathChanged();
+    }
+}
+
+// =============================================================================
+// setBatchReceive() — Cambiar entre recepcion por datagrama y por lotes
+// =============================================================================
+// Se puede cambiar con el socket bindeado: UdpTransport aplica el nuevo
+// tamano de lote en la siguiente lectura.
+// =============================================================================
+void EthernetController::setBatchReceive(bool enabled)
+{
+    if (m_batchReceive == enabled)
+        return;
+
+    m_batchReceive = enabled;
+    m_transport.setBatchSize(enabled ? kReceiveBatchSize : 0);
+    updateReceiveConnection();
+    emit batchReceiveChanged();
+}
+
+// =============================================================================
+// setThreadedReceive() — Mover la recepcion a (o desde) un hilo propio
+// =============================================================================
+// El socket no puede cambiar de hilo estando en uso, asi que si ya estamos
+// escuchando se hace stop + start: el puerto se re-bindea en el nuevo modo.
+// =============================================================================
+void EthernetController::setThreadedReceive(bool enabled)
+{
+    if (m_threadedReceive == enabled)
+        return;
+
+    const bool wasBound = m_bound;
+    if (wasBound)
+        stopListening();
+
+    m_threadedReceive = enabled;
+    emit threadedReceiveChanged();
+
+    if (wasBound)
+        startListening();
+}
+
+// =============================================================================
+// setMulticastGroup() / setMulticastInterface()
+// =============================================================================
+// "" vuelve al unicast en localhost. Un grupo invalido se rechaza sin
+// tocar el valor actual (el motivo queda en statusText).
+// =============================================================================
+void EthernetController::setMulticastGroup(const QString &group)
+{
+    const QString trimmed = group.trimmed();
+    if (m_multicastGroup == trimmed)
+        return;
+
+    if (!trimmed.isEmpty()) {
+        const QHostAddress address(trimmed);
+        if (!address.isMulticast() || address.protocol() != QAbstractSocket::IPv4Protocol) {
+            setStatusText(QStringLiteral("%1 is not an IPv4 multicast group (224.0.0.0/4)")
+                              .arg(trimmed));
+            return;
+        }
+    }
+
+    m_multicastGroup = trimmed;
+    emit multicastGroupChanged();
+    rebindIfListening();
+}
+
+void EthernetController::setMulticastInterface(const QString &name)
+{
+    const QString trimmed = name.trimmed();
+    if (m_multicastInterface == trimmed)
+        return;
+
+    m_multicastInterface = trimmed;
+    emit multicastInterfaceChanged();
+    if (!m_multicastGroup.isEmpty())
+        rebindIfListening();
+}
+
+void EthernetController::rebindIfListening()
+{
+    if (!m_bound)
+        return;
+    stopListening();
+    startListening();
+}
+
+// =============================================================================
+// setChecksumMode() — Algoritmo de checksum de las tramas enviadas
+// =============================================================================
+// Valores fuera de rango se ignoran. Solo afecta a lo que se codifica a
+// partir de ahora; una rafaga en curso conserva el modo de su plantilla.
+//
+// Elegir un modo a mano desactiva followPeerChecksum: si no, la siguiente
+// trama valida del peer lo desharia (y contra un peer que envia sin parar
+// el modo no se podria cambiar nunca). La negociacion usa applyChecksumMode().
+// =============================================================================
+void EthernetController::setChecksumMode(int mode)
+{
+    if (mode < int(StanagChecksumMode::Xor8) || mode > int(StanagChecksumMode::Crc32))
+        return;
+    setFollowPeerChecksum(false);
+    applyChecksumMode(mode);
+}
+
+void EthernetController::applyChecksumMode(int mode)
+{
+    if (int(m_checksumMode) == mode)
+        return;
+
+    m_checksumMode = static_cast<StanagChecksumMode>(mode);
+    emit checksumModeChanged();
+}
+
+void EthernetController::setFollowPeerChecksum(bool enabled)
+{
+    if (m_followPeerChecksum != enabled) {
+        m_followPeerChecksum = enabled;
+        emit followPeerChecksumChanged();
+    }
+}
+
+// Afecta a la PROXIMA rafaga: la arena en curso ya esta repartida en vistas
+void EthernetController::setFramesPerDatagram(int frames)
+{
+    frames = qBound(1, frames, kMaxFramesPerDatagram);
+    if (m_framesPerDatagram != frames) {
+        m_framesPerDatagram = frames;
+        emit framesPerDatagramChanged();
+    }
+}
+
+// =============================================================================
+// notePeerChecksum() — Negociacion implicita del modo de checksum
+// =============================================================================
+// Solo se llama con tramas cuyo checksum es VALIDO: una trama corrupta con
+// un tamano raro no debe cambiar el modo de envio.
+// =============================================================================
+void EthernetController::notePeerChecksum(StanagChecksumMode mode)
+{
+    if (m_peerChecksumMode != int(mode)) {
+        m_peerChecksumMode = int(mode);
+        emit peerChecksumModeChanged();
+    }
+    if (m_followPeerChecksum)
+        applyChecksumMode(int(mode));
+}
+
+// =============================================================================
+// setUiUpdateRateHz() — Frecuencia de publicacion hacia QML
+// =============================================================================
+// 0 quita el tick fijo en el camino del hilo de GUI: lo recibido se publica
+// en la siguiente vuelta del event loop (schedulePublish()), una vez por
+// vuelta y no por datagrama. El timer sigue, a kPerTurnDrainMs, para
+// vaciar la cola del worker y la captura.
+// =============================================================================
+void EthernetController::setUiUpdateRateHz(int hz)
+{
+    hz = qBound(0, hz, 1000);
+    if (m_uiUpdateRateHz == hz)
+        return;
+
+    m_uiUpdateRateHz = hz;
+    m_uiTimer.setInterval(hz > 0 ? 1000 / hz : kPerTurnDrainMs);
+    emit uiUpdateRateHzChanged();
+}
+
+void EthernetController::updateReceiveConnection()
+{
+    disconnect(m_receiveConnection);
+
+    if (m_batchReceive) {
+        m_receiveConnection = connect(&m_transport, &UdpTransport::datagramsReceived,
+                                      this, &EthernetController::onDatagramsReceived);
+    } else {
+        m_receiveConnection = connect(&m_transport, &UdpTransport::datagramReceived,
+                                      this, &EthernetController::onDatagramReceived);
+    }
+}
+
 void EthernetController::setStatusText(const QString &text)
 {
     if (m_statusText != text) {
@@ -98,11 +367,21 @@ void EthernetController::startListening()
         return;
     }
 
-    if (m_transport.bind(m_listenPort)) {
+    const bool ok = m_threadedReceive ? startReceiveThread()
+                                      : bindTransport();
+    if (ok) {
         setBound(true);
-        setStatusText(QStringLiteral("Listening on port %1 → Sending to port %2")
+        m_uiTimer.start();
+        const int destCount = m_transport.destinationCount();
+        setStatusText(QStringLiteral("Listening on %1port %2%3 → %4")
+                          .arg(m_multicastGroup.isEmpty()
+                                   ? QString() : m_multicastGroup + QLatin1Char(' '))
                           .arg(m_listenPort)
-                          .arg(m_sendPort));
+                          .arg(m_threadedReceive ? QStringLiteral(" (RX thread)")
+                                                 : QString())
+                          .arg(destCount > 0
+                                   ? QStringLiteral("Fan-out to %1 destinations").arg(destCount)
+                                   : QStringLiteral("Sending to port %1").arg(m_sendPort)));
     } else {
         setStatusText(QStringLiteral("Failed to bind port %1").arg(m_listenPort));
         m_errorCount++;
@@ -110,6 +389,17 @@ void EthernetController::startListening()
     }
 }
 
+// =============================================================================
+// bindTransport() — Bind del socket de GUI (unicast o multicast)
+// =============================================================================
+bool EthernetController::bindTransport()
+{
+    if (m_multicastGroup.isEmpty())
+        return m_transport.bind(m_listenPort);
+    return m_transport.bindMulticast(m_listenPort, QHostAddress(m_multicastGroup),
+                                     m_multicastInterface);
+}
+
 // =============================================================================
 // stopListening() — Cerrar el socket
 // =============================================================================
@@ -120,7 +410,14 @@ void EthernetController::stopListening()
         return;
     }
 
-    m_transport.unbind();
+    stopBurst();
+    stopReplay();
+    if (m_threadedReceive)
+        stopReceiveThread();
+    else
+        m_transport.unbind();
+    m_uiTimer.stop();
+    onUiTick();   // Publicar lo que quedara pendiente
     setBound(false);
     setStatusText(QStringLiteral("Disconnected (was on port %1)").arg(m_listenPort));
 }
@@ -141,25 +438,71 @@ void EthernetController::stopListening()
 // =============================================================================
 void EthernetController::sendMessage(int messageId, int presenceMask,
                                      const QVariantList &fieldValues)
+{
+    StanagMessage msg = buildMessage(messageId, presenceMask, fieldValues);
+    msg.sequenceNum = m_nextSequence++;
+
+    // --- Serializar ---
+    QByteArray encoded = StanagCodec::encode(msg, m_catalog->plan(msg.messageId));
+
+    // --- Enviar (a sendPort o a todos los destinos) ---
+    if (sendFrame(encoded)) {
+        m_sentCount++;
+        emit sentCountChanged();
+
+        m_lastSentFrame = encoded;
+        emit lastSentHexChanged();
+
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        QString timestamp = QDateTime::fromMSecsSinceEpoch(nowMs)
+                                .toString(QStringLiteral("hh:mm:ss.zzz"));
+        emit messageSent(timestamp, hexForSignal(m_messageSentSignal, encoded),
+                         messageId, msg.fields.size(), encoded.size());
+
+        MessageLogModel::Entry entry;
+        entry.timestampMs = nowMs;
+        entry.direction = MessageLogModel::Direction::Sent;
+        entry.messageId = msg.messageId;
+        entry.fieldCount = int(msg.fields.size());
+        entry.byteSize = int(encoded.size());
+        entry.hasSequence = true;
+        entry.sequenceNum = msg.sequenceNum;
+        entry.raw = encoded;
+        appendLog(std::move(entry));
+    } else {
+        m_errorCount++;
+        emit errorCountChanged();
+    }
+}
+
+// =============================================================================
+// buildMessage() — StanagMessage a partir de los parametros de QML
+// =============================================================================
+// Los fieldValues se emparejan con los bits activos del presenceMask.
+// Nombres y campos validos salen del plan de messageId en el catalogo.
+// El sequenceNum lo asigna quien envia (sendMessage o sendBurst).
+// =============================================================================
+StanagMessage EthernetController::buildMessage(int messageId, int presenceMask,
+                                               const QVariantList &fieldValues)
 {
     StanagMessage msg;
     msg.messageId    = static_cast<quint16>(messageId);
     msg.sourcePort   = m_listenPort;
     msg.destPort     = m_sendPort;
-    msg.sequenceNum  = m_nextSequence++;
     msg.presenceMask = static_cast<quint16>(presenceMask);
+    msg.checksumMode = m_checksumMode;
 
     // --- Llenar campos desde QML ---
-    const auto &defs = StanagCodec::fieldDefinitions();
+    const StanagMessagePlan &plan = m_catalog->plan(msg.messageId);
     int valueIndex = 0;
 
     for (int i = 0; i < kStanagMaxFields; ++i) {
-        if (!(presenceMask & (1 << i)))
+        if (!(presenceMask & plan.fieldMask & (1 << i)))
             continue;
 
         StanagField field;
         field.index = i;
-        field.name = defs[i].name;
+        field.name = plan.fields[i].name;
         field.value = (valueIndex < fieldValues.size())
                           ? fieldValues[valueIndex].toDouble()
                           : 0.0;
@@ -168,26 +511,373 @@ void EthernetController::sendMessage(int messageId, int presenceMask,
         msg.fields.append(field);
     }
 
-    // --- Serializar ---
-    QByteArray encoded = StanagCodec::encode(msg);
+    return msg;
+}
 
-    // --- Enviar ---
-    if (m_transport.sendDatagram(encoded, m_sendPort)) {
-        m_sentCount++;
-        emit sentCountChanged();
+// =============================================================================
+// sendBurst() — Preparar la arena y lanzar la rafaga
+// =============================================================================
+// Construccion de la arena:
+//   1. encode() de la plantilla (una sola vez)
+//   2. memcpy de la plantilla en cada hueco de la arena
+//   3. restampSequence() en cada copia: sequenceNum propio + checksum
+//
+// Asi, preparar 100.000 tramas cuesta 100.000 memcpy de ~47 bytes en vez
+// de 100.000 encode() con sus reservas de memoria.
+// =============================================================================
+void EthernetController::sendBurst(int messageId, int presenceMask,
+                                   const QVariantList &fieldValues,
+                                   int count, int rateHz)
+{
+    if (!m_bound) {
+        setStatusText(QStringLiteral("Bind a port before sending a burst"));
+        return;
+    }
 
-        QString hexDump = QString::fromLatin1(encoded.toHex(' ')).toUpper();
-        m_lastSentHex = hexDump;
-        emit lastSentHexChanged();
+    stopBurst();
 
-        QString timestamp = QDateTime::currentDateTime()
-                                .toString(QStringLiteral("hh:mm:ss.zzz"));
-        emit messageSent(timestamp, hexDump, messageId,
-                         msg.fields.size(), encoded.size());
-    } else {
+    const StanagMessage msg = buildMessage(messageId, presenceMask, fieldValues);
+    const QByteArray frame = StanagCodec::encode(msg, m_catalog->plan(msg.messageId));
+    const qsizetype frameSize = frame.size();
+    count = qBound(1, count, kMaxBurstFrames);
+
+    // --- Arena contigua con todas las tramas ---
+    m_burstArena.resize(frameSize * count);
+    char *arena = m_burstArena.data();
+    for (int n = 0; n < count; ++n) {
+        char *slot = arena + n * frameSize;
+        std::memcpy(slot, frame.constData(), std::size_t(frameSize));
+        StanagCodec::restampSequence(slot, frameSize, m_nextSequence++);
+    }
+
+    // --- Una vista por datagrama: 1 trama o framesPerDatagram seguidas ---
+    // La arena ya es contigua, asi que empaquetar no copia nada: la vista
+    // simplemente abarca varias tramas.
+    const int perDatagram = m_framesPerDatagram;
+    m_burstFrames.clear();
+    m_burstFrames.reserve((count + perDatagram - 1) / perDatagram);
+    for (int n = 0; n < count; n += perDatagram) {
+        const int frames = qMin(perDatagram, count - n);
+        m_burstFrames.append(QByteArrayView(arena + n * frameSize, frames * frameSize));
+    }
+
+    m_burstMessageId = messageId;
+    m_burstFieldCount = int(msg.fields.size());
+    m_burstRateHz = qMax(0, rateHz);
+    m_burstSentFrames = 0;
+    m_burstSentDatagrams = 0;
+    m_burstFramesPerDatagram = perDatagram;
+    m_burstFrameSize = int(frameSize);
+    m_burstClock.start();
+    setBursting(true);
+
+    // El hilo de GUI nunca espera al SO: con el buffer de envio lleno,
+    // sendBurstChunk() reintenta en el siguiente tick
+    m_transport.setSendStallMs(0);
+    m_burstTimer.setInterval(m_burstRateHz > 0 ? kBurstTickMs : 0);
+
+    sendBurstChunk();
+    if (m_bursting)
+        m_burstTimer.start();
+}
+
+void EthernetController::stopBurst()
+{
+    if (m_bursting)
+        finishBurst();
+}
+
+// =============================================================================
+// startCapture() / stopCapture() / captureDatagram()
+// =============================================================================
+// El pcap siempre se escribe en el hilo de GUI y siempre con el datagrama
+// crudo, antes de separar tramas empaquetadas, en los dos modos de
+// recepcion: processDatagram() (socket propio) y drainReceiveQueue(), que
+// vacia la CaptureQueue donde el ReceiveWorker copia cada datagrama entero
+// mientras la captura esta activa. Asi el fichero no depende del modo y el
+// replay reproduce los datagramas tal cual llegaron.
+// =============================================================================
+bool EthernetController::startCapture()
+{
+    if (m_capture.isOpen())
+        return true;
+
+    QString error;
+    if (!m_capture.open(m_capturePath, &error)) {
+        setStatusText(QStringLiteral("Capture failed: %1").arg(error));
         m_errorCount++;
         emit errorCountChanged();
+        return false;
     }
+
+    m_publishedCaptured = 0;
+    m_captureDropped = 0;
+    if (m_receiveWorker) {
+        if (!m_captureQueue)
+            m_captureQueue = std::make_unique<CaptureQueue>();
+        m_receiveWorker->setCaptureQueue(m_captureQueue.get());
+        m_receiveWorker->setCapturing(true);
+    }
+    emit capturingChanged();
+    emit capturedCountChanged();
+    setStatusText(QStringLiteral("Capturing to %1").arg(m_capturePath));
+    return true;
+}
+
+void EthernetController::stopCapture()
+{
+    if (!m_capture.isOpen())
+        return;
+
+    // Lo que el worker ya copio tambien pertenece a la captura
+    if (m_receiveWorker)
+        m_receiveWorker->setCapturing(false);
+    drainCaptureQueue();
+
+    m_capture.close();
+    emit capturingChanged();
+    emit capturedCountChanged();
+    QString status = QStringLiteral("Captured %1 datagrams (%2 KB) to %3")
+                         .arg(m_capture.packetCount())
+                         .arg(m_capture.bytesWritten() / 1024)
+                         .arg(m_capturePath);
+    if (m_captureDropped > 0)
+        status += QStringLiteral(", %1 dropped (capture queue full)").arg(m_captureDropped);
+    setStatusText(status);
+}
+
+void EthernetController::captureDatagram(QByteArrayView data, qsizetype size,
+                                         quint16 senderPort, qint64 receivedNs)
+{
+    if (m_capture.isOpen())
+        m_capture.append(data, size, senderPort, m_listenPort, receivedNs);
+}
+
+// =============================================================================
+// startReplay() / stopReplay() — Reenviar una captura con ReplayEngine
+// =============================================================================
+// Como sendBurst(), exige el socket bindeado: asi el receptor ve nuestro
+// listenPort como origen y el tick de UI publica el progreso.
+// =============================================================================
+bool EthernetController::startReplay(const QString &path, double speed)
+{
+    if (!m_bound) {
+        setStatusText(QStringLiteral("Bind a port before replaying a capture"));
+        return false;
+    }
+
+    m_publishedReplaySent = 0;
+    QString error;
+    if (!m_replay.start(path, speed, m_sendPort, &error)) {
+        setStatusText(QStringLiteral("Replay failed: %1").arg(error));
+        m_errorCount++;
+        emit errorCountChanged();
+        return false;
+    }
+
+    // Una captura muy corta puede haberse enviado entera dentro de start()
+    // (onReplayFinished ya lo habra publicado)
+    if (m_replay.isRunning()) {
+        emit replayProgressChanged();
+        emit replayingChanged();
+        setStatusText(QStringLiteral("Replaying %1 datagrams from %2 (%3)")
+                          .arg(m_replay.totalCount())
+                          .arg(path)
+                          .arg(speed > 0.0 ? QStringLiteral("x%1").arg(speed)
+                                           : QStringLiteral("max speed")));
+    }
+    return true;
+}
+
+void EthernetController::stopReplay()
+{
+    m_replay.stop();
+}
+
+void EthernetController::onReplayFinished(int framesSent, int elapsedMs,
+                                          double achievedRateHz)
+{
+    m_publishedReplaySent = framesSent;
+    emit replayingChanged();
+    emit replayProgressChanged();
+    setStatusText(QStringLiteral("Replay finished: %1 datagrams in %2 ms")
+                      .arg(framesSent)
+                      .arg(elapsedMs));
+    emit replayFinished(framesSent, elapsedMs, achievedRateHz);
+}
+
+// =============================================================================
+// sendBurstChunk() — Enviar las tramas "debidas" en este instante
+// =============================================================================
+// Con ritmo fijo, en el instante t deberian haberse enviado t * rateHz
+// tramas. Cada tick envia la diferencia con lo ya enviado, asi que el ritmo
+// medio se mantiene aunque un tick llegue tarde (se "recupera" en el
+// siguiente). Sin ritmo (rateHz = 0) se envian kBurstChunkDatagrams por
+// vuelta del event loop (temporizador a 0 ms): un millon de tramas no
+// congela la UI, y entre lote y lote se procesan eventos y repintados.
+//
+// El transporte no espera con el buffer de envio lleno (sendStallMs = 0):
+// lo que no cupo se reintenta en el siguiente tick, y sin ritmo el
+// temporizador pasa a kBurstTickMs hasta que el SO vuelva a aceptar.
+//
+// rateHz cuenta TRAMAS: con tramas empaquetadas se envian los datagramas
+// necesarios para cubrir las tramas debidas.
+//
+// Las propiedades visibles desde QML se actualizan UNA vez por lote.
+// =============================================================================
+void EthernetController::sendBurstChunk()
+{
+    const int total = int(m_burstFrames.size());   // Datagramas
+    int due = qMin(total, m_burstSentDatagrams + kBurstChunkDatagrams);
+    if (m_burstRateHz > 0) {
+        const double elapsedSec = m_burstClock.nsecsElapsed() / 1e9;
+        const qint64 dueFrames = qint64(elapsedSec * m_burstRateHz) + 1;
+        due = int(qMin<qint64>(total, (dueFrames + m_burstFramesPerDatagram - 1)
+                                          / m_burstFramesPerDatagram));
+    }
+
+    const int pending = due - m_burstSentDatagrams;
+    if (pending > 0) {
+        const int sent = sendFrames(m_burstFrames.constData() + m_burstSentDatagrams,
+                                    pending);
+
+        if (sent > 0) {
+            // Se acumula; publishPending() lo publica en el siguiente tick.
+            // Las vistas son contiguas en la arena: los bytes enviados son
+            // la distancia entre el principio de la primera y el final de
+            // la ultima.
+            const QByteArrayView first = m_burstFrames[m_burstSentDatagrams];
+            const QByteArrayView last = m_burstFrames[m_burstSentDatagrams + sent - 1];
+            const int bytes = int(last.data() + last.size() - first.data());
+            const int frames = bytes / m_burstFrameSize;
+            m_burstSentDatagrams += sent;
+            m_burstSentFrames += frames;
+            m_sentCount += frames;
+            m_pendingBurstFrames += frames;
+            m_pendingBurstBytes += bytes;
+            m_pendingBurstLast = last.last(m_burstFrameSize).toByteArray();
+        }
+
+        if (sent < pending && m_transport.sendWouldBlock()) {
+            // Buffer del SO lleno: se reintenta sin bloquear la GUI
+            if (m_burstRateHz == 0)
+                m_burstTimer.setInterval(kBurstTickMs);
+            return;
+        }
+        if (m_burstRateHz == 0 && m_burstTimer.interval() != 0)
+            m_burstTimer.setInterval(0);
+
+        if (sent < pending) {
+            // El SO rechazo el envio (no por falta de hueco): se aborta
+            m_errorCount++;
+            emit errorCountChanged();
+            finishBurst();
+            return;
+        }
+    }
+
+    if (m_burstSentDatagrams >= total)
+        finishBurst();
+}
+
+void EthernetController::finishBurst()
+{
+    m_burstTimer.stop();
+    m_transport.setSendStallMs(UdpTransport::kDefaultSendStallMs);
+    publishPending();   // El ultimo lote, antes de burstFinished()
+
+    const qint64 elapsedNs = qMax<qint64>(m_burstClock.nsecsElapsed(), 1);
+    const int framesSent = m_burstSentFrames;
+    m_burstFrames.clear();   // La arena conserva su capacidad para la proxima
+    setBursting(false);
+
+    emit burstFinished(framesSent, int(elapsedNs / 1000000),
+                       framesSent * 1e9 / elapsedNs);
+}
+
+void EthernetController::setBursting(bool bursting)
+{
+    if (m_bursting != bursting) {
+        m_bursting = bursting;
+        emit burstingChanged();
+    }
+}
+
+// =============================================================================
+// sendFrame() / sendFrames() — Destino unico o fan-out
+// =============================================================================
+// Sin destinos registrados se conserva el comportamiento original
+// (127.0.0.1:sendPort). Con destinos, UdpTransport::fanOut() reparte los
+// mismos bytes a todos: una trama codificada, N datagramas.
+// =============================================================================
+bool EthernetController::sendFrame(QByteArrayView frame)
+{
+    if (m_transport.destinationCount() == 0)
+        return m_transport.sendDatagram(frame, QHostAddress(QHostAddress::LocalHost),
+                                        m_sendPort);
+    return m_transport.fanOut(frame) == 1;
+}
+
+int EthernetController::sendFrames(const QByteArrayView *frames, int count)
+{
+    if (m_transport.destinationCount() == 0)
+        return m_transport.sendDatagrams(frames, count, m_sendPort);
+    return m_transport.fanOut(frames, count);
+}
+
+// =============================================================================
+// Destinos de fan-out
+// =============================================================================
+QVariantList EthernetController::destinations() const
+{
+    QVariantList list;
+    for (const UdpDestination &dest : m_transport.destinations()) {
+        list.append(QVariantMap{
+            { QStringLiteral("address"), dest.address.toString() },
+            { QStringLiteral("port"), int(dest.port) },
+            { QStringLiteral("sent"), double(dest.sentDatagrams) },
+            { QStringLiteral("bytes"), double(dest.sentBytes) },
+            { QStringLiteral("failed"), double(dest.failedDatagrams) },
+        });
+    }
+    return list;
+}
+
+bool EthernetController::addDestination(const QString &address, int port)
+{
+    const QHostAddress host(address.trimmed());
+    if (host.protocol() != QAbstractSocket::IPv4Protocol || port <= 0 || port > 65535) {
+        setStatusText(QStringLiteral("Invalid destination %1:%2").arg(address).arg(port));
+        return false;
+    }
+
+    const int before = m_transport.destinationCount();
+    m_transport.addDestination(host, quint16(port));
+    if (m_transport.destinationCount() != before)
+        emit destinationsChanged();
+    return true;
+}
+
+void EthernetController::removeDestination(int index)
+{
+    if (m_transport.removeDestination(index))
+        emit destinationsChanged();
+}
+
+void EthernetController::clearDestinations()
+{
+    if (m_transport.destinationCount() == 0)
+        return;
+    m_transport.clearDestinations();
+    m_publishedDestinationTraffic = 0;
+    emit destinationsChanged();
+}
+
+void EthernetController::resetDestinationCounters()
+{
+    m_transport.resetDestinationCounters();
+    m_publishedDestinationTraffic = 0;
+    emit destinationsChanged();
 }
 
 // =============================================================================
@@ -202,55 +892,72 @@ void EthernetController::sendMessage(int messageId, int presenceMask,
 // =============================================================================
 void EthernetController::sendRawHex(const QString &hexString)
 {
-    // Eliminar espacios y convertir hex a bytes
-    QString cleanHex = hexString;
-    cleanHex.remove(QLatin1Char(' '));
-    QByteArray data = QByteArray::fromHex(cleanHex.toLatin1());
+    // Eliminar espacios y convertir hex a bytes (StanagFuzzer ejercita
+    // esta misma conversion con entradas arbitrarias)
+    QByteArray data = HexFormatter::parse(hexString);
 
     if (data.isEmpty()) {
-        QString timestamp = QDateTime::currentDateTime()
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        QString timestamp = QDateTime::fromMSecsSinceEpoch(nowMs)
                                 .toString(QStringLiteral("hh:mm:ss.zzz"));
         emit protocolError(timestamp,
                            QStringLiteral("Invalid hex string"),
                            hexString);
+
+        MessageLogModel::Entry entry;
+        entry.timestampMs = nowMs;
+        entry.direction = MessageLogModel::Direction::Error;
+        entry.checksumOk = false;
+        entry.text = QStringLiteral("Invalid hex string: %1").arg(hexString.left(40));
+        appendLog(std::move(entry));
         return;
     }
 
-    if (m_transport.sendDatagram(data, m_sendPort)) {
+    if (sendFrame(data)) {
         m_sentCount++;
         emit sentCountChanged();
 
-        QString hexDump = QString::fromLatin1(data.toHex(' ')).toUpper();
-        m_lastSentHex = hexDump;
+        m_lastSentFrame = data;
         emit lastSentHexChanged();
 
-        QString timestamp = QDateTime::currentDateTime()
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        QString timestamp = QDateTime::fromMSecsSinceEpoch(nowMs)
                                 .toString(QStringLiteral("hh:mm:ss.zzz"));
-        emit messageSent(timestamp, hexDump, 0, 0, data.size());
+        emit messageSent(timestamp, hexForSignal(m_messageSentSignal, data),
+                         0, 0, data.size());
+
+        MessageLogModel::Entry entry;
+        entry.timestampMs = nowMs;
+        entry.direction = MessageLogModel::Direction::Sent;
+        entry.byteSize = int(data.size());
+        entry.raw = data;
+        appendLog(std::move(entry));
     }
 }
 
 // =============================================================================
 // getFieldDefinitions() — Tabla de campos para la UI de QML
 // =============================================================================
-// Convierte la tabla interna de FieldDef a QVariantList de QVariantMap.
+// Convierte la tabla de FieldDef del plan a QVariantList de QVariantMap.
 // QVariantMap es la forma de Qt de pasar objetos JavaScript entre C++ y QML.
 //
 // En QML se puede acceder asi:
-//   var defs = controller.getFieldDefinitions()
+//   var defs = controller.getFieldDefinitions(101)
 //   defs[0].name     // "Latitude"
 //   defs[0].sizeBytes // 4
+//   defs[0].type     // "float32"
 // =============================================================================
-QVariantList EthernetController::getFieldDefinitions() const
+QVariantList EthernetController::getFieldDefinitions(int messageId) const
 {
     QVariantList result;
-    const auto &defs = StanagCodec::fieldDefinitions();
+    const auto &defs = m_catalog->plan(quint16(messageId)).fields;
 
     for (int i = 0; i < defs.size(); ++i) {
         QVariantMap entry;
         entry[QStringLiteral("index")] = i;
         entry[QStringLiteral("name")] = defs[i].name;
         entry[QStringLiteral("sizeBytes")] = defs[i].sizeBytes;
+        entry[QStringLiteral("type")] = StanagCatalog::typeName(defs[i].type);
         result.append(entry);
     }
 
@@ -258,59 +965,535 @@ QVariantList EthernetController::getFieldDefinitions() const
 }
 
 // =============================================================================
-// onDatagramReceived() — Procesar un datagrama UDP entrante
+// loadCatalog() — Cargar otro catalogo y repartirlo
 // =============================================================================
-// Flujo completo del "receive path":
-//   1. Recibir bytes crudos de UdpTransport
-//   2. Intentar decodificar con StanagCodec::decode()
-//   3. Si falla → emitir protocolError con el hex dump del datagrama
-//   4. Si exito → emitir messageReceived + fieldsDecoded
+// Se carga en un catalogo NUEVO: el actual sigue en uso (aqui y en el hilo
+// de recepcion) hasta que se sustituye el puntero. El worker recibe su
+// copia del shared_ptr en su propio hilo, con una llamada encolada.
+// =============================================================================
+bool EthernetController::loadCatalog(const QString &path)
+{
+    auto catalog = std::make_shared<StanagCatalog>();
+    QString error;
+    if (!catalog->loadFile(path, &error)) {
+        setStatusText(QStringLiteral("Catalogue %1 not loaded: %2").arg(path, error));
+        return false;
+    }
+
+    m_catalog = std::move(catalog);
+    m_packetSplitter.setCatalog(m_catalog.get());
+    if (m_receiveWorker) {
+        ReceiveWorker *worker = m_receiveWorker;
+        std::shared_ptr<const StanagCatalog> shared = m_catalog;
+        QMetaObject::invokeMethod(worker, [worker, shared]() {
+            worker->setCatalog(shared);
+        }, Qt::QueuedConnection);
+    }
+
+    setStatusText(QStringLiteral("Catalogue loaded: %1 messages").arg(m_catalog->messageCount()));
+    emit catalogChanged();
+    return true;
+}
+
+// =============================================================================
+// runDecodeBenchmark() — Delegar en StanagBenchmark
+// =============================================================================
+// La fachada no mide nada por si misma: solo expone el benchmark a QML.
+// El valor de retorno (QVariantMap) llega a JavaScript como un objeto.
+// =============================================================================
+QVariantMap EthernetController::runDecodeBenchmark(int frames)
+{
+    return StanagBenchmark::compareDecode(frames);
+}
+
+QVariantMap EthernetController::runHexBenchmark(int frames)
+{
+    return StanagBenchmark::compareHexDump(frames);
+}
+
+QVariantList EthernetController::runChecksumBenchmark(int megabytesPerCase)
+{
+    return StanagBenchmark::compareChecksums(megabytesPerCase);
+}
+
+QVariantList EthernetController::runDensityBenchmark(int frames)
+{
+    return StanagBenchmark::compareMaskDensity(frames);
+}
+
+QVariantMap EthernetController::runFuzzer(int iterations, int seed)
+{
+    return StanagFuzzer::run(iterations, quint32(seed));
+}
+
+QString EthernetController::statsSnapshotJson(bool indented)
+{
+    const QJsonDocument doc(m_statsModel.toJson(UdpTransport::wallClockNs()));
+    return QString::fromUtf8(doc.toJson(indented ? QJsonDocument::Indented
+                                                 : QJsonDocument::Compact));
+}
+
+void EthernetController::resetStats()
+{
+    m_statsModel.clear();
+}
+
+void EthernetController::resetLatency()
+{
+    m_latency.reset();
+    m_latencyDirty = false;
+    emit latencyStatsChanged();
+}
+
+// =============================================================================
+// startReceiveThread() / stopReceiveThread() — Ciclo de vida del worker
+// =============================================================================
+// Patron worker + moveToThread: el worker se crea SIN parent (un QObject con
+// parent no puede cambiar de hilo), se mueve al QThread y se destruye con
+// deleteLater cuando el hilo termina.
 //
-// La conversion de campos decodificados a QVariantList permite que QML
-// muestre cada campo individualmente sin conocer la estructura interna
-// de StanagField.
+// bind()/unbind() se invocan con BlockingQueuedConnection: se ejecutan en el
+// hilo del worker (donde vive el socket) pero esperamos su resultado aqui,
+// asi startListening() sabe si el bind fallo igual que en el modo normal.
+// =============================================================================
+bool EthernetController::startReceiveThread()
+{
+    if (!m_receiveQueue)
+        m_receiveQueue = std::make_unique<ReceiveQueue>();
+    // La cola de captura solo existe si se ha capturado con el hilo activo
+    if (m_capture.isOpen() && !m_captureQueue)
+        m_captureQueue = std::make_unique<CaptureQueue>();
+
+    m_receiveThread = new QThread(this);
+    m_receiveThread->setObjectName(QStringLiteral("EthernetRx"));
+    m_receiveWorker = new ReceiveWorker(m_receiveQueue.get());
+    m_receiveWorker->setCatalog(m_catalog);   // Aun no se ha movido de hilo
+    m_receiveWorker->setCaptureQueue(m_captureQueue.get());
+    m_receiveWorker->setCapturing(m_capture.isOpen());
+    m_receiveWorker->moveToThread(m_receiveThread);
+
+    connect(m_receiveThread, &QThread::finished,
+            m_receiveWorker, &QObject::deleteLater);
+    connect(m_receiveWorker, &ReceiveWorker::errorOccurred,
+            this, &EthernetController::onTransportError);
+
+    m_receiveThread->start();
+
+    bool ok = false;
+    ReceiveWorker *worker = m_receiveWorker;
+    const quint16 port = m_listenPort;
+    const QHostAddress group = m_multicastGroup.isEmpty()
+                                   ? QHostAddress() : QHostAddress(m_multicastGroup);
+    const QString iface = m_multicastInterface;
+    QMetaObject::invokeMethod(worker, [&ok, worker, port, group, iface]() {
+        ok = worker->bind(port, kReceiveBatchSize, group, iface);
+    }, Qt::BlockingQueuedConnection);
+
+    if (!ok)
+        stopReceiveThread();
+    return ok;
+}
+
+void EthernetController::stopReceiveThread()
+{
+    if (!m_receiveThread)
+        return;
+
+    ReceiveWorker *worker = m_receiveWorker;
+    QMetaObject::invokeMethod(worker, [worker]() { worker->unbind(); },
+                              Qt::BlockingQueuedConnection);
+
+    // Sin socket ya no hay productor: lo que quede en la cola se publica
+    // ahora, asi queda vacia para el siguiente worker.
+    drainReceiveQueue();
+
+    m_receiveThread->quit();
+    m_receiveThread->wait();
+    delete m_receiveThread;
+    m_receiveThread = nullptr;
+    m_receiveWorker = nullptr;   // Ya destruido por deleteLater
+}
+
+// =============================================================================
+// onUiTick() — Una vez por tick de UI (uiUpdateRateHz)
+// =============================================================================
+void EthernetController::onUiTick()
+{
+    if (m_receiveQueue)
+        drainReceiveQueue();
+
+    m_capture.maybeFlush();
+    publishPending();
+}
+
+// =============================================================================
+// drainReceiveQueue() — Vaciar la cola del worker en el estado pendiente
+// =============================================================================
+// Cada trama cuenta (contadores + latencia), pero solo la ULTIMA decodificada
+// y el ULTIMO error se conservan para publishPending().
+//
+// La latencia se mide contra el instante de este vaciado: es el tiempo que
+// tarda un datagrama desde que el kernel lo recibe hasta que el hilo de GUI
+// lo tiene (incluye la espera al siguiente tick).
+// =============================================================================
+void EthernetController::drainReceiveQueue()
+{
+    ReceivedFrame frame;
+    const qint64 nowNs = UdpTransport::wallClockNs();
+    while (m_receiveQueue->tryPop(frame)) {
+        m_receivedCount++;
+        m_pendingReceived++;
+        m_latency.record(nowNs - frame.receivedNs);
+        m_latencyDirty = true;
+
+        if (frame.decoded) {
+            m_statsModel.record(frame.view, frame.size, frame.receivedNs);
+            m_pendingFrame = frame;
+            m_hasPendingFrame = true;
+        } else {
+            m_pendingError = frame;
+            m_hasPendingError = true;
+            m_errorCount++;
+            m_pendingErrors++;
+        }
+    }
+
+    const quint64 dropped = m_receiveWorker ? m_receiveWorker->takeDropped() : 0;
+    if (dropped > 0) {
+        m_droppedCount += int(dropped);
+        emit droppedCountChanged();
+    }
+
+    drainCaptureQueue();
+}
+
+// =============================================================================
+// drainCaptureQueue() — Datagramas crudos del worker al pcap
+// =============================================================================
+// Con la captura cerrada la cola se vacia igualmente (puede quedar algo
+// copiado justo antes de setCapturing(false)). Sin cola (nunca se capturo
+// con el hilo activo) no hay nada que hacer.
+// =============================================================================
+void EthernetController::drainCaptureQueue()
+{
+    if (!m_captureQueue)
+        return;
+    CapturedDatagram datagram;
+    while (m_captureQueue->tryPop(datagram))
+        captureDatagram(datagram.bytesView(), datagram.size, datagram.senderPort,
+                        datagram.receivedNs);
+
+    if (m_receiveWorker)
+        m_captureDropped += m_receiveWorker->takeCaptureDropped();
+}
+
+// =============================================================================
+// onDatagramReceived() / onDatagramsReceived() — Entradas del receive path
+// =============================================================================
+// Ambas desembocan en processDatagram(). La version por lotes recorre el
+// UdpDatagramSpan: las vistas apuntan a los buffers de UdpTransport y solo
+// son validas durante esta llamada, por eso se procesan aqui mismo.
 // =============================================================================
 void EthernetController::onDatagramReceived(const QByteArray &data,
                                             quint16 senderPort)
+{
+    // QNetworkDatagram no trae timestamp del kernel: se usa la hora actual
+    processDatagram(data, senderPort, UdpTransport::wallClockNs());
+}
+
+void EthernetController::onDatagramsReceived(UdpDatagramSpan batch)
+{
+    for (const UdpDatagramView &datagram : batch)
+        processDatagram(datagram.data, datagram.senderPort, datagram.receivedNs);
+}
+
+// =============================================================================
+// processDatagram() — Procesar un datagrama UDP entrante
+// =============================================================================
+// Flujo completo del "receive path":
+//   1. Recibir bytes crudos de UdpTransport (QByteArrayView, sin copia)
+//   2. Intentar decodificar con el plan de su messageId en el catalogo
+//      (StanagCatalog::decodeView(), fast path)
+//   3. Contar y copiar el datagrama al hueco pendiente (trama o error)
+//   4. En el siguiente tick, publishPending() emite las senales a QML
+//
+// Si el datagrama no es UNA trama (varias empaquetadas, framesPerDatagram
+// en el emisor), m_packetSplitter las separa y cada una sigue el paso 3
+// por su cuenta; las vistas apuntan al propio datagrama, sin copias.
+//
+// Con uiUpdateRateHz = 0 el paso 4 se encola para el final de esta vuelta
+// del event loop: un lote de recvmmsg() se publica una sola vez.
+// =============================================================================
+void EthernetController::processDatagram(QByteArrayView data, quint16 senderPort,
+                                         qint64 receivedNs)
+{
+    captureDatagram(data, data.size(), senderPort, receivedNs);
+
+    bool handled = false;
+    if (!StanagStreamDecoder::isSingleFrame(data)) {
+        const quint64 skippedBefore = m_packetSplitter.skippedBytes();
+        m_packetSplitter.feed(data, true);
+
+        StanagFrameView view;
+        while (m_packetSplitter.next(view)) {
+            processFrame(view.frame, senderPort, receivedNs, true, view);
+            handled = true;
+        }
+
+        // Bytes que no eran trama entre las validas: un error por datagrama
+        if (handled && m_packetSplitter.skippedBytes() != skippedBefore)
+            processFrame(data, senderPort, receivedNs, false, StanagFrameView());
+    }
+
+    if (!handled) {
+        StanagFrameView view;
+        const bool decoded = m_catalog->decodeView(data, view);
+        processFrame(data, senderPort, receivedNs, decoded, view);
+    }
+
+    if (m_uiUpdateRateHz == 0)
+        schedulePublish();
+}
+
+void EthernetController::schedulePublish()
+{
+    if (m_publishQueued)
+        return;
+    m_publishQueued = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        m_publishQueued = false;
+        publishPending();
+    }, Qt::QueuedConnection);
+}
+
+void EthernetController::processFrame(QByteArrayView data, quint16 senderPort,
+                                      qint64 receivedNs, bool decoded,
+                                      const StanagFrameView &view)
 {
     m_receivedCount++;
-    emit receivedCountChanged();
+    m_pendingReceived++;
+
+    ReceivedFrame &slot = decoded ? m_pendingFrame : m_pendingError;
+    slot.assign(data, senderPort, receivedNs);
+    slot.decoded = decoded;
+    slot.view = view;   // view.frame se re-apunta a slot.bytes al publicar
+
+    if (decoded) {
+        m_statsModel.record(view, int(data.size()), receivedNs);
+        m_hasPendingFrame = true;
+    } else {
+        m_hasPendingError = true;
+        m_errorCount++;
+        m_pendingErrors++;
+    }
+
+    m_latency.record(UdpTransport::wallClockNs() - receivedNs);
+    m_latencyDirty = true;
+}
+
+// =============================================================================
+// publishPending() — Todo lo acumulado desde el ultimo tick, de una vez
+// =============================================================================
+//   - receivedCountChanged / errorCountChanged: una emision por tick
+//   - ultimo error  → protocolError + entrada de log "(+N more)"
+//   - ultima trama  → messageReceived + fieldsDecoded + entrada "+N merged"
+//   - rafaga        → sentCountChanged + lastSentHex + burstSent + entrada
+//   - log           → MessageLogModel::flush(): un beginInsertRows por tick
+//   - latencia      → latencyStatsChanged si hubo muestras nuevas
+// =============================================================================
+void EthernetController::publishPending()
+{
+    if (m_pendingReceived > 0) {
+        const int published = int(m_hasPendingFrame) + int(m_hasPendingError);
+        const int merged = m_pendingReceived - published;
+        const int errors = m_pendingErrors;
 
-    QString hexDump = QString::fromLatin1(data.toHex(' ')).toUpper();
-    m_lastReceivedHex = hexDump;
+        m_pendingReceived = 0;
+        m_pendingErrors = 0;
+
+        emit receivedCountChanged();
+        if (errors > 0)
+            emit errorCountChanged();
+        if (merged > 0) {
+            m_mergedCount += merged;
+            emit mergedCountChanged();
+        }
+
+        if (m_hasPendingError) {
+            m_hasPendingError = false;
+            const QString note = errors > 1
+                ? QStringLiteral(" (+%1 more)").arg(errors - 1) : QString();
+            publishReceived(m_pendingError.bytesView(), m_pendingError.size,
+                            m_pendingError.senderPort, nullptr, note);
+        }
+
+        if (m_hasPendingFrame) {
+            m_hasPendingFrame = false;
+            // view.frame apuntaba al buffer de origen: re-apuntar a la copia
+            m_pendingFrame.view.frame = m_pendingFrame.bytesView();
+            const QString note = merged > 0
+                ? QStringLiteral("+%1 merged").arg(merged) : QString();
+            publishReceived(m_pendingFrame.bytesView(), m_pendingFrame.size,
+                            m_pendingFrame.senderPort, &m_pendingFrame.view, note);
+        }
+    }
+
+    if (m_pendingBurstFrames > 0) {
+        const int frames = m_pendingBurstFrames;
+        m_pendingBurstFrames = 0;
+
+        emit sentCountChanged();
+        m_lastSentFrame = m_pendingBurstLast;
+        emit lastSentHexChanged();
+
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        QString timestamp = QDateTime::fromMSecsSinceEpoch(nowMs)
+                                .toString(QStringLiteral("hh:mm:ss.zzz"));
+        emit burstSent(timestamp, m_burstMessageId, m_burstFieldCount,
+                       frames, m_pendingBurstBytes);
+
+        MessageLogModel::Entry entry;
+        entry.timestampMs = nowMs;
+        entry.direction = MessageLogModel::Direction::Burst;
+        entry.messageId = quint16(m_burstMessageId);
+        entry.fieldCount = m_burstFieldCount;
+        entry.byteSize = m_pendingBurstBytes;
+        entry.text = QStringLiteral("%1 frames").arg(frames);
+        entry.raw = m_pendingBurstLast;
+        if (m_pendingBurstLast.size() >= kStanagHeaderSize) {
+            entry.hasSequence = true;
+            entry.sequenceNum = qFromBigEndian<quint16>(m_pendingBurstLast.constData() + 6);
+        }
+        m_logModel.append(std::move(entry));
+        m_pendingBurstBytes = 0;
+    }
+
+    if (int(m_capture.packetCount()) != m_publishedCaptured) {
+        m_publishedCaptured = int(m_capture.packetCount());
+        emit capturedCountChanged();
+    }
+    if (m_replay.sentCount() != m_publishedReplaySent) {
+        m_publishedReplaySent = m_replay.sentCount();
+        emit replayProgressChanged();
+    }
+
+    // Contadores de fan-out: se comparan totales, no destino a destino
+    quint64 destinationTraffic = 0;
+    for (const UdpDestination &dest : m_transport.destinations())
+        destinationTraffic += dest.sentDatagrams + dest.failedDatagrams;
+    if (destinationTraffic != m_publishedDestinationTraffic) {
+        m_publishedDestinationTraffic = destinationTraffic;
+        emit destinationsChanged();
+    }
+
+    m_logModel.flush();
+    m_statsModel.refresh(UdpTransport::wallClockNs());
+
+    if (m_latencyDirty) {
+        m_latencyDirty = false;
+        emit latencyStatsChanged();
+    }
+}
+
+// =============================================================================
+// appendLog() — Entradas de log fuera del camino de recepcion
+// =============================================================================
+// Envios manuales, errores de red... Con el tick de UI en marcha esperan a
+// su flush(); sin el (socket sin bindear) se publican inmediatamente.
+// =============================================================================
+void EthernetController::appendLog(MessageLogModel::Entry entry)
+{
+    m_logModel.append(std::move(entry));
+    if (!m_uiTimer.isActive())
+        m_logModel.flush();
+    else if (m_uiUpdateRateHz == 0)
+        schedulePublish();
+}
+
+// =============================================================================
+// publishReceived() — Senales de QML + log para un datagrama recibido
+// =============================================================================
+// La conversion de campos decodificados a QVariantList permite que QML
+// muestre cada campo individualmente sin conocer la estructura interna
+// de StanagFrameView.
+// =============================================================================
+void EthernetController::publishReceived(QByteArrayView data, int byteSize,
+                                         quint16 senderPort,
+                                         const StanagFrameView *view,
+                                         const QString &note)
+{
+    m_lastReceivedFrame = data.toByteArray();
     emit lastReceivedHexChanged();
 
-    QString timestamp = QDateTime::currentDateTime()
+    const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+    QString timestamp = QDateTime::fromMSecsSinceEpoch(nowMs)
                             .toString(QStringLiteral("hh:mm:ss.zzz"));
 
-    // --- Intentar decodificar ---
-    StanagMessage msg;
-    if (!StanagCodec::decode(data, msg)) {
-        m_errorCount++;
-        emit errorCountChanged();
-        emit protocolError(timestamp,
-                           QStringLiteral("Failed to decode message (%1 bytes)")
-                               .arg(data.size()),
-                           hexDump);
+    MessageLogModel::Entry logEntry;
+    logEntry.timestampMs = nowMs;
+    logEntry.byteSize = byteSize;
+    logEntry.raw = m_lastReceivedFrame;   // Compartido, sin copia
+
+    if (!view) {
+        const QString error = QStringLiteral("Failed to decode message (%1 bytes)")
+                                  .arg(byteSize) + note;
+        emit protocolError(timestamp, error,
+                           hexForSignal(m_protocolErrorSignal, data));
+
+        logEntry.direction = MessageLogModel::Direction::Error;
+        logEntry.checksumOk = false;
+        logEntry.text = error;
+        m_logModel.append(std::move(logEntry));
         return;
     }
 
     // --- Emitir mensaje recibido ---
-    emit messageReceived(timestamp, hexDump,
-                         msg.messageId, senderPort,
-                         msg.fields.size(), data.size(),
-                         msg.checksumValid);
+    emit messageReceived(timestamp, hexForSignal(m_messageReceivedSignal, data),
+                         view->messageId, senderPort,
+                         view->fieldCount, byteSize,
+                         view->checksumValid);
+
+    logEntry.direction = MessageLogModel::Direction::Received;
+    logEntry.messageId = view->messageId;
+    logEntry.fieldCount = view->fieldCount;
+    logEntry.checksumOk = view->checksumValid;
+    logEntry.hasSequence = true;
+    logEntry.sequenceNum = view->sequenceNum;
+    logEntry.text = note;
+    m_logModel.append(std::move(logEntry));
+
+    if (view->checksumValid)
+        notePeerChecksum(view->checksumMode);
 
     // --- Convertir campos a QVariantList para QML ---
+    // value(): una trama decodificada por el worker con el catalogo
+    // anterior a un loadCatalog() puede traer bits que el nuevo no tiene
+    const auto &defs = m_catalog->plan(view->messageId).fields;
     QVariantList fieldList;
-    for (const auto &field : msg.fields) {
+    fieldList.reserve(view->fieldCount);
+    for (int i = 0; i < kStanagMaxFields; ++i) {
+        if (!view->hasField(i))
+            continue;
+
         QVariantMap entry;
-        entry[QStringLiteral("index")] = field.index;
-        entry[QStringLiteral("name")] = field.name;
-        entry[QStringLiteral("hex")] = QString::fromLatin1(
-            field.rawBytes.toHex(' ')).toUpper();
-        entry[QStringLiteral("value")] = field.value;
+        entry[QStringLiteral("index")] = i;
+        entry[QStringLiteral("name")] = defs.value(i).name;
+        entry[QStringLiteral("hex")] = HexFormatter::format(view->fieldBytes(i));
+        entry[QStringLiteral("value")] = view->values[i];
         fieldList.append(entry);
     }
     emit fieldsDecoded(fieldList);
 }
+
+// =============================================================================
+// hexForSignal() — Hex dump solo si alguien escucha la senal
+// =============================================================================
+// Las senales messageSent/messageReceived/protocolError conservan su
+// parametro hexDump por compatibilidad, pero generar la cadena es lo mas
+// caro del camino de publicacion. Si no hay receptores, se pasa "".
+// =============================================================================
+QString EthernetController::hexForSignal(const QMetaMethod &signal,
+                                         QByteArrayView bytes) const
+{
+    return isSignalConnected(signal) ? HexFormatter::format(bytes) : QString();
+}
@@ -14,21 +14,46 @@
 // COMUNICACION CON QML:
 //   Las senales emiten SOLO tipos simples (QString, int, bool, QVariantList).
 //   Esto evita tener que registrar tipos complejos en QML y simplifica
-//   el binding. QML recibe los datos y los inserta en un ListModel local.
+//   el binding. El historial de mensajes es un modelo C++ (logModel).
+//
+// ACTUALIZACIONES COALESCIDAS (uiUpdateRateHz):
+//   La recepcion NO emite senales por datagrama. Los contadores se acumulan
+//   y en cada tick de UI se publica solo la ULTIMA trama decodificada (y el
+//   ultimo error); el resto cuenta como "merged". Asi el coste de QML es
+//   por refresco de pantalla, no por datagrama.
 //
 // FLUJO TIPICO:
 //   1. QML llama startListening() → bind socket → indicador verde
 //   2. QML llama sendMessage(id, mask, values) → encode → UDP → log
-//   3. UDP recibe datagrama → decode → signals → QML actualiza log
+//   3. UDP recibe datagrama(s) → decode → signals → QML actualiza log
 //   4. QML llama stopListening() → unbind → indicador rojo
+//
+// RECEPCION EN HILO DEDICADO (threadedReceive):
+//   Opcionalmente el socket y el decode viven en un ReceiveWorker con su
+//   propio QThread. Los resultados cruzan al hilo de GUI por una SpscQueue
+//   que se vacia una vez por tick de UI. Ver receiveworker.h.
 // =============================================================================
 
 #ifndef ETHERNETCONTROLLER_H
 #define ETHERNETCONTROLLER_H
 
+#include <QElapsedTimer>
+#include <QMetaMethod>
 #include <QObject>
+#include <QThread>
+#include <QTimer>
 #include <QVariantList>
+#include <QVariantMap>
 #include <QtQml/qqmlregistration.h>
+#include <memory>
+#include "latencyhistogram.h"
+#include "messagelogmodel.h"
+#include "messagestatsmodel.h"
+#include "pcapwriter.h"
+#include "replayengine.h"
+#include "receiveworker.h"
+#include "stanagcatalog.h"
+#include "stanagstreamdecoder.h"
 #include "udptransport.h"
 #include "stanagcodec.h"
 #include "stanagmessage.h"
@@ -48,12 +73,102 @@ class EthernetController : public QObject
     Q_PROPERTY(quint16 sendPort READ sendPort WRITE setSendPort NOTIFY sendPortChanged)
     Q_PROPERTY(QString statusText READ statusText NOTIFY statusTextChanged)
 
+    // --- Modo de recepcion ---
+    // true → UdpTransport en modo batch (recvmmsg en Linux): un lote de
+    // datagramas por llamada al sistema y una senal por lote.
+    Q_PROPERTY(bool batchReceive READ batchReceive WRITE setBatchReceive NOTIFY batchReceiveChanged)
+
+    // true → socket + decode en un hilo propio (ReceiveWorker); el hilo de
+    // GUI solo vacia la cola una vez por refresco. Cambiarlo con el socket
+    // bindeado re-bindea en el nuevo modo.
+    Q_PROPERTY(bool threadedReceive READ threadedReceive WRITE setThreadedReceive NOTIFY threadedReceiveChanged)
+
+    // --- Multicast y fan-out ---
+    // multicastGroup no vacio (p.ej. "239.1.2.3") → se escucha ese grupo en
+    // listenPort con bind compartido: varias instancias en la misma maquina
+    // reciben cada trama. multicastInterface elige la interfaz ("" = la del
+    // kernel; "lo" para multicast solo local). Cambiarlos con el socket
+    // bindeado re-bindea.
+    Q_PROPERTY(QString multicastGroup READ multicastGroup WRITE setMulticastGroup NOTIFY multicastGroupChanged)
+    Q_PROPERTY(QString multicastInterface READ multicastInterface WRITE setMulticastInterface NOTIFY multicastInterfaceChanged)
+
+    // Destinos registrados: [{ address, port, sent, bytes, failed }, ...].
+    // Vacio → se envia a 127.0.0.1:sendPort como siempre. Con destinos,
+    // cada trama se codifica una vez y se reparte a todos (UdpTransport::
+    // fanOut). Los contadores se publican una vez por tick de UI.
+    Q_PROPERTY(QVariantList destinations READ destinations NOTIFY destinationsChanged)
+
+    // --- Checksum de la trama ---
+    // Modo con el que se CODIFICAN las tramas enviadas (valor de
+    // StanagChecksumMode): 0 = XOR (1 byte), 1 = CRC-16-CCITT, 2 = CRC-32.
+    // La recepcion no depende de el: el modo se deduce de cada trama.
+    // Escribirlo desactiva followPeerChecksum.
+    Q_PROPERTY(int checksumMode READ checksumMode WRITE setChecksumMode NOTIFY checksumModeChanged)
+
+    // Modo detectado en la ultima trama valida del peer (-1 = ninguna aun)
+    Q_PROPERTY(int peerChecksumMode READ peerChecksumMode NOTIFY peerChecksumModeChanged)
+
+    // true → checksumMode adopta el modo del peer en cuanto llega una trama
+    // valida con otro modo (negociacion implicita: el que cambia primero
+    // arrastra al otro extremo). Desactivado por defecto.
+    Q_PROPERTY(bool followPeerChecksum READ followPeerChecksum WRITE setFollowPeerChecksum NOTIFY followPeerChecksumChanged)
+
+    // --- Rafaga de envio en curso (sendBurst) ---
+    Q_PROPERTY(bool bursting READ bursting NOTIFY burstingChanged)
+
+    // Tramas de rafaga por datagrama (1 = una por datagrama, como siempre).
+    // Con N > 1 cada datagrama lleva N tramas seguidas de la arena: N veces
+    // menos datagramas y llamadas al sistema. El receptor las separa con
+    // StanagStreamDecoder.
+    Q_PROPERTY(int framesPerDatagram READ framesPerDatagram WRITE setFramesPerDatagram NOTIFY framesPerDatagramChanged)
+
+    // --- Captura a fichero pcap (datagramas RECIBIDOS) ---
+    Q_PROPERTY(bool capturing READ capturing NOTIFY capturingChanged)
+    Q_PROPERTY(QString capturePath READ capturePath WRITE setCapturePath NOTIFY capturePathChanged)
+    Q_PROPERTY(int capturedCount READ capturedCount NOTIFY capturedCountChanged)
+
+    // --- Replay de una captura (ReplayEngine) ---
+    Q_PROPERTY(bool replaying READ replaying NOTIFY replayingChanged)
+    Q_PROPERTY(int replaySent READ replaySent NOTIFY replayProgressChanged)
+    Q_PROPERTY(int replayTotal READ replayTotal NOTIFY replayProgressChanged)
+
     // --- Contadores de actividad ---
     Q_PROPERTY(int sentCount READ sentCount NOTIFY sentCountChanged)
     Q_PROPERTY(int receivedCount READ receivedCount NOTIFY receivedCountChanged)
     Q_PROPERTY(int errorCount READ errorCount NOTIFY errorCountChanged)
+    Q_PROPERTY(int droppedCount READ droppedCount NOTIFY droppedCountChanged)
+
+    // Datagramas recibidos que no se publicaron uno a uno porque llego otro
+    // mas reciente en el mismo tick de UI (cuentan en receivedCount igual)
+    Q_PROPERTY(int mergedCount READ mergedCount NOTIFY mergedCountChanged)
+
+    // --- Refresco de UI ---
+    // Ticks por segundo en los que se publican contadores, ultima trama y
+    // log. 0 = sin tick fijo: se publica una vez por vuelta del event loop
+    // (todo lo que llego en esa vuelta junto), nunca por datagrama.
+    Q_PROPERTY(int uiUpdateRateHz READ uiUpdateRateHz WRITE setUiUpdateRateHz NOTIFY uiUpdateRateHzChanged)
+
+    // --- Catalogo de mensajes (stanagcatalog.json o loadCatalog()) ---
+    // [{id: 101, name: "Inertial States", fieldCount: 13}, ...]. Los
+    // messageId que no aparecen usan la telemetria de 14 campos.
+    Q_PROPERTY(QVariantList catalogMessages READ catalogMessages NOTIFY catalogChanged)
+
+    // --- Historial de mensajes (ring buffer, fila 0 = mas reciente) ---
+    Q_PROPERTY(MessageLogModel *logModel READ logModel CONSTANT)
+
+    // --- Estadisticas por flujo (messageId, sourcePort) ---
+    // Tabla para QML; se publica una vez por tick de UI. Para
+    // monitorizacion externa, statsSnapshotJson().
+    Q_PROPERTY(MessageStatsModel *statsModel READ statsModel CONSTANT)
+
+    // --- Latencia socket → QML ---
+    // { samples, p50Us, p90Us, p99Us, p999Us, maxUs, octaves } — ver
+    // LatencyHistogram::toVariantMap(). Se notifica como mucho una vez por
+    // tick de UI, nunca por datagrama.
+    Q_PROPERTY(QVariantMap latencyStats READ latencyStats NOTIFY latencyStatsChanged)
 
     // --- Ultimo mensaje (para vista rapida) ---
+    // Se guardan los bytes; el hex solo se genera cuando QML lee la propiedad.
     Q_PROPERTY(QString lastSentHex READ lastSentHex NOTIFY lastSentHexChanged)
     Q_PROPERTY(QString lastReceivedHex READ lastReceivedHex NOTIFY lastReceivedHexChanged)
 
@@ -66,15 +181,47 @@ public:
     quint16 listenPort() const;
     quint16 sendPort() const;
     QString statusText() const;
+    bool batchReceive() const;
+    bool threadedReceive() const;
+    QString multicastGroup() const;
+    QString multicastInterface() const;
+    QVariantList destinations() const;
+    int checksumMode() const;
+    int peerChecksumMode() const;
+    bool followPeerChecksum() const;
+    bool bursting() const;
+    int framesPerDatagram() const;
+    bool capturing() const;
+    QString capturePath() const;
+    int capturedCount() const;
+    bool replaying() const;
+    int replaySent() const;
+    int replayTotal() const;
     int sentCount() const;
     int receivedCount() const;
     int errorCount() const;
+    int droppedCount() const;
+    int mergedCount() const;
+    int uiUpdateRateHz() const;
+    QVariantList catalogMessages() const;
+    MessageLogModel *logModel();
+    MessageStatsModel *statsModel();
+    QVariantMap latencyStats() const;
     QString lastSentHex() const;
     QString lastReceivedHex() const;
 
     // --- Setters ---
     void setListenPort(quint16 port);
     void setSendPort(quint16 port);
+    void setBatchReceive(bool enabled);
+    void setThreadedReceive(bool enabled);
+    void setMulticastGroup(const QString &group);
+    void setMulticastInterface(const QString &name);
+    void setChecksumMode(int mode);
+    void setFollowPeerChecksum(bool enabled);
+    void setFramesPerDatagram(int frames);
+    void setCapturePath(const QString &path);
+    void setUiUpdateRateHz(int hz);
 
     // =========================================================================
     // Q_INVOKABLE — Metodos invocables desde QML
@@ -111,14 +258,129 @@ public:
     // =========================================================================
     Q_INVOKABLE void sendRawHex(const QString &hexString);
 
+    // =========================================================================
+    // sendBurst() — Enviar una rafaga de tramas (load testing)
+    // =========================================================================
+    // Codifica el mensaje UNA vez como plantilla y lo replica 'count' veces
+    // en un buffer contiguo (arena), cambiando solo el sequenceNum. Despues
+    // envia la arena por lotes con UdpTransport::sendDatagrams() (sendmmsg),
+    // o con fanOut() a todos los destinos si hay alguno registrado.
+    //
+    //   rateHz = 0  → lo mas rapido posible, en lotes de
+    //                 kBurstChunkDatagrams por vuelta del event loop
+    //   rateHz > 0  → un temporizador de kBurstTickMs envia en cada tick
+    //                 las tramas que "tocan" para mantener ese ritmo
+    //
+    // Con framesPerDatagram = N > 1 cada vista abarca N tramas consecutivas
+    // de la arena (sin copiar nada): un datagrama empaquetado por vista.
+    //
+    // A diferencia de sendMessage(), NO hay senales por trama: contadores,
+    // lastSentHex y burstSent() se actualizan una vez por tick de UI.
+    // =========================================================================
+    Q_INVOKABLE void sendBurst(int messageId, int presenceMask,
+                               const QVariantList &fieldValues,
+                               int count, int rateHz);
+
+    // =========================================================================
+    // startCapture() / stopCapture() — Grabar lo recibido en capturePath
+    // =========================================================================
+    // Cada datagrama recibido (por cualquiera de los caminos de recepcion)
+    // se anade al pcap con su timestamp de llegada. PcapWriter acumula en
+    // memoria y escribe por bloques; stopCapture() vuelca lo pendiente.
+    // Si el fichero ya existe y es compatible, se continua al final.
+    // =========================================================================
+    Q_INVOKABLE bool startCapture();
+    Q_INVOKABLE void stopCapture();
+
+    // =========================================================================
+    // startReplay() — Reenviar una captura pcap a sendPort
+    // =========================================================================
+    // speed = 1.0 ritmo original, N = N veces mas rapido, 0 = sin esperas.
+    // La captura se mapea en memoria y se envia sin copiar los payloads.
+    // Al terminar (o con stopReplay()) se emite replayFinished().
+    // =========================================================================
+    Q_INVOKABLE bool startReplay(const QString &path, double speed);
+    Q_INVOKABLE void stopReplay();
+
+    // Cancelar la rafaga en curso (las tramas ya enviadas cuentan)
+    Q_INVOKABLE void stopBurst();
+
+    // =========================================================================
+    // Destinos de fan-out
+    // =========================================================================
+    // addDestination("239.1.2.3", 5000) o ("127.0.0.1", 5002). Solo IPv4.
+    // Retorna false si la direccion no es valida o el puerto es 0.
+    // Afecta a sendMessage(), sendRawHex() y sendBurst(); el replay de
+    // capturas sigue yendo a sendPort.
+    // =========================================================================
+    Q_INVOKABLE bool addDestination(const QString &address, int port);
+    Q_INVOKABLE void removeDestination(int index);
+    Q_INVOKABLE void clearDestinations();
+    Q_INVOKABLE void resetDestinationCounters();
+
     // =========================================================================
     // getFieldDefinitions() — Obtener tabla de campos para la UI
     // =========================================================================
-    // Retorna un QVariantList con un QVariantMap por campo:
-    //   [{name: "Latitude", sizeBytes: 4}, {name: "Longitude", sizeBytes: 4}, ...]
+    // Retorna un QVariantList con un QVariantMap por campo del plan de
+    // 'messageId' (la telemetria si no esta en el catalogo):
+    //   [{name: "Latitude", sizeBytes: 4, type: "float32"}, ...]
     // QML usa esto para generar los checkboxes y editores de campo.
     // =========================================================================
-    Q_INVOKABLE QVariantList getFieldDefinitions() const;
+    Q_INVOKABLE QVariantList getFieldDefinitions(int messageId = 0) const;
+
+    // =========================================================================
+    // loadCatalog() — Reemplazar el catalogo de mensajes
+    // =========================================================================
+    // Lee un JSON con el formato de stanagcatalog.h. Si no es valido, el
+    // catalogo actual se conserva y el motivo va a statusText. El hilo de
+    // recepcion recibe el nuevo catalogo sin pararse.
+    // =========================================================================
+    Q_INVOKABLE bool loadCatalog(const QString &path);
+
+    // =========================================================================
+    // runDecodeBenchmark() — Comparar decode() vs decodeView()
+    // =========================================================================
+    // Ejecuta StanagBenchmark::compareDecode() de forma sincrona y devuelve
+    // el QVariantMap con tramas/s de cada implementacion y el speedup.
+    // En QML:  var r = controller.runDecodeBenchmark(200000)
+    // =========================================================================
+    Q_INVOKABLE QVariantMap runDecodeBenchmark(int frames);
+
+    // Igual, para el hex dump: StanagBenchmark::compareHexDump()
+    Q_INVOKABLE QVariantMap runHexBenchmark(int frames);
+
+    // Throughput de los kernels de checksum por tamano de trama (13 B a
+    // 64 KB): StanagBenchmark::compareChecksums(). Una fila por tamano.
+    Q_INVOKABLE QVariantList runChecksumBenchmark(int megabytesPerCase);
+
+    // encode / decode / decodeView en tramas/s para 1 a 14 campos activos:
+    // StanagBenchmark::compareMaskDensity(). Una fila por densidad.
+    Q_INVOKABLE QVariantList runDensityBenchmark(int frames);
+
+    // =========================================================================
+    // runFuzzer() — Fuzzing del decode y del parseo de sendRawHex
+    // =========================================================================
+    // StanagFuzzer::run() sincrono: 'iterations' entradas mutadas a partir
+    // de 'seed'. Un fallo se reproduce con la misma semilla, o enviando
+    // firstFailureHex con sendRawHex() a otra instancia.
+    // =========================================================================
+    Q_INVOKABLE QVariantMap runFuzzer(int iterations, int seed);
+
+    // Vaciar el histograma de latencias (p.ej. al cambiar de modo)
+    Q_INVOKABLE void resetLatency();
+
+    // =========================================================================
+    // statsSnapshotJson() — Estadisticas de todos los flujos en JSON
+    // =========================================================================
+    // { "timestampNs": "...", "streams": [ { messageId, sourcePort, frames,
+    //   bytes, framesPerSec, bytesPerSec, lost, outOfOrder, duplicates,
+    //   checksumFailures, meanInterArrivalUs, jitterP50Us, jitterP99Us,
+    //   jitterP999Us, jitterMaxUs }, ... ] }
+    // 'indented' = false → una sola linea (para enviar a un colector).
+    // =========================================================================
+    Q_INVOKABLE QString statsSnapshotJson(bool indented = false);
+
+    Q_INVOKABLE void resetStats();
 
 signals:
     // --- Signals de cambio de propiedad ---
@@ -126,9 +388,29 @@ signals:
     void listenPortChanged();
     void sendPortChanged();
     void statusTextChanged();
+    void batchReceiveChanged();
+    void threadedReceiveChanged();
+    void multicastGroupChanged();
+    void multicastInterfaceChanged();
+    void destinationsChanged();
+    void checksumModeChanged();
+    void peerChecksumModeChanged();
+    void followPeerChecksumChanged();
+    void burstingChanged();
+    void framesPerDatagramChanged();
+    void capturingChanged();
+    void capturePathChanged();
+    void capturedCountChanged();
+    void replayingChanged();
+    void replayProgressChanged();
     void sentCountChanged();
     void receivedCountChanged();
     void errorCountChanged();
+    void droppedCountChanged();
+    void mergedCountChanged();
+    void uiUpdateRateHzChanged();
+    void catalogChanged();
+    void latencyStatsChanged();
     void lastSentHexChanged();
     void lastReceivedHexChanged();
 
@@ -142,11 +424,22 @@ signals:
     void messageSent(const QString &timestamp, const QString &hexDump,
                      int messageId, int fieldCount, int byteSize);
 
-    // Emitida cuando se recibe y decodifica un datagrama
+    // Emitida por la ULTIMA trama decodificada de cada tick de UI
     void messageReceived(const QString &timestamp, const QString &hexDump,
                          int messageId, int sourcePort, int fieldCount,
                          int byteSize, bool checksumOk);
 
+    // Emitida una vez por tick de UI con las tramas de rafaga enviadas en el
+    // intervalo (frameCount) y el total de bytes
+    void burstSent(const QString &timestamp, int messageId, int fieldCount,
+                   int frameCount, int byteSize);
+
+    // Emitida al terminar (o cancelar) una rafaga, con el ritmo conseguido
+    void burstFinished(int framesSent, int elapsedMs, double achievedRateHz);
+
+    // Igual, para el replay de una captura
+    void replayFinished(int framesSent, int elapsedMs, double achievedRateHz);
+
     // Emitida con los campos decodificados del ultimo mensaje recibido
     // QVariantList de QVariantMap: [{index, name, hex, value}, ...]
     void fieldsDecoded(const QVariantList &fields);
@@ -165,27 +458,204 @@ private slots:
     // =========================================================================
     void onDatagramReceived(const QByteArray &data, quint16 senderPort);
 
+    // Version por lotes: conectada a UdpTransport::datagramsReceived cuando
+    // batchReceive esta activo. Procesa cada datagrama del lote sin copiarlo.
+    void onDatagramsReceived(UdpDatagramSpan batch);
+
+    // Error de red de cualquiera de los dos transportes (GUI o worker)
+    void onTransportError(const QString &error);
+
+    // Tick de refresco de UI: vacia la cola del worker y publica lo pendiente
+    void onUiTick();
+
 private:
     // Setters privados para propiedades read-only
     void setStatusText(const QString &text);
     void setBound(bool bound);
 
+    // Enviar a sendPort o, si hay destinos registrados, a todos ellos.
+    // sendFrames() retorna las tramas que llegaron a TODOS los destinos.
+    bool sendFrame(QByteArrayView frame);
+    int sendFrames(const QByteArrayView *frames, int count);
+
+    // Re-bindear si se cambia algo que afecta al bind estando escuchando
+    void rebindIfListening();
+
+    // Bind en el hilo de GUI: unicast a localhost o grupo multicast
+    bool bindTransport();
+
+    // Construir un StanagMessage desde los parametros de QML
+    StanagMessage buildMessage(int messageId, int presenceMask,
+                               const QVariantList &fieldValues);
+
+    // Anadir un datagrama recibido a la captura (si esta activa)
+    void captureDatagram(QByteArrayView data, qsizetype size,
+                         quint16 senderPort, qint64 receivedNs);
+    void onReplayFinished(int framesSent, int elapsedMs, double achievedRateHz);
+
+    // Enviar las tramas de la rafaga que tocan en este tick
+    void sendBurstChunk();
+    void finishBurst();
+    void setBursting(bool bursting);
+
+    // Camino de recepcion en el hilo de GUI (ver .cpp). processFrame()
+    // cuenta una trama (o un error) y la deja pendiente de publicar.
+    void processDatagram(QByteArrayView data, quint16 senderPort, qint64 receivedNs);
+    void processFrame(QByteArrayView data, quint16 senderPort, qint64 receivedNs,
+                      bool decoded, const StanagFrameView &view);
+
+    // Publicar todo lo acumulado desde el ultimo tick (contadores, ultima
+    // trama, ultimo error, rafaga, log). Ver .cpp.
+    void publishPending();
+    // uiUpdateRateHz = 0: un publishPending() encolado por vuelta del
+    // event loop, aunque lleguen muchos datagramas en ella
+    void schedulePublish();
+
+    // Emitir a QML un datagrama ya decodificado (view) o fallido (nullptr)
+    // y anadirlo al log. 'note' se anade al texto de la entrada.
+    void publishReceived(QByteArrayView data, int byteSize, quint16 senderPort,
+                         const StanagFrameView *view, const QString &note);
+
+    // Registrar el modo de checksum de una trama valida del peer (y
+    // adoptarlo si followPeerChecksum esta activo)
+    void notePeerChecksum(StanagChecksumMode mode);
+    // Cambiar el modo sin tocar followPeerChecksum (negociacion)
+    void applyChecksumMode(int mode);
+
+    // Encolar una entrada de log; sin tick de UI activo se publica ya
+    void appendLog(MessageLogModel::Entry entry);
+
+    // Hex dump para el parametro hexDump de una senal, o "" si nadie esta
+    // conectado a ella (QML usa logModel y no necesita la cadena).
+    QString hexForSignal(const QMetaMethod &signal, QByteArrayView bytes) const;
+
+    // --- Hilo de recepcion (threadedReceive) ---
+    bool startReceiveThread();
+    void stopReceiveThread();
+    void drainReceiveQueue();
+    void drainCaptureQueue();
+
+    // Conecta UNA de las dos senales de recepcion segun batchReceive, para
+    // que el shim por datagrama de UdpTransport no duplique el trabajo.
+    void updateReceiveConnection();
+
     // --- Componentes internos ---
     UdpTransport m_transport;       // Capa de transporte UDP
     quint16 m_listenPort = 5000;    // Puerto de escucha por defecto
     quint16 m_sendPort   = 5001;    // Puerto de envio por defecto
     quint16 m_nextSequence = 0;     // Contador de secuencia (auto-incremento)
+    static constexpr int kReceiveBatchSize = 64;  // Datagramas por recvmmsg
     bool m_bound = false;
+    bool m_batchReceive = false;
+    bool m_threadedReceive = false;
+    QString m_multicastGroup;
+    QString m_multicastInterface;
+    quint64 m_publishedDestinationTraffic = 0;   // sent + failed ya publicados
+    StanagChecksumMode m_checksumMode = StanagChecksumMode::Xor8;
+    int m_peerChecksumMode = -1;
+    bool m_followPeerChecksum = false;
+    QMetaObject::Connection m_receiveConnection;
     QString m_statusText{QStringLiteral("Not bound")};
 
     // --- Contadores ---
     int m_sentCount     = 0;
     int m_receivedCount = 0;
     int m_errorCount    = 0;
+    int m_droppedCount  = 0;
+    int m_mergedCount   = 0;
 
     // --- Cache del ultimo mensaje ---
-    QString m_lastSentHex;
-    QString m_lastReceivedHex;
+    QByteArray m_lastSentFrame;
+    QByteArray m_lastReceivedFrame;
+
+    // Senales con parametro hexDump (ver hexForSignal)
+    const QMetaMethod m_messageSentSignal =
+        QMetaMethod::fromSignal(&EthernetController::messageSent);
+    const QMetaMethod m_messageReceivedSignal =
+        QMetaMethod::fromSignal(&EthernetController::messageReceived);
+    const QMetaMethod m_protocolErrorSignal =
+        QMetaMethod::fromSignal(&EthernetController::protocolError);
+
+    // --- Rafaga (sendBurst) ---
+    // m_burstArena guarda todas las tramas seguidas; m_burstFrames son
+    // vistas a cada DATAGRAMA (una trama, o m_burstFramesPerDatagram
+    // seguidas), lo que consume sendmmsg. La arena conserva su capacidad
+    // entre rafagas, asi que rafagas repetidas no reservan memoria.
+    static constexpr int kBurstTickMs = 5;
+    static constexpr int kMaxBurstFrames = 1000000;
+    // Sin ritmo: datagramas por vuelta del event loop (un sendmmsg())
+    static constexpr int kBurstChunkDatagrams = 1024;
+    static constexpr int kMaxFramesPerDatagram = 64;
+    static_assert(kMaxFramesPerDatagram * StanagStreamDecoder::kMaxFrameSize
+                      <= UdpTransport::kBatchSlotSize,
+                  "Un datagrama empaquetado debe caber en un slot de recvmmsg");
+    int m_framesPerDatagram = 1;
+    QTimer m_burstTimer;
+    QElapsedTimer m_burstClock;
+    QByteArray m_burstArena;
+    QList<QByteArrayView> m_burstFrames;
+    bool m_bursting = false;
+    int m_burstSentFrames = 0;
+    int m_burstSentDatagrams = 0;
+    int m_burstFramesPerDatagram = 1;
+    int m_burstFrameSize = 0;
+    int m_burstRateHz = 0;
+    int m_burstMessageId = 0;
+    int m_burstFieldCount = 0;
+
+    // --- Captura y replay ---
+    // m_replay envia por m_transport (declarado antes, vive mas que el).
+    PcapWriter m_capture;
+    QString m_capturePath;
+    int m_publishedCaptured = 0;
+    quint64 m_captureDropped = 0;     // Datagramas que no cupieron en CaptureQueue
+    ReplayEngine m_replay;
+    int m_publishedReplaySent = 0;
+
+    // --- Recepcion en hilo dedicado ---
+    // La cola de tramas (~2 MB) se reserva al arrancar el hilo la primera
+    // vez; la de captura (512 datagramas de kBatchSlotSize, 4 MB) solo al
+    // empezar la primera captura con el hilo activo. Ambas se reutilizan.
+    // El worker vive en m_receiveThread y se destruye con deleteLater al
+    // pararlo.
+    std::unique_ptr<ReceiveQueue> m_receiveQueue;
+    std::unique_ptr<CaptureQueue> m_captureQueue;
+    QThread *m_receiveThread = nullptr;
+    ReceiveWorker *m_receiveWorker = nullptr;
+
+    // --- Refresco de UI y latencia ---
+    int m_uiUpdateRateHz = 60;
+    // Con uiUpdateRateHz = 0 el timer solo vacia la cola del worker y la
+    // captura: no necesita ir mas rapido que la pantalla
+    static constexpr int kPerTurnDrainMs = 16;
+    QTimer m_uiTimer;
+    bool m_publishQueued = false;
+    LatencyHistogram m_latency;
+    bool m_latencyDirty = false;
+    MessageLogModel m_logModel;
+    MessageStatsModel m_statsModel;
+
+    // --- Catalogo de mensajes ---
+    // Inmutable y compartido con el ReceiveWorker; m_packetSplitter guarda
+    // un puntero crudo, por eso se declara antes que el.
+    std::shared_ptr<const StanagCatalog> m_catalog;
+    StanagStreamDecoder m_packetSplitter;   // Datagramas con varias tramas
+
+    // --- Pendiente de publicar en el siguiente tick ---
+    // Solo se conserva la ULTIMA trama valida y el ULTIMO error: copiarlos
+    // (ReceivedFrame, sin memoria dinamica) es mas barato que cualquier
+    // senal. m_pendingReceived/m_pendingErrors cuentan todo lo demas.
+    ReceivedFrame m_pendingFrame;
+    ReceivedFrame m_pendingError;
+    bool m_hasPendingFrame = false;
+    bool m_hasPendingError = false;
+    int m_pendingReceived = 0;
+    int m_pendingErrors = 0;
+
+    // Rafaga: lotes de sendmmsg acumulados hasta el siguiente tick
+    int m_pendingBurstFrames = 0;
+    int m_pendingBurstBytes = 0;
+    QByteArray m_pendingBurstLast;
 };
 
 #endif // ETHERNETCONTROLLER_H
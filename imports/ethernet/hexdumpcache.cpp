@@ -0,0 +1,38 @@
+// =============================================================================
+// hexdumpcache.cpp — Implementacion de la cache LRU de hex dumps
+// =============================================================================
+
+#include "hexdumpcache.h"
+#include "hexformatter.h"
+
+// =============================================================================
+// lookup() — Un recorrido: busca la clave y, a la vez, la victima LRU
+// =============================================================================
+QString HexDumpCache::lookup(quint32 key, const QByteArray &raw)
+{
+    ++m_clock;
+
+    Slot *victim = &m_slots[0];
+    for (Slot &slot : m_slots) {
+        if (slot.lastUse != 0 && slot.key == key && slot.raw == raw) {
+            slot.lastUse = m_clock;
+            ++m_hits;
+            return slot.hex;
+        }
+        if (slot.lastUse < victim->lastUse)
+            victim = &slot;
+    }
+
+    ++m_misses;
+    victim->key = key;
+    victim->lastUse = m_clock;
+    victim->raw = raw;
+    victim->hex = HexFormatter::format(raw);
+    return victim->hex;
+}
+
+void HexDumpCache::clear()
+{
+    m_slots.fill(Slot());
+    m_clock = 0;
+}
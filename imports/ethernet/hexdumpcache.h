@@ -0,0 +1,56 @@
+// =============================================================================
+// hexdumpcache.h — Cache LRU pequena de hex dumps por numero de secuencia
+// =============================================================================
+//
+// El hex dump de una trama solo se genera cuando un delegate de QML lo pide
+// (MessageLogModel::data(HexRole)). Pero un delegate lo vuelve a pedir al
+// hacer scroll, al recrearse o al seleccionar la fila, asi que las ultimas
+// cadenas generadas se guardan aqui.
+//
+// CLAVE: (direccion << 16) | sequenceNum — ver MessageLogModel::hexKey().
+// El sequenceNum da la vuelta cada 65536 tramas, asi que un acierto de clave
+// se CONFIRMA comparando los bytes (<= 47 en STANAG). 'raw' comparte datos
+// con la entrada del log (QByteArray implicitamente compartido): guardarla
+// aqui no copia nada.
+//
+// ESTRUCTURA: array plano de kCapacity huecos con un "reloj" de ultimo uso.
+// Con 64 entradas, recorrerlas entero es mas rapido que mantener un hash +
+// lista enlazada, y no reserva memoria por operacion.
+// =============================================================================
+
+#ifndef HEXDUMPCACHE_H
+#define HEXDUMPCACHE_H
+
+#include <QByteArray>
+#include <QString>
+#include <array>
+
+class HexDumpCache
+{
+public:
+    static constexpr int kCapacity = 64;
+
+    // Hex dump de 'raw', desde la cache o generado (y guardado) ahora
+    QString lookup(quint32 key, const QByteArray &raw);
+
+    void clear();
+
+    quint64 hits() const { return m_hits; }
+    quint64 misses() const { return m_misses; }
+
+private:
+    struct Slot
+    {
+        quint32 key = 0;
+        quint64 lastUse = 0;    // 0 = hueco libre
+        QByteArray raw;
+        QString hex;
+    };
+
+    std::array<Slot, kCapacity> m_slots{};
+    quint64 m_clock = 0;
+    quint64 m_hits = 0;
+    quint64 m_misses = 0;
+};
+
+#endif // HEXDUMPCACHE_H
@@ -0,0 +1,89 @@
+// =============================================================================
+// hexformatter.cpp — Implementacion del formateador hexadecimal
+// =============================================================================
+
+#include "hexformatter.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HEXFORMATTER_SSE2 1
+#endif
+
+namespace {
+
+constexpr char kHexDigits[] = "0123456789ABCDEF";
+
+#ifdef HEXFORMATTER_SSE2
+// 16 nibbles (0..15) → 16 caracteres ASCII '0'..'9','A'..'F'
+inline __m128i nibblesToAscii(__m128i nibbles)
+{
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i gap  = _mm_set1_epi8('A' - '0' - 10);
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, nine), gap);
+    return _mm_add_epi8(_mm_add_epi8(nibbles, zero), letters);
+}
+#endif
+
+} // namespace
+
+// =============================================================================
+// format()
+// =============================================================================
+// Se reservan n * 3 caracteres (cada byte escribe "HL ") y al final se
+// recorta el ultimo espacio: resize() a un tamano menor no reasigna.
+// =============================================================================
+QString HexFormatter::format(QByteArrayView bytes)
+{
+    const qsizetype n = bytes.size();
+    if (n == 0)
+        return QString();
+
+    QString out(n * 3, Qt::Uninitialized);
+    char16_t *dst = reinterpret_cast<char16_t *>(out.data());
+    const uchar *src = reinterpret_cast<const uchar *>(bytes.data());
+    qsizetype i = 0;
+
+#ifdef HEXFORMATTER_SSE2
+    // --- 16 bytes por iteracion ---
+    // hi/lo: nibble alto y bajo de cada byte → ASCII en paralelo.
+    // unpacklo/hi los intercalan en pares "HL" (32 caracteres).
+    const __m128i lowMask = _mm_set1_epi8(0x0F);
+    alignas(16) char pairs[32];
+    for (; i + 16 <= n; i += 16) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i hi = nibblesToAscii(_mm_and_si128(_mm_srli_epi16(in, 4), lowMask));
+        const __m128i lo = nibblesToAscii(_mm_and_si128(in, lowMask));
+        _mm_store_si128(reinterpret_cast<__m128i *>(pairs), _mm_unpacklo_epi8(hi, lo));
+        _mm_store_si128(reinterpret_cast<__m128i *>(pairs + 16), _mm_unpackhi_epi8(hi, lo));
+
+        for (int k = 0; k < 32; k += 2) {
+            dst[0] = char16_t(pairs[k]);
+            dst[1] = char16_t(pairs[k + 1]);
+            dst[2] = u' ';
+            dst += 3;
+        }
+    }
+#endif
+
+    // --- Resto (o todo, sin SSE2) ---
+    for (; i < n; ++i) {
+        dst[0] = char16_t(kHexDigits[src[i] >> 4]);
+        dst[1] = char16_t(kHexDigits[src[i] & 0x0F]);
+        dst[2] = u' ';
+        dst += 3;
+    }
+
+    out.resize(n * 3 - 1);
+    return out;
+}
+
+// =============================================================================
+// parse()
+// =============================================================================
+QByteArray HexFormatter::parse(const QString &text)
+{
+    QString clean = text;
+    clean.remove(QLatin1Char(' '));
+    return QByteArray::fromHex(clean.toLatin1());
+}
@@ -0,0 +1,40 @@
+// =============================================================================
+// hexformatter.h — Hex dump "0A FF 12" en una sola pasada
+// =============================================================================
+//
+// PATRON: Clase utilitaria con metodos estaticos (igual que StanagCodec).
+//
+// Sustituye al idiom QString::fromLatin1(bytes.toHex(' ')).toUpper(), que
+// hace 3 pasadas y 2 reservas de memoria (QByteArray intermedio + QString)
+// mas una tercera en toUpper(). format() reserva el QString final UNA vez
+// y escribe directamente sus char16_t.
+//
+// Con SSE2 (siempre disponible en x86-64) la conversion nibble → ASCII se
+// hace de 16 en 16 bytes sin ramas:
+//
+//   ascii = nibble + '0' + (nibble > 9 ? 'A' - '0' - 10 : 0)
+//
+// El resto de bytes (o toda la entrada sin SSE2) usa una tabla "0123...F".
+// Ambos caminos producen exactamente el mismo texto.
+// =============================================================================
+
+#ifndef HEXFORMATTER_H
+#define HEXFORMATTER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QString>
+
+class HexFormatter
+{
+public:
+    // Bytes → "0A FF 12" (mayusculas, separados por espacio). Vacio → "".
+    static QString format(QByteArrayView bytes);
+
+    // "0A FF 12" → bytes. Es la conversion de sendRawHex(): se quitan los
+    // espacios y QByteArray::fromHex() ignora cualquier otro caracter no
+    // hex. Inversa exacta de format(): parse(format(b)) == b.
+    static QByteArray parse(const QString &text);
+};
+
+#endif // HEXFORMATTER_H
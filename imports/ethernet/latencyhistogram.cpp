@@ -0,0 +1,60 @@
+// =============================================================================
+// latencyhistogram.cpp — Implementacion del histograma de latencias
+// =============================================================================
+
+#include "latencyhistogram.h"
+#include <QVariantList>
+#include <QtCore/qalgorithms.h>
+
+void LatencyHistogram::record(qint64 latencyNs)
+{
+    const quint64 us = latencyNs > 0 ? quint64(latencyNs) / 1000 : 0;
+    ++m_buckets[std::size_t(Buckets::index(us))];
+    ++m_count;
+    m_maxUs = qMax(m_maxUs, qint64(us));
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+    m_maxUs = 0;
+}
+
+// =============================================================================
+// percentileUs() — Recorrer las cubetas hasta acumular el rango pedido
+// =============================================================================
+qint64 LatencyHistogram::percentileUs(double percentile) const
+{
+    return Buckets::percentile(m_buckets, m_count, m_maxUs, percentile);
+}
+
+QVariantMap LatencyHistogram::toVariantMap() const
+{
+    QVariantMap result;
+    result[QStringLiteral("samples")] = double(m_count);
+    result[QStringLiteral("p50Us")] = double(percentileUs(50.0));
+    result[QStringLiteral("p90Us")] = double(percentileUs(90.0));
+    result[QStringLiteral("p99Us")] = double(percentileUs(99.0));
+    result[QStringLiteral("p999Us")] = double(percentileUs(99.9));
+    result[QStringLiteral("maxUs")] = double(m_maxUs);
+
+    // --- Agrupar por potencias de 2 para el grafico de barras ---
+    const int topOctave = m_maxUs > 0 ? 63 - qCountLeadingZeroBits(quint64(m_maxUs)) : 0;
+    QList<quint64> octaves(topOctave + 1, 0);
+    for (int i = 0; i < Buckets::kBucketCount; ++i) {
+        const quint64 n = m_buckets[std::size_t(i)];
+        if (n == 0)
+            continue;
+        const quint64 lower = Buckets::lower(i);
+        const int octave = lower > 0 ? 63 - qCountLeadingZeroBits(lower) : 0;
+        octaves[qMin(octave, topOctave)] += n;
+    }
+
+    QVariantList octaveList;
+    octaveList.reserve(octaves.size());
+    for (quint64 n : octaves)
+        octaveList.append(double(n));
+    result[QStringLiteral("octaves")] = octaveList;
+    return result;
+}
@@ -0,0 +1,63 @@
+// =============================================================================
+// latencyhistogram.h — Histograma de latencias log-lineal (estilo HDR)
+// =============================================================================
+//
+// PATRON: Histograma de cubetas fijas. Registrar una muestra es O(1) y no
+// reserva memoria: calcular el indice de cubeta + incrementar un contador.
+//
+// CUBETAS (en microsegundos):
+//   0..15 us       → una cubeta por microsegundo (exactas)
+//   >= 16 us       → cada potencia de 2 se divide en 8 sub-cubetas iguales
+//                    (error relativo maximo de 1/8 = 12.5%)
+//
+// Asi el mismo array de 240 contadores cubre desde 1 us hasta ~35 minutos
+// con precision relativa constante, que es lo que importa en latencias:
+// distinguir 10 us de 11 us, y 10 ms de 11 ms, pero no 10.000 de 10.001 us.
+//
+// Los percentiles se calculan recorriendo las cubetas y devuelven el limite
+// SUPERIOR de la cubeta (estimacion pesimista). La aritmetica de cubetas es
+// la de LogLinearBuckets (imports/common), compartida con StageHistogram.
+//
+// NO es thread-safe: cada histograma pertenece a un solo hilo.
+// =============================================================================
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QVariantMap>
+#include <QtGlobal>
+#include "loglinearbuckets.h"
+
+class LatencyHistogram
+{
+public:
+    // Registrar una latencia en nanosegundos (negativas cuentan como 0)
+    void record(qint64 latencyNs);
+
+    void reset();
+
+    quint64 count() const { return m_count; }
+    qint64 maxUs() const { return m_maxUs; }
+
+    // Percentil en [0, 100] → microsegundos (limite superior de su cubeta)
+    qint64 percentileUs(double percentile) const;
+
+    // =========================================================================
+    // toVariantMap() — Resumen para QML
+    // =========================================================================
+    //   { samples, p50Us, p90Us, p99Us, p999Us, maxUs,
+    //     octaves: [n0, n1, ...] }   // octaves[k] = muestras en [2^k, 2^(k+1)) us
+    // 'octaves' agrupa las cubetas finas por potencias de 2 para dibujar
+    // un grafico de barras compacto.
+    // =========================================================================
+    QVariantMap toVariantMap() const;
+
+private:
+    using Buckets = LogLinearBuckets<32>;     // hasta 2^32 us
+
+    Buckets::Counts m_buckets{};
+    quint64 m_count = 0;
+    qint64 m_maxUs = 0;
+};
+
+#endif // LATENCYHISTOGRAM_H
@@ -0,0 +1,188 @@
+// =============================================================================
+// messagelogmodel.cpp — Implementacion del log en ring buffer
+// =============================================================================
+
+#include "messagelogmodel.h"
+#include "hexformatter.h"
+#include <QDateTime>
+#include <iterator>
+
+MessageLogModel::MessageLogModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_ring(std::size_t(kDefaultCapacity))
+{
+}
+
+int MessageLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_size;
+}
+
+int MessageLogModel::count() const { return m_size; }
+int MessageLogModel::capacity() const { return int(m_ring.size()); }
+bool MessageLogModel::hasPending() const { return !m_pending.empty(); }
+
+const MessageLogModel::Entry &MessageLogModel::entryAt(int row) const
+{
+    const int capacity = int(m_ring.size());
+    return m_ring[std::size_t((m_head - 1 - row + capacity) % capacity)];
+}
+
+// =============================================================================
+// data() — Formateo perezoso: solo para filas que QML pide
+// =============================================================================
+QVariant MessageLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_size)
+        return {};
+
+    const Entry &entry = entryAt(index.row());
+    switch (role) {
+    case TimeRole:
+        return QDateTime::fromMSecsSinceEpoch(entry.timestampMs)
+            .toString(QStringLiteral("hh:mm:ss.zzz"));
+    case DirectionRole:
+        switch (entry.direction) {
+        case Direction::Sent:     return QStringLiteral("sent");
+        case Direction::Received: return QStringLiteral("received");
+        case Direction::Burst:    return QStringLiteral("burst");
+        case Direction::Error:    return QStringLiteral("error");
+        }
+        return {};
+    case MsgIdRole:
+        return int(entry.messageId);
+    case FieldsRole:
+        return entry.fieldCount;
+    case SizeRole:
+        return entry.byteSize;
+    case HexRole:
+        return hexFor(entry);
+    case ChecksumOkRole:
+        return entry.checksumOk;
+    case ErrorTextRole:
+        return entry.text;
+    default:
+        return {};
+    }
+}
+
+// =============================================================================
+// hexFor() — Hex dump bajo demanda
+// =============================================================================
+// Clave de cache: (direccion << 16) | sequenceNum. La direccion evita que la
+// trama enviada y su eco recibido (mismo sequenceNum en loopback) se pisen.
+// Las entradas sin secuencia (errores, hex crudo) se formatean sin cache.
+// =============================================================================
+QString MessageLogModel::hexFor(const Entry &entry) const
+{
+    if (!entry.hasSequence)
+        return HexFormatter::format(entry.raw);
+
+    const quint32 key = (quint32(entry.direction) << 16) | entry.sequenceNum;
+    return m_hexCache.lookup(key, entry.raw);
+}
+
+QHash<int, QByteArray> MessageLogModel::roleNames() const
+{
+    return {
+        { TimeRole,       "time" },
+        { DirectionRole,  "direction" },
+        { MsgIdRole,      "msgId" },
+        { FieldsRole,     "fields" },
+        { SizeRole,       "size" },
+        { HexRole,        "hex" },
+        { ChecksumOkRole, "checksumOk" },
+        { ErrorTextRole,  "errorText" }
+    };
+}
+
+void MessageLogModel::append(Entry entry)
+{
+    m_pending.push_back(std::move(entry));
+}
+
+// =============================================================================
+// flush() — Publicar las entradas encoladas en bloque
+// =============================================================================
+// 1. Si lo nuevo + lo visible supera la capacidad, se quitan primero las
+//    filas mas antiguas (las ultimas) con un solo beginRemoveRows(). Basta
+//    con reducir m_size: sus huecos son justo los que se van a sobrescribir.
+// 2. Las nuevas se escriben en orden cronologico (la ultima queda en la
+//    fila 0) con un solo beginInsertRows(0, n - 1).
+// =============================================================================
+void MessageLogModel::flush()
+{
+    if (m_pending.empty())
+        return;
+
+    const int capacity = int(m_ring.size());
+    const int previousSize = m_size;
+
+    // Si llego mas de lo que cabe, solo sobreviven las 'capacity' ultimas
+    auto first = m_pending.begin();
+    if (int(m_pending.size()) > capacity)
+        first = m_pending.end() - capacity;
+    const int incoming = int(std::distance(first, m_pending.end()));
+
+    const int overflow = m_size + incoming - capacity;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), m_size - overflow, m_size - 1);
+        m_size -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), 0, incoming - 1);
+    for (auto it = first; it != m_pending.end(); ++it) {
+        m_ring[std::size_t(m_head)] = std::move(*it);
+        m_head = (m_head + 1) % capacity;
+    }
+    m_size += incoming;
+    endInsertRows();
+
+    m_pending.clear();   // Conserva la capacidad del vector
+    if (m_size != previousSize)
+        emit countChanged();
+}
+
+// =============================================================================
+// setCapacity() — Redimensionar conservando las entradas mas recientes
+// =============================================================================
+void MessageLogModel::setCapacity(int capacity)
+{
+    capacity = qMax(1, capacity);
+    if (capacity == int(m_ring.size()))
+        return;
+
+    const int oldCapacity = int(m_ring.size());
+    const int keep = qMin(m_size, capacity);
+    std::vector<Entry> ring(std::size_t(capacity));
+    for (int row = keep - 1, slot = 0; row >= 0; --row, ++slot) {
+        const int from = (m_head - 1 - row + oldCapacity) % oldCapacity;
+        ring[std::size_t(slot)] = std::move(m_ring[std::size_t(from)]);
+    }
+
+    beginResetModel();
+    const int previousSize = m_size;
+    m_ring = std::move(ring);
+    m_head = keep % capacity;
+    m_size = keep;
+    endResetModel();
+
+    emit capacityChanged();
+    if (m_size != previousSize)
+        emit countChanged();
+}
+
+void MessageLogModel::clear()
+{
+    m_pending.clear();
+    m_hexCache.clear();
+    if (m_size == 0)
+        return;
+
+    beginResetModel();
+    m_size = 0;
+    m_head = 0;
+    endResetModel();
+    emit countChanged();
+}
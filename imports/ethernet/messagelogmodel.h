@@ -0,0 +1,112 @@
+// =============================================================================
+// messagelogmodel.h — Log de protocolo como QAbstractListModel (ring buffer)
+// =============================================================================
+//
+// Sustituye al ListModel de QML que se rellenaba con logModel.insert(0, ...)
+// desde los handlers de senales: una llamada JS + un insert por mensaje.
+//
+// PATRON: Ring buffer de capacidad fija + insercion por lotes.
+//   - append() solo encola la entrada en m_pending (sin senales de modelo).
+//   - flush() publica TODO lo pendiente con UN beginInsertRows() y, si se
+//     supera la capacidad, UN beginRemoveRows() de las mas antiguas.
+//   EthernetController llama a flush() una vez por tick de UI, asi que el
+//   coste para QML es por refresco, no por mensaje.
+//
+// ORDEN: la fila 0 es la entrada MAS RECIENTE (igual que el log anterior).
+//   fila r → hueco fisico (m_head - 1 - r) mod capacidad
+//
+// Las entradas guardan los bytes crudos; el texto "hh:mm:ss.zzz" y el hex
+// dump se generan en data(), es decir, solo para las filas que un delegate
+// esta mostrando. Los hex dumps de tramas con sequenceNum pasan ademas por
+// una HexDumpCache (LRU de 64) para no regenerarlos en cada scroll.
+//
+// ROLES (mismos nombres que el ListModel anterior, los delegates no cambian):
+//   time, direction, msgId, fields, size, hex, checksumOk, errorText
+// =============================================================================
+
+#ifndef MESSAGELOGMODEL_H
+#define MESSAGELOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QByteArray>
+#include <QtQml/qqmlregistration.h>
+#include <vector>
+#include "hexdumpcache.h"
+
+class MessageLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("MessageLogModel is provided by EthernetController.logModel")
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+
+public:
+    enum class Direction : quint8 { Sent, Received, Burst, Error };
+
+    // Una fila del log. 'text' es el mensaje de error, o una nota
+    // ("1000 frames", "+57 merged") segun la direccion.
+    struct Entry
+    {
+        qint64 timestampMs = 0;     // QDateTime::currentMSecsSinceEpoch()
+        Direction direction = Direction::Received;
+        quint16 messageId = 0;
+        int fieldCount = 0;
+        int byteSize = 0;
+        bool checksumOk = true;
+        bool hasSequence = false;   // true → el hex se cachea por sequenceNum
+        quint16 sequenceNum = 0;
+        QString text;
+        QByteArray raw;             // Trama (el hex se genera en data())
+    };
+
+    enum Roles {
+        TimeRole = Qt::UserRole + 1,
+        DirectionRole,
+        MsgIdRole,
+        FieldsRole,
+        SizeRole,
+        HexRole,
+        ChecksumOkRole,
+        ErrorTextRole
+    };
+
+    explicit MessageLogModel(QObject *parent = nullptr);
+
+    // ─── QAbstractListModel ─────────────────────────────────────────
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // ─── Alimentacion desde C++ ─────────────────────────────────────
+    void append(Entry entry);   // Encola (sin senales de modelo)
+    void flush();               // Publica lo encolado (una vez por tick)
+    bool hasPending() const;
+
+    int count() const;
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    Q_INVOKABLE void clear();
+
+    static constexpr int kDefaultCapacity = 1000;
+
+signals:
+    void countChanged();
+    void capacityChanged();
+
+private:
+    const Entry &entryAt(int row) const;
+    QString hexFor(const Entry &entry) const;
+
+    std::vector<Entry> m_ring;      // capacity huecos, se reutilizan
+    int m_head = 0;                 // Siguiente hueco a escribir
+    int m_size = 0;                 // Filas visibles
+    std::vector<Entry> m_pending;   // Encoladas desde el ultimo flush()
+
+    // data() es const pero la cache se actualiza al consultarla
+    mutable HexDumpCache m_hexCache;
+};
+
+#endif // MESSAGELOGMODEL_H
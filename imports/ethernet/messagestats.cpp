@@ -0,0 +1,124 @@
+// =============================================================================
+// messagestats.cpp — Implementacion de StreamStats
+// =============================================================================
+
+#include "messagestats.h"
+#include <cstdlib>
+
+void StreamStats::record(quint16 sequenceNum, int byteSize, bool checksumOk,
+                         qint64 receivedNs)
+{
+    frames++;
+    bytes += quint64(qMax(byteSize, 0));
+
+    // --- Ritmo ---
+    if (m_windowStartNs == 0)
+        m_windowStartNs = receivedNs;
+    rollRateWindow(receivedNs);
+    m_windowFrames++;
+    m_windowBytes += quint64(qMax(byteSize, 0));
+
+    // --- Tiempo entre llegadas y jitter ---
+    if (m_lastArrivalNs != 0) {
+        const qint64 interArrival = qMax<qint64>(receivedNs - m_lastArrivalNs, 0);
+        if (m_lastInterArrivalNs >= 0) {
+            jitter.record(std::llabs(interArrival - m_lastInterArrivalNs));
+            meanInterArrivalNs += (interArrival - meanInterArrivalNs) / 16.0;
+        } else {
+            meanInterArrivalNs = double(interArrival);
+        }
+        m_lastInterArrivalNs = interArrival;
+    }
+    m_lastArrivalNs = receivedNs;
+
+    // --- Checksum / secuencia ---
+    if (!checksumOk) {
+        checksumFailures++;
+        return;
+    }
+    trackSequence(sequenceNum);
+}
+
+// =============================================================================
+// trackSequence() — Huecos, desorden y duplicados en O(1)
+// =============================================================================
+// 'ahead' es la distancia con signo (16 bits, con vuelta) al mayor numero
+// visto:
+//   ahead > 0  → avanza: se pierden ahead-1 numeros (por ahora), la
+//                ventana se desplaza y se marca el nuevo
+//   ahead <= 0 → llega tarde. Si cae dentro de la ventana y su bit ya esta
+//                marcado es un duplicado; si no, es una trama desordenada
+//                que rellena un hueco contado antes como perdido.
+// =============================================================================
+void StreamStats::trackSequence(quint16 sequenceNum)
+{
+    if (!m_hasSequence) {
+        m_hasSequence = true;
+        m_highestSeq = sequenceNum;
+        m_seenWindow = 1;
+        return;
+    }
+
+    const int ahead = qint16(quint16(sequenceNum - m_highestSeq));
+    if (ahead > 0) {
+        lost += quint64(ahead - 1);
+        m_seenWindow = (ahead >= kSequenceWindow) ? 0 : (m_seenWindow << ahead);
+        m_seenWindow |= 1;
+        m_highestSeq = sequenceNum;
+        return;
+    }
+
+    const int behind = -ahead;
+    if (behind >= kResyncDistance) {
+        // Salto enorme hacia atras: el emisor reinicio su contador
+        m_highestSeq = sequenceNum;
+        m_seenWindow = 1;
+        return;
+    }
+
+    if (behind < kSequenceWindow) {
+        const quint64 bit = quint64(1) << behind;
+        if (m_seenWindow & bit) {
+            duplicates++;
+            return;
+        }
+        m_seenWindow |= bit;
+    }
+    outOfOrder++;
+    if (lost > 0)
+        lost--;
+}
+
+void StreamStats::rollRateWindow(qint64 nowNs)
+{
+    const qint64 elapsed = nowNs - m_windowStartNs;
+    if (m_windowStartNs == 0 || elapsed < kRateWindowNs)
+        return;
+
+    framesPerSec = m_windowFrames * 1e9 / elapsed;
+    bytesPerSec = m_windowBytes * 1e9 / elapsed;
+    m_windowStartNs = nowNs;
+    m_windowFrames = 0;
+    m_windowBytes = 0;
+}
+
+QJsonObject StreamStats::toJson() const
+{
+    QJsonObject json;
+    json[QStringLiteral("messageId")] = messageId;
+    json[QStringLiteral("sourcePort")] = sourcePort;
+    json[QStringLiteral("frames")] = double(frames);
+    json[QStringLiteral("bytes")] = double(bytes);
+    json[QStringLiteral("framesPerSec")] = framesPerSec;
+    json[QStringLiteral("bytesPerSec")] = bytesPerSec;
+    json[QStringLiteral("lost")] = double(lost);
+    json[QStringLiteral("outOfOrder")] = double(outOfOrder);
+    json[QStringLiteral("duplicates")] = double(duplicates);
+    json[QStringLiteral("checksumFailures")] = double(checksumFailures);
+    json[QStringLiteral("meanInterArrivalUs")] = meanInterArrivalNs / 1000.0;
+    json[QStringLiteral("jitterP50Us")] = double(jitter.percentileUs(50.0));
+    json[QStringLiteral("jitterP99Us")] = double(jitter.percentileUs(99.0));
+    json[QStringLiteral("jitterP999Us")] = double(jitter.percentileUs(99.9));
+    json[QStringLiteral("jitterMaxUs")] = double(jitter.maxUs());
+    return json;
+}
@@ -0,0 +1,84 @@
+// =============================================================================
+// messagestats.h — Estadisticas incrementales de un flujo STANAG
+// =============================================================================
+//
+// Un "flujo" es el par (messageId, sourcePort) del header: un emisor
+// mandando un tipo de mensaje. StreamStats acumula todo lo que interesa
+// vigilar de ese flujo y se actualiza en O(1) por trama, sin memoria
+// dinamica despues de crearse:
+//
+//   - Ritmo: tramas/s y bytes/s en ventanas de 1 segundo.
+//   - Secuencia (sequenceNum, 16 bits con vuelta):
+//       lost        → huecos: tramas que se saltaron
+//       outOfOrder  → llegaron despues de una posterior (rellenan un hueco)
+//       duplicates  → sequenceNum ya visto
+//     Se distinguen con una ventana de bits de los ultimos 64 numeros
+//     (el mismo esquema que el anti-replay de IPsec): bit k = "visto
+//     highestSeq - k". Un salto hacia atras de mas de kResyncDistance se
+//     trata como reinicio del emisor: se resincroniza sin contar nada.
+//   - Checksum: tramas que decodifican pero con checksum invalido. No
+//     participan en la secuencia (el propio sequenceNum podria estar mal).
+//   - Jitter: |IAT(n) - IAT(n-1)|, siendo IAT el tiempo entre llegadas.
+//     Se registra en un LatencyHistogram para dar p50/p99/p99.9.
+//
+// Los timestamps son los de UdpTransport (ns de reloj de pared; los del
+// kernel en modo batch), asi que el jitter no incluye la espera en la GUI.
+// =============================================================================
+
+#ifndef MESSAGESTATS_H
+#define MESSAGESTATS_H
+
+#include <QJsonObject>
+#include <QtGlobal>
+#include "latencyhistogram.h"
+
+struct StreamStats
+{
+    static constexpr int kSequenceWindow = 64;
+    static constexpr int kResyncDistance = 1024;
+    static constexpr qint64 kRateWindowNs = 1000000000;
+
+    quint16 messageId = 0;
+    quint16 sourcePort = 0;
+
+    // --- Contadores ---
+    quint64 frames = 0;
+    quint64 bytes = 0;
+    quint64 checksumFailures = 0;
+    quint64 lost = 0;
+    quint64 outOfOrder = 0;
+    quint64 duplicates = 0;
+
+    // --- Ritmo (ultima ventana completa) ---
+    double framesPerSec = 0.0;
+    double bytesPerSec = 0.0;
+
+    // --- Tiempos entre llegadas ---
+    double meanInterArrivalNs = 0.0;    // Media movil exponencial (1/16)
+    LatencyHistogram jitter;
+
+    // Registrar una trama decodificada de este flujo
+    void record(quint16 sequenceNum, int byteSize, bool checksumOk, qint64 receivedNs);
+
+    // Cerrar la ventana de ritmo si ya paso 1 s (un flujo que deja de
+    // recibir baja a 0 en vez de quedarse con el ultimo valor)
+    void rollRateWindow(qint64 nowNs);
+
+    QJsonObject toJson() const;
+
+private:
+    void trackSequence(quint16 sequenceNum);
+
+    bool m_hasSequence = false;
+    quint16 m_highestSeq = 0;
+    quint64 m_seenWindow = 0;
+
+    qint64 m_lastArrivalNs = 0;
+    qint64 m_lastInterArrivalNs = -1;
+
+    qint64 m_windowStartNs = 0;
+    quint64 m_windowFrames = 0;
+    quint64 m_windowBytes = 0;
+};
+
+#endif // MESSAGESTATS_H
@@ -0,0 +1,164 @@
+// =============================================================================
+// messagestatsmodel.cpp — Implementacion de la tabla de estadisticas
+// =============================================================================
+
+#include "messagestatsmodel.h"
+#include "stanagmessage.h"
+#include <QJsonArray>
+
+MessageStatsModel::MessageStatsModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+int MessageStatsModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_visibleRows;
+}
+
+int MessageStatsModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+int MessageStatsModel::streamCount() const { return m_visibleRows; }
+
+QVariant MessageStatsModel::data(const QModelIndex &index, int role) const
+{
+    if (role != Qt::DisplayRole || !index.isValid() || index.row() >= m_visibleRows)
+        return {};
+
+    const StreamStats &s = m_streams[std::size_t(index.row())];
+    switch (index.column()) {
+    case MessageIdColumn:        return int(s.messageId);
+    case SourcePortColumn:       return int(s.sourcePort);
+    case FramesColumn:           return double(s.frames);
+    case FramesPerSecColumn:     return s.framesPerSec;
+    case BytesPerSecColumn:      return s.bytesPerSec;
+    case LostColumn:             return double(s.lost);
+    case OutOfOrderColumn:       return double(s.outOfOrder);
+    case DuplicatesColumn:       return double(s.duplicates);
+    case ChecksumFailuresColumn: return double(s.checksumFailures);
+    case JitterP50Column:        return double(s.jitter.percentileUs(50.0));
+    case JitterP99Column:        return double(s.jitter.percentileUs(99.0));
+    default:                     return {};
+    }
+}
+
+QVariant MessageStatsModel::headerData(int section, Qt::Orientation orientation,
+                                       int role) const
+{
+    if (role != Qt::DisplayRole || orientation != Qt::Horizontal)
+        return {};
+
+    switch (section) {
+    case MessageIdColumn:        return QStringLiteral("MsgId");
+    case SourcePortColumn:       return QStringLiteral("Src");
+    case FramesColumn:           return QStringLiteral("Frames");
+    case FramesPerSecColumn:     return QStringLiteral("Msg/s");
+    case BytesPerSecColumn:      return QStringLiteral("Bytes/s");
+    case LostColumn:             return QStringLiteral("Lost");
+    case OutOfOrderColumn:       return QStringLiteral("OOO");
+    case DuplicatesColumn:       return QStringLiteral("Dup");
+    case ChecksumFailuresColumn: return QStringLiteral("Bad CRC");
+    case JitterP50Column:        return QStringLiteral("Jit p50");
+    case JitterP99Column:        return QStringLiteral("Jit p99");
+    default:                     return {};
+    }
+}
+
+QHash<int, QByteArray> MessageStatsModel::roleNames() const
+{
+    return { { Qt::DisplayRole, "display" } };
+}
+
+// =============================================================================
+// record() — Una trama, O(1)
+// =============================================================================
+// Un flujo nuevo se anade al final de m_streams pero NO es visible hasta el
+// siguiente refresh() (rowCount devuelve m_visibleRows). Asi QML nunca ve
+// filas a medio insertar y el coste de beginInsertRows es por tick.
+// =============================================================================
+void MessageStatsModel::record(const StanagFrameView &view, int byteSize,
+                               qint64 receivedNs)
+{
+    const quint32 key = (quint32(view.messageId) << 16) | view.sourcePort;
+
+    int row = m_lastRow;
+    if (row < 0 || key != m_lastKey) {
+        const auto it = m_index.constFind(key);
+        if (it != m_index.cend()) {
+            row = it.value();
+        } else {
+            row = int(m_streams.size());
+            m_streams.emplace_back();
+            m_streams.back().messageId = view.messageId;
+            m_streams.back().sourcePort = view.sourcePort;
+            m_index.insert(key, row);
+        }
+        m_lastKey = key;
+        m_lastRow = row;
+    }
+
+    m_streams[std::size_t(row)].record(view.sequenceNum, byteSize,
+                                       view.checksumValid, receivedNs);
+    m_dirty = true;
+}
+
+// =============================================================================
+// refresh() — Publicar a la vista (una vez por tick de UI)
+// =============================================================================
+// Tambien cierra las ventanas de ritmo de los flujos que han dejado de
+// recibir: por eso hay dataChanged aunque no haya llegado nada nuevo
+// mientras algun flujo tenga ritmo > 0.
+// =============================================================================
+void MessageStatsModel::refresh(qint64 nowNs)
+{
+    bool ratesChanged = false;
+    for (StreamStats &s : m_streams) {
+        const double before = s.framesPerSec;
+        s.rollRateWindow(nowNs);
+        ratesChanged |= (s.framesPerSec != before);
+    }
+
+    const int total = int(m_streams.size());
+    if (total > m_visibleRows) {
+        beginInsertRows(QModelIndex(), m_visibleRows, total - 1);
+        m_visibleRows = total;
+        endInsertRows();
+        emit streamCountChanged();
+    }
+
+    if ((m_dirty || ratesChanged) && m_visibleRows > 0)
+        emit dataChanged(index(0, 0), index(m_visibleRows - 1, ColumnCount - 1),
+                         { Qt::DisplayRole });
+    m_dirty = false;
+}
+
+QJsonObject MessageStatsModel::toJson(qint64 nowNs)
+{
+    QJsonArray streams;
+    for (StreamStats &s : m_streams) {
+        s.rollRateWindow(nowNs);
+        streams.append(s.toJson());
+    }
+
+    // Como cadena: un double de JSON solo tiene 53 bits de mantisa y los ns
+    // desde epoch no caben sin perder precision
+    QJsonObject json;
+    json[QStringLiteral("timestampNs")] = QString::number(nowNs);
+    json[QStringLiteral("streams")] = streams;
+    return json;
+}
+
+void MessageStatsModel::clear()
+{
+    beginResetModel();
+    m_streams.clear();
+    m_index.clear();
+    m_visibleRows = 0;
+    m_lastRow = -1;
+    m_dirty = false;
+    endResetModel();
+    emit streamCountChanged();
+}
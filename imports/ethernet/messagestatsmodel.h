@@ -0,0 +1,100 @@
+// =============================================================================
+// messagestatsmodel.h — Estadisticas por flujo (messageId, sourcePort)
+// =============================================================================
+//
+// PATRON: QAbstractTableModel alimentado desde C++ con publicacion por
+// lotes (igual que MessageLogModel):
+//   - record() se llama por CADA trama recibida. Busca el flujo y actualiza
+//     su StreamStats (O(1), sin senales de modelo).
+//   - refresh() se llama una vez por tick de UI: inserta las filas de los
+//     flujos nuevos y emite UN dataChanged para toda la tabla.
+//
+// BUSQUEDA DEL FLUJO: clave (messageId << 16) | sourcePort en un QHash que
+// da el indice en m_streams (vector contiguo). Como las tramas de un mismo
+// flujo suelen llegar seguidas, se recuerda el ultimo (clave, indice) y en
+// el caso comun ni siquiera se consulta el hash.
+//
+// COLUMNAS (DisplayRole; headerData() da los titulos):
+//   MsgId | Src | Frames | Msg/s | Bytes/s | Lost | OOO | Dup | Bad CRC |
+//   Jitter p50 (us) | Jitter p99 (us)
+//
+// Para monitorizacion externa, toJson() devuelve todos los flujos con todas
+// las metricas (ver StreamStats::toJson()).
+// =============================================================================
+
+#ifndef MESSAGESTATSMODEL_H
+#define MESSAGESTATSMODEL_H
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QJsonObject>
+#include <QtQml/qqmlregistration.h>
+#include <vector>
+#include "messagestats.h"
+
+struct StanagFrameView;
+
+class MessageStatsModel : public QAbstractTableModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("MessageStatsModel is provided by EthernetController.statsModel")
+
+    Q_PROPERTY(int streamCount READ streamCount NOTIFY streamCountChanged)
+
+public:
+    enum Column {
+        MessageIdColumn,
+        SourcePortColumn,
+        FramesColumn,
+        FramesPerSecColumn,
+        BytesPerSecColumn,
+        LostColumn,
+        OutOfOrderColumn,
+        DuplicatesColumn,
+        ChecksumFailuresColumn,
+        JitterP50Column,
+        JitterP99Column,
+        ColumnCount
+    };
+    Q_ENUM(Column)
+
+    explicit MessageStatsModel(QObject *parent = nullptr);
+
+    // ─── QAbstractTableModel ────────────────────────────────────────
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // ─── Alimentacion desde C++ ─────────────────────────────────────
+    // Trama decodificada (checksum valido o no). Sin senales de modelo.
+    void record(const StanagFrameView &view, int byteSize, qint64 receivedNs);
+
+    // Publicar filas nuevas + valores (una vez por tick de UI)
+    void refresh(qint64 nowNs);
+
+    int streamCount() const;
+
+    // Instantanea { timestampNs, streams: [ {...}, ... ] }
+    QJsonObject toJson(qint64 nowNs);
+
+    Q_INVOKABLE void clear();
+
+signals:
+    void streamCountChanged();
+
+private:
+    std::vector<StreamStats> m_streams;
+    QHash<quint32, int> m_index;        // clave → fila
+    int m_visibleRows = 0;              // Filas ya publicadas a la vista
+    bool m_dirty = false;
+
+    // Ultimo flujo consultado (atajo para rafagas del mismo flujo)
+    quint32 m_lastKey = 0;
+    int m_lastRow = -1;
+};
+
+#endif // MESSAGESTATSMODEL_H
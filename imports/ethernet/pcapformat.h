@@ -0,0 +1,78 @@
+// =============================================================================
+// pcapformat.h — Constantes del formato de captura pcap (libpcap clasico)
+// =============================================================================
+//
+// Un fichero pcap es:
+//
+//   +----------------------+  24 bytes, una vez al principio
+//   |  Global header       |  magic, version 2.4, snaplen, linktype
+//   +----------------------+
+//   |  Record header       |  16 bytes: ts_sec, ts_frac, incl_len, orig_len
+//   |  Paquete (incl_len)  |
+//   +----------------------+
+//   |  Record header ...   |  (se repite; el fichero solo crece al final)
+//
+// Los campos se escriben en el orden de bytes de la maquina que captura. El
+// lector lo deduce del magic: si lo lee al reves, todo el fichero esta al
+// reves. El magic tambien indica la resolucion de ts_frac:
+//   0xA1B2C3D4 → microsegundos      0xA1B23C4D → nanosegundos
+//
+// Nosotros escribimos SIEMPRE nanosegundos y linktype RAW (101): cada
+// paquete empieza directamente por la cabecera IPv4, sin Ethernet. Como
+// UdpTransport solo entrega el payload UDP, PcapWriter sintetiza una
+// cabecera IPv4 + UDP (127.0.0.1:origen → 127.0.0.1:destino) para que
+// Wireshark/tcpdump lo abran tal cual.
+//
+// pcapng (bloques SHB/IDB/EPB) NO se soporta: es mas flexible pero no
+// aporta nada aqui y complica el lector. Wireshark convierte entre ambos.
+// =============================================================================
+
+#ifndef PCAPFORMAT_H
+#define PCAPFORMAT_H
+
+#include <QtGlobal>
+
+namespace Pcap {
+
+constexpr quint32 kMagicMicros = 0xA1B2C3D4u;
+constexpr quint32 kMagicNanos  = 0xA1B23C4Du;
+constexpr quint16 kVersionMajor = 2;
+constexpr quint16 kVersionMinor = 4;
+constexpr quint32 kSnapLen = 65535;
+
+// Linktypes que entiende PcapReader (https://www.tcpdump.org/linktypes.html)
+constexpr quint32 kLinkNull     = 0;    // Loopback BSD/macOS: 4 bytes de familia
+constexpr quint32 kLinkEthernet = 1;    // Loopback de Linux ("lo") y NICs
+constexpr quint32 kLinkRaw      = 101;  // IPv4/IPv6 sin capa de enlace (el nuestro)
+constexpr quint32 kLinkIpv4     = 228;
+
+constexpr int kGlobalHeaderSize = 24;
+constexpr int kRecordHeaderSize = 16;
+constexpr int kIpv4HeaderSize   = 20;   // Sin opciones
+constexpr int kUdpHeaderSize    = 8;
+
+struct GlobalHeader
+{
+    quint32 magic;
+    quint16 versionMajor;
+    quint16 versionMinor;
+    qint32  thisZone;       // Siempre 0 (timestamps en UTC)
+    quint32 sigFigs;        // Siempre 0
+    quint32 snapLen;
+    quint32 linkType;
+};
+
+struct RecordHeader
+{
+    quint32 tsSec;
+    quint32 tsFrac;         // us o ns segun el magic
+    quint32 inclLen;        // Bytes guardados en el fichero
+    quint32 origLen;        // Bytes que tenia el paquete en el cable
+};
+
+static_assert(sizeof(GlobalHeader) == kGlobalHeaderSize, "GlobalHeader con padding");
+static_assert(sizeof(RecordHeader) == kRecordHeaderSize, "RecordHeader con padding");
+
+} // namespace Pcap
+
+#endif // PCAPFORMAT_H
@@ -0,0 +1,187 @@
+// =============================================================================
+// pcapreader.cpp — Indexado de una captura pcap mapeada en memoria
+// =============================================================================
+
+#include "pcapreader.h"
+#include "pcapformat.h"
+#include <QtEndian>
+#include <cstring>
+
+PcapReader::~PcapReader()
+{
+    close();
+}
+
+bool PcapReader::open(const QString &path, QString *error)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        if (error)
+            *error = m_file.errorString();
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < Pcap::kGlobalHeaderSize) {
+        if (error)
+            *error = QStringLiteral("%1 is too small to be a pcap file").arg(path);
+        close();
+        return false;
+    }
+
+    m_data = m_file.map(0, m_size);
+    if (!m_data) {
+        if (error)
+            *error = m_file.errorString();
+        close();
+        return false;
+    }
+
+    if (!parse(error)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void PcapReader::close()
+{
+    m_packets.clear();
+    m_payloads.clear();
+    m_skipped = 0;
+    if (m_data)
+        m_file.unmap(m_data);
+    m_data = nullptr;
+    m_size = 0;
+    m_file.close();
+}
+
+qint64 PcapReader::durationNs() const
+{
+    if (m_packets.size() < 2)
+        return 0;
+    return m_packets.back().timestampNs - m_packets.front().timestampNs;
+}
+
+// =============================================================================
+// parse() — Recorrer los registros y quedarse con los datagramas UDP/IPv4
+// =============================================================================
+// Un fichero cortado a mitad de registro (captura interrumpida) no es un
+// error: se indexa hasta el ultimo registro completo.
+//
+// Cabeceras de enlace:
+//   NULL      → 4 bytes (familia de protocolo en orden del host que capturo)
+//   Ethernet  → 14 bytes; 18 si lleva etiqueta VLAN (0x8100)
+//   RAW/IPv4  → 0 bytes: el paquete empieza por la cabecera IP
+// En todos los casos se comprueba despues que la version IP sea 4.
+// =============================================================================
+bool PcapReader::parse(QString *error)
+{
+    quint32 magic = 0;
+    std::memcpy(&magic, m_data, sizeof(magic));
+
+    // Si el magic se lee al reves, el fichero se escribio en una maquina con
+    // el otro orden de bytes: todos los campos hay que invertirlos
+    const bool swapped = (magic == qbswap(Pcap::kMagicMicros)
+                          || magic == qbswap(Pcap::kMagicNanos));
+    if (swapped)
+        magic = qbswap(magic);
+
+    if (magic != Pcap::kMagicMicros && magic != Pcap::kMagicNanos) {
+        if (error) {
+            // 0x0A0D0D0A es el bloque inicial (SHB) de pcapng
+            *error = (magic == 0x0A0D0D0Au)
+                         ? QStringLiteral("pcapng is not supported; save the capture as pcap")
+                         : QStringLiteral("Not a pcap file");
+        }
+        return false;
+    }
+    const bool nanos = (magic == Pcap::kMagicNanos);
+
+    auto read32 = [swapped](const uchar *p) {
+        quint32 value = 0;
+        std::memcpy(&value, p, sizeof(value));
+        return swapped ? qbswap(value) : value;
+    };
+
+    // Los 16 bits altos del linktype pueden llevar flags (FCS): se ignoran
+    const quint32 linkType = read32(m_data + 20) & 0xFFFF;
+    if (linkType != Pcap::kLinkNull && linkType != Pcap::kLinkEthernet
+        && linkType != Pcap::kLinkRaw && linkType != Pcap::kLinkIpv4) {
+        if (error)
+            *error = QStringLiteral("Unsupported pcap link type %1").arg(linkType);
+        return false;
+    }
+
+    // Estimacion grosera para no realojar el indice muchas veces
+    m_packets.reserve(std::size_t(m_size / 96));
+    m_payloads.reserve(std::size_t(m_size / 96));
+
+    qint64 offset = Pcap::kGlobalHeaderSize;
+    while (offset + Pcap::kRecordHeaderSize <= m_size) {
+        const uchar *record = m_data + offset;
+        const quint32 tsSec = read32(record + 0);
+        const quint32 tsFrac = read32(record + 4);
+        const quint32 inclLen = read32(record + 8);
+        offset += Pcap::kRecordHeaderSize;
+
+        if (inclLen > quint64(m_size - offset))
+            break;   // Registro incompleto al final del fichero
+
+        const uchar *packet = m_data + offset;
+        offset += inclLen;
+
+        // --- Capa de enlace ---
+        qint64 linkLen = 0;
+        if (linkType == Pcap::kLinkNull) {
+            linkLen = 4;
+        } else if (linkType == Pcap::kLinkEthernet) {
+            linkLen = 14;
+            if (inclLen >= 18 && qFromBigEndian<quint16>(packet + 12) == 0x8100)
+                linkLen = 18;
+            if (inclLen < linkLen
+                || qFromBigEndian<quint16>(packet + linkLen - 2) != 0x0800) {
+                m_skipped++;
+                continue;
+            }
+        }
+
+        // --- IPv4 ---
+        const qint64 ipAvailable = qint64(inclLen) - linkLen;
+        const uchar *ip = packet + linkLen;
+        if (ipAvailable < Pcap::kIpv4HeaderSize || (ip[0] >> 4) != 4 || ip[9] != 17) {
+            m_skipped++;
+            continue;
+        }
+        const int ihl = (ip[0] & 0x0F) * 4;
+        const quint16 fragment = qFromBigEndian<quint16>(ip + 6);
+        if (ihl < Pcap::kIpv4HeaderSize || (fragment & 0x3FFF) != 0
+            || ipAvailable < ihl + Pcap::kUdpHeaderSize) {
+            m_skipped++;   // Fragmentado (MF u offset) o truncado
+            continue;
+        }
+
+        // --- UDP ---
+        const uchar *udp = ip + ihl;
+        const quint16 udpLen = qFromBigEndian<quint16>(udp + 4);
+        if (udpLen < Pcap::kUdpHeaderSize) {
+            m_skipped++;
+            continue;
+        }
+        const qint64 captured = ipAvailable - ihl - Pcap::kUdpHeaderSize;
+        const qint64 payloadLen = qMin<qint64>(udpLen - Pcap::kUdpHeaderSize, captured);
+
+        CapturePacket entry;
+        entry.timestampNs = qint64(tsSec) * 1000000000
+                            + (nanos ? qint64(tsFrac) : qint64(tsFrac) * 1000);
+        entry.sourcePort = qFromBigEndian<quint16>(udp + 0);
+        entry.destPort = qFromBigEndian<quint16>(udp + 2);
+        m_packets.push_back(entry);
+        m_payloads.emplace_back(reinterpret_cast<const char *>(udp + Pcap::kUdpHeaderSize),
+                                payloadLen);
+    }
+
+    return true;
+}
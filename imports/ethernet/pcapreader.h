@@ -0,0 +1,69 @@
+// =============================================================================
+// pcapreader.h — Lectura de capturas pcap mapeadas en memoria
+// =============================================================================
+//
+// PATRON: Clase de valor que posee el mapeo del fichero y expone vistas.
+//
+// open() mapea el fichero entero con QFile::map() (mmap en POSIX). No se
+// lee nada a heap: el SO trae las paginas bajo demanda y las comparte con
+// la cache de disco. Despues se recorre una vez para construir un indice
+// de paquetes UDP (CapturePacket) cuyas vistas apuntan DENTRO del mapeo.
+//
+// Las vistas son validas mientras el PcapReader siga abierto. ReplayEngine
+// las pasa tal cual a UdpTransport::sendDatagrams(): reenviar una captura
+// no copia ni un byte de payload.
+//
+// Acepta pcap clasico en cualquier orden de bytes, con timestamps en us o
+// ns, y linktypes NULL (loopback BSD), Ethernet (loopback Linux), RAW e
+// IPv4. Se indexan solo datagramas UDP sobre IPv4 no fragmentados; el resto
+// de paquetes se cuenta en skippedCount().
+// =============================================================================
+
+#ifndef PCAPREADER_H
+#define PCAPREADER_H
+
+#include <QByteArrayView>
+#include <QFile>
+#include <QString>
+#include <vector>
+
+// Un datagrama UDP de la captura
+struct CapturePacket
+{
+    qint64 timestampNs = 0;
+    quint16 sourcePort = 0;
+    quint16 destPort = 0;
+};
+
+class PcapReader
+{
+public:
+    ~PcapReader();
+
+    bool open(const QString &path, QString *error = nullptr);
+    void close();
+    bool isOpen() const { return m_data != nullptr; }
+
+    // packets()[i] y payloads()[i] describen el mismo datagrama. Se guardan
+    // en arrays separados para que payloads() sea directamente el array de
+    // QByteArrayView que consume sendDatagrams().
+    const std::vector<CapturePacket> &packets() const { return m_packets; }
+    const std::vector<QByteArrayView> &payloads() const { return m_payloads; }
+
+    int skippedCount() const { return m_skipped; }
+
+    // Duracion de la captura (ultimo timestamp - primero)
+    qint64 durationNs() const;
+
+private:
+    bool parse(QString *error);
+
+    QFile m_file;
+    uchar *m_data = nullptr;
+    qint64 m_size = 0;
+    std::vector<CapturePacket> m_packets;
+    std::vector<QByteArrayView> m_payloads;
+    int m_skipped = 0;
+};
+
+#endif // PCAPREADER_H
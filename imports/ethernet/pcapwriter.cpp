@@ -0,0 +1,179 @@
+// =============================================================================
+// pcapwriter.cpp — Implementacion de la captura pcap bufferizada
+// =============================================================================
+
+#include "pcapwriter.h"
+#include "pcapformat.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+// Checksum de la cabecera IPv4 (RFC 791): suma en complemento a uno de las
+// palabras de 16 bits, con el campo checksum a 0 durante el calculo.
+quint16 ipv4HeaderChecksum(const uchar *header)
+{
+    quint32 sum = 0;
+    for (int i = 0; i < Pcap::kIpv4HeaderSize; i += 2)
+        sum += qFromBigEndian<quint16>(header + i);
+    while (sum >> 16)
+        sum = (sum & 0xFFFF) + (sum >> 16);
+    return quint16(~sum);
+}
+
+} // namespace
+
+PcapWriter::~PcapWriter()
+{
+    close();
+}
+
+// =============================================================================
+// open() — Crear o continuar una captura
+// =============================================================================
+// Un fichero existente solo se acepta si su cabecera es EXACTAMENTE la que
+// escribiriamos nosotros (mismo orden de bytes, ns, RAW): mezclar registros
+// de otro formato lo dejaria ilegible.
+// =============================================================================
+bool PcapWriter::open(const QString &path, QString *error)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Unbuffered)) {
+        if (error)
+            *error = m_file.errorString();
+        return false;
+    }
+
+    const Pcap::GlobalHeader header{ Pcap::kMagicNanos, Pcap::kVersionMajor,
+                                     Pcap::kVersionMinor, 0, 0,
+                                     Pcap::kSnapLen, Pcap::kLinkRaw };
+
+    if (m_file.size() > 0) {
+        QFile existing(path);
+        Pcap::GlobalHeader found{};
+        const bool compatible =
+            existing.open(QIODevice::ReadOnly)
+            && existing.read(reinterpret_cast<char *>(&found), sizeof(found)) == qint64(sizeof(found))
+            && found.magic == header.magic
+            && found.linkType == header.linkType;
+        if (!compatible) {
+            if (error)
+                *error = QStringLiteral("%1 is not a nanosecond raw-IP pcap file").arg(path);
+            m_file.close();
+            return false;
+        }
+    } else {
+        m_buffer.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    m_buffer.reserve(kFlushThreshold + 4096);
+    m_packets = 0;
+    m_bytesWritten = 0;
+    m_sinceFlush.start();
+    return true;
+}
+
+void PcapWriter::close()
+{
+    if (!m_file.isOpen())
+        return;
+    flush();
+    m_file.close();
+}
+
+bool PcapWriter::isOpen() const
+{
+    return m_file.isOpen();
+}
+
+QString PcapWriter::path() const
+{
+    return m_file.fileName();
+}
+
+// =============================================================================
+// append() — Registro pcap + IPv4 + UDP + payload, todo en el buffer
+// =============================================================================
+// Se reserva el hueco de una vez (resize) y se escribe con punteros: un
+// registro de una trama STANAG son ~90 bytes y no debe costar mas que eso.
+// =============================================================================
+void PcapWriter::append(QByteArrayView payload, qsizetype originalSize,
+                        quint16 sourcePort, quint16 destPort, qint64 timestampNs)
+{
+    if (!m_file.isOpen())
+        return;
+
+    constexpr int kNetHeaders = Pcap::kIpv4HeaderSize + Pcap::kUdpHeaderSize;
+    const qsizetype captured = qMin<qsizetype>(payload.size(),
+                                               Pcap::kSnapLen - kNetHeaders);
+    const qsizetype original = qMax(originalSize, captured);
+
+    const Pcap::RecordHeader record{
+        quint32(timestampNs / 1000000000),
+        quint32(timestampNs % 1000000000),
+        quint32(kNetHeaders + captured),
+        quint32(kNetHeaders + original)
+    };
+
+    const qsizetype start = m_buffer.size();
+    m_buffer.resize(start + Pcap::kRecordHeaderSize + kNetHeaders + captured);
+    auto *ptr = reinterpret_cast<uchar *>(m_buffer.data() + start);
+
+    std::memcpy(ptr, &record, sizeof(record));
+    ptr += sizeof(record);
+
+    // --- IPv4 (20 bytes, 127.0.0.1 → 127.0.0.1) ---
+    uchar *ip = ptr;
+    ip[0] = 0x45;                                           // v4, IHL = 5
+    ip[1] = 0;                                              // DSCP/ECN
+    qToBigEndian<quint16>(quint16(qMin<qsizetype>(kNetHeaders + original, 0xFFFF)), ip + 2);
+    qToBigEndian<quint16>(m_ipId++, ip + 4);
+    qToBigEndian<quint16>(0x4000, ip + 6);                  // Don't Fragment
+    ip[8] = 64;                                             // TTL
+    ip[9] = 17;                                             // UDP
+    qToBigEndian<quint16>(0, ip + 10);
+    qToBigEndian<quint32>(0x7F000001u, ip + 12);
+    qToBigEndian<quint32>(0x7F000001u, ip + 16);
+    qToBigEndian<quint16>(ipv4HeaderChecksum(ip), ip + 10);
+
+    // --- UDP (8 bytes; checksum 0 = "no calculado", valido en IPv4) ---
+    uchar *udp = ip + Pcap::kIpv4HeaderSize;
+    qToBigEndian<quint16>(sourcePort, udp + 0);
+    qToBigEndian<quint16>(destPort, udp + 2);
+    qToBigEndian<quint16>(quint16(qMin<qsizetype>(Pcap::kUdpHeaderSize + original, 0xFFFF)), udp + 4);
+    qToBigEndian<quint16>(0, udp + 6);
+
+    std::memcpy(udp + Pcap::kUdpHeaderSize, payload.data(), std::size_t(captured));
+
+    m_packets++;
+    if (m_buffer.size() >= kFlushThreshold)
+        flush();
+}
+
+// =============================================================================
+// flush() — Un solo write() con todo lo acumulado
+// =============================================================================
+// clear() en Qt 6 libera la memoria; resize(0) conserva la capacidad, asi
+// el buffer no se vuelve a reservar en cada volcado.
+// =============================================================================
+bool PcapWriter::flush()
+{
+    m_sinceFlush.restart();
+    if (m_buffer.isEmpty() || !m_file.isOpen())
+        return true;
+
+    const qint64 written = m_file.write(m_buffer);
+    const bool ok = (written == m_buffer.size());
+    if (written > 0)
+        m_bytesWritten += quint64(written);
+    m_buffer.resize(0);
+    return ok;
+}
+
+void PcapWriter::maybeFlush()
+{
+    if (m_sinceFlush.isValid() && m_sinceFlush.elapsed() >= kMaxFlushDelayMs)
+        flush();
+}
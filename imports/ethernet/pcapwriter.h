@@ -0,0 +1,79 @@
+// =============================================================================
+// pcapwriter.h — Captura de datagramas recibidos a un fichero pcap
+// =============================================================================
+//
+// PATRON: Clase de valor con buffer propio (no QObject, no senales). La usa
+// EthernetController desde el hilo de GUI, que es donde llegan todos los
+// datagramas (directamente o vaciando la cola del ReceiveWorker).
+//
+// E/S BUFFERIZADA Y SOLO-APPEND:
+//   - append() solo copia el registro (16 B de cabecera pcap + 28 B de
+//     IPv4/UDP sintetizados + payload) al final de un QByteArray en memoria.
+//     No hay llamada al sistema por datagrama.
+//   - Cuando el buffer pasa de kFlushThreshold, o cuando lleva mas de
+//     kMaxFlushDelayMs sin volcarse (maybeFlush(), una vez por tick de UI),
+//     se escribe entero con UN write(). El QFile se abre Unbuffered para
+//     que Qt no anada una segunda copia.
+//   - El fichero se abre en modo Append: nunca se reescribe ni se hace
+//     seek. Si ya existe y es un pcap nuestro (ns + RAW), se sigue
+//     anadiendo; si esta vacio se escribe primero la cabecera global.
+//
+// Timestamps: los de UdpTransport (ns desde epoch; el del kernel con
+// SO_TIMESTAMPNS en modo batch), que es justo lo que pcap espera.
+// =============================================================================
+
+#ifndef PCAPWRITER_H
+#define PCAPWRITER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+
+class PcapWriter
+{
+public:
+    static constexpr int kFlushThreshold = 256 * 1024;
+    static constexpr int kMaxFlushDelayMs = 1000;
+
+    ~PcapWriter();
+
+    // =========================================================================
+    // open() — Abrir (o crear) el fichero de captura para anadir al final
+    // =========================================================================
+    // Retorna false con el motivo en 'error' si no se puede abrir o si el
+    // fichero existe pero no es un pcap compatible (otro linktype, us...).
+    // =========================================================================
+    bool open(const QString &path, QString *error = nullptr);
+    void close();
+    bool isOpen() const;
+    QString path() const;
+
+    // =========================================================================
+    // append() — Anadir un datagrama a la captura
+    // =========================================================================
+    // 'payload' son los bytes disponibles; 'originalSize' el tamano real del
+    // datagrama (mayor si la copia se trunco, p.ej. ReceivedFrame). pcap lo
+    // representa con incl_len < orig_len, igual que un snaplen corto.
+    // =========================================================================
+    void append(QByteArrayView payload, qsizetype originalSize,
+                quint16 sourcePort, quint16 destPort, qint64 timestampNs);
+
+    // Volcar el buffer al disco ahora / solo si lleva demasiado esperando
+    bool flush();
+    void maybeFlush();
+
+    quint64 packetCount() const { return m_packets; }
+    quint64 bytesWritten() const { return m_bytesWritten; }
+
+private:
+    QFile m_file;
+    QByteArray m_buffer;
+    QElapsedTimer m_sinceFlush;
+    quint64 m_packets = 0;
+    quint64 m_bytesWritten = 0;
+    quint16 m_ipId = 0;         // Identificador IPv4 (solo informativo)
+};
+
+#endif // PCAPWRITER_H
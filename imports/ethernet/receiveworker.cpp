@@ -0,0 +1,147 @@
+// =============================================================================
+// receiveworker.cpp — Implementacion del worker de recepcion
+// =============================================================================
+
+#include "receiveworker.h"
+#include "stanagcodec.h"
+
+// =============================================================================
+// Constructor
+// =============================================================================
+// m_transport se construye con 'this' como parent: al hacer moveToThread()
+// del worker se mueven tambien el transporte y su socket.
+// =============================================================================
+ReceiveWorker::ReceiveWorker(ReceiveQueue *queue, QObject *parent)
+    : QObject(parent)
+    , m_queue(queue)
+    , m_transport(this)
+    , m_catalog(std::make_shared<const StanagCatalog>())
+{
+    m_splitter.setCatalog(m_catalog.get());
+    connect(&m_transport, &UdpTransport::datagramsReceived,
+            this, &ReceiveWorker::onDatagramsReceived);
+    connect(&m_transport, &UdpTransport::errorOccurred,
+            this, &ReceiveWorker::errorOccurred);
+}
+
+bool ReceiveWorker::bind(quint16 port, int batchSize, const QHostAddress &group,
+                         const QString &interfaceName)
+{
+    // El worker siempre lee por lotes: es el modo que da timestamps del
+    // kernel y una sola senal por recvmmsg.
+    m_transport.setBatchSize(qMax(1, batchSize));
+    if (!group.isNull())
+        return m_transport.bindMulticast(port, group, interfaceName);
+    return m_transport.bind(port);
+}
+
+void ReceiveWorker::unbind()
+{
+    m_transport.unbind();
+}
+
+// El splitter guarda un puntero crudo: m_catalog lo mantiene vivo hasta
+// que llega el siguiente.
+void ReceiveWorker::setCatalog(std::shared_ptr<const StanagCatalog> catalog)
+{
+    m_catalog = std::move(catalog);
+    m_splitter.setCatalog(m_catalog.get());
+}
+
+quint64 ReceiveWorker::takeDropped()
+{
+    return m_dropped.exchange(0, std::memory_order_relaxed);
+}
+
+void ReceiveWorker::setCaptureQueue(CaptureQueue *queue)
+{
+    m_captureQueue.store(queue, std::memory_order_relaxed);
+}
+
+// release: quien lea m_capturing == true con acquire ve ya la cola
+void ReceiveWorker::setCapturing(bool capturing)
+{
+    m_capturing.store(capturing, std::memory_order_release);
+}
+
+quint64 ReceiveWorker::takeCaptureDropped()
+{
+    return m_captureDropped.exchange(0, std::memory_order_relaxed);
+}
+
+// =============================================================================
+// onDatagramsReceived() — Decode en el hilo de red y entrega por la cola
+// =============================================================================
+// Las vistas del lote solo son validas durante esta llamada, por eso cada
+// datagrama se copia (acotado a kCopyBytes) dentro del ReceivedFrame.
+//
+// Un datagrama con varias tramas empaquetadas se separa aqui con
+// StanagStreamDecoder: a la cola llega una entrada por TRAMA (y una de
+// error por datagrama si hubo bytes que no eran trama). La captura, si esta
+// activa, recibe antes el datagrama entero.
+// =============================================================================
+void ReceiveWorker::onDatagramsReceived(UdpDatagramSpan batch)
+{
+    CaptureQueue *captureQueue = m_capturing.load(std::memory_order_acquire)
+        ? m_captureQueue.load(std::memory_order_relaxed) : nullptr;
+    ReceivedFrame frame;
+    for (const UdpDatagramView &datagram : batch) {
+        if (captureQueue)
+            capture(*captureQueue, datagram);
+
+        if (!StanagStreamDecoder::isSingleFrame(datagram.data)
+            && pushPacked(datagram, frame))
+            continue;
+
+        frame.assign(datagram.data, datagram.senderPort, datagram.receivedNs);
+        frame.decoded = m_catalog->decodeView(frame.bytesView(), frame.view);
+        push(frame);
+    }
+}
+
+// =============================================================================
+// pushPacked() — Encolar las tramas de un datagrama empaquetado
+// =============================================================================
+// Retorna false si no se encontro ninguna trama: el datagrama sigue el
+// camino normal y se reporta como un datagrama invalido mas.
+// =============================================================================
+bool ReceiveWorker::pushPacked(const UdpDatagramView &datagram, ReceivedFrame &frame)
+{
+    const quint64 skippedBefore = m_splitter.skippedBytes();
+    m_splitter.feed(datagram.data, true);
+
+    int frames = 0;
+    StanagFrameView view;
+    while (m_splitter.next(view)) {
+        frame.assign(view.frame, datagram.senderPort, datagram.receivedNs);
+        frame.decoded = true;
+        frame.view = view;
+        frame.view.frame = frame.bytesView();
+        push(frame);
+        ++frames;
+    }
+
+    if (frames > 0 && m_splitter.skippedBytes() != skippedBefore) {
+        frame.assign(datagram.data, datagram.senderPort, datagram.receivedNs);
+        frame.decoded = false;
+        push(frame);
+    }
+    return frames > 0;
+}
+
+void ReceiveWorker::push(const ReceivedFrame &frame)
+{
+    if (!m_queue->tryPush(frame))
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ReceiveWorker::capture(CaptureQueue &queue, const UdpDatagramView &datagram)
+{
+    m_captured.receivedNs = datagram.receivedNs;
+    m_captured.senderPort = datagram.senderPort;
+    m_captured.size = int(datagram.data.size());
+    std::memcpy(m_captured.bytes, datagram.data.data(),
+                std::size_t(qMin(m_captured.size, CapturedDatagram::kCopyBytes)));
+    if (!queue.tryPush(m_captured))
+        m_captureDropped.fetch_add(1, std::memory_order_relaxed);
+}
@@ -0,0 +1,167 @@
+// =============================================================================
+// receiveworker.h — Recepcion + decode STANAG en un hilo dedicado
+// =============================================================================
+//
+// PATRON: Worker QObject + moveToThread() (igual que los workers de
+// imports/threads). EthernetController crea el worker sin parent, lo mueve
+// a un QThread propio y lo destruye con deleteLater al parar el hilo.
+//
+// REPARTO DE TRABAJO:
+//
+//   Hilo de red (este worker)            Hilo de GUI (EthernetController)
+//   ─────────────────────────            ────────────────────────────────
+//   recvmmsg (UdpTransport batch)
+//   StanagCatalog::decodeView()
+//   copia compacta → ReceivedFrame
+//   queue.tryPush(frame) ──────────────→ tick de UI: while (tryPop)
+//                                         contadores + latencia agregados
+//                                         senales a QML SOLO del ultimo
+//
+// La cola es SpscQueue (lock-free, sin senales Qt por trama). El hilo de
+// GUI solo paga el coste de QML una vez por refresco, sin importar si en
+// ese intervalo llegaron 1 o 10.000 datagramas.
+//
+// Si la cola se llena (GUI bloqueada), el worker NO espera: descarta la
+// trama y lo cuenta en droppedFrames(). La red nunca se frena por la UI.
+// =============================================================================
+
+#ifndef RECEIVEWORKER_H
+#define RECEIVEWORKER_H
+
+#include <QObject>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include "spscqueue.h"
+#include "stanagcatalog.h"
+#include "stanagmessage.h"
+#include "stanagstreamdecoder.h"
+#include "udptransport.h"
+
+// =============================================================================
+// ReceivedFrame — Lo que cruza de hilo por cada datagrama
+// =============================================================================
+// Copia acotada del datagrama (los slots de UdpTransport se reutilizan) mas
+// el resultado del decode. view.frame apunta al buffer del PRODUCTOR: el
+// consumidor debe re-apuntarlo a su propia copia con bytesView().
+// =============================================================================
+struct ReceivedFrame
+{
+    static constexpr int kCopyBytes = 256;   // Trama STANAG completa <= 72 bytes
+
+    qint64 receivedNs = 0;     // UdpDatagramView::receivedNs
+    quint16 senderPort = 0;
+    bool decoded = false;
+    int size = 0;              // Tamano real del datagrama (puede ser > copia)
+    StanagFrameView view;
+    char bytes[kCopyBytes];
+
+    QByteArrayView bytesView() const
+    {
+        return QByteArrayView(bytes, qMin(size, kCopyBytes));
+    }
+
+    // Copiar un datagrama (acotado a kCopyBytes). No toca decoded ni view.
+    void assign(QByteArrayView data, quint16 port, qint64 timestampNs)
+    {
+        receivedNs = timestampNs;
+        senderPort = port;
+        size = int(data.size());
+        std::memcpy(bytes, data.data(), std::size_t(qMin(size, kCopyBytes)));
+    }
+};
+
+using ReceiveQueue = SpscQueue<ReceivedFrame, 4096>;
+
+// =============================================================================
+// CapturedDatagram — Datagrama crudo para la captura pcap
+// =============================================================================
+// Se copia ANTES de separar las tramas empaquetadas: el pcap guarda lo que
+// llego por la red, igual que en el modo sin hilo, y el replay reproduce
+// los datagramas tal cual. El buffer cubre un slot de recvmmsg completo.
+// =============================================================================
+struct CapturedDatagram
+{
+    static constexpr int kCopyBytes = UdpTransport::kBatchSlotSize;
+
+    qint64 receivedNs = 0;
+    quint16 senderPort = 0;
+    int size = 0;              // Tamano real del datagrama
+    char bytes[kCopyBytes];
+
+    QByteArrayView bytesView() const
+    {
+        return QByteArrayView(bytes, qMin(size, kCopyBytes));
+    }
+};
+
+using CaptureQueue = SpscQueue<CapturedDatagram, 512>;
+
+class ReceiveWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    // La cola pertenece a EthernetController y debe vivir mas que el worker
+    explicit ReceiveWorker(ReceiveQueue *queue, QObject *parent = nullptr);
+
+    // =========================================================================
+    // bind() / unbind() — Deben ejecutarse EN EL HILO DEL WORKER
+    // =========================================================================
+    // El socket se crea en un hilo y solo puede usarse desde ese hilo.
+    // EthernetController los invoca con Qt::BlockingQueuedConnection para
+    // obtener el resultado del bind de forma sincrona.
+    //
+    // Con 'group' no nulo se escucha ese grupo multicast (bindMulticast).
+    // =========================================================================
+    bool bind(quint16 port, int batchSize,
+              const QHostAddress &group = QHostAddress(),
+              const QString &interfaceName = QString());
+    void unbind();
+
+    // =========================================================================
+    // setCatalog() — Catalogo de mensajes para el decode
+    // =========================================================================
+    // En el hilo del worker (antes de moveToThread, o con invokeMethod
+    // encolado). El catalogo es inmutable: recargar es pasar uno nuevo.
+    // =========================================================================
+    void setCatalog(std::shared_ptr<const StanagCatalog> catalog);
+
+    // Tramas descartadas por cola llena desde la ultima llamada (thread-safe)
+    quint64 takeDropped();
+
+    // =========================================================================
+    // setCapturing() — Copiar cada datagrama crudo a la cola de captura
+    // =========================================================================
+    // Thread-safe (atomicos). La cola la crea EthernetController al empezar
+    // la primera captura: setCaptureQueue() ANTES de setCapturing(true).
+    // Sin captura activa el worker no copia nada extra.
+    // takeCaptureDropped() cuenta los datagramas que no cupieron.
+    // =========================================================================
+    void setCaptureQueue(CaptureQueue *queue);
+    void setCapturing(bool capturing);
+    quint64 takeCaptureDropped();
+
+signals:
+    void errorOccurred(const QString &error);
+
+private slots:
+    void onDatagramsReceived(UdpDatagramSpan batch);
+
+private:
+    bool pushPacked(const UdpDatagramView &datagram, ReceivedFrame &frame);
+    void push(const ReceivedFrame &frame);
+    void capture(CaptureQueue &queue, const UdpDatagramView &datagram);
+
+    ReceiveQueue *m_queue;
+    std::atomic<CaptureQueue *> m_captureQueue{nullptr};
+    UdpTransport m_transport;
+    std::shared_ptr<const StanagCatalog> m_catalog;
+    StanagStreamDecoder m_splitter;     // Datagramas con varias tramas
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<bool> m_capturing{false};
+    std::atomic<quint64> m_captureDropped{0};
+    CapturedDatagram m_captured;        // Staging de capture() (unos KB)
+};
+
+#endif // RECEIVEWORKER_H
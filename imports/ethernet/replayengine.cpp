@@ -0,0 +1,95 @@
+// =============================================================================
+// replayengine.cpp — Implementacion del reenvio de capturas
+// =============================================================================
+
+#include "replayengine.h"
+#include "udptransport.h"
+#include <algorithm>
+
+ReplayEngine::ReplayEngine(UdpTransport *transport, QObject *parent)
+    : QObject(parent)
+    , m_transport(transport)
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &ReplayEngine::onTick);
+}
+
+bool ReplayEngine::start(const QString &path, double speed, quint16 destPort,
+                         QString *error)
+{
+    stop();
+
+    if (!m_reader.open(path, error))
+        return false;
+
+    if (m_reader.payloads().empty()) {
+        if (error)
+            *error = QStringLiteral("%1 contains no UDP datagrams").arg(path);
+        m_reader.close();
+        return false;
+    }
+
+    m_speed = speed;
+    m_destPort = destPort;
+    m_next = 0;
+    m_total = int(m_reader.payloads().size());
+    m_firstTsNs = m_reader.packets().front().timestampNs;
+    m_clock.start();
+
+    // A maxima velocidad el tick es 0 ms: se cede el event loop entre lotes
+    // para que la UI (y la recepcion, si es el mismo proceso) no se congelen
+    m_timer.setInterval(m_speed > 0.0 ? kTickMs : 0);
+    m_timer.start();
+    onTick();
+    return true;
+}
+
+// =============================================================================
+// stop() — Cancelar (o cerrar tras terminar) y desmapear la captura
+// =============================================================================
+void ReplayEngine::stop()
+{
+    if (!m_reader.isOpen())
+        return;
+
+    m_timer.stop();
+    const qint64 elapsedNs = qMax<qint64>(m_clock.nsecsElapsed(), 1);
+    const int framesSent = m_next;
+    m_reader.close();
+
+    emit finished(framesSent, int(elapsedNs / 1000000), framesSent * 1e9 / elapsedNs);
+}
+
+// =============================================================================
+// onTick() — Enviar los paquetes debidos en este instante
+// =============================================================================
+// 'due' = primer paquete cuyo instante relativo (escalado) aun no ha
+// llegado. Como los timestamps estan ordenados, se busca con upper_bound
+// en vez de recorrerlos. (Si la captura tuviera timestamps desordenados,
+// se envian en orden de fichero igualmente: upper_bound nunca retrocede
+// por debajo de m_next.)
+// =============================================================================
+void ReplayEngine::onTick()
+{
+    const auto &packets = m_reader.packets();
+    const int total = int(packets.size());
+
+    int due = qMin(total, m_next + kMaxBatch);
+    if (m_speed > 0.0) {
+        const qint64 limitNs = m_firstTsNs + qint64(m_clock.nsecsElapsed() * m_speed);
+        const auto it = std::upper_bound(
+            packets.begin() + m_next, packets.end(), limitNs,
+            [](qint64 ts, const CapturePacket &p) { return ts < p.timestampNs; });
+        due = int(it - packets.begin());
+    }
+
+    const int pending = due - m_next;
+    if (pending > 0) {
+        const int sent = m_transport->sendDatagrams(
+            m_reader.payloads().data() + m_next, pending, m_destPort);
+        m_next += qMax(sent, 0);   // Lo que falte, en el siguiente tick
+    }
+
+    if (m_next >= total)
+        stop();
+}
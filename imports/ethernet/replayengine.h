@@ -0,0 +1,80 @@
+// =============================================================================
+// replayengine.h — Reenvio de una captura pcap por UdpTransport
+// =============================================================================
+//
+// PATRON: QObject con temporizador propio (como la rafaga de
+// EthernetController). Vive en el hilo de GUI y envia por el UdpTransport
+// que le pasan; no crea sockets.
+//
+// VELOCIDAD (speed):
+//   1.0   → ritmo original: el paquete i sale en (ts_i - ts_0) desde start()
+//   N     → N veces mas rapido (0.5 = a mitad de velocidad)
+//   <= 0  → maxima velocidad: lotes de kMaxBatch por tick, sin esperas
+//
+// Con ritmo, cada tick (1 ms, PreciseTimer) envia TODO lo que ya "deberia"
+// haber salido, igual que sendBurstChunk(): si un tick llega tarde, el
+// siguiente lo recupera y el ritmo medio se conserva. Las rafagas de la
+// captura (muchos paquetes con el mismo timestamp) salen en un solo
+// sendDatagrams() → sendmmsg, como en el campo.
+//
+// Si sendDatagrams() no acepta todo el lote (buffer del SO lleno), lo que
+// falta se reintenta en el siguiente tick: a maxima velocidad eso actua
+// como control de flujo en vez de abortar como la rafaga.
+//
+// SIN COPIAS: los datagramas se envian con las QByteArrayView de
+// PcapReader::payloads(), que apuntan al fichero mapeado en memoria.
+//
+// Todos los paquetes se envian al mismo puerto destino (el de start()),
+// sin importar a que puerto iban en la captura.
+// =============================================================================
+
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include "pcapreader.h"
+
+class UdpTransport;
+
+class ReplayEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kTickMs = 1;
+    static constexpr int kMaxBatch = 1024;   // Datagramas por tick a maxima velocidad
+
+    explicit ReplayEngine(UdpTransport *transport, QObject *parent = nullptr);
+
+    // Mapear 'path' y empezar a reenviar a destPort. false + 'error' si la
+    // captura no se puede abrir o no contiene datagramas UDP.
+    bool start(const QString &path, double speed, quint16 destPort,
+               QString *error = nullptr);
+    void stop();
+
+    bool isRunning() const { return m_timer.isActive(); }
+    int sentCount() const { return m_next; }
+    int totalCount() const { return m_total; }
+
+signals:
+    // Al terminar o al llamar a stop(): tramas enviadas, duracion y ritmo
+    void finished(int framesSent, int elapsedMs, double achievedRateHz);
+
+private slots:
+    void onTick();
+
+private:
+    UdpTransport *m_transport;
+    PcapReader m_reader;
+    QTimer m_timer;
+    QElapsedTimer m_clock;
+    double m_speed = 1.0;
+    quint16 m_destPort = 0;
+    int m_next = 0;             // Indice del siguiente paquete a enviar
+    int m_total = 0;            // Se conserva tras stop() para la UI
+    qint64 m_firstTsNs = 0;
+};
+
+#endif // REPLAYENGINE_H
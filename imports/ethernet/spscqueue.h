@@ -0,0 +1,100 @@
+// =============================================================================
+// spscqueue.h — Cola lock-free de un productor y un consumidor (SPSC)
+// =============================================================================
+//
+// PATRON: Ring buffer de capacidad fija (potencia de 2) con dos indices
+// atomicos que solo crecen:
+//
+//   m_head → lo escribe SOLO el productor (siguiente hueco a llenar)
+//   m_tail → lo escribe SOLO el consumidor (siguiente hueco a leer)
+//
+//   elementos en cola = head - tail      (aritmetica sin signo, sin wrap)
+//   hueco fisico      = indice & (Capacity - 1)
+//
+// Sin mutex: cada hilo solo escribe su indice. El orden de memoria
+// release/acquire garantiza que el consumidor ve el elemento completo antes
+// de ver el head que lo publica (y al reves para liberar el hueco).
+//
+// Cada lado guarda ademas una copia cacheada del indice del otro lado
+// (m_cachedTail / m_cachedHead) y solo relee el atomico cuando la copia dice
+// "lleno" o "vacio". Asi, en regimen normal, productor y consumidor no tocan
+// la misma linea de cache en cada operacion.
+//
+// alignas(64) separa los datos de cada hilo en lineas de cache distintas
+// para evitar "false sharing".
+//
+// USO (EthernetController + ReceiveWorker):
+//   hilo de red:  if (!queue.tryPush(frame)) ++dropped;   // nunca bloquea
+//   hilo de GUI:  while (queue.tryPop(frame)) { ... }      // una vez por frame
+//
+// Un SOLO productor y un SOLO consumidor. Con mas hilos, no es seguro.
+// =============================================================================
+
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue: Capacity debe ser potencia de 2");
+
+public:
+    // Llamar SOLO desde el hilo productor. false si la cola esta llena.
+    bool tryPush(const T &item)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == Capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == Capacity)
+                return false;
+        }
+
+        m_slots[head & kMask] = item;
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Llamar SOLO desde el hilo consumidor. false si la cola esta vacia.
+    bool tryPop(T &item)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_cachedHead) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail == m_cachedHead)
+                return false;
+        }
+
+        item = m_slots[tail & kMask];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Numero aproximado de elementos (exacto solo si nadie opera a la vez)
+    std::size_t sizeApprox() const
+    {
+        return m_head.load(std::memory_order_acquire)
+               - m_tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t capacity() { return Capacity; }
+
+private:
+    static constexpr std::size_t kMask = Capacity - 1;
+
+    // --- Lado productor ---
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+
+    // --- Lado consumidor ---
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cachedHead = 0;
+
+    // --- Huecos ---
+    alignas(64) T m_slots[Capacity];
+};
+
+#endif // SPSCQUEUE_H
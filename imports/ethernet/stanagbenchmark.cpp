@@ -0,0 +1,366 @@
+// =============================================================================
+// stanagbenchmark.cpp — Implementacion de los microbenchmarks del codec
+// =============================================================================
+
+#include "stanagbenchmark.h"
+#include "hexformatter.h"
+#include "stanagchecksum.h"
+#include "stanagcodec.h"
+#include "stanagmessagepool.h"
+#include <QElapsedTimer>
+#include <iterator>
+
+// =============================================================================
+// sampleFrames() — Tramas variadas y deterministas
+// =============================================================================
+// Usamos un generador lineal congruente trivial (no std::mt19937) porque
+// solo necesitamos variedad reproducible, no calidad estadistica.
+// El presenceMask se fuerza a tener al menos un bit activo.
+// =============================================================================
+QList<QByteArray> StanagBenchmark::sampleFrames(int count)
+{
+    QList<QByteArray> frames;
+    frames.reserve(count);
+
+    quint32 state = 0x4586u;
+    const auto &defs = StanagCodec::fieldDefinitions();
+
+    for (int n = 0; n < count; ++n) {
+        state = state * 1664525u + 1013904223u;
+
+        StanagMessage msg;
+        msg.messageId    = static_cast<quint16>(1 + n % 8);
+        msg.sourcePort   = 5000;
+        msg.destPort     = 5001;
+        msg.sequenceNum  = static_cast<quint16>(n);
+        msg.presenceMask = static_cast<quint16>((state >> 8) & 0x3FFF) | 0x0001;
+
+        for (int i = 0; i < kStanagMaxFields; ++i) {
+            if (!(msg.presenceMask & (1 << i)))
+                continue;
+            StanagField field;
+            field.index = i;
+            field.name = defs[i].name;
+            field.value = (i < 2) ? 40.0 + i * 0.125 : (n * 7 + i) % 1000;
+            msg.fields.append(field);
+        }
+
+        frames.append(StanagCodec::encode(msg));
+    }
+
+    return frames;
+}
+
+// =============================================================================
+// sampleMessages() — Mensajes con un numero fijo de campos
+// =============================================================================
+// Los bits se eligen al azar (mismo LCG) hasta tener 'fieldCount'
+// distintos: las tramas de una misma densidad tienen el mismo numero de
+// campos pero distinta mezcla de tamanos (2 y 4 bytes).
+// =============================================================================
+QList<StanagMessage> StanagBenchmark::sampleMessages(int count, int fieldCount)
+{
+    fieldCount = qBound(1, fieldCount, kStanagMaxFields);
+
+    QList<StanagMessage> messages;
+    messages.reserve(count);
+
+    quint32 state = 0x4586u + quint32(fieldCount);
+    const auto &defs = StanagCodec::fieldDefinitions();
+
+    for (int n = 0; n < count; ++n) {
+        quint16 mask = 0;
+        while (qPopulationCount(quint32(mask)) < uint(fieldCount)) {
+            state = state * 1664525u + 1013904223u;
+            mask |= quint16(1u << ((state >> 16) % kStanagMaxFields));
+        }
+
+        StanagMessage msg;
+        msg.messageId    = static_cast<quint16>(1 + n % 8);
+        msg.sourcePort   = 5000;
+        msg.destPort     = 5001;
+        msg.sequenceNum  = static_cast<quint16>(n);
+        msg.presenceMask = mask;
+
+        for (int i = 0; i < kStanagMaxFields; ++i) {
+            if (!(mask & (1 << i)))
+                continue;
+            StanagField field;
+            field.index = i;
+            field.name = defs[i].name;
+            field.value = (i < 2) ? 40.0 + i * 0.125 : (n * 7 + i) % 1000;
+            msg.fields.append(field);
+        }
+
+        messages.append(msg);
+    }
+
+    return messages;
+}
+
+// =============================================================================
+// compareDecode() — Medir las implementaciones sobre las mismas tramas
+// =============================================================================
+// El camino con pool se calienta con una pasada por todas las tramas antes
+// de medir. Sus contadores (acquire() servidos por un mensaje reciclado y
+// mensajes creados) dicen si el pool cubrio todo el bucle. Las reservas de
+// heap por trama se cuentan en el benchmark standalone (stanagcodecbench,
+// funcion allocations), que es el unico ejecutable que sustituye malloc.
+// =============================================================================
+QVariantMap StanagBenchmark::compareDecode(int frames)
+{
+    frames = qMax(frames, 1);
+    const QList<QByteArray> samples = sampleFrames(64);
+    const int sampleCount = samples.size();
+
+    double sink = 0.0;
+    QElapsedTimer timer;
+
+    // --- Camino clasico: un StanagMessage nuevo por trama ---
+    timer.start();
+    for (int n = 0; n < frames; ++n) {
+        StanagMessage msg;
+        if (StanagCodec::decode(samples[n % sampleCount], msg) && !msg.fields.isEmpty())
+            sink += msg.fields.constFirst().value;
+    }
+    const qint64 legacyNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    // --- decode() sobre mensajes reciclados (StanagMessagePool) ---
+    StanagMessagePool pool(1);
+    for (const QByteArray &sample : samples) {
+        StanagMessagePool::Handle msg = pool.acquire();
+        StanagCodec::decode(sample, *msg);
+    }
+
+    const quint64 reusedBefore = pool.reuseCount();
+    timer.restart();
+    for (int n = 0; n < frames; ++n) {
+        StanagMessagePool::Handle msg = pool.acquire();
+        if (StanagCodec::decode(samples[n % sampleCount], *msg) && !msg->fields.isEmpty())
+            sink += msg->fields.constFirst().value;
+    }
+    const qint64 pooledNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+    const quint64 reused = pool.reuseCount() - reusedBefore;
+
+    // --- Fast path: StanagFrameView en la pila ---
+    timer.restart();
+    for (int n = 0; n < frames; ++n) {
+        StanagFrameView view;
+        if (StanagCodec::decodeView(samples[n % sampleCount], view))
+            sink += view.values[0];
+    }
+    const qint64 fastNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    const double legacyFps = frames * 1e9 / legacyNs;
+    const double fastFps = frames * 1e9 / fastNs;
+
+    QVariantMap result;
+    result[QStringLiteral("frames")] = frames;
+    result[QStringLiteral("legacyFramesPerSec")] = legacyFps;
+    result[QStringLiteral("pooledFramesPerSec")] = frames * 1e9 / pooledNs;
+    result[QStringLiteral("fastFramesPerSec")] = fastFps;
+    result[QStringLiteral("legacyNsPerFrame")] = double(legacyNs) / frames;
+    result[QStringLiteral("pooledNsPerFrame")] = double(pooledNs) / frames;
+    result[QStringLiteral("fastNsPerFrame")] = double(fastNs) / frames;
+    result[QStringLiteral("pooledReuseRate")] = double(reused) / frames;
+    result[QStringLiteral("pooledMessages")] = pool.size();
+    result[QStringLiteral("speedup")] = fastFps / legacyFps;
+    // El sink se devuelve para que el trabajo tenga un efecto observable
+    result[QStringLiteral("checksum")] = sink;
+    return result;
+}
+
+// =============================================================================
+// compareHexDump() — Coste de generar el texto de un hex dump
+// =============================================================================
+// Es lo que antes se hacia por CADA trama enviada o recibida. El sink suma
+// la longitud de las cadenas para que no se puedan descartar.
+// =============================================================================
+QVariantMap StanagBenchmark::compareHexDump(int frames)
+{
+    frames = qMax(frames, 1);
+    const QList<QByteArray> samples = sampleFrames(64);
+    const int sampleCount = samples.size();
+
+    qint64 sink = 0;
+    QElapsedTimer timer;
+
+    // --- Camino clasico: QByteArray intermedio + QString + toUpper() ---
+    timer.start();
+    for (int n = 0; n < frames; ++n) {
+        const QString hex = QString::fromLatin1(samples[n % sampleCount].toHex(' ')).toUpper();
+        sink += hex.size();
+    }
+    const qint64 legacyNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    // --- HexFormatter: una reserva, SSE2 ---
+    timer.restart();
+    for (int n = 0; n < frames; ++n) {
+        const QString hex = HexFormatter::format(samples[n % sampleCount]);
+        sink += hex.size();
+    }
+    const qint64 fastNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    const double legacyFps = frames * 1e9 / legacyNs;
+    const double fastFps = frames * 1e9 / fastNs;
+
+    QVariantMap result;
+    result[QStringLiteral("frames")] = frames;
+    result[QStringLiteral("legacyFramesPerSec")] = legacyFps;
+    result[QStringLiteral("fastFramesPerSec")] = fastFps;
+    result[QStringLiteral("legacyNsPerFrame")] = double(legacyNs) / frames;
+    result[QStringLiteral("fastNsPerFrame")] = double(fastNs) / frames;
+    result[QStringLiteral("speedup")] = fastFps / legacyFps;
+    result[QStringLiteral("checksum")] = double(sink);
+    return result;
+}
+
+// =============================================================================
+// compareMaskDensity() — Coste por trama segun los campos presentes
+// =============================================================================
+// encode() se mide sobre mensajes ya construidos (el coste de construir el
+// StanagMessage no cuenta); decode() y decodeView() sobre sus tramas ya
+// codificadas. El sink mezcla los tres caminos.
+// =============================================================================
+QVariantList StanagBenchmark::compareMaskDensity(int frames)
+{
+    static constexpr int kFieldCounts[] = { 1, 2, 4, 7, 10, 14 };
+
+    frames = qMax(frames, 1);
+    double sink = 0.0;
+    QVariantList rows;
+
+    for (int fieldCount : kFieldCounts) {
+        const QList<StanagMessage> messages = sampleMessages(64, fieldCount);
+        const int sampleCount = int(messages.size());
+
+        QList<QByteArray> samples;
+        samples.reserve(sampleCount);
+        qint64 totalSize = 0;
+        for (const StanagMessage &msg : messages) {
+            samples.append(StanagCodec::encode(msg));
+            totalSize += samples.constLast().size();
+        }
+
+        QElapsedTimer timer;
+
+        // --- encode() ---
+        timer.start();
+        for (int n = 0; n < frames; ++n)
+            sink += StanagCodec::encode(messages[n % sampleCount]).size();
+        const qint64 encodeNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+        // --- decode() (StanagMessage nuevo por trama) ---
+        timer.restart();
+        for (int n = 0; n < frames; ++n) {
+            StanagMessage msg;
+            if (StanagCodec::decode(samples[n % sampleCount], msg) && !msg.fields.isEmpty())
+                sink += msg.fields.constFirst().value;
+        }
+        const qint64 decodeNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+        // --- decodeView() (zero-copy) ---
+        timer.restart();
+        for (int n = 0; n < frames; ++n) {
+            StanagFrameView view;
+            if (StanagCodec::decodeView(samples[n % sampleCount], view))
+                sink += view.values[qCountTrailingZeroBits(quint32(view.presenceMask))];
+        }
+        const qint64 decodeViewNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+        QVariantMap row;
+        row[QStringLiteral("fields")] = fieldCount;
+        row[QStringLiteral("frameSize")] = double(totalSize) / sampleCount;
+        row[QStringLiteral("encodeFramesPerSec")] = frames * 1e9 / encodeNs;
+        row[QStringLiteral("decodeFramesPerSec")] = frames * 1e9 / decodeNs;
+        row[QStringLiteral("decodeViewFramesPerSec")] = frames * 1e9 / decodeViewNs;
+        row[QStringLiteral("encodeNs")] = double(encodeNs) / frames;
+        row[QStringLiteral("decodeNs")] = double(decodeNs) / frames;
+        row[QStringLiteral("decodeViewNs")] = double(decodeViewNs) / frames;
+        row[QStringLiteral("checksum")] = sink;
+        rows.append(row);
+    }
+
+    return rows;
+}
+
+// =============================================================================
+// compareChecksums() — Kernels de checksum por tamano de trama
+// =============================================================================
+// Cada iteracion cambia el primer byte del buffer: asi el compilador no
+// puede sacar del bucle el calculo (la referencia byte a byte esta en este
+// mismo fichero y podria verla entera). El coste de esa escritura es el
+// mismo para todos los kernels.
+//
+// Con tramas pequenas domina el coste fijo por llamada; con tramas grandes
+// se ve el ancho de cada kernel (1 byte, 32 bytes, tabla, slice-by-8).
+// =============================================================================
+namespace {
+
+quint8 xorBytewise(QByteArrayView data)
+{
+    quint8 result = 0;
+    for (char byte : data)
+        result ^= static_cast<quint8>(byte);
+    return result;
+}
+
+} // namespace
+
+QVariantList StanagBenchmark::compareChecksums(int megabytesPerCase)
+{
+    static constexpr int kSizes[] = { 13, 47, 256, 1500, 9000, 65536 };
+
+    const qint64 bytesPerCase = qint64(qBound(1, megabytesPerCase, 1024)) * 1024 * 1024;
+
+    QByteArray buffer(kSizes[std::size(kSizes) - 1], Qt::Uninitialized);
+    quint32 state = 0x4586u;
+    for (char &byte : buffer) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<char>(state >> 24);
+    }
+    char *data = buffer.data();
+
+    quint32 sink = 0;
+    QVariantList rows;
+
+    for (int size : kSizes) {
+        const QByteArrayView view(data, size);
+        const qint64 iterations = qMax<qint64>(bytesPerCase / size, 1);
+        QElapsedTimer timer;
+
+        auto measure = [&](auto kernel) {
+            timer.start();
+            for (qint64 n = 0; n < iterations; ++n) {
+                data[0] = static_cast<char>(n);
+                sink += kernel(view);
+            }
+            return qMax<qint64>(timer.nsecsElapsed(), 1);
+        };
+
+        const qint64 bytewiseNs = measure(xorBytewise);
+        const qint64 wideNs = measure(StanagChecksum::xor8);
+        const qint64 crc16Ns = measure(StanagChecksum::crc16);
+        const qint64 crc32Ns = measure(StanagChecksum::crc32);
+
+        // bytes/ns * 1e9 / 2^20 = MB/s
+        const double totalBytes = double(iterations) * size;
+        auto mbps = [totalBytes](qint64 ns) { return totalBytes * 1e9 / ns / (1024.0 * 1024.0); };
+
+        QVariantMap row;
+        row[QStringLiteral("size")] = size;
+        row[QStringLiteral("iterations")] = iterations;
+        row[QStringLiteral("xorBytewiseMBps")] = mbps(bytewiseNs);
+        row[QStringLiteral("xorWideMBps")] = mbps(wideNs);
+        row[QStringLiteral("crc16MBps")] = mbps(crc16Ns);
+        row[QStringLiteral("crc32MBps")] = mbps(crc32Ns);
+        row[QStringLiteral("xorBytewiseNs")] = double(bytewiseNs) / iterations;
+        row[QStringLiteral("xorWideNs")] = double(wideNs) / iterations;
+        row[QStringLiteral("crc16Ns")] = double(crc16Ns) / iterations;
+        row[QStringLiteral("crc32Ns")] = double(crc32Ns) / iterations;
+        row[QStringLiteral("checksum")] = sink;
+        rows.append(row);
+    }
+
+    return rows;
+}
@@ -0,0 +1,104 @@
+// =============================================================================
+// stanagbenchmark.h — Microbenchmarks del codec STANAG 4586
+// =============================================================================
+//
+// PATRON: Clase utilitaria con metodos estaticos (igual que StanagCodec).
+//
+// Mide el rendimiento del codec en tramas por segundo para poder comparar
+// implementaciones alternativas con numeros, no con intuicion. Cada metodo
+// devuelve un QVariantMap que EthernetController reenvia tal cual a QML:
+//
+//   var r = controller.runDecodeBenchmark(200000)
+//   r.legacyFramesPerSec   // decode() a un StanagMessage nuevo
+//   r.pooledFramesPerSec   // decode() a un mensaje de StanagMessagePool
+//   r.fastFramesPerSec     // decodeView() sin copias
+//   r.speedup              // fast / legacy
+//   r.pooledReuseRate      // acquire() servidos sin crear mensaje (1 = objetivo)
+//
+// METODOLOGIA:
+//   - Se pre-codifica un conjunto pequeno de tramas variadas (distintos
+//     presenceMask) ANTES de medir, para que el coste de encode no
+//     contamine la medicion de decode.
+//   - Se recorre ese conjunto en bucle hasta decodificar N tramas.
+//   - Los valores decodificados se acumulan en una variable "sink" para
+//     que el optimizador no pueda eliminar el trabajo.
+//   - QElapsedTimer::nsecsElapsed() usa el reloj monotono del sistema.
+//
+// Se ejecuta de forma SINCRONA en el hilo que llama (el de QML): es una
+// herramienta de medicion puntual, no algo que corra durante la captura.
+// Para seguir regresiones con numeros comparables entre compilaciones esta
+// el benchmark standalone stanagcodecbench (benchmarks/, QBENCHMARK), que
+// reutiliza sampleMessages().
+// =============================================================================
+
+#ifndef STANAGBENCHMARK_H
+#define STANAGBENCHMARK_H
+
+#include <QByteArray>
+#include <QList>
+#include <QVariantList>
+#include <QVariantMap>
+#include "stanagmessage.h"
+
+class StanagBenchmark
+{
+public:
+    // =========================================================================
+    // compareDecode() — decode() (nuevo / con pool) vs decodeView()
+    // =========================================================================
+    // Decodifica 'frames' tramas con cada implementacion y devuelve:
+    //   { frames, legacyFramesPerSec, pooledFramesPerSec, fastFramesPerSec,
+    //     speedup, legacyNsPerFrame, pooledNsPerFrame, fastNsPerFrame,
+    //     pooledReuseRate, pooledMessages }
+    // pooledReuseRate y pooledMessages son los contadores del pool durante
+    // la medicion; las reservas de heap reales por trama las mide
+    // stanagcodecbench (benchmarks/), que cuenta malloc.
+    // =========================================================================
+    static QVariantMap compareDecode(int frames);
+
+    // =========================================================================
+    // compareHexDump() — toHex(' ').toUpper() vs HexFormatter::format()
+    // =========================================================================
+    // Genera el hex dump de 'frames' tramas con cada metodo. Mismas claves
+    // que compareDecode() para que QML los muestre igual.
+    // =========================================================================
+    static QVariantMap compareHexDump(int frames);
+
+    // =========================================================================
+    // compareChecksums() — Throughput de los kernels de checksum
+    // =========================================================================
+    // Para cada tamano de trama (13 B = trama minima ... 64 KB) procesa
+    // ~'megabytesPerCase' MB con cada kernel y devuelve una fila por tamano:
+    //   { size, iterations,
+    //     xorBytewiseMBps, xorWideMBps, crc16MBps, crc32MBps,
+    //     xorBytewiseNs, xorWideNs, crc16Ns, crc32Ns }   // ns por trama
+    // xorBytewise es el bucle original de computeChecksum() (referencia).
+    // =========================================================================
+    static QVariantList compareChecksums(int megabytesPerCase);
+
+    // =========================================================================
+    // compareMaskDensity() — encode/decode segun los campos presentes
+    // =========================================================================
+    // Para 1, 2, 4, 7, 10 y 14 campos activos mide 'frames' tramas con
+    // cada camino y devuelve una fila por densidad:
+    //   { fields, frameSize,
+    //     encodeFramesPerSec, decodeFramesPerSec, decodeViewFramesPerSec,
+    //     encodeNs, decodeNs, decodeViewNs }               // ns por trama
+    // frameSize es el tamano medio de las tramas del caso (con XOR).
+    // =========================================================================
+    static QVariantList compareMaskDensity(int frames);
+
+    // =========================================================================
+    // sampleFrames() — Conjunto de tramas de prueba pre-codificadas
+    // =========================================================================
+    // Genera 'count' tramas validas con presenceMask variados (desde un
+    // solo campo hasta los 14) y valores deterministas.
+    // =========================================================================
+    static QList<QByteArray> sampleFrames(int count);
+
+    // Igual, pero con exactamente 'fieldCount' campos activos (1-14) en
+    // posiciones variadas. Devuelve los mensajes, listos para encode().
+    static QList<StanagMessage> sampleMessages(int count, int fieldCount);
+};
+
+#endif // STANAGBENCHMARK_H
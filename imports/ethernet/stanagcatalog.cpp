@@ -0,0 +1,148 @@
+// =============================================================================
+// stanagcatalog.cpp — Carga y compilacion del catalogo de mensajes
+// =============================================================================
+
+#include "stanagcatalog.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtEndian>
+
+namespace {
+
+constexpr int kIndexSize = 65536;
+
+struct TypeName
+{
+    const char *name;
+    StanagFieldType type;
+};
+
+constexpr TypeName kTypeNames[] = {
+    { "float32", StanagFieldType::Float32 },
+    { "uint32",  StanagFieldType::UInt32 },
+    { "int32",   StanagFieldType::Int32 },
+    { "uint16",  StanagFieldType::UInt16 },
+    { "int16",   StanagFieldType::Int16 },
+    { "uint8",   StanagFieldType::UInt8 },
+    { "int8",    StanagFieldType::Int8 },
+};
+
+bool fail(QString *error, const QString &text)
+{
+    if (error)
+        *error = text;
+    return false;
+}
+
+} // namespace
+
+StanagCatalog::StanagCatalog()
+    : m_index(new quint16[kIndexSize]())
+{
+    m_plans.append(StanagCodec::defaultPlan());
+}
+
+bool StanagCatalog::parseType(const QString &name, StanagFieldType *type)
+{
+    for (const TypeName &entry : kTypeNames) {
+        if (name == QLatin1String(entry.name)) {
+            *type = entry.type;
+            return true;
+        }
+    }
+    return false;
+}
+
+QString StanagCatalog::typeName(StanagFieldType type)
+{
+    for (const TypeName &entry : kTypeNames) {
+        if (entry.type == type)
+            return QString::fromLatin1(entry.name);
+    }
+    return QString();
+}
+
+// =============================================================================
+// loadJson()
+// =============================================================================
+// Se construye en variables locales y solo al final se sustituyen plans e
+// indice: un JSON invalido no deja el catalogo a medias.
+// =============================================================================
+bool StanagCatalog::loadJson(QByteArrayView json, QString *error)
+{
+    QJsonParseError parseError;
+    const QJsonDocument doc = QJsonDocument::fromJson(json.toByteArray(), &parseError);
+    if (doc.isNull())
+        return fail(error, parseError.errorString());
+
+    const QJsonArray messages = doc.object().value(QStringLiteral("messages")).toArray();
+
+    QList<StanagMessagePlan> plans;
+    plans.reserve(messages.size() + 1);
+    plans.append(StanagCodec::defaultPlan());
+
+    std::unique_ptr<quint16[]> index(new quint16[kIndexSize]());
+
+    for (qsizetype m = 0; m < messages.size(); ++m) {
+        const QJsonObject message = messages[m].toObject();
+        const int id = message.value(QStringLiteral("id")).toInt(-1);
+        const QString name = message.value(QStringLiteral("name")).toString();
+
+        if (id < 1 || id > 65535)
+            return fail(error, QStringLiteral("Message %1: invalid id").arg(m));
+        if (index[id] != 0)
+            return fail(error, QStringLiteral("Message %1: duplicate id %2").arg(m).arg(id));
+
+        const QJsonArray fieldArray = message.value(QStringLiteral("fields")).toArray();
+        if (fieldArray.isEmpty() || fieldArray.size() > kStanagMaxFields)
+            return fail(error, QStringLiteral("Message %1: needs 1-%2 fields, has %3")
+                                   .arg(id).arg(kStanagMaxFields).arg(fieldArray.size()));
+
+        QList<FieldDef> fields;
+        fields.reserve(fieldArray.size());
+        for (qsizetype f = 0; f < fieldArray.size(); ++f) {
+            const QJsonObject field = fieldArray[f].toObject();
+            const QString fieldName = field.value(QStringLiteral("name")).toString();
+            const QString typeText = field.value(QStringLiteral("type")).toString();
+
+            StanagFieldType type = StanagFieldType::UInt16;
+            if (!parseType(typeText, &type))
+                return fail(error, QStringLiteral("Message %1, field %2: unknown type '%3'")
+                                       .arg(id).arg(f).arg(typeText));
+            if (fieldName.isEmpty())
+                return fail(error, QStringLiteral("Message %1, field %2: missing name")
+                                       .arg(id).arg(f));
+
+            fields.append({ fieldName, stanagFieldTypeSize(type), type });
+        }
+
+        index[id] = quint16(plans.size());
+        plans.append(StanagMessagePlan::compile(quint16(id), name, fields));
+    }
+
+    m_plans = std::move(plans);
+    m_index = std::move(index);
+    return true;
+}
+
+bool StanagCatalog::loadFile(const QString &path, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return fail(error, file.errorString());
+    return loadJson(file.readAll(), error);
+}
+
+// =============================================================================
+// decodeView() — Plan elegido por el messageId de la trama
+// =============================================================================
+// Si la trama no llega ni a messageId, decodeView() la rechazara igual: se
+// le pasa el plan por defecto.
+// =============================================================================
+bool StanagCatalog::decodeView(QByteArrayView data, StanagFrameView &view) const
+{
+    const quint16 messageId = data.size() >= 2 ? qFromBigEndian<quint16>(data.data()) : 0;
+    return StanagCodec::decodeView(data, view, plan(messageId));
+}
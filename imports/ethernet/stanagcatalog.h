@@ -0,0 +1,80 @@
+// =============================================================================
+// stanagcatalog.h — Catalogo de mensajes STANAG: messageId → plan de campos
+// =============================================================================
+//
+// PATRON: Clase de valor inmutable una vez cargada. Quien decodifica la
+// comparte con std::shared_ptr<const StanagCatalog>: recargar el catalogo
+// es crear uno nuevo y cambiar el puntero, nunca modificar uno en uso (el
+// ReceiveWorker lo lee desde otro hilo).
+//
+// FORMATO (JSON):
+//   {
+//     "messages": [
+//       { "id": 101, "name": "Inertial States",
+//         "fields": [ { "name": "Latitude", "type": "float32" },
+//                     { "name": "Roll",     "type": "int16" }, ... ] },
+//       ...
+//     ]
+//   }
+//   Tipos: float32, uint32, int32, uint16, int16, uint8, int8. Como mucho
+//   14 campos por mensaje; el campo N es el bit N del presenceMask.
+//
+// PLANES Y BUSQUEDA O(1):
+//   Cada mensaje se compila a un StanagMessagePlan (tipos, tamanos y
+//   planos de tamano por bit) al cargar. plan(messageId) es un acceso a un
+//   array plano de 65536 indices de 16 bits (128 KB) → plans()[indice],
+//   sin hash ni busqueda. El indice 0 es el plan por defecto
+//   (StanagCodec::defaultPlan(), la telemetria de 14 campos): los
+//   messageId que no estan en el catalogo se decodifican como siempre.
+// =============================================================================
+
+#ifndef STANAGCATALOG_H
+#define STANAGCATALOG_H
+
+#include <QByteArrayView>
+#include <QList>
+#include <QString>
+#include <memory>
+#include "stanagcodec.h"
+
+class StanagCatalog
+{
+public:
+    // Catalogo vacio: todos los messageId usan el plan por defecto
+    StanagCatalog();
+
+    // =========================================================================
+    // loadJson() / loadFile() — Reemplazar el contenido
+    // =========================================================================
+    // Todo o nada: si algo no es valido (id repetido o fuera de 1-65535,
+    // tipo desconocido, mas de 14 campos...) se describe en 'error' y el
+    // catalogo queda como estaba.
+    // =========================================================================
+    bool loadJson(QByteArrayView json, QString *error = nullptr);
+    bool loadFile(const QString &path, QString *error = nullptr);
+
+    // Plan de un messageId (el por defecto si no esta en el catalogo)
+    const StanagMessagePlan &plan(quint16 messageId) const
+    {
+        return m_plans[m_index[messageId]];
+    }
+
+    bool contains(quint16 messageId) const { return m_index[messageId] != 0; }
+
+    // plans()[0] es el plan por defecto; el resto, en el orden del JSON
+    const QList<StanagMessagePlan> &plans() const { return m_plans; }
+    int messageCount() const { return int(m_plans.size()) - 1; }
+
+    // decodeView() con el plan del messageId de la propia trama
+    bool decodeView(QByteArrayView data, StanagFrameView &view) const;
+
+    // Nombre de tipo en el JSON ↔ StanagFieldType
+    static bool parseType(const QString &name, StanagFieldType *type);
+    static QString typeName(StanagFieldType type);
+
+private:
+    QList<StanagMessagePlan> m_plans;
+    std::unique_ptr<quint16[]> m_index;     // 65536 entradas
+};
+
+#endif // STANAGCATALOG_H
@@ -0,0 +1,221 @@
+// =============================================================================
+// stanagchecksum.cpp — Implementacion de los kernels de checksum
+// =============================================================================
+
+#include "stanagchecksum.h"
+#include <QtEndian>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define STANAGCHECKSUM_SSE2 1
+#endif
+
+#if defined(STANAGCHECKSUM_SSE2) && defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define STANAGCHECKSUM_AVX2 1
+#endif
+
+namespace {
+
+// =============================================================================
+// Tablas CRC generadas en tiempo de compilacion
+// =============================================================================
+// CRC-32 (reflejado, poly 0xEDB88320). Slice-by-8:
+//   tabla[0][b] = CRC de un byte b
+//   tabla[k][b] = CRC de b seguido de k bytes a cero
+// Con ellas, 8 bytes de entrada se reducen con 8 consultas independientes
+// (que la CPU puede solapar) en vez de 8 consultas encadenadas.
+// =============================================================================
+using Crc32Tables = std::array<std::array<quint32, 256>, 8>;
+
+constexpr Crc32Tables makeCrc32Tables()
+{
+    Crc32Tables tables{};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        tables[0][i] = crc;
+    }
+    for (int k = 1; k < 8; ++k) {
+        for (quint32 i = 0; i < 256; ++i) {
+            const quint32 prev = tables[k - 1][i];
+            tables[k][i] = (prev >> 8) ^ tables[0][prev & 0xFF];
+        }
+    }
+    return tables;
+}
+
+// CRC-16/CCITT-FALSE (no reflejado, poly 0x1021)
+constexpr std::array<quint16, 256> makeCrc16Table()
+{
+    std::array<quint16, 256> table{};
+    for (quint32 i = 0; i < 256; ++i) {
+        quint32 crc = i << 8;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021u : crc << 1;
+        table[i] = quint16(crc);
+    }
+    return table;
+}
+
+constexpr Crc32Tables kCrc32Tables = makeCrc32Tables();
+constexpr std::array<quint16, 256> kCrc16Table = makeCrc16Table();
+
+static_assert(kCrc32Tables[0][1] == 0x77073096u, "tabla CRC-32 incorrecta");
+static_assert(kCrc16Table[1] == 0x1021u, "tabla CRC-16 incorrecta");
+
+// Plegar un acumulador de 64 bits a un byte: XOR de sus 8 bytes
+inline quint8 foldXor64(quint64 acc)
+{
+    acc ^= acc >> 32;
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    return quint8(acc);
+}
+
+#ifdef STANAGCHECKSUM_AVX2
+// Solo se llama si la CPU soporta AVX2 (comprobado en tiempo de ejecucion).
+// El atributo target permite usar intrinsics AVX2 sin compilar todo el
+// modulo con -mavx2.
+__attribute__((target("avx2")))
+quint64 xorBlocksAvx2(const uchar *p, qsizetype blocks)
+{
+    __m256i acc = _mm256_setzero_si256();
+    for (qsizetype b = 0; b < blocks; ++b)
+        acc = _mm256_xor_si256(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + b * 32)));
+
+    const __m128i half = _mm_xor_si128(_mm256_castsi256_si128(acc),
+                                       _mm256_extracti128_si256(acc, 1));
+    return quint64(_mm_cvtsi128_si64(half)) ^ quint64(_mm_cvtsi128_si64(_mm_unpackhi_epi64(half, half)));
+}
+
+bool cpuHasAvx2()
+{
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    return hasAvx2;
+}
+#endif
+
+} // namespace
+
+// =============================================================================
+// xor8() — Reduccion XOR ancha
+// =============================================================================
+// Cada etapa consume todos los bloques completos de su ancho y deja el resto
+// a la siguiente. El acumulador de 64 bits contiene 8 "carriles" de XOR
+// independientes; al final se pliegan en un solo byte.
+// =============================================================================
+quint8 StanagChecksum::xor8(QByteArrayView data)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data.data());
+    qsizetype n = data.size();
+    quint64 acc = 0;
+
+#ifdef STANAGCHECKSUM_AVX2
+    if (n >= 64 && cpuHasAvx2()) {
+        const qsizetype blocks = n / 32;
+        acc ^= xorBlocksAvx2(p, blocks);
+        p += blocks * 32;
+        n -= blocks * 32;
+    }
+#endif
+
+#ifdef STANAGCHECKSUM_SSE2
+    if (n >= 16) {
+        __m128i vacc = _mm_setzero_si128();
+        for (; n >= 16; p += 16, n -= 16)
+            vacc = _mm_xor_si128(vacc, _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+        acc ^= quint64(_mm_cvtsi128_si64(vacc))
+               ^ quint64(_mm_cvtsi128_si64(_mm_unpackhi_epi64(vacc, vacc)));
+    }
+#endif
+
+    // Palabras de 64 bits (memcpy: lectura sin requisitos de alineacion)
+    for (; n >= 8; p += 8, n -= 8) {
+        quint64 word;
+        std::memcpy(&word, p, sizeof(word));
+        acc ^= word;
+    }
+
+    quint8 result = foldXor64(acc);
+    for (; n > 0; ++p, --n)
+        result ^= *p;
+    return result;
+}
+
+// =============================================================================
+// crc16() — CRC-16/CCITT-FALSE, un byte por iteracion con tabla
+// =============================================================================
+// Valor de control: crc16("123456789") = 0x29B1
+// =============================================================================
+quint16 StanagChecksum::crc16(QByteArrayView data)
+{
+    quint16 crc = 0xFFFF;
+    for (char c : data) {
+        const uchar byte = static_cast<uchar>(c);
+        crc = quint16((crc << 8) ^ kCrc16Table[((crc >> 8) ^ byte) & 0xFF]);
+    }
+    return crc;
+}
+
+// =============================================================================
+// crc32() — CRC-32 IEEE, slice-by-8
+// =============================================================================
+// Valor de control: crc32("123456789") = 0xCBF43926
+// Los 8 bytes se leen como dos palabras LittleEndian porque el CRC reflejado
+// consume primero el bit menos significativo de cada byte.
+// =============================================================================
+quint32 StanagChecksum::crc32(QByteArrayView data)
+{
+    const uchar *p = reinterpret_cast<const uchar *>(data.data());
+    qsizetype n = data.size();
+    quint32 crc = 0xFFFFFFFFu;
+    const auto &t = kCrc32Tables;
+
+    for (; n >= 8; p += 8, n -= 8) {
+        const quint32 one = qFromLittleEndian<quint32>(p) ^ crc;
+        const quint32 two = qFromLittleEndian<quint32>(p + 4);
+        crc = t[7][one & 0xFF] ^ t[6][(one >> 8) & 0xFF]
+            ^ t[5][(one >> 16) & 0xFF] ^ t[4][one >> 24]
+            ^ t[3][two & 0xFF] ^ t[2][(two >> 8) & 0xFF]
+            ^ t[1][(two >> 16) & 0xFF] ^ t[0][two >> 24];
+    }
+
+    for (; n > 0; ++p, --n)
+        crc = (crc >> 8) ^ t[0][(crc ^ *p) & 0xFF];
+
+    return ~crc;
+}
+
+quint32 StanagChecksum::compute(QByteArrayView data, StanagChecksumMode mode)
+{
+    switch (mode) {
+    case StanagChecksumMode::Crc16Ccitt: return crc16(data);
+    case StanagChecksumMode::Crc32:      return crc32(data);
+    case StanagChecksumMode::Xor8:       break;
+    }
+    return xor8(data);
+}
+
+void StanagChecksum::writeTrailer(uchar *dst, quint32 value, StanagChecksumMode mode)
+{
+    switch (mode) {
+    case StanagChecksumMode::Crc16Ccitt: qToBigEndian<quint16>(quint16(value), dst); return;
+    case StanagChecksumMode::Crc32:      qToBigEndian<quint32>(value, dst); return;
+    case StanagChecksumMode::Xor8:       break;
+    }
+    dst[0] = uchar(value);
+}
+
+quint32 StanagChecksum::readTrailer(const uchar *src, StanagChecksumMode mode)
+{
+    switch (mode) {
+    case StanagChecksumMode::Crc16Ccitt: return qFromBigEndian<quint16>(src);
+    case StanagChecksumMode::Crc32:      return qFromBigEndian<quint32>(src);
+    case StanagChecksumMode::Xor8:       break;
+    }
+    return src[0];
+}
@@ -0,0 +1,79 @@
+// =============================================================================
+// stanagchecksum.h — Kernels de checksum de la trama STANAG
+// =============================================================================
+//
+// PATRON: Clase utilitaria con metodos estaticos (igual que StanagCodec).
+//
+// La trama termina en un "trailer" de integridad cuyo tamano depende del modo:
+//
+//   Modo          Trailer   Algoritmo
+//   ───────────   ───────   ─────────────────────────────────────────────
+//   Xor8          1 byte    XOR de todos los bytes (el original)
+//   Crc16Ccitt    2 bytes   CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+//   Crc32         4 bytes   CRC-32 IEEE 802.3 (el de Ethernet/zlib)
+//
+// El trailer se escribe en BigEndian, como el resto de la trama.
+//
+// DETECCION: el header lleva payloadLen, asi que el receptor sabe cuantos
+// bytes sobran tras el payload: 1, 2 o 4 identifican el modo sin necesidad
+// de un campo extra (modeForTrailer()). Por eso un emisor puede cambiar de
+// modo y el receptor lo sigue automaticamente.
+//
+// RENDIMIENTO:
+//   - xor8(): reduccion ancha. XOR es asociativo, asi que se pueden
+//     combinar 8/16/32 bytes a la vez y plegar el acumulador al final.
+//     AVX2 (32 B, si la CPU lo soporta) → SSE2 (16 B) → palabras de 64 bits
+//     → bytes sueltos para la cola.
+//   - crc32(): "slice-by-8": 8 tablas de 256 entradas generadas en tiempo
+//     de compilacion; procesa 8 bytes por iteracion en vez de 1.
+//   - crc16(): tabla de 256 entradas, un byte por iteracion.
+// =============================================================================
+
+#ifndef STANAGCHECKSUM_H
+#define STANAGCHECKSUM_H
+
+#include <QByteArrayView>
+#include <QtGlobal>
+
+enum class StanagChecksumMode : quint8
+{
+    Xor8       = 0,
+    Crc16Ccitt = 1,
+    Crc32      = 2
+};
+
+class StanagChecksum
+{
+public:
+    // Bytes que ocupa el trailer en la trama (1, 2 o 4)
+    static constexpr int trailerSize(StanagChecksumMode mode)
+    {
+        return mode == StanagChecksumMode::Crc32      ? 4
+             : mode == StanagChecksumMode::Crc16Ccitt ? 2
+                                                      : 1;
+    }
+
+    // Modo correspondiente a un trailer de 'bytes' bytes. Cualquier otro
+    // tamano se trata como Xor8 sobre el ultimo byte (comportamiento previo).
+    static constexpr StanagChecksumMode modeForTrailer(qsizetype bytes)
+    {
+        return bytes == 4 ? StanagChecksumMode::Crc32
+             : bytes == 2 ? StanagChecksumMode::Crc16Ccitt
+                          : StanagChecksumMode::Xor8;
+    }
+
+    // Calcular el checksum de 'data' en el modo dado (valor sin signo; solo
+    // los trailerSize(mode) bytes bajos son significativos)
+    static quint32 compute(QByteArrayView data, StanagChecksumMode mode);
+
+    // Escribir / leer el trailer en BigEndian
+    static void writeTrailer(uchar *dst, quint32 value, StanagChecksumMode mode);
+    static quint32 readTrailer(const uchar *src, StanagChecksumMode mode);
+
+    // --- Kernels individuales ---
+    static quint8 xor8(QByteArrayView data);
+    static quint16 crc16(QByteArrayView data);
+    static quint32 crc32(QByteArrayView data);
+};
+
+#endif // STANAGCHECKSUM_H
@@ -3,8 +3,9 @@
 // =============================================================================
 //
 // Este archivo contiene la logica central de serializacion/deserializacion.
-// Usa QDataStream para escribir/leer datos en formato BigEndian (network
-// byte order), que es el estandar en protocolos de comunicacion.
+// Lee y escribe datos en formato BigEndian (network byte order), que es el
+// estandar en protocolos de comunicacion: qToBigEndian()/qFromBigEndian()
+// sobre punteros, en header y payload.
 //
 // CONCEPTOS CLAVE:
 //
@@ -16,13 +17,16 @@
 //      nativo de x86/x64. Ejemplo: 0x1234 se almacena como [0x34, 0x12].
 //    - Los protocolos de red usan BigEndian por convencion historica (RFC 1700).
 //
-// 2. QDATASTREAM
+// 2. QDATASTREAM (y por que aqui no se usa)
 //    - Clase de Qt para lectura/escritura binaria secuencial.
 //    - setByteOrder(QDataStream::BigEndian) asegura que todos los operadores
 //      << y >> hacen la conversion de byte order automaticamente.
 //    - Maneja tipos primitivos (quint16, float, etc.) y tipos Qt (QString...).
 //    - El "stream" avanza automaticamente al escribir/leer — no necesitamos
 //      gestionar offsets manualmente.
+//    - Pero QDataStream(const QByteArray &) crea un QBuffer en heap: un
+//      decode() con stream nunca podria ser libre de reservas. El header
+//      se lee con qFromBigEndian en offsets fijos, igual que decodeView().
 //
 // 3. BITMASK (MASCARA DE BITS)
 //    - Un entero donde cada bit individual tiene significado propio.
@@ -30,43 +34,225 @@
 //    - Para activar el bit N: mask |= (1 << N)
 //    - Patron muy comun en protocolos: indica presencia/ausencia de campos
 //      opcionales sin desperdiciar bytes enteros por cada flag.
+//
+// 4. CODEC GUIADO POR TABLA
+//    - El tipo de cada campo sale del plan del mensaje (StanagMessagePlan;
+//      por defecto kStanagFieldLayout compilado), no de cadenas de if por
+//      indice. El tipo indexa una tabla de punteros a funcion
+//      (kFieldWriters / kFieldReaders): el bucle de encode/decode es el
+//      mismo para los 14 campos y para cualquier tipo de mensaje.
+//    - Los bucles recorren SOLO los bits activos: qCountTrailingZeroBits()
+//      da el indice del bit mas bajo y "bits &= bits - 1" lo apaga.
+//
+// 5. TRAILER DE CHECKSUM VARIABLE
+//    - La trama termina en 1 (XOR), 2 (CRC-16) o 4 (CRC-32) bytes de
+//      checksum. Como payloadLen va en el header, los bytes que sobran tras
+//      el payload indican el modo (ver trailerOf()). Los kernels viven en
+//      StanagChecksum (stanagchecksum.cpp).
 // =============================================================================
 
 #include "stanagcodec.h"
-#include <QDataStream>
-#include <QIODevice>
 #include <QtEndian>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
 // =============================================================================
-// fieldDefinitions() — Tabla estatica de los 14 campos
+// fieldDefinitions() — Tabla estatica de los 14 campos (con QString)
 // =============================================================================
 // La variable "static const" se inicializa una sola vez y persiste durante
 // toda la ejecucion del programa. Devolver una referencia evita copias.
 //
-// Los tamanos de campo (2 o 4 bytes) determinan cuantos bytes se leen/escriben
-// del payload por cada campo presente.
+// Se construye a partir de kStanagFieldLayout (via defaultPlan()). Los
+// QString resultantes se comparten (implicit sharing) con cada StanagField
+// que copia su nombre, asi que asignar defs[i].name no reserva memoria.
 // =============================================================================
 const QList<FieldDef> &StanagCodec::fieldDefinitions()
 {
-    static const QList<FieldDef> defs = {
-        { QStringLiteral("Latitude"),        4 },  // Bit 0:  float32  (-90 a 90)
-        { QStringLiteral("Longitude"),       4 },  // Bit 1:  float32  (-180 a 180)
-        { QStringLiteral("Altitude"),        2 },  // Bit 2:  int16    (metros)
-        { QStringLiteral("Heading"),         2 },  // Bit 3:  uint16   (0-359 grados)
-        { QStringLiteral("Speed"),           2 },  // Bit 4:  uint16   (km/h)
-        { QStringLiteral("Roll"),            2 },  // Bit 5:  int16    (-180 a 180)
-        { QStringLiteral("Pitch"),           2 },  // Bit 6:  int16    (-90 a 90)
-        { QStringLiteral("Yaw"),             2 },  // Bit 7:  int16    (-180 a 180)
-        { QStringLiteral("Fuel Level"),      2 },  // Bit 8:  uint16   (porcentaje)
-        { QStringLiteral("Engine RPM"),      2 },  // Bit 9:  uint16   (RPM)
-        { QStringLiteral("Battery Voltage"), 2 },  // Bit 10: uint16   (mV)
-        { QStringLiteral("Sensor Status"),   2 },  // Bit 11: uint16   (flags)
-        { QStringLiteral("Waypoint Index"),  2 },  // Bit 12: uint16   (indice)
-        { QStringLiteral("Mission Time"),    4 },  // Bit 13: uint32   (segundos)
-    };
-    return defs;
+    return defaultPlan().fields;
+}
+
+const StanagMessagePlan &StanagCodec::defaultPlan()
+{
+    static const StanagMessagePlan plan = [] {
+        QList<FieldDef> fields;
+        fields.reserve(kStanagMaxFields);
+        for (const auto &layout : kStanagFieldLayout)
+            fields.append({ QString::fromLatin1(layout.name), layout.sizeBytes, layout.type });
+        return StanagMessagePlan::compile(0, QStringLiteral("Telemetry"), fields);
+    }();
+    return plan;
+}
+
+// =============================================================================
+// StanagMessagePlan::compile() — Tabla de campos → plan
+// =============================================================================
+// El tamano sale siempre del tipo (FieldDef::sizeBytes se rellena aqui),
+// y cada campo suma su bit a los planos de tamano que le corresponden,
+// igual que stanagSizePlane() hace en tiempo de compilacion.
+// =============================================================================
+StanagMessagePlan StanagMessagePlan::compile(quint16 messageId, const QString &name,
+                                             const QList<FieldDef> &fields)
+{
+    StanagMessagePlan plan;
+    plan.messageId = messageId;
+    plan.name = name;
+
+    const int count = qMin(int(fields.size()), kStanagMaxFields);
+    plan.fields.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const StanagFieldType type = fields[i].type;
+        const int size = stanagFieldTypeSize(type);
+        const quint16 bit = quint16(1u << i);
+
+        plan.types[i] = type;
+        plan.sizes[i] = quint8(size);
+        plan.fieldMask |= bit;
+        if (size & 1) plan.sizePlane1 |= bit;
+        if (size & 2) plan.sizePlane2 |= bit;
+        if (size & 4) plan.sizePlane4 |= bit;
+        plan.fields.append({ fields[i].name, size, type });
+    }
+    return plan;
+}
+
+// =============================================================================
+// Lectores y escritores por tipo de campo
+// =============================================================================
+// Una funcion por StanagFieldType, agrupadas en tablas indexadas por el
+// valor del enum. Todas trabajan sobre punteros crudos (sin alineacion
+// requerida) con qToBigEndian / qFromBigEndian.
+//
+// Para los float32 copiamos el patron de bits a/desde un quint32 con
+// memcpy: es la forma portable (y sin undefined behavior) de reinterpretar
+// bits en C++17. El compilador lo reduce a un simple mov.
+//
+// Las conversiones double → entero replican lo que hacia el static_cast
+// de la version con QDataStream.
+// =============================================================================
+namespace {
+
+using FieldWriter = void (*)(uchar *dst, double value);
+using FieldReader = double (*)(const uchar *src);
+
+void writeFloat32(uchar *dst, double value)
+{
+    const float fval = static_cast<float>(value);
+    quint32 bits = 0;
+    std::memcpy(&bits, &fval, sizeof(bits));
+    qToBigEndian<quint32>(bits, dst);
+}
+
+void writeUInt32(uchar *dst, double value)
+{
+    qToBigEndian<quint32>(static_cast<quint32>(value), dst);
+}
+
+void writeInt16(uchar *dst, double value)
+{
+    qToBigEndian<qint16>(static_cast<qint16>(value), dst);
+}
+
+void writeUInt16(uchar *dst, double value)
+{
+    qToBigEndian<quint16>(static_cast<quint16>(value), dst);
+}
+
+void writeInt32(uchar *dst, double value)
+{
+    qToBigEndian<qint32>(static_cast<qint32>(value), dst);
+}
+
+void writeUInt8(uchar *dst, double value)
+{
+    *dst = static_cast<quint8>(value);
+}
+
+void writeInt8(uchar *dst, double value)
+{
+    *dst = static_cast<uchar>(static_cast<qint8>(value));
+}
+
+double readFloat32(const uchar *src)
+{
+    const quint32 bits = qFromBigEndian<quint32>(src);
+    float fval = 0.0f;
+    std::memcpy(&fval, &bits, sizeof(fval));
+    return static_cast<double>(fval);
+}
+
+double readUInt32(const uchar *src)
+{
+    return static_cast<double>(qFromBigEndian<quint32>(src));
+}
+
+double readInt16(const uchar *src)
+{
+    return static_cast<double>(qFromBigEndian<qint16>(src));
+}
+
+double readUInt16(const uchar *src)
+{
+    return static_cast<double>(qFromBigEndian<quint16>(src));
+}
+
+double readInt32(const uchar *src)
+{
+    return static_cast<double>(qFromBigEndian<qint32>(src));
+}
+
+double readUInt8(const uchar *src)
+{
+    return static_cast<double>(*src);
+}
+
+double readInt8(const uchar *src)
+{
+    return static_cast<double>(static_cast<qint8>(*src));
+}
+
+// Mismo orden que StanagFieldType
+constexpr FieldWriter kFieldWriters[] = {
+    writeFloat32, writeUInt32, writeInt16, writeUInt16,
+    writeInt32, writeUInt8, writeInt8
+};
+constexpr FieldReader kFieldReaders[] = {
+    readFloat32, readUInt32, readInt16, readUInt16,
+    readInt32, readUInt8, readInt8
+};
+
+inline void writeField(StanagFieldType type, uchar *dst, double value)
+{
+    kFieldWriters[int(type)](dst, value);
+}
+
+inline double readField(StanagFieldType type, const uchar *src)
+{
+    return kFieldReaders[int(type)](src);
+}
+
+// =============================================================================
+// trailerOf() — Modo de checksum y bytes cubiertos de una trama recibida
+// =============================================================================
+// extra = bytes tras el payload. 1, 2 o 4 → Xor8, Crc16Ccitt, Crc32. Con
+// cualquier otro valor se aplica la regla de siempre: XOR sobre todos los
+// bytes menos el ultimo (una trama con basura al final fallara el checksum).
+// =============================================================================
+struct TrailerInfo
+{
+    StanagChecksumMode mode;
+    qsizetype covered;      // Bytes protegidos = posicion del trailer
+};
+
+inline TrailerInfo trailerOf(qsizetype frameSize, quint16 payloadLen)
+{
+    const qsizetype extra = frameSize - kStanagHeaderSize - payloadLen;
+    const StanagChecksumMode mode = StanagChecksum::modeForTrailer(extra);
+    return { mode, frameSize - StanagChecksum::trailerSize(mode) };
 }
 
+} // namespace
+
 // =============================================================================
 // computeChecksum() — XOR acumulativo de todos los bytes
 // =============================================================================
@@ -78,216 +264,171 @@ const QList<FieldDef> &StanagCodec::fieldDefinitions()
 // Es el checksum mas simple posible. Detecta cualquier error de 1 bit,
 // pero no detecta intercambios de bytes ni errores de cantidad par de bits.
 //
-// static_cast<quint8>: asegura que trabajamos con bytes sin signo (0-255).
-// El tipo "char" de QByteArray puede ser signed en algunas plataformas,
-// lo que causaria problemas con el XOR si no hacemos el cast.
+// El bucle byte a byte se ha sustituido por StanagChecksum::xor8(), que
+// combina 8/16/32 bytes por iteracion. El resultado es identico.
 // =============================================================================
-quint8 StanagCodec::computeChecksum(const QByteArray &data)
+quint8 StanagCodec::computeChecksum(QByteArrayView data)
 {
-    quint8 result = 0;
-    for (char byte : data)
-        result ^= static_cast<quint8>(byte);
-    return result;
+    return StanagChecksum::xor8(data);
 }
 
 // =============================================================================
 // encodePayload() — Empaquetar campos presentes en bytes BigEndian
 // =============================================================================
-// Recorre los 14 bits del presenceMask. Por cada bit activo, busca el campo
-// correspondiente en msg.fields y escribe su valor en BigEndian.
-//
-// TIPOS DE CAMPO:
-//   - 4 bytes: float (campos 0,1) o uint32 (campo 13)
-//   - 2 bytes: int16 (campos 2,5,6,7) o uint16 (campos 3,4,8-12)
+// Recorre SOLO los bits activos del presenceMask:
+//   - qCountTrailingZeroBits(bits) → indice del bit activo mas bajo
+//   - bits &= bits - 1             → apagar ese bit y pasar al siguiente
 //
-// La conversion de tipos se basa en el indice del campo:
-//   - Indices 0,1 → float (latitud/longitud son punto flotante)
-//   - Indice 13 → uint32 (mission time es un timestamp grande)
-//   - Indices 2,5,6,7 → int16 (valores que pueden ser negativos)
-//   - Resto → uint16 (valores siempre positivos)
+// Por cada campo, la tabla de escritores (indexada por el tipo que da el
+// plan) escribe el valor en BigEndian y el puntero avanza su tamano. No
+// hay ramas por indice de campo: el mismo bucle sirve para todos los tipos.
 //
-// QDataStream::setFloatingPointPrecision(SinglePrecision):
-//   Por defecto QDataStream escribe doubles (8 bytes). Necesitamos floats
-//   (4 bytes) para Latitude y Longitude, asi que cambiamos la precision.
+// Los valores llegan indexados por bit (values[i]), asi que tampoco hay
+// busqueda lineal en msg.fields por cada campo (antes era O(campos^2)).
 // =============================================================================
-QByteArray StanagCodec::encodePayload(const StanagMessage &msg)
+void StanagCodec::encodePayload(const double *values, quint16 presenceMask,
+                                const StanagMessagePlan &plan, uchar *dst)
 {
-    QByteArray payload;
-    QDataStream stream(&payload, QIODevice::WriteOnly);
-    stream.setByteOrder(QDataStream::BigEndian);
-    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
-
-    const auto &defs = fieldDefinitions();
-
-    for (int i = 0; i < kStanagMaxFields; ++i) {
-        // --- Verificar si el bit i esta activo en el presenceMask ---
-        // (1 << i) crea una mascara con solo el bit i encendido.
-        // El AND (&) devuelve 0 si el bit esta apagado, o no-cero si esta activo.
-        if (!(msg.presenceMask & (1 << i)))
-            continue;  // Este campo no esta presente, saltar
-
-        // Buscar el valor del campo en la lista de campos del mensaje
-        double value = 0.0;
-        for (const auto &field : msg.fields) {
-            if (field.index == i) {
-                value = field.value;
-                break;
-            }
-        }
-
-        // Escribir el valor segun el tipo de campo
-        if (defs[i].sizeBytes == 4) {
-            if (i == 0 || i == 1) {
-                // Latitude/Longitude: float32
-                stream << static_cast<float>(value);
-            } else {
-                // Mission Time: uint32
-                stream << static_cast<quint32>(value);
-            }
-        } else {
-            // Campos de 2 bytes
-            if (i == 2 || i == 5 || i == 6 || i == 7) {
-                // Altitude, Roll, Pitch, Yaw: int16 (pueden ser negativos)
-                stream << static_cast<qint16>(value);
-            } else {
-                // Heading, Speed, Fuel, RPM, Battery, Sensor, Waypoint: uint16
-                stream << static_cast<quint16>(value);
-            }
-        }
+    for (quint32 bits = presenceMask & plan.fieldMask; bits; bits &= bits - 1) {
+        const int i = int(qCountTrailingZeroBits(bits));
+        writeField(plan.types[i], dst, values[i]);
+        dst += plan.sizes[i];
     }
-
-    return payload;
 }
 
 // =============================================================================
 // decodePayload() — Desempaquetar campos del payload BigEndian
 // =============================================================================
 // El proceso es el inverso de encodePayload():
-//   1. Recorrer los 14 bits del presenceMask
-//   2. Por cada bit activo, leer la cantidad de bytes correspondiente
-//   3. Decodificar al tipo numerico apropiado
+//   1. Recorrer los bits activos del presenceMask
+//   2. Por cada bit activo, leer sizeBytes del payload
+//   3. Decodificar con el lector del tipo de campo (tabla)
 //   4. Guardar el campo decodificado con su nombre e indice
 //
 // IMPORTANTE: Los campos se leen en ORDEN de bit (0, 1, 2, ...).
 // El emisor y el receptor deben usar la misma tabla de definiciones
 // para que el payload se interprete correctamente.
+//
+// Si el payload es mas corto de lo que declara el presenceMask, los campos
+// que no caben conservan los bytes disponibles y valor 0 (el mismo
+// comportamiento que tenia la lectura con QDataStream).
+//
+// SIN RESERVAS: clear() conserva la capacidad de 'fields', el nombre se
+// comparte con el plan y de los bytes crudos solo se anota su posicion en
+// la trama (frameOffset). Solo una lista sin capacidad (mensaje nuevo)
+// reserva, una vez.
 // =============================================================================
-QList<StanagField> StanagCodec::decodePayload(const QByteArray &payload,
-                                              quint16 presenceMask)
+void StanagCodec::decodePayload(const char *payload, int payloadSize,
+                                quint16 presenceMask, const StanagMessagePlan &plan,
+                                QList<StanagField> &fields)
 {
-    QList<StanagField> fields;
-    QDataStream stream(payload);
-    stream.setByteOrder(QDataStream::BigEndian);
-    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    fields.clear();
 
-    const auto &defs = fieldDefinitions();
+    const auto *ptr = reinterpret_cast<const uchar *>(payload);
+    int offset = 0;
 
-    for (int i = 0; i < kStanagMaxFields; ++i) {
-        if (!(presenceMask & (1 << i)))
-            continue;
+    for (quint32 bits = presenceMask & plan.fieldMask; bits; bits &= bits - 1) {
+        const int i = int(qCountTrailingZeroBits(bits));
+        const int fieldSize = plan.sizes[i];
+        const int available = qBound(0, payloadSize - offset, fieldSize);
 
-        StanagField field;
+        StanagField &field = fields.emplaceBack();
         field.index = i;
-        field.name = defs[i].name;
-
-        // Extraer los bytes crudos para mostrar en el hex dump
-        int fieldSize = defs[i].sizeBytes;
-        int pos = stream.device()->pos();
-        field.rawBytes = payload.mid(pos, fieldSize);
-
-        // Decodificar el valor segun el tipo
-        if (fieldSize == 4) {
-            if (i == 0 || i == 1) {
-                float fval = 0.0f;
-                stream >> fval;
-                field.value = static_cast<double>(fval);
-            } else {
-                quint32 u32 = 0;
-                stream >> u32;
-                field.value = static_cast<double>(u32);
-            }
-        } else {
-            if (i == 2 || i == 5 || i == 6 || i == 7) {
-                qint16 s16 = 0;
-                stream >> s16;
-                field.value = static_cast<double>(s16);
-            } else {
-                quint16 u16 = 0;
-                stream >> u16;
-                field.value = static_cast<double>(u16);
-            }
-        }
+        field.name = plan.fields[i].name;
+        // Bytes crudos para el hex dump: solo su posicion en la trama
+        field.frameOffset = kStanagHeaderSize + offset;
+        field.byteSize = available;
+        field.value = (available == fieldSize) ? readField(plan.types[i], ptr + offset) : 0.0;
 
-        fields.append(field);
+        offset += available;
     }
-
-    return fields;
 }
 
 // =============================================================================
 // encode() — Serializar un StanagMessage completo a bytes BigEndian
 // =============================================================================
 // Flujo de serializacion:
-//   1. Crear un QByteArray vacio como buffer de salida
-//   2. Abrir un QDataStream sobre el buffer en modo escritura
-//   3. Configurar BigEndian (network byte order)
-//   4. Escribir los 6 campos del header como quint16
-//   5. Empaquetar el payload (solo campos presentes segun bitmask)
-//   6. Actualizar payloadLen en el header con el tamano real del payload
-//   7. Agregar el payload al buffer
-//   8. Calcular el XOR checksum de todo lo anterior y agregarlo
+//   1. Reordenar msg.fields en un array de 14 valores indexado por bit
+//   2. Calcular payloadLen con plan.payloadSize() (popcount, sin bucles)
+//   3. Reservar el buffer EXACTO: header + payload + trailer (1 sola
+//      asignacion de memoria; antes habia buffer + payload + append)
+//   4. Escribir los 6 campos del header como quint16 BigEndian
+//   5. Empaquetar el payload directamente en su posicion final
+//   6. Calcular el checksum (msg.checksumMode) de todo lo anterior y
+//      escribirlo al final
 //
-// NOTA SOBRE payloadLen:
-//   No sabemos el tamano del payload hasta despues de empaquetarlo,
-//   porque depende de cuantos campos estan presentes. Por eso escribimos
-//   un placeholder (0) en la posicion de payloadLen, empaquetamos el
-//   payload, y luego sobrescribimos el placeholder con el valor real.
+// Como payloadLen se conoce por adelantado, ya no hace falta escribir un
+// placeholder y volver atras con seek() para corregirlo.
 //
-// QDataStream::device()->seek(): permite volver a una posicion anterior
-// del stream para sobrescribir datos. Usamos esto para actualizar payloadLen.
+// Si msg.fields repite un indice, gana la PRIMERA aparicion (igual que la
+// busqueda lineal de la version anterior): por eso se recorre al reves.
 // =============================================================================
 QByteArray StanagCodec::encode(const StanagMessage &msg)
 {
-    QByteArray buffer;
-    QDataStream stream(&buffer, QIODevice::WriteOnly);
-    stream.setByteOrder(QDataStream::BigEndian);
+    return encode(msg, defaultPlan());
+}
+
+QByteArray StanagCodec::encode(const StanagMessage &msg, const StanagMessagePlan &plan)
+{
+    double values[kStanagMaxFields] = {};
+    for (auto it = msg.fields.crbegin(); it != msg.fields.crend(); ++it) {
+        if (it->index >= 0 && it->index < kStanagMaxFields)
+            values[it->index] = it->value;
+    }
+
+    const int payloadLen = plan.payloadSize(msg.presenceMask);
+    const int trailerSize = StanagChecksum::trailerSize(msg.checksumMode);
+    QByteArray buffer(kStanagHeaderSize + payloadLen + trailerSize, Qt::Uninitialized);
+    auto *ptr = reinterpret_cast<uchar *>(buffer.data());
 
     // --- Escribir header ---
-    stream << msg.messageId;        // Bytes 0-1
-    stream << msg.sourcePort;       // Bytes 2-3
-    stream << msg.destPort;         // Bytes 4-5
-    stream << msg.sequenceNum;      // Bytes 6-7
-    // payloadLen se escribe como placeholder, se actualizara despues
-    stream << quint16(0);           // Bytes 8-9 (placeholder)
-    stream << msg.presenceMask;     // Bytes 10-11
-
-    // --- Empaquetar payload ---
-    QByteArray payload = encodePayload(msg);
-
-    // --- Actualizar payloadLen en el header ---
-    // Volver a la posicion del campo payloadLen (byte 8) y sobrescribir
-    quint16 payloadLen = static_cast<quint16>(payload.size());
-    stream.device()->seek(8);
-    stream << payloadLen;
-
-    // --- Agregar payload al final del buffer ---
-    buffer.append(payload);
+    qToBigEndian<quint16>(msg.messageId,    ptr + 0);   // Bytes 0-1
+    qToBigEndian<quint16>(msg.sourcePort,   ptr + 2);   // Bytes 2-3
+    qToBigEndian<quint16>(msg.destPort,     ptr + 4);   // Bytes 4-5
+    qToBigEndian<quint16>(msg.sequenceNum,  ptr + 6);   // Bytes 6-7
+    qToBigEndian<quint16>(quint16(payloadLen), ptr + 8); // Bytes 8-9
+    qToBigEndian<quint16>(msg.presenceMask, ptr + 10);  // Bytes 10-11
+
+    // --- Empaquetar payload en su sitio ---
+    encodePayload(values, msg.presenceMask, plan, ptr + kStanagHeaderSize);
 
     // --- Calcular y agregar checksum ---
-    quint8 checksum = computeChecksum(buffer);
-    buffer.append(static_cast<char>(checksum));
+    const int checksumPos = kStanagHeaderSize + payloadLen;
+    StanagChecksum::writeTrailer(
+        ptr + checksumPos,
+        StanagChecksum::compute(QByteArrayView(buffer).first(checksumPos), msg.checksumMode),
+        msg.checksumMode);
 
     return buffer;
 }
 
+// =============================================================================
+// restampSequence() — Parchear sequenceNum + checksum in-place
+// =============================================================================
+void StanagCodec::restampSequence(char *frame, qsizetype size, quint16 sequenceNum)
+{
+    if (size < kStanagHeaderSize + 1)
+        return;
+
+    qToBigEndian<quint16>(sequenceNum, frame + 6);
+
+    // El modo se deduce de la propia trama, asi que una plantilla
+    // codificada con CRC-32 se reestampa con CRC-32
+    const TrailerInfo trailer = trailerOf(size, qFromBigEndian<quint16>(frame + 8));
+    StanagChecksum::writeTrailer(
+        reinterpret_cast<uchar *>(frame) + trailer.covered,
+        StanagChecksum::compute(QByteArrayView(frame, trailer.covered), trailer.mode),
+        trailer.mode);
+}
+
 // =============================================================================
 // decode() — Deserializar bytes BigEndian a un StanagMessage
 // =============================================================================
 // Flujo de deserializacion:
 //   1. Verificar longitud minima (12 bytes header + 1 byte checksum = 13)
-//   2. Verificar checksum ANTES de parsear (fail-fast si datos corruptos)
-//   3. Leer header con QDataStream en BigEndian
-//   4. Verificar que payloadLen coincide con el tamano real del payload
+//   2. Leer header con qFromBigEndian (offsets fijos, ver decodeView())
+//   3. Verificar que payloadLen coincide con el tamano real del payload
+//   4. Verificar checksum (el modo sale del tamano del trailer)
 //   5. Extraer y decodificar los campos del payload segun presenceMask
 //
 // PATRON OUTPUT PARAMETER:
@@ -297,45 +438,187 @@ QByteArray StanagCodec::encode(const StanagMessage &msg)
 //   para funciones que pueden fallar.
 //
 // VALIDACION DEL CHECKSUM:
-//   El checksum se calcula sobre todos los bytes EXCEPTO el ultimo
-//   (que es el propio checksum). Si el XOR de todos los bytes precedentes
-//   coincide con el byte de checksum, los datos no fueron corrompidos.
+//   El checksum se calcula sobre todos los bytes EXCEPTO el trailer
+//   (que es el propio checksum). Si el valor calculado sobre los bytes
+//   precedentes coincide con el trailer, los datos no fueron corrompidos.
+//   Se calcula sobre una vista de 'data': no se copia la trama.
 // =============================================================================
 bool StanagCodec::decode(const QByteArray &data, StanagMessage &msg)
+{
+    return decode(data, msg, defaultPlan());
+}
+
+bool StanagCodec::decode(const QByteArray &data, StanagMessage &msg,
+                         const StanagMessagePlan &plan)
 {
     // Longitud minima: 12 bytes header + 1 byte checksum
     if (data.size() < kStanagHeaderSize + 1)
         return false;
 
-    // Guardar la trama cruda completa para hex dump
+    // Guardar la trama cruda completa para hex dump (compartida, sin copia)
     msg.rawFrame = data;
 
-    // --- Verificar checksum ---
-    // El checksum cubre todos los bytes excepto el ultimo (que ES el checksum)
-    QByteArray dataWithoutChecksum = data.left(data.size() - 1);
-    quint8 computedChecksum = computeChecksum(dataWithoutChecksum);
-    msg.checksum = static_cast<quint8>(data.back());
-    msg.checksumValid = (computedChecksum == msg.checksum);
-
     // --- Leer header ---
-    QDataStream stream(data);
-    stream.setByteOrder(QDataStream::BigEndian);
-
-    stream >> msg.messageId;
-    stream >> msg.sourcePort;
-    stream >> msg.destPort;
-    stream >> msg.sequenceNum;
-    stream >> msg.payloadLen;
-    stream >> msg.presenceMask;
+    const auto *ptr = reinterpret_cast<const uchar *>(data.constData());
+    msg.messageId    = qFromBigEndian<quint16>(ptr + 0);
+    msg.sourcePort   = qFromBigEndian<quint16>(ptr + 2);
+    msg.destPort     = qFromBigEndian<quint16>(ptr + 4);
+    msg.sequenceNum  = qFromBigEndian<quint16>(ptr + 6);
+    msg.payloadLen   = qFromBigEndian<quint16>(ptr + 8);
+    msg.presenceMask = qFromBigEndian<quint16>(ptr + 10);
 
     // --- Verificar que hay suficientes bytes para el payload ---
     int expectedSize = kStanagHeaderSize + msg.payloadLen + 1;  // +1 checksum
     if (data.size() < expectedSize)
         return false;
 
+    // --- Verificar checksum ---
+    // Cubre todos los bytes excepto el trailer (que ES el checksum)
+    const TrailerInfo trailer = trailerOf(data.size(), msg.payloadLen);
+    msg.checksumMode = trailer.mode;
+    msg.checksum = StanagChecksum::readTrailer(ptr + trailer.covered, trailer.mode);
+    msg.checksumValid = (StanagChecksum::compute(QByteArrayView(data).first(trailer.covered),
+                                                 trailer.mode) == msg.checksum);
+
     // --- Extraer y decodificar el payload ---
-    QByteArray payload = data.mid(kStanagHeaderSize, msg.payloadLen);
-    msg.fields = decodePayload(payload, msg.presenceMask);
+    decodePayload(msg.rawFrame.constData() + kStanagHeaderSize, msg.payloadLen,
+                  msg.presenceMask, plan, msg.fields);
+
+    return true;
+}
+
+// =============================================================================
+// decodeView() — Decode sin copias sobre un QByteArrayView
+// =============================================================================
+// Mismas validaciones que decode() (longitud minima, payloadLen suficiente,
+// checksum sobre todos los bytes menos el trailer), pero el trabajo se hace
+// con aritmetica de punteros:
+//
+//   ptr + 0  → messageId      ptr + 6  → sequenceNum
+//   ptr + 2  → sourcePort     ptr + 8  → payloadLen
+//   ptr + 4  → destPort       ptr + 10 → presenceMask
+//
+// Ninguna linea de esta funcion reserva memoria en heap.
+// =============================================================================
+bool StanagCodec::decodeView(QByteArrayView data, StanagFrameView &view)
+{
+    return decodeView(data, view, defaultPlan());
+}
+
+bool StanagCodec::decodeView(QByteArrayView data, StanagFrameView &view,
+                             const StanagMessagePlan &plan)
+{
+    if (data.size() < kStanagHeaderSize + 1)
+        return false;
+
+    const auto *ptr = reinterpret_cast<const uchar *>(data.data());
+    view.frame = data;
+
+    // --- Header ---
+    view.messageId    = qFromBigEndian<quint16>(ptr + 0);
+    view.sourcePort   = qFromBigEndian<quint16>(ptr + 2);
+    view.destPort     = qFromBigEndian<quint16>(ptr + 4);
+    view.sequenceNum  = qFromBigEndian<quint16>(ptr + 6);
+    view.payloadLen   = qFromBigEndian<quint16>(ptr + 8);
+    view.presenceMask = qFromBigEndian<quint16>(ptr + 10);
+
+    if (data.size() < kStanagHeaderSize + view.payloadLen + 1)
+        return false;
+
+    // --- Checksum (todos los bytes excepto el trailer) ---
+    const TrailerInfo trailer = trailerOf(data.size(), view.payloadLen);
+    view.checksumMode = trailer.mode;
+    view.checksum = StanagChecksum::readTrailer(ptr + trailer.covered, trailer.mode);
+    view.checksumValid =
+        (StanagChecksum::compute(data.first(trailer.covered), trailer.mode) == view.checksum);
+
+    // --- Payload: recorrer solo los bits presentes ---
+    // Los slots de campos ausentes deben quedar a 0 aunque la vista se
+    // reutilice entre tramas.
+    std::fill(std::begin(view.values), std::end(view.values), 0.0);
+    std::fill(std::begin(view.sizes), std::end(view.sizes), quint8(0));
+    std::fill(std::begin(view.offsets), std::end(view.offsets), quint16(0));
+
+    const quint32 present = view.presenceMask & plan.fieldMask;
+    view.fieldMask = plan.fieldMask;
+    view.fieldCount = int(qPopulationCount(present));
+
+    // Caso normal: el payload contiene todos los campos declarados.
+    // Cada campo se lee en su offset sin comprobar limites.
+    if (view.payloadLen >= plan.payloadSize(view.presenceMask)) {
+        int offset = kStanagHeaderSize;
+        for (quint32 bits = present; bits; bits &= bits - 1) {
+            const int i = int(qCountTrailingZeroBits(bits));
+            const int fieldSize = plan.sizes[i];
+            view.offsets[i] = quint16(offset);
+            view.sizes[i] = quint8(fieldSize);
+            view.values[i] = readField(plan.types[i], ptr + offset);
+            offset += fieldSize;
+        }
+        return true;
+    }
+
+    // Payload truncado: igual que en decodePayload(), los campos que no
+    // caben conservan los bytes disponibles y se quedan con valor 0.
+    const int payloadEnd = kStanagHeaderSize + view.payloadLen;
+    int offset = kStanagHeaderSize;
+    for (quint32 bits = present; bits; bits &= bits - 1) {
+        const int i = int(qCountTrailingZeroBits(bits));
+        const int fieldSize = plan.sizes[i];
+        const int available = qBound(0, payloadEnd - offset, fieldSize);
+        view.offsets[i] = quint16(offset);
+        view.sizes[i] = quint8(available);
+        if (available == fieldSize)
+            view.values[i] = readField(plan.types[i], ptr + offset);
+        offset += available;
+    }
 
     return true;
 }
+
+// =============================================================================
+// toMessage() — Materializar el StanagMessage completo desde la vista
+// =============================================================================
+// Este es el UNICO punto del fast path donde se copian bytes: la trama
+// completa, a rawFrame. Los campos solo guardan su offset en ella. Por eso
+// se deja fuera de decodeView() y solo se invoca cuando la UI necesita el
+// mensaje.
+// =============================================================================
+void StanagCodec::toMessage(const StanagFrameView &view, StanagMessage &msg)
+{
+    toMessage(view, msg, defaultPlan());
+}
+
+void StanagCodec::toMessage(const StanagFrameView &view, StanagMessage &msg,
+                            const StanagMessagePlan &plan)
+{
+    msg.messageId    = view.messageId;
+    msg.sourcePort   = view.sourcePort;
+    msg.destPort     = view.destPort;
+    msg.sequenceNum  = view.sequenceNum;
+    msg.payloadLen   = view.payloadLen;
+    msg.presenceMask = view.presenceMask;
+    msg.checksum     = view.checksum;
+    msg.checksumMode = view.checksumMode;
+    msg.checksumValid = view.checksumValid;
+
+    // Copia sobre la capacidad que ya tenga rawFrame: resize() solo
+    // reserva si no cabe o si el buffer esta compartido con otra copia
+    // (memmove: la vista puede venir del propio rawFrame)
+    msg.rawFrame.resize(view.frame.size());
+    std::memmove(msg.rawFrame.data(), view.frame.data(), std::size_t(view.frame.size()));
+
+    msg.fields.clear();
+
+    for (int i = 0; i < kStanagMaxFields; ++i) {
+        if (!view.hasField(i))
+            continue;
+
+        StanagField &field = msg.fields.emplaceBack();
+        field.index = i;
+        field.name = plan.fields.value(i).name;
+        field.frameOffset = view.offsets[i];
+        field.byteSize = view.sizes[i];
+        field.value = view.values[i];
+    }
+}
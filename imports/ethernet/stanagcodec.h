@@ -5,9 +5,9 @@
 // PATRON: Clase utilitaria con metodos estaticos puros (sin estado).
 //
 // Esta clase es el CORAZON EDUCATIVO del modulo. Demuestra:
-//   1. Serializacion BigEndian con QDataStream
+//   1. Serializacion BigEndian con qToBigEndian()/qFromBigEndian()
 //   2. Parsing de bitmask para payload de longitud variable
-//   3. XOR checksum
+//   3. Checksum XOR / CRC-16 / CRC-32 (kernels en StanagChecksum)
 //   4. Separacion de responsabilidades: el codec no sabe nada de red ni de UI
 //
 // ¿Por que metodos estaticos en vez de un objeto?
@@ -17,33 +17,205 @@
 //       QByteArray data = StanagCodec::encode(msg);
 //   - Es el patron mas simple y directo para utilidades de conversion.
 //
-// QDATASTREAM Y BIGENDIAN:
-//   QDataStream es la forma idiomatica de Qt para serializar datos binarios.
-//   Por defecto usa BigEndian (network byte order), que es exactamente lo
-//   que necesitamos para protocolos de comunicacion.
+// BIGENDIAN SIN QDATASTREAM:
+//   QDataStream es la forma idiomatica de Qt para serializar datos binarios
+//   (BigEndian por defecto, stream << value). Es comodo para ficheros o
+//   mensajes de control, pero no para el camino caliente: un QDataStream
+//   sobre un QByteArray crea un QBuffer en heap en cada llamada, y decode()
+//   no debe reservar memoria (StanagMessagePool).
 //
-//   Alternativa manual: qToBigEndian() / qFromBigEndian() de <QtEndian>.
-//   QDataStream es preferible porque:
-//     - Maneja el byte order automaticamente
-//     - Soporta tipos Qt nativos (QString, QByteArray, etc.)
-//     - El codigo resultante es mas legible: stream << value;
+//   El codec usa qToBigEndian()/qFromBigEndian() de <QtEndian> sobre
+//   punteros, guiado por una tabla constexpr (kStanagFieldLayout): cada
+//   campo se lee o escribe en su offset, sin estado de stream.
+//
+// LAYOUT EN TIEMPO DE COMPILACION:
+//   El tipo y tamano de cada campo viven en kStanagFieldLayout. A partir de
+//   esa tabla el compilador calcula mascaras por "plano de tamano" que
+//   permiten obtener el offset de cualquier campo para cualquier
+//   presenceMask con dos popcount (ver stanagFieldOffset()). No hay
+//   cadenas de if por indice ni tablas de 16K entradas.
+//
+// PLANES POR MENSAJE (StanagMessagePlan):
+//   kStanagFieldLayout es el layout de telemetria por defecto. Cada
+//   messageId puede tener su propia tabla de campos (StanagCatalog, cargado
+//   de JSON): se "compila" a un StanagMessagePlan con los mismos planos de
+//   tamano, y encode/decode reciben el plan. Las versiones sin plan usan
+//   defaultPlan(), que es kStanagFieldLayout compilado.
 // =============================================================================
 
 #ifndef STANAGCODEC_H
 #define STANAGCODEC_H
 
 #include "stanagmessage.h"
+#include <QtCore/qalgorithms.h>
+
+// =============================================================================
+// StanagFieldType — Tipo de dato en el cable de cada campo
+// =============================================================================
+// Sustituye a las cadenas "if (i == 0 || i == 1)" que decidian el tipo por
+// indice. El valor del enum se usa como indice en las tablas de funciones
+// de lectura/escritura de stanagcodec.cpp, asi que el orden importa.
+// =============================================================================
+enum class StanagFieldType : quint8
+{
+    Float32 = 0,    // IEEE-754 de 4 bytes
+    UInt32  = 1,
+    Int16   = 2,
+    UInt16  = 3,
+    Int32   = 4,
+    UInt8   = 5,
+    Int8    = 6,
+};
+
+// Bytes en el cable de cada tipo
+constexpr int stanagFieldTypeSize(StanagFieldType type)
+{
+    switch (type) {
+    case StanagFieldType::UInt8:
+    case StanagFieldType::Int8:
+        return 1;
+    case StanagFieldType::Int16:
+    case StanagFieldType::UInt16:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+// Campo mas grande posible y payload maximo de cualquier plan (14 campos
+// de 4 bytes). Acota los buffers de quien reconstruye tramas.
+inline constexpr int kStanagMaxFieldSize = 4;
+inline constexpr int kStanagMaxPayloadSize = kStanagMaxFields * kStanagMaxFieldSize;
+
+// =============================================================================
+// StanagFieldLayout — Entrada de la tabla constexpr de campos
+// =============================================================================
+struct StanagFieldLayout
+{
+    const char *name;           // Nombre legible (literal, sin QString)
+    StanagFieldType type;       // Tipo en el cable
+    quint8 sizeBytes;           // Tamano en bytes (1, 2 o 4)
+};
+
+// =============================================================================
+// kStanagFieldLayout — Los 14 campos de telemetria, indexados por bit
+// =============================================================================
+inline constexpr StanagFieldLayout kStanagFieldLayout[kStanagMaxFields] = {
+    { "Latitude",        StanagFieldType::Float32, 4 },  // Bit 0
+    { "Longitude",       StanagFieldType::Float32, 4 },  // Bit 1
+    { "Altitude",        StanagFieldType::Int16,   2 },  // Bit 2
+    { "Heading",         StanagFieldType::UInt16,  2 },  // Bit 3
+    { "Speed",           StanagFieldType::UInt16,  2 },  // Bit 4
+    { "Roll",            StanagFieldType::Int16,   2 },  // Bit 5
+    { "Pitch",           StanagFieldType::Int16,   2 },  // Bit 6
+    { "Yaw",             StanagFieldType::Int16,   2 },  // Bit 7
+    { "Fuel Level",      StanagFieldType::UInt16,  2 },  // Bit 8
+    { "Engine RPM",      StanagFieldType::UInt16,  2 },  // Bit 9
+    { "Battery Voltage", StanagFieldType::UInt16,  2 },  // Bit 10
+    { "Sensor Status",   StanagFieldType::UInt16,  2 },  // Bit 11
+    { "Waypoint Index",  StanagFieldType::UInt16,  2 },  // Bit 12
+    { "Mission Time",    StanagFieldType::UInt32,  4 },  // Bit 13
+};
+
+// Bits validos del presenceMask (0-13). Los bits 14 y 15 se ignoran.
+inline constexpr quint16 kStanagFieldBitsMask = (1u << kStanagMaxFields) - 1;
+
+// =============================================================================
+// Planos de tamano — offsets por mascara con popcount
+// =============================================================================
+// Cada tamano de campo se descompone en bits (4 = 0b100, 2 = 0b010). Para
+// cada bit de tamano guardamos la mascara de campos que lo tienen activo.
+// El tamano de los campos presentes por debajo del bit i es entonces:
+//
+//   1 * popcount(m & below & plane1) + 2 * popcount(m & below & plane2)
+//   + 4 * popcount(m & below & plane4)          con below = (1 << i) - 1
+//
+// Es decir, un offset por mascara equivale a tres popcount (instrucciones
+// de un ciclo en CPUs modernas), sin tabla de 2^14 entradas ni bucles.
+// =============================================================================
+constexpr quint16 stanagSizePlane(int sizeBit)
+{
+    quint16 plane = 0;
+    for (int i = 0; i < kStanagMaxFields; ++i) {
+        if (kStanagFieldLayout[i].sizeBytes & sizeBit)
+            plane |= quint16(1u << i);
+    }
+    return plane;
+}
+
+inline constexpr quint16 kStanagSizePlane1 = stanagSizePlane(1);
+inline constexpr quint16 kStanagSizePlane2 = stanagSizePlane(2);
+inline constexpr quint16 kStanagSizePlane4 = stanagSizePlane(4);
+
+// Bytes que ocupan los campos de 'mask' (solo cuentan los bits 0-13)
+constexpr int stanagPayloadSize(quint16 mask)
+{
+    const quint32 m = mask & kStanagFieldBitsMask;
+    return int(qPopulationCount(m & kStanagSizePlane1))
+         + 2 * int(qPopulationCount(m & kStanagSizePlane2))
+         + 4 * int(qPopulationCount(m & kStanagSizePlane4));
+}
+
+// Offset (relativo al inicio del payload) del campo 'index' para 'mask'
+constexpr int stanagFieldOffset(quint16 mask, int index)
+{
+    return stanagPayloadSize(quint16(mask & ((1u << index) - 1)));
+}
+
+static_assert(stanagPayloadSize(kStanagFieldBitsMask) == 34,
+              "Los 14 campos ocupan 3x4 + 11x2 = 34 bytes");
+static_assert(stanagFieldOffset(0x2000 | 0x0003, 13) == 8,
+              "Mission Time va detras de Latitude y Longitude");
 
 // =============================================================================
-// FieldDef — Definicion de un campo del protocolo
+// FieldDef — Definicion de un campo del protocolo (vista para QML/UI)
 // =============================================================================
-// Cada campo tiene un nombre legible y un tamano en bytes.
-// Esta tabla define los 14 campos posibles del STANAG 4586.
+// Cada campo tiene un nombre legible y un tamano en bytes. Se construye una
+// unica vez a partir de kStanagFieldLayout: la tabla constexpr es la fuente
+// de verdad, FieldDef solo existe para quien necesita QString (la UI).
 // =============================================================================
 struct FieldDef
 {
     QString name;       // Nombre legible: "Latitude", "Heading", etc.
-    int sizeBytes;      // Tamano del campo en bytes (2 o 4)
+    int sizeBytes;      // Tamano del campo en bytes (1, 2 o 4)
+    StanagFieldType type = StanagFieldType::UInt16;
+};
+
+// =============================================================================
+// StanagMessagePlan — Layout compilado de UN tipo de mensaje
+// =============================================================================
+// Lo mismo que kStanagFieldLayout + sus planos de tamano, pero en tiempo de
+// ejecucion: cada messageId del catalogo tiene el suyo. Los arrays son de
+// tamano fijo (14 campos, bit = indice) para que el bucle de decode sea el
+// mismo que con la tabla constexpr: tipo y tamano por bit, sin busquedas.
+//
+// fieldMask son los bits con campo definido: los bits del presenceMask
+// fuera de el se ignoran (igual que los bits 14 y 15 en el layout fijo).
+// =============================================================================
+struct StanagMessagePlan
+{
+    quint16 messageId = 0;          // 0 = plan por defecto (telemetria)
+    QString name;
+    quint16 fieldMask = 0;
+    quint16 sizePlane1 = 0;
+    quint16 sizePlane2 = 0;
+    quint16 sizePlane4 = 0;
+    StanagFieldType types[kStanagMaxFields] = {};
+    quint8 sizes[kStanagMaxFields] = {};
+    QList<FieldDef> fields;         // Para la UI y toMessage(); indice = bit
+
+    // Bytes que ocupan los campos de 'mask' (solo cuentan los de fieldMask)
+    int payloadSize(quint16 mask) const
+    {
+        const quint32 m = mask & fieldMask;
+        return int(qPopulationCount(m & sizePlane1))
+             + 2 * int(qPopulationCount(m & sizePlane2))
+             + 4 * int(qPopulationCount(m & sizePlane4));
+    }
+
+    // Compilar una tabla de campos (como mucho kStanagMaxFields)
+    static StanagMessagePlan compile(quint16 messageId, const QString &name,
+                                     const QList<FieldDef> &fields);
 };
 
 class StanagCodec
@@ -53,28 +225,80 @@ public:
     // encode() — Serializar un StanagMessage a bytes BigEndian
     // =========================================================================
     // Flujo:
-    //   1. Escribir header (6 x quint16) con QDataStream en BigEndian
-    //   2. Iterar el presenceMask, empaquetando solo los campos presentes
-    //   3. Calcular payloadLen y escribirlo en la posicion correcta
-    //   4. Calcular XOR checksum de todos los bytes y agregarlo al final
+    //   1. Calcular payloadLen a partir del presenceMask (tabla constexpr)
+    //      y reservar el buffer exacto de una sola vez
+    //   2. Escribir header (6 x quint16) en BigEndian con qToBigEndian
+    //   3. Iterar SOLO los bits activos, empaquetando cada campo presente
+    //   4. Calcular el checksum de msg.checksumMode (XOR, CRC-16 o CRC-32)
+    //      de todos los bytes y agregarlo al final (1, 2 o 4 bytes)
     //
     // Retorna: QByteArray con la trama completa lista para enviar por UDP
     // =========================================================================
     static QByteArray encode(const StanagMessage &msg);
+    static QByteArray encode(const StanagMessage &msg, const StanagMessagePlan &plan);
 
     // =========================================================================
     // decode() — Deserializar bytes BigEndian a un StanagMessage
     // =========================================================================
     // Flujo:
     //   1. Verificar longitud minima (header + checksum = 13 bytes)
-    //   2. Leer header con QDataStream en BigEndian
+    //   2. Leer header con qFromBigEndian
     //   3. Iterar presenceMask para extraer los campos presentes del payload
-    //   4. Verificar checksum XOR
+    //   4. Verificar checksum (modo deducido del tamano del trailer)
     //
     // Retorna: true si el decode fue exitoso, false si los datos son invalidos
     // El StanagMessage se llena por referencia (patron output parameter).
+    // Con un mensaje reutilizado (StanagMessagePool) no reserva memoria:
+    // rawFrame comparte 'data' y los campos reutilizan la lista.
     // =========================================================================
     static bool decode(const QByteArray &data, StanagMessage &msg);
+    static bool decode(const QByteArray &data, StanagMessage &msg,
+                       const StanagMessagePlan &plan);
+
+    // =========================================================================
+    // decodeView() — Fast path de decode sin copias ni QDataStream
+    // =========================================================================
+    // Mismo formato y mismas reglas de validacion que decode(), pero:
+    //   - Lee el header y los campos con qFromBigEndian directamente del
+    //     buffer (const char* via QByteArrayView), sin QDataStream.
+    //   - No crea QByteArray por campo ni QString de nombre: el resultado
+    //     es un StanagFrameView de tamano fijo que vive en la pila.
+    //   - No copia la trama: view.frame apunta a 'data'.
+    //
+    // Pensado para el camino caliente (replay de miles de tramas/s). Si
+    // luego hace falta el mensaje completo, usar toMessage().
+    //
+    // Con 'plan', los campos se leen con la tabla de ese tipo de mensaje
+    // (normalmente StanagCatalog::plan(messageId)); sin el, defaultPlan().
+    // encode(), decode() y toMessage() tienen la misma sobrecarga.
+    // =========================================================================
+    static bool decodeView(QByteArrayView data, StanagFrameView &view);
+    static bool decodeView(QByteArrayView data, StanagFrameView &view,
+                           const StanagMessagePlan &plan);
+
+    // =========================================================================
+    // toMessage() — Materializar un StanagMessage desde una vista
+    // =========================================================================
+    // Convierte un StanagFrameView en el StanagMessage "clasico" (con
+    // QList<StanagField>, nombres y offsets de los bytes crudos). Aqui SI se
+    // copian datos (la trama, a rawFrame): solo debe llamarse cuando alguien
+    // necesita el mensaje. Sobre un mensaje reutilizado, la copia cabe en
+    // la capacidad que ya tiene y no reserva memoria.
+    // =========================================================================
+    static void toMessage(const StanagFrameView &view, StanagMessage &msg);
+    static void toMessage(const StanagFrameView &view, StanagMessage &msg,
+                          const StanagMessagePlan &plan);
+
+    // =========================================================================
+    // restampSequence() — Cambiar el sequenceNum de una trama ya codificada
+    // =========================================================================
+    // Reescribe los bytes 6-7 (sequenceNum) y recalcula el checksum final
+    // (en el modo que ya tenga la trama) directamente en el buffer. Permite
+    // generar rafagas de tramas casi identicas codificando la plantilla UNA
+    // vez y copiandola, en vez de llamar a encode() por cada trama. 'frame'
+    // debe ser una trama completa (header + payload + trailer).
+    // =========================================================================
+    static void restampSequence(char *frame, qsizetype size, quint16 sequenceNum);
 
     // =========================================================================
     // computeChecksum() — Calcular XOR de todos los bytes
@@ -84,14 +308,20 @@ public:
     // errores de reordenamiento. Para este ejemplo didactico es suficiente.
     //
     // Alternativas mas robustas: CRC-16 (comun en STANAG), CRC-32 (Ethernet).
+    // Ambas estan disponibles en StanagChecksum y se seleccionan por trama
+    // con StanagMessage::checksumMode; esta funcion es siempre el XOR.
+    //
+    // Recibe un QByteArrayView para poder calcularlo sobre cualquier rango
+    // de bytes (un QByteArray se convierte implicitamente, sin copia).
     // =========================================================================
-    static quint8 computeChecksum(const QByteArray &data);
+    static quint8 computeChecksum(QByteArrayView data);
 
     // =========================================================================
     // fieldDefinitions() — Tabla de los 14 campos del protocolo
     // =========================================================================
     // Devuelve una referencia constante a la tabla estatica de definiciones.
-    // Cada entrada tiene {nombre, tamano_en_bytes}.
+    // Cada entrada tiene {nombre, tamano_en_bytes}. Se deriva una sola vez
+    // de kStanagFieldLayout (que es la que usan encode/decode).
     //
     // Los campos estan inspirados en telemetria UAV de STANAG 4586:
     //   Bit 0:  Latitude        (4B float32)
@@ -111,25 +341,36 @@ public:
     // =========================================================================
     static const QList<FieldDef> &fieldDefinitions();
 
+    // kStanagFieldLayout compilado: el plan de los messageId sin entrada
+    // en el catalogo y el de las sobrecargas sin plan
+    static const StanagMessagePlan &defaultPlan();
+
 private:
     // =========================================================================
     // encodePayload() — Empaquetar solo los campos presentes
     // =========================================================================
-    // Recorre los bits del presenceMask (0-13). Por cada bit activo,
-    // busca el campo correspondiente en msg.fields y escribe sus bytes
-    // en BigEndian. Los campos no presentes se saltan completamente.
+    // Recibe los valores indexados por bit (values[i] = campo i) y escribe
+    // en 'dst' los campos activos de presenceMask en BigEndian. 'dst' debe
+    // tener al menos stanagPayloadSize(presenceMask) bytes.
     // =========================================================================
-    static QByteArray encodePayload(const StanagMessage &msg);
+    static void encodePayload(const double *values, quint16 presenceMask,
+                              const StanagMessagePlan &plan, uchar *dst);
 
     // =========================================================================
     // decodePayload() — Desempaquetar los campos del payload
     // =========================================================================
     // Lee el payload secuencialmente. Por cada bit activo en presenceMask,
-    // extrae los bytes correspondientes segun la tabla de fieldDefinitions()
-    // y los decodifica al valor numerico apropiado (float, int16, uint16, etc.)
+    // extrae los bytes correspondientes segun el plan y los decodifica al
+    // valor numerico apropiado (float, int16, uint16, etc.)
+    //
+    // 'payload' es el payload del rawFrame del mensaje (kStanagHeaderSize
+    // bytes despues de su inicio): el frameOffset de cada campo se cuenta
+    // desde el inicio de la trama. 'fields' se vacia y se rellena
+    // conservando su capacidad.
     // =========================================================================
-    static QList<StanagField> decodePayload(const QByteArray &payload,
-                                            quint16 presenceMask);
+    static void decodePayload(const char *payload, int payloadSize,
+                              quint16 presenceMask, const StanagMessagePlan &plan,
+                              QList<StanagField> &fields);
 };
 
 #endif // STANAGCODEC_H
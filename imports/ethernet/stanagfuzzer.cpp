@@ -0,0 +1,360 @@
+// =============================================================================
+// stanagfuzzer.cpp — Implementacion del fuzzer del codec
+// =============================================================================
+
+#include "stanagfuzzer.h"
+#include "hexformatter.h"
+#include "stanagbenchmark.h"
+#include "stanagcodec.h"
+#include "stanagstreamdecoder.h"
+#include <QElapsedTimer>
+#include <QList>
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// =============================================================================
+// Generador reproducible
+// =============================================================================
+// El mismo LCG que StanagBenchmark::sampleFrames(): lo que importa es que
+// una semilla reproduzca la misma secuencia, no la calidad estadistica.
+// Se usan los bits altos (los bajos de un LCG tienen periodos cortos).
+// =============================================================================
+struct FuzzRandom
+{
+    quint32 state;
+
+    quint32 next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    }
+
+    // Entero en [0, bound)
+    int below(int bound) { return bound > 0 ? int(next() % quint32(bound)) : 0; }
+    char byte() { return static_cast<char>(next()); }
+};
+
+bool sameValue(double a, double b)
+{
+    return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+bool fail(QString *failure, const QString &text)
+{
+    if (failure)
+        *failure = text;
+    return false;
+}
+
+// Tramas (tamano, sequenceNum) y bytes descartados de un flujo completo
+struct StreamResult
+{
+    QList<QPair<qsizetype, quint16>> frames;
+    quint64 skipped = 0;
+};
+
+StreamResult streamDecode(QByteArrayView data, qsizetype split)
+{
+    StreamResult result;
+    StanagStreamDecoder decoder;
+    StanagFrameView view;
+
+    const QByteArrayView parts[] = { data.first(split), data.sliced(split) };
+    for (int part = 0; part < 2; ++part) {
+        decoder.feed(parts[part], part == 1);
+        while (decoder.next(view))
+            result.frames.append({ view.frame.size(), view.sequenceNum });
+    }
+    result.skipped = decoder.skippedBytes();
+    return result;
+}
+
+// =============================================================================
+// checkDecodeAgreement() — Invariante 1: decode() == decodeView()
+// =============================================================================
+bool checkDecodeAgreement(QByteArrayView data, QString *failure)
+{
+    StanagMessage msg;
+    StanagFrameView view;
+    const bool legacyOk = StanagCodec::decode(data.toByteArray(), msg);
+    const bool fastOk = StanagCodec::decodeView(data, view);
+
+    if (legacyOk != fastOk)
+        return fail(failure, QStringLiteral("decode() = %1, decodeView() = %2")
+                                 .arg(legacyOk).arg(fastOk));
+    if (!legacyOk)
+        return true;
+
+    if (msg.messageId != view.messageId || msg.sourcePort != view.sourcePort
+        || msg.destPort != view.destPort || msg.sequenceNum != view.sequenceNum
+        || msg.payloadLen != view.payloadLen || msg.presenceMask != view.presenceMask)
+        return fail(failure, QStringLiteral("Header differs between decode() and decodeView()"));
+
+    if (msg.checksumMode != view.checksumMode || msg.checksum != view.checksum
+        || msg.checksumValid != view.checksumValid)
+        return fail(failure, QStringLiteral("Checksum differs between decode() and decodeView()"));
+
+    if (msg.fields.size() != view.fieldCount)
+        return fail(failure, QStringLiteral("Field count %1 vs %2")
+                                 .arg(msg.fields.size()).arg(view.fieldCount));
+
+    for (const StanagField &field : std::as_const(msg.fields)) {
+        if (view.fieldBytes(field.index) != msg.fieldBytes(field))
+            return fail(failure, QStringLiteral("Field %1: bytes differ").arg(field.index));
+        if (!sameValue(view.values[field.index], field.value))
+            return fail(failure, QStringLiteral("Field %1: %2 vs %3")
+                                     .arg(field.index)
+                                     .arg(field.value)
+                                     .arg(view.values[field.index]));
+    }
+    return true;
+}
+
+// =============================================================================
+// mutate() — Una mutacion aleatoria sobre 'frame'
+// =============================================================================
+void mutate(QByteArray &frame, const QList<QByteArray> &corpus, FuzzRandom &rng)
+{
+    switch (rng.below(8)) {
+    case 0:   // Un bit
+        if (!frame.isEmpty())
+            frame[rng.below(int(frame.size()))] ^= char(1 << rng.below(8));
+        break;
+    case 1:   // Un byte
+        if (!frame.isEmpty())
+            frame[rng.below(int(frame.size()))] = rng.byte();
+        break;
+    case 2:   // Cortar
+        frame.truncate(rng.below(int(frame.size()) + 1));
+        break;
+    case 3:   // Basura al final
+        for (int n = 1 + rng.below(16); n > 0; --n)
+            frame.append(rng.byte());
+        break;
+    case 4: { // Campo del header con un valor "interesante"
+        if (frame.size() < kStanagHeaderSize)
+            break;
+        static constexpr int kOffsets[] = { 0, 8, 8, 10, 10 };
+        const int offset = kOffsets[rng.below(5)];
+        const quint16 mask = qFromBigEndian<quint16>(frame.constData() + 10);
+        quint16 value = 0;
+        switch (rng.below(5)) {
+        case 0: value = 0; break;
+        case 1: value = 0xFFFF; break;
+        case 2: value = quint16(stanagPayloadSize(mask) + 1); break;
+        case 3: value = quint16(stanagPayloadSize(mask) - 1); break;
+        default: value = quint16(rng.next()); break;
+        }
+        qToBigEndian<quint16>(value, frame.data() + offset);
+        break;
+    }
+    case 5:   // Otra trama detras (datagrama empaquetado), quiza con basura
+        for (int n = rng.below(3); n > 0; --n)
+            frame.append(rng.byte());
+        frame.append(corpus[rng.below(int(corpus.size()))]);
+        break;
+    case 6:   // Bytes insertados en medio
+        frame.insert(rng.below(int(frame.size()) + 1),
+                     QByteArray(1 + rng.below(4), rng.byte()));
+        break;
+    default:  // Buffer completamente aleatorio
+        frame.resize(rng.below(80));
+        for (char &byte : frame)
+            byte = rng.byte();
+        break;
+    }
+}
+
+// Texto "hex" derivado de una trama: espacios, minusculas, caracteres
+// basura o no Latin-1, digitos impares
+QString mutateHex(QByteArrayView frame, FuzzRandom &rng)
+{
+    QString text = HexFormatter::format(frame);
+    for (int n = rng.below(4); n > 0; --n) {
+        const int position = rng.below(int(text.size()) + 1);
+        switch (rng.below(5)) {
+        case 0: text.insert(position, QLatin1Char(' ')); break;
+        case 1: text = text.toLower(); break;
+        case 2: text.insert(position, QChar(u'g' + rng.below(20))); break;
+        case 3: text.insert(position, QChar(char16_t(0x00C0 + rng.below(0x400)))); break;
+        default: text.insert(position, QChar(u'0' + rng.below(10))); break;
+        }
+    }
+    return text;
+}
+
+QList<QByteArray> buildCorpus()
+{
+    static constexpr StanagChecksumMode kModes[] = {
+        StanagChecksumMode::Xor8,
+        StanagChecksumMode::Crc16Ccitt,
+        StanagChecksumMode::Crc32,
+    };
+
+    QList<QByteArray> corpus;
+    for (const QByteArray &frame : StanagBenchmark::sampleFrames(16)) {
+        StanagMessage msg;
+        StanagCodec::decode(frame, msg);
+        for (StanagChecksumMode mode : kModes) {
+            msg.checksumMode = mode;
+            corpus.append(StanagCodec::encode(msg));
+        }
+    }
+    return corpus;
+}
+
+} // namespace
+
+// =============================================================================
+// checkFrame()
+// =============================================================================
+bool StanagFuzzer::checkFrame(QByteArrayView data, qsizetype split, QString *failure)
+{
+    if (!checkDecodeAgreement(data, failure))
+        return false;
+
+    const StreamResult whole = streamDecode(data, data.size());
+
+    // --- Invariante 2: una trama valida entra entera por el decoder ---
+    StanagFrameView view;
+    if (StanagStreamDecoder::isSingleFrame(data)
+        && StanagCodec::decodeView(data, view) && view.checksumValid
+        && view.messageId != 0
+        && view.payloadLen == stanagPayloadSize(view.presenceMask)) {
+        if (whole.frames.size() != 1 || whole.frames.constFirst().first != data.size()
+            || whole.skipped != 0)
+            return fail(failure, QStringLiteral("Valid frame split into %1 frames, %2 bytes skipped")
+                                     .arg(whole.frames.size())
+                                     .arg(whole.skipped));
+    }
+
+    // --- Invariante 3: el resultado no depende de los trozos ---
+    const StreamResult chunked = streamDecode(data, qBound<qsizetype>(0, split, data.size()));
+    if (chunked.frames != whole.frames || chunked.skipped != whole.skipped)
+        return fail(failure, QStringLiteral("Split at %1: %2 frames / %3 skipped, whole: %4 / %5")
+                                 .arg(split)
+                                 .arg(chunked.frames.size())
+                                 .arg(chunked.skipped)
+                                 .arg(whole.frames.size())
+                                 .arg(whole.skipped));
+    return true;
+}
+
+// =============================================================================
+// checkHex()
+// =============================================================================
+bool StanagFuzzer::checkHex(const QString &text, QString *failure)
+{
+    const QByteArray bytes = HexFormatter::parse(text);
+    if (bytes.size() > (text.size() + 1) / 2)
+        return fail(failure, QStringLiteral("%1 chars parsed to %2 bytes")
+                                 .arg(text.size()).arg(bytes.size()));
+
+    if (HexFormatter::parse(HexFormatter::format(bytes)) != bytes)
+        return fail(failure, QStringLiteral("parse(format(bytes)) != bytes"));
+
+    return checkFrame(bytes, bytes.size() / 2, failure);
+}
+
+// =============================================================================
+// checkInput()
+// =============================================================================
+bool StanagFuzzer::checkInput(QByteArrayView input, QString *failure)
+{
+    if (input.isEmpty())
+        return true;
+
+    const QByteArrayView rest = input.sliced(1);
+    if (input.front() & 1)
+        return checkHex(QString::fromLatin1(rest), failure);
+    return checkFrame(rest, rest.size() / 2, failure);
+}
+
+// =============================================================================
+// run()
+// =============================================================================
+// Todas las entradas parten de una copia de una trama del corpus: las
+// mutaciones nunca se acumulan entre iteraciones, asi cada fallo se
+// reproduce con una sola entrada (firstFailureHex).
+// =============================================================================
+QVariantMap StanagFuzzer::run(int iterations, quint32 seed)
+{
+    iterations = qMax(iterations, 1);
+    const QList<QByteArray> corpus = buildCorpus();
+    FuzzRandom rng{ seed };
+
+    int decoded = 0;
+    int checksumValid = 0;
+    int streamFrames = 0;
+    int hexInputs = 0;
+    int failures = 0;
+    QString firstFailure;
+    QString firstFailureHex;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int n = 0; n < iterations; ++n) {
+        QByteArray input = corpus[rng.below(int(corpus.size()))];
+        for (int m = 1 + rng.below(3); m > 0; --m)
+            mutate(input, corpus, rng);
+
+        // Checksum recalculado: la trama pasa la validacion y los campos
+        // mutados llegan hasta el payload y el decoder de flujo
+        if (rng.below(2) == 0 && input.size() > kStanagHeaderSize) {
+            StanagCodec::restampSequence(input.data(), input.size(),
+                                         qFromBigEndian<quint16>(input.constData() + 6));
+        }
+
+        QString failure;
+        bool ok = true;
+        if (rng.below(8) == 0) {
+            ++hexInputs;
+            const QString text = mutateHex(input, rng);
+            ok = checkHex(text, &failure);
+            if (!ok && firstFailure.isEmpty())
+                firstFailureHex = text;
+        } else {
+            ok = checkFrame(input, rng.below(int(input.size()) + 1), &failure);
+            if (!ok && firstFailure.isEmpty())
+                firstFailureHex = HexFormatter::format(input);
+        }
+
+        if (!ok) {
+            if (firstFailure.isEmpty())
+                firstFailure = failure;
+            ++failures;
+        }
+
+        // Estadisticas de cobertura: cuanto llega a cada nivel del decode
+        StanagFrameView view;
+        if (StanagCodec::decodeView(input, view)) {
+            ++decoded;
+            if (view.checksumValid)
+                ++checksumValid;
+        }
+        StanagStreamDecoder stream;
+        stream.feed(input, true);
+        while (stream.next(view))
+            ++streamFrames;
+    }
+
+    const qint64 elapsedNs = qMax<qint64>(timer.nsecsElapsed(), 1);
+
+    QVariantMap result;
+    result[QStringLiteral("iterations")] = iterations;
+    result[QStringLiteral("seed")] = seed;
+    result[QStringLiteral("elapsedMs")] = elapsedNs / 1000000;
+    result[QStringLiteral("execsPerSec")] = iterations * 1e9 / elapsedNs;
+    result[QStringLiteral("decoded")] = decoded;
+    result[QStringLiteral("checksumValid")] = checksumValid;
+    result[QStringLiteral("streamFrames")] = streamFrames;
+    result[QStringLiteral("hexInputs")] = hexInputs;
+    result[QStringLiteral("failures")] = failures;
+    result[QStringLiteral("firstFailure")] = firstFailure;
+    result[QStringLiteral("firstFailureHex")] = firstFailureHex;
+    return result;
+}
@@ -0,0 +1,84 @@
+// =============================================================================
+// stanagfuzzer.h — Fuzzing del decode STANAG y del parseo de sendRawHex
+// =============================================================================
+//
+// PATRON: Clase utilitaria con metodos estaticos (igual que StanagBenchmark).
+//
+// El decode recibe bytes de la red sin filtrar: cualquier datagrama puede
+// llegar a decode(), decodeView() o StanagStreamDecoder. Este fuzzer genera
+// entradas mutando tramas validas y comprueba en cada una:
+//
+//   1. decode() y decodeView() coinciden: mismo resultado, mismo header,
+//      mismo modo y validez de checksum, mismos valores y bytes por campo.
+//   2. Una trama unica valida (isSingleFrame + checksum + header plausible)
+//      sale del decoder de flujo como UNA trama entera, sin bytes perdidos.
+//   3. El decoder de flujo no depende de como se trocean los bytes: el
+//      buffer entero y el mismo buffer partido en un punto dan las mismas
+//      tramas (tamano y sequenceNum) y los mismos bytes descartados.
+//   4. parse(format(bytes)) == bytes, y parse() de texto arbitrario (lo que
+//      recibe sendRawHex) no produce mas de un byte por dos caracteres.
+//
+// Los fallos de memoria (lecturas fuera del buffer) no se "comprueban": se
+// ven al compilar con -fsanitize=address,undefined y ejecutar el fuzzer.
+//
+// USO DESDE LA APP (pasada rapida desde la tarjeta, mutador propio):
+//   var r = controller.runFuzzer(200000, 1)   // iteraciones, semilla
+//   r.failures, r.firstFailure, r.firstFailureHex
+// La misma semilla reproduce exactamente la misma secuencia de entradas.
+//
+// USO CON libFUZZER (el fuzzing de verdad, guiado por cobertura):
+//   El target stanagcodecfuzz (fuzz/, -DQMLSNIPPETS_BUILD_FUZZERS=ON)
+//   llama a checkInput() desde LLVMFuzzerTestOneInput() con ASan y UBSan.
+//   Ver fuzz/CMakeLists.txt para compilarlo y lanzarlo.
+// =============================================================================
+
+#ifndef STANAGFUZZER_H
+#define STANAGFUZZER_H
+
+#include <QByteArrayView>
+#include <QString>
+#include <QVariantMap>
+
+class StanagFuzzer
+{
+public:
+    // =========================================================================
+    // checkFrame() — Invariantes 1-3 sobre un buffer de bytes
+    // =========================================================================
+    // 'split' = punto de corte para el invariante 3 (se acota al buffer).
+    // Retorna false y describe el problema en 'failure' si alguno no se
+    // cumple.
+    // =========================================================================
+    static bool checkFrame(QByteArrayView data, qsizetype split,
+                           QString *failure = nullptr);
+
+    // Invariante 4 sobre un texto, y checkFrame() sobre lo que produce
+    static bool checkHex(const QString &text, QString *failure = nullptr);
+
+    // =========================================================================
+    // checkInput() — Entrada unica para libFuzzer
+    // =========================================================================
+    // El primer byte elige el objetivo: par → checkFrame() sobre el resto
+    // (cortado por la mitad), impar → checkHex() con el resto como Latin-1.
+    // =========================================================================
+    static bool checkInput(QByteArrayView input, QString *failure = nullptr);
+
+    // =========================================================================
+    // run() — Bucle de fuzzing por mutacion
+    // =========================================================================
+    // Corpus inicial: tramas de StanagBenchmark::sampleFrames() en los tres
+    // modos de checksum. Cada iteracion aplica 1-3 mutaciones (bits, bytes,
+    // cortes, basura, campos del header, tramas concatenadas) y, la mitad
+    // de las veces, recalcula el checksum para llegar mas alla de el.
+    // Una de cada ocho iteraciones prueba el camino de sendRawHex.
+    //
+    // Devuelve:
+    //   { iterations, seed, elapsedMs, execsPerSec, decoded, checksumValid,
+    //     streamFrames, hexInputs, failures, firstFailure, firstFailureHex }
+    // firstFailureHex es la entrada que fallo: el hex de la trama, o el
+    // texto tal cual si era una entrada de sendRawHex.
+    // =========================================================================
+    static QVariantMap run(int iterations, quint32 seed);
+};
+
+#endif // STANAGFUZZER_H
@@ -24,8 +24,8 @@
 //   +-------------------+-------------------+
 //   |     Payload (longitud variable)        |
 //   +-----------------------------------------+
-//   |  Checksum (u8 XOR)|
-//   +-------------------+
+//   |  Checksum (u8 XOR | u16 CRC-16 | u32 CRC-32)  |
+//   +-----------------------------------------------+
 //
 // La Presence Mask es un bitmask de 16 bits donde cada bit (0-13) indica
 // si un campo de telemetria esta presente en el payload. Los campos
@@ -36,14 +36,18 @@
 #define STANAGMESSAGE_H
 
 #include <QByteArray>
+#include <QByteArrayView>
 #include <QList>
 #include <QString>
+#include "hexformatter.h"
+#include "stanagchecksum.h"
 
 // =============================================================================
 // TAMANO DEL HEADER (en bytes)
 // =============================================================================
 // El header tiene 6 campos de 2 bytes cada uno = 12 bytes fijos.
-// Despues del header viene el payload (variable) y al final 1 byte de checksum.
+// Despues del header viene el payload (variable) y al final el checksum:
+// 1 byte (XOR), 2 (CRC-16) o 4 (CRC-32). Ver stanagchecksum.h.
 // =============================================================================
 constexpr int kStanagHeaderSize = 12;  // 6 x quint16
 constexpr int kStanagMaxFields  = 14;  // Bits 0-13 del presenceMask
@@ -51,15 +55,25 @@ constexpr int kStanagMaxFields  = 14;  // Bits 0-13 del presenceMask
 // =============================================================================
 // StanagField — Un campo individual decodificado del payload
 // =============================================================================
-// Cada campo tiene un indice (0-13), un nombre legible, los bytes crudos
-// y un valor numerico decodificado. El tipo del valor depende de la
-// definicion del campo (float, int16, uint16, uint32).
+// Cada campo tiene un indice (0-13), un nombre legible, la posicion de sus
+// bytes crudos en la trama y un valor numerico decodificado. El tipo del
+// valor depende de la definicion del campo (float, int16, uint16, uint32).
+//
+// Al decodificar, no se reserva memoria:
+//   - name comparte el QString de la tabla de campos del plan (implicit
+//     sharing: solo sube un contador de referencias).
+//   - Los bytes crudos NO se guardan en el campo: frameOffset/byteSize
+//     senalan su sitio en el rawFrame del mensaje y se leen con
+//     StanagMessage::fieldBytes(). Un campo copiado fuera del mensaje, o
+//     que sobrevive a que rawFrame cambie, no apunta a memoria liberada:
+//     solo son dos enteros.
 // =============================================================================
 struct StanagField
 {
     int index = 0;              // Posicion en el bitmask (0-13)
     QString name;               // Nombre legible: "Latitude", "Heading", etc.
-    QByteArray rawBytes;        // Bytes crudos de este campo (2 o 4 bytes)
+    int frameOffset = 0;        // Offset de los bytes crudos en rawFrame
+    int byteSize = 0;           // 1, 2 o 4 (menos si la trama esta truncada)
     double value = 0.0;         // Valor numerico decodificado
 };
 
@@ -80,16 +94,87 @@ struct StanagMessage
     QList<StanagField> fields;  // Solo los campos presentes (segun bitmask)
 
     // --- Checksum ---
-    quint8 checksum      = 0;   // XOR de todos los bytes precedentes
+    // En encode() checksumMode elige el algoritmo; en decode() se rellena
+    // con el modo detectado a partir del tamano del trailer.
+    StanagChecksumMode checksumMode = StanagChecksumMode::Xor8;
+    quint32 checksum     = 0;   // Valor del trailer (XOR o CRC)
     bool checksumValid   = false;
 
     // --- Trama cruda completa ---
     QByteArray rawFrame;        // Todos los bytes de la trama (para hex dump)
 
-    // Helper: representacion hexadecimal de la trama completa
+    // Bytes crudos de un campo de ESTE mensaje (vista sobre rawFrame).
+    // Vacia si el campo no cabe en la trama actual.
+    QByteArrayView fieldBytes(const StanagField &field) const
+    {
+        if (field.frameOffset < 0 || field.byteSize < 0
+            || field.frameOffset + field.byteSize > rawFrame.size())
+            return {};
+        return QByteArrayView(rawFrame).sliced(field.frameOffset, field.byteSize);
+    }
+
+    // Helper: representacion hexadecimal de la trama completa.
+    // Se genera al llamarla (nunca al decodificar), con HexFormatter.
     QString hexDump() const
     {
-        return QString::fromLatin1(rawFrame.toHex(' ')).toUpper();
+        return HexFormatter::format(rawFrame);
+    }
+};
+
+// =============================================================================
+// StanagFrameView — Vista decodificada SIN copias (fast path de decode)
+// =============================================================================
+// Alternativa ligera a StanagMessage para el camino caliente de recepcion.
+// StanagCodec::decodeView() la rellena leyendo directamente del buffer del
+// datagrama con qFromBigEndian, sin QDataStream ni asignaciones en heap:
+//
+//   - Los valores se guardan en un array fijo de 14 slots indexado por el
+//     BIT del presenceMask (no por orden de aparicion). Los slots de campos
+//     ausentes quedan a 0.
+//   - offsets[i] / sizes[i] permiten recuperar los bytes crudos del campo i
+//     como QByteArrayView sobre la trama original (fieldBytes()).
+//   - frame NO es propietario: apunta al buffer que se paso a decodeView().
+//     La vista solo es valida mientras ese buffer siga vivo.
+//
+// Todo el struct vive en la pila (~170 bytes). Cuando hace falta el
+// StanagMessage completo (por ejemplo para mostrarlo en QML), se materializa
+// bajo demanda con StanagCodec::toMessage().
+// =============================================================================
+struct StanagFrameView
+{
+    // --- Header ---
+    quint16 messageId    = 0;
+    quint16 sourcePort   = 0;
+    quint16 destPort     = 0;
+    quint16 sequenceNum  = 0;
+    quint16 payloadLen   = 0;
+    quint16 presenceMask = 0;
+
+    // --- Checksum ---
+    StanagChecksumMode checksumMode = StanagChecksumMode::Xor8;
+    quint32 checksum     = 0;
+    bool checksumValid   = false;
+
+    // --- Payload (14 slots indexados por bit) ---
+    // fieldMask: bits con campo en el plan del mensaje (ver StanagCatalog);
+    // un bit del presenceMask fuera de el no es un campo.
+    quint16 fieldMask = (1u << kStanagMaxFields) - 1;
+    int fieldCount = 0;                         // Campos presentes
+    double values[kStanagMaxFields] = {};       // Valor decodificado por bit
+    quint16 offsets[kStanagMaxFields] = {};     // Offset del campo en frame
+    quint8 sizes[kStanagMaxFields] = {};        // Tamano del campo (0 = ausente)
+
+    // --- Trama original (no propietaria) ---
+    QByteArrayView frame;
+
+    bool hasField(int index) const
+    {
+        return (presenceMask & fieldMask & (1u << index)) != 0;
+    }
+
+    QByteArrayView fieldBytes(int index) const
+    {
+        return frame.sliced(offsets[index], sizes[index]);
     }
 };
 
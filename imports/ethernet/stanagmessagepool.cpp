@@ -0,0 +1,50 @@
+// =============================================================================
+// stanagmessagepool.cpp — Implementacion del pool de mensajes
+// =============================================================================
+
+#include "stanagmessagepool.h"
+#include "stanagcodec.h"
+
+StanagMessagePool::StanagMessagePool(int prealloc)
+{
+    prealloc = qMax(prealloc, 0);
+    m_storage.reserve(std::size_t(prealloc));
+    m_free.reserve(std::size_t(prealloc));
+    for (int i = 0; i < prealloc; ++i)
+        m_free.push_back(create());
+}
+
+// =============================================================================
+// create() — Mensaje nuevo con la capacidad maxima ya reservada
+// =============================================================================
+// m_free se reserva al mismo tamano que m_storage: release() nunca tiene
+// que hacer crecer el vector.
+// =============================================================================
+StanagMessage *StanagMessagePool::create()
+{
+    auto msg = std::make_unique<StanagMessage>();
+    msg->fields.reserve(kStanagMaxFields);
+    msg->rawFrame.reserve(kStanagHeaderSize + kStanagMaxPayloadSize + 4);
+
+    m_storage.push_back(std::move(msg));
+    m_free.reserve(m_storage.size());
+    return m_storage.back().get();
+}
+
+StanagMessagePool::Handle StanagMessagePool::acquire()
+{
+    StanagMessage *msg = nullptr;
+    if (m_free.empty()) {
+        msg = create();
+    } else {
+        msg = m_free.back();
+        m_free.pop_back();
+        ++m_reused;
+    }
+    return Handle(msg, Releaser{ this });
+}
+
+void StanagMessagePool::release(StanagMessage *msg)
+{
+    m_free.push_back(msg);
+}
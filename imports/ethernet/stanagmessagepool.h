@@ -0,0 +1,73 @@
+// =============================================================================
+// stanagmessagepool.h — Pool de StanagMessage reutilizables
+// =============================================================================
+//
+// PATRON: Free list de objetos con almacenamiento propio. Un StanagMessage
+// decodificado tiene memoria dinamica (la QList de campos); crear uno por
+// trama es una reserva de heap por trama. El pool conserva los mensajes
+// devueltos CON su capacidad, y decode()/toMessage() la reutilizan:
+//
+//   StanagMessagePool pool(4);                 // 4 mensajes pre-reservados
+//   StanagMessagePool::Handle msg = pool.acquire();
+//   StanagCodec::decode(frame, *msg);          // 0 reservas tras el arranque
+//   ...                                        // al salir de ambito, vuelve
+//
+// Cada mensaje sale con fields.reserve(14) y rawFrame.reserve() de la
+// trama mas larga, asi que ni siquiera el primer decode tiene que crecer.
+//
+// QUE NO RESERVA (con un mensaje reutilizado):
+//   - fields: clear() conserva la capacidad si la lista no esta compartida.
+//   - StanagField::name: comparte el QString del plan (implicit sharing).
+//   - Bytes crudos de cada campo: solo su offset en msg.rawFrame.
+//   - rawFrame: decode() comparte el QByteArray de entrada; toMessage()
+//     copia sobre la capacidad que ya tiene.
+// Si el llamador se queda una COPIA del mensaje (fields o rawFrame
+// compartidos), el siguiente decode sobre el original reserva una vez
+// para separarse de ella. Es correcto, solo deja de ser gratis.
+//
+// Un pool no es thread-safe: uno por hilo (como el StanagStreamDecoder).
+// =============================================================================
+
+#ifndef STANAGMESSAGEPOOL_H
+#define STANAGMESSAGEPOOL_H
+
+#include <memory>
+#include <vector>
+#include "stanagmessage.h"
+
+class StanagMessagePool
+{
+public:
+    // Devuelve el mensaje a su pool al destruirse el Handle
+    struct Releaser
+    {
+        StanagMessagePool *pool = nullptr;
+        void operator()(StanagMessage *msg) const { pool->release(msg); }
+    };
+    using Handle = std::unique_ptr<StanagMessage, Releaser>;
+
+    // 'prealloc' mensajes listos desde el principio (el calentamiento)
+    explicit StanagMessagePool(int prealloc = 0);
+
+    StanagMessagePool(const StanagMessagePool &) = delete;
+    StanagMessagePool &operator=(const StanagMessagePool &) = delete;
+
+    // Un mensaje libre (o uno nuevo si no queda ninguno). Su contenido es
+    // el de su ultimo uso: decode()/toMessage() lo sobrescriben entero.
+    Handle acquire();
+
+    // --- Contadores ---
+    int size() const { return int(m_storage.size()); }      // Mensajes creados
+    int available() const { return int(m_free.size()); }   // Libres ahora
+    quint64 reuseCount() const { return m_reused; }         // acquire() sin crear
+
+private:
+    void release(StanagMessage *msg);
+    StanagMessage *create();
+
+    std::vector<std::unique_ptr<StanagMessage>> m_storage;
+    std::vector<StanagMessage *> m_free;
+    quint64 m_reused = 0;
+};
+
+#endif // STANAGMESSAGEPOOL_H
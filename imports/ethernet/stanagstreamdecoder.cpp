@@ -0,0 +1,303 @@
+// =============================================================================
+// stanagstreamdecoder.cpp — Implementacion del decoder de flujo
+// =============================================================================
+
+#include "stanagstreamdecoder.h"
+#include "stanagcatalog.h"
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+// Orden de prueba cuando el modo no esta fijado: del checksum mas fuerte
+// al mas debil (un CRC-32 valido por casualidad es ~imposible; un XOR no)
+constexpr StanagChecksumMode kProbeOrder[] = {
+    StanagChecksumMode::Crc32,
+    StanagChecksumMode::Crc16Ccitt,
+    StanagChecksumMode::Xor8,
+};
+
+quint16 payloadLenAt(const char *header)
+{
+    return qFromBigEndian<quint16>(header + 8);
+}
+
+bool checksumMatches(const char *frame, qsizetype size, StanagChecksumMode mode)
+{
+    const qsizetype covered = size - StanagChecksum::trailerSize(mode);
+    const quint32 trailer = StanagChecksum::readTrailer(
+        reinterpret_cast<const uchar *>(frame) + covered, mode);
+    return StanagChecksum::compute(QByteArrayView(frame, covered), mode) == trailer;
+}
+
+} // namespace
+
+// =============================================================================
+// plausibleHeader() — ¿Puede empezar una trama aqui?
+// =============================================================================
+// payloadLen debe ser EXACTAMENTE el tamano de los campos de presenceMask
+// (lo que escribe encode()) segun el plan de su messageId, y messageId
+// distinto de 0: asi un relleno de ceros (que con XOR tendria checksum
+// "valido") no se toma por tramas.
+// =============================================================================
+const StanagMessagePlan &StanagStreamDecoder::planFor(const char *header) const
+{
+    if (!m_catalog)
+        return StanagCodec::defaultPlan();
+    return m_catalog->plan(qFromBigEndian<quint16>(header));
+}
+
+bool StanagStreamDecoder::plausibleHeader(const char *header) const
+{
+    const quint16 messageId = qFromBigEndian<quint16>(header);
+    const quint16 presenceMask = qFromBigEndian<quint16>(header + 10);
+    return messageId != 0
+           && payloadLenAt(header) == planFor(header).payloadSize(presenceMask);
+}
+
+// =============================================================================
+// feed()
+// =============================================================================
+// Si quedaba una trama entregada desde el buffer interno, se consume ya,
+// sin "devolver" bytes al trozo viejo (m_carryFromChunk = 0): lo que sobre
+// se queda en el buffer y se completa con el trozo nuevo.
+// =============================================================================
+void StanagStreamDecoder::feed(QByteArrayView chunk, bool endOfStream)
+{
+    Q_ASSERT_X(m_position >= m_chunk.size(), "StanagStreamDecoder::feed",
+               "feed() called before next() consumed the previous chunk");
+
+    m_carryFromChunk = 0;
+    if (m_carryConsumed > 0) {
+        dropCarry(m_carryConsumed);
+        m_carryConsumed = 0;
+    }
+
+    m_chunk = chunk;
+    m_position = 0;
+    m_endOfStream = endOfStream;
+}
+
+// =============================================================================
+// next() — Siguiente trama
+// =============================================================================
+// Dos fases:
+//   1. Buffer interno no vacio: una trama a caballo entre trozos. Se
+//      rellena desde el trozo actual (hasta kCarryCapacity) y se prueba
+//      ahi. Cuando el buffer se vacia, los bytes copiados de mas vuelven
+//      al trozo (dropCarry) y se pasa a la fase 2.
+//   2. Directamente sobre el trozo: las tramas se entregan como vistas
+//      sobre 'chunk', sin copias. Si el final del trozo no basta para
+//      decidir, esos pocos bytes (< kCarryCapacity) pasan al buffer.
+// =============================================================================
+bool StanagStreamDecoder::next(StanagFrameView &view)
+{
+    if (m_carryConsumed > 0) {
+        dropCarry(m_carryConsumed);
+        m_carryConsumed = 0;
+    }
+
+    qsizetype frameSize = 0;
+    StanagChecksumMode mode = m_mode;
+
+    for (;;) {
+        // --- Fase 1: trama partida ---
+        if (m_carrySize > 0) {
+            const qsizetype take = qMin(qsizetype(kCarryCapacity) - m_carrySize,
+                                        m_chunk.size() - m_position);
+            if (take > 0) {
+                std::memcpy(m_carry + m_carrySize, m_chunk.data() + m_position,
+                            std::size_t(take));
+                m_carrySize += take;
+                m_position += take;
+                m_carryFromChunk += take;
+                m_carried += quint64(take);
+            }
+
+            const bool final = m_endOfStream && m_position >= m_chunk.size();
+            switch (probe(m_carry, m_carrySize, final, frameSize, mode)) {
+            case Probe::Frame:
+                m_carryConsumed = frameSize;   // Se libera en la proxima llamada
+                return emitFrame(QByteArrayView(m_carry, frameSize), mode, view);
+            case Probe::Skip:
+                ++m_skipped;
+                m_skipping = true;
+                dropCarry(1);
+                continue;
+            case Probe::NeedMore:
+                return false;
+            }
+        }
+
+        // --- Fase 2: directamente sobre el trozo ---
+        const qsizetype available = m_chunk.size() - m_position;
+        if (available <= 0)
+            return false;
+
+        const char *data = m_chunk.data() + m_position;
+        switch (probe(data, available, m_endOfStream, frameSize, mode)) {
+        case Probe::Frame:
+            m_position += frameSize;
+            return emitFrame(QByteArrayView(data, frameSize), mode, view);
+        case Probe::Skip:
+            ++m_skipped;
+            m_skipping = true;
+            ++m_position;
+            continue;
+        case Probe::NeedMore:
+            std::memcpy(m_carry, data, std::size_t(available));
+            m_carrySize = available;
+            m_carryFromChunk = 0;   // El trozo se agota: no hay a donde devolver
+            m_carried += quint64(available);
+            m_position = m_chunk.size();
+            return false;
+        }
+    }
+}
+
+// =============================================================================
+// probe() — ¿Trama, faltan bytes o basura?
+// =============================================================================
+// 1. Header: hacen falta 12 bytes y que sea plausible.
+// 2. Modo fijado: si caben header + payload + su trailer y el checksum
+//    cuadra, es una trama (sin mirar mas alla).
+// 3. Resto de modos, de mas fuerte a mas debil: checksum valido (y, para
+//    XOR, ademas un header plausible detras o el fin exacto del flujo).
+// Solo se pide "mas bytes" si no es el final: al final se decide con lo
+// que hay, asi un datagrama nunca deja nada pendiente.
+// =============================================================================
+StanagStreamDecoder::Probe StanagStreamDecoder::probe(const char *data, qsizetype size,
+                                                      bool final, qsizetype &frameSize,
+                                                      StanagChecksumMode &mode) const
+{
+    if (size < kStanagHeaderSize)
+        return final ? Probe::Skip : Probe::NeedMore;
+    if (!plausibleHeader(data))
+        return Probe::Skip;
+
+    const qsizetype base = kStanagHeaderSize + payloadLenAt(data);
+
+    if (m_modeLocked) {
+        const qsizetype candidate = base + StanagChecksum::trailerSize(m_mode);
+        if (candidate > size && !final)
+            return Probe::NeedMore;
+        if (candidate <= size && checksumMatches(data, candidate, m_mode)) {
+            frameSize = candidate;
+            mode = m_mode;
+            return Probe::Frame;
+        }
+    }
+
+    for (const StanagChecksumMode other : kProbeOrder) {
+        if (m_modeLocked && other == m_mode)
+            continue;
+
+        const qsizetype candidate = base + StanagChecksum::trailerSize(other);
+        if (candidate > size) {
+            if (!final)
+                return Probe::NeedMore;
+            continue;
+        }
+        if (!checksumMatches(data, candidate, other))
+            continue;
+
+        // Un CRC valido sobre un header plausible basta. Un XOR (1 de cada
+        // 256 posiciones de basura lo "cumple") se confirma con lo que
+        // viene detras.
+        if (other != StanagChecksumMode::Xor8) {
+            frameSize = candidate;
+            mode = other;
+            return Probe::Frame;
+        }
+
+        const qsizetype rest = size - candidate;
+        if (rest < kStanagHeaderSize) {
+            if (!final)
+                return Probe::NeedMore;
+            if (rest != 0)
+                continue;
+        } else if (!plausibleHeader(data + candidate)) {
+            continue;
+        }
+
+        frameSize = candidate;
+        mode = other;
+        return Probe::Frame;
+    }
+
+    return Probe::Skip;
+}
+
+// =============================================================================
+// dropCarry() — Consumir bytes del principio del buffer interno
+// =============================================================================
+// Si todo lo que queda en el buffer salio del trozo actual, en vez de
+// moverlo se retrocede m_position: esos bytes se vuelven a leer
+// directamente del trozo (fase 2, sin copia).
+// =============================================================================
+void StanagStreamDecoder::dropCarry(qsizetype count)
+{
+    const qsizetype rest = m_carrySize - count;
+    if (rest <= m_carryFromChunk) {
+        m_position -= rest;
+        m_carrySize = 0;
+        m_carryFromChunk = 0;
+        return;
+    }
+
+    std::memmove(m_carry, m_carry + count, std::size_t(rest));
+    m_carrySize = rest;
+}
+
+bool StanagStreamDecoder::emitFrame(QByteArrayView frame, StanagChecksumMode mode,
+                                    StanagFrameView &view)
+{
+    m_mode = mode;
+    m_modeLocked = true;
+    ++m_frames;
+    if (m_skipping) {
+        m_skipping = false;
+        ++m_resyncs;
+    }
+    return StanagCodec::decodeView(frame, view, planFor(frame.data()));
+}
+
+void StanagStreamDecoder::setCatalog(const StanagCatalog *catalog)
+{
+    m_catalog = catalog;
+}
+
+void StanagStreamDecoder::reset()
+{
+    m_chunk = QByteArrayView();
+    m_position = 0;
+    m_endOfStream = false;
+    m_carrySize = 0;
+    m_carryFromChunk = 0;
+    m_carryConsumed = 0;
+    m_modeLocked = false;
+    m_skipping = false;
+}
+
+void StanagStreamDecoder::setChecksumMode(StanagChecksumMode mode)
+{
+    m_mode = mode;
+    m_modeLocked = true;
+}
+
+bool StanagStreamDecoder::hasChecksumMode() const { return m_modeLocked; }
+StanagChecksumMode StanagStreamDecoder::checksumMode() const { return m_mode; }
+
+bool StanagStreamDecoder::isSingleFrame(QByteArrayView data)
+{
+    if (data.size() < kStanagHeaderSize + 1)
+        return false;
+    const qsizetype trailer = data.size() - kStanagHeaderSize - payloadLenAt(data.data());
+    return trailer == 1 || trailer == 2 || trailer == 4;
+}
+
+quint64 StanagStreamDecoder::frameCount() const { return m_frames; }
+quint64 StanagStreamDecoder::skippedBytes() const { return m_skipped; }
+quint64 StanagStreamDecoder::resyncCount() const { return m_resyncs; }
+quint64 StanagStreamDecoder::carriedBytes() const { return m_carried; }
+qsizetype StanagStreamDecoder::pendingBytes() const { return m_carrySize - m_carryConsumed; }
@@ -0,0 +1,159 @@
+// =============================================================================
+// stanagstreamdecoder.h — Decoder incremental de tramas STANAG concatenadas
+// =============================================================================
+//
+// PATRON: Decoder "push/pull" sin hilo ni QObject. Quien recibe bytes los
+// entrega con feed() y despues saca tramas con next() hasta que devuelve
+// false:
+//
+//   decoder.feed(chunk);
+//   StanagFrameView view;
+//   while (decoder.next(view))
+//       procesar(view);            // view.frame apunta a 'chunk'
+//
+// Sirve para dos casos que StanagCodec::decode() no cubre:
+//   - Transportes de flujo (TCP, serie): los bytes llegan en trozos
+//     arbitrarios, una trama puede quedar partida entre dos trozos.
+//   - Datagramas con VARIAS tramas empaquetadas (menos llamadas al sistema
+//     por trama). Ahi cada datagrama es un flujo cerrado: feed(d, true).
+//
+// LIMITES DE TRAMA:
+//   El header dice payloadLen, pero el tamano del trailer (1, 2 o 4 bytes
+//   segun el checksum) no viaja en la trama: con un solo frame por
+//   datagrama se deducia del tamano total. En un flujo se prueba cada
+//   tamano y se queda el que tiene checksum valido:
+//     - Modo fijado: el modo de la ultima trama aceptada. Se prueba
+//       primero y, si es valido, la trama se acepta sin mirar mas bytes.
+//     - Cualquier otro modo (primera trama, o el peer cambio de modo) se
+//       prueba de mas fuerte a mas debil (CRC-32, CRC-16, XOR). Un XOR de
+//       1 byte (1/256 de falsos positivos) solo se acepta si ADEMAS lo que
+//       sigue es un header plausible o el fin del flujo: asi no basta para
+//       "engancharse" a basura.
+//   Header plausible = payloadLen == tamano del presenceMask segun el plan
+//   del messageId (setCatalog(); sin catalogo, el plan por defecto). Es lo
+//   que produce siempre StanagCodec::encode().
+//
+// RESINCRONIZACION:
+//   Si en la posicion actual no hay una trama valida, se descarta UN byte y
+//   se vuelve a probar. skippedBytes() cuenta lo descartado y resyncCount()
+//   las veces que se recupero el sincronismo despues de descartar.
+//
+// SIN COPIAS:
+//   Las tramas enteras dentro de un trozo se entregan como vistas sobre el
+//   propio trozo. Solo una trama que cruza el limite entre dos trozos se
+//   reconstruye en un buffer interno de kCarryCapacity bytes (carriedBytes()
+//   cuenta esas copias). Una vista es valida hasta la siguiente llamada a
+//   feed() o next(), y mientras el trozo del llamador siga vivo.
+// =============================================================================
+
+#ifndef STANAGSTREAMDECODER_H
+#define STANAGSTREAMDECODER_H
+
+#include <QByteArrayView>
+#include "stanagcodec.h"
+#include "stanagmessage.h"
+
+class StanagCatalog;
+
+class StanagStreamDecoder
+{
+public:
+    // Trama mas larga posible: header + 14 campos de 4 bytes + CRC-32
+    // (cualquier plan del catalogo cabe)
+    static constexpr int kMaxFrameSize =
+        kStanagHeaderSize + kStanagMaxPayloadSize + 4;
+
+    // Una trama completa + el header siguiente (para validar un modo nuevo)
+    static constexpr int kCarryCapacity = kMaxFrameSize + kStanagHeaderSize;
+
+    // =========================================================================
+    // feed() — Entregar el siguiente trozo de bytes
+    // =========================================================================
+    // Solo debe llamarse cuando next() ya devolvio false (el trozo anterior
+    // esta consumido; lo que quedara a medias ya esta en el buffer interno).
+    // 'chunk' debe seguir vivo mientras se llama a next().
+    //
+    // endOfStream = true: no llegaran mas bytes. La ultima trama se decide
+    // con lo que haya y los bytes sobrantes se descartan (cuentan en
+    // skippedBytes). Es el modo para datagramas con tramas empaquetadas.
+    // =========================================================================
+    void feed(QByteArrayView chunk, bool endOfStream = false);
+
+    // Siguiente trama completa (checksum valido), o false si hacen falta
+    // mas bytes (o el flujo termino)
+    bool next(StanagFrameView &view);
+
+    // Olvidar bytes pendientes y el modo fijado (los contadores se conservan)
+    void reset();
+
+    // Catalogo para elegir el plan de cada messageId (no propietario; debe
+    // vivir mientras se use el decoder). nullptr = plan por defecto.
+    void setCatalog(const StanagCatalog *catalog);
+
+    // Fijar el modo de checksum esperado desde el principio (sin deteccion)
+    void setChecksumMode(StanagChecksumMode mode);
+    bool hasChecksumMode() const;
+    StanagChecksumMode checksumMode() const;
+
+    // =========================================================================
+    // isSingleFrame() — ¿'data' es exactamente UNA trama?
+    // =========================================================================
+    // Cierto si el tamano encaja con header + payloadLen + trailer de 1, 2
+    // o 4 bytes. Un datagrama con dos o mas tramas nunca lo cumple (cada
+    // trama ocupa al menos 13 bytes), asi que el receptor puede usar el
+    // decode de siempre y solo pasar por el decoder de flujo si hace falta.
+    // =========================================================================
+    static bool isSingleFrame(QByteArrayView data);
+
+    // --- Contadores ---
+    quint64 frameCount() const;
+    quint64 skippedBytes() const;
+    quint64 resyncCount() const;
+    quint64 carriedBytes() const;
+    qsizetype pendingBytes() const;      // Esperando en el buffer interno
+
+private:
+    enum class Probe { Frame, NeedMore, Skip };
+
+    // Decide que hay en data[0..size): una trama (frameSize), falta de
+    // bytes o basura. 'final' = no llegaran mas bytes detras de 'size'.
+    Probe probe(const char *data, qsizetype size, bool final,
+                qsizetype &frameSize, StanagChecksumMode &mode) const;
+
+    // Consumir 'count' bytes del principio del buffer interno
+    void dropCarry(qsizetype count);
+
+    const StanagMessagePlan &planFor(const char *header) const;
+    bool plausibleHeader(const char *header) const;
+
+    bool emitFrame(QByteArrayView frame, StanagChecksumMode mode,
+                   StanagFrameView &view);
+
+    const StanagCatalog *m_catalog = nullptr;
+
+    // --- Trozo actual (no propietario) ---
+    QByteArrayView m_chunk;
+    qsizetype m_position = 0;
+    bool m_endOfStream = false;
+
+    // --- Trama partida entre trozos ---
+    // m_carryFromChunk: cuantos de los ultimos bytes del buffer se copiaron
+    // del trozo ACTUAL; si sobran se "devuelven" al trozo en vez de moverlos.
+    char m_carry[kCarryCapacity];
+    qsizetype m_carrySize = 0;
+    qsizetype m_carryFromChunk = 0;
+    qsizetype m_carryConsumed = 0;      // Trama entregada desde el buffer
+
+    // --- Modo de checksum fijado ---
+    StanagChecksumMode m_mode = StanagChecksumMode::Xor8;
+    bool m_modeLocked = false;
+    bool m_skipping = false;
+
+    // --- Contadores ---
+    quint64 m_frames = 0;
+    quint64 m_skipped = 0;
+    quint64 m_resyncs = 0;
+    quint64 m_carried = 0;
+};
+
+#endif // STANAGSTREAMDECODER_H
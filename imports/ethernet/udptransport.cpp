@@ -5,6 +5,105 @@
 #include "udptransport.h"
 #include <QHostAddress>
 #include <QNetworkDatagram>
+#include <QNetworkInterface>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <arpa/inet.h>
+#include <cerrno>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <ctime>
+#endif
+
+// =============================================================================
+// UdpBatchBuffers — Memoria preasignada del modo batch
+// =============================================================================
+// Todo lo que necesita una lectura por lotes se reserva UNA vez:
+//   - arena: N slots contiguos de kBatchSlotSize bytes (los datos)
+//   - views: N UdpDatagramView que se emiten apuntando a los slots
+//   - (Linux) headers/iovecs/addrs: las estructuras que recvmmsg() rellena.
+//     Cada mmsghdr apunta a su iovec (→ su slot) y a su sockaddr_storage
+//     (donde el kernel escribe la direccion del emisor).
+//
+// Despues de construirse, leer un lote no reserva memoria.
+//
+// controls: buffer de "mensajes de control" (cmsg) por slot, donde el
+// kernel deja el timestamp de llegada (SCM_TIMESTAMPNS → struct timespec).
+// =============================================================================
+#ifdef Q_OS_LINUX
+struct alignas(cmsghdr) ControlBuffer
+{
+    char data[64];
+};
+static_assert(CMSG_SPACE(sizeof(timespec)) <= sizeof(ControlBuffer),
+              "ControlBuffer demasiado pequeno para SCM_TIMESTAMPNS");
+#endif
+
+struct UdpBatchBuffers
+{
+    explicit UdpBatchBuffers(int size)
+        : arena(std::size_t(size) * UdpTransport::kBatchSlotSize)
+        , views(std::size_t(size))
+#ifdef Q_OS_LINUX
+        , headers(std::size_t(size))
+        , iovecs(std::size_t(size))
+        , addrs(std::size_t(size))
+        , controls(std::size_t(size))
+#endif
+    {
+#ifdef Q_OS_LINUX
+        for (int i = 0; i < size; ++i) {
+            iovecs[i].iov_base = slot(i);
+            iovecs[i].iov_len = UdpTransport::kBatchSlotSize;
+            std::memset(&headers[i], 0, sizeof(mmsghdr));
+            headers[i].msg_hdr.msg_iov = &iovecs[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &addrs[i];
+        }
+#endif
+    }
+
+    int capacity() const { return int(views.size()); }
+    char *slot(int i) { return arena.data() + std::size_t(i) * UdpTransport::kBatchSlotSize; }
+
+    std::vector<char> arena;
+    std::vector<UdpDatagramView> views;
+#ifdef Q_OS_LINUX
+    std::vector<mmsghdr> headers;
+    std::vector<iovec> iovecs;
+    std::vector<sockaddr_storage> addrs;
+    std::vector<ControlBuffer> controls;
+#endif
+};
+
+#ifdef Q_OS_LINUX
+// Puerto del emisor desde la direccion que relleno el kernel (IPv4 o IPv6)
+static quint16 senderPortOf(const sockaddr_storage &addr)
+{
+    if (addr.ss_family == AF_INET)
+        return ntohs(reinterpret_cast<const sockaddr_in &>(addr).sin_port);
+    if (addr.ss_family == AF_INET6)
+        return ntohs(reinterpret_cast<const sockaddr_in6 &>(addr).sin6_port);
+    return 0;
+}
+
+// Timestamp de llegada del kernel (SO_TIMESTAMPNS), o 0 si no viene
+static qint64 kernelTimestampOf(msghdr &header)
+{
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec ts{};
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            return qint64(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        }
+    }
+    return 0;
+}
+#endif
 
 // =============================================================================
 // Constructor
@@ -14,9 +113,13 @@
 // Esta conexion es la base del patron asincrono de Qt: en vez de hacer
 // polling (preguntar continuamente "¿hay datos?"), el event loop nos
 // notifica cuando llegan datos.
+//
+// El socket se crea con 'this' como parent para que, si el transporte se
+// mueve a otro hilo (ReceiveWorker), el socket se mueva con el.
 // =============================================================================
 UdpTransport::UdpTransport(QObject *parent)
     : QObject(parent)
+    , m_socket(this)   // Hijo del transporte: moveToThread() mueve ambos
 {
     connect(&m_socket, &QUdpSocket::readyRead,
             this, &UdpTransport::onReadyRead);
@@ -34,18 +137,43 @@ UdpTransport::~UdpTransport()
         m_socket.close();
 }
 
+// =============================================================================
+// setBatchSize() — Configurar el modo batch
+// =============================================================================
+// Solo guarda el tamano deseado. Los buffers se crean (o se recrean) al
+// principio de readBatch(): asi es seguro llamar a setBatchSize() incluso
+// desde un slot conectado a datagramsReceived(), mientras las vistas del
+// lote actual todavia apuntan a los buffers viejos.
+// =============================================================================
+void UdpTransport::setBatchSize(int size)
+{
+    m_batchSize = qMax(0, size);
+}
+
+int UdpTransport::batchSize() const
+{
+    return m_batchSize;
+}
+
 // =============================================================================
 // bind() — Vincular el socket a un puerto local
 // =============================================================================
-// QHostAddress::LocalHost = 127.0.0.1 (solo conexiones locales).
-// Alternativa: QHostAddress::Any = 0.0.0.0 (acepta conexiones de cualquier
-// interfaz de red). Para un ejemplo didactico, LocalHost es mas seguro.
+// QHostAddress::LocalHost = 127.0.0.1 (solo conexiones locales, el valor
+// por defecto). Alternativa: QHostAddress::AnyIPv4 = 0.0.0.0 (acepta
+// datagramas de cualquier interfaz; necesario para multicast). Para un
+// ejemplo didactico, LocalHost es mas seguro.
 //
 // ReuseAddressHint permite reutilizar un puerto que el SO aun tiene en
 // estado TIME_WAIT (comun cuando cierras y reabres rapidamente). Sin esto,
 // el bind podria fallar si reinicias la app rapido.
+//
+// Opciones multicast (afectan solo a lo que se ENVIA a un grupo):
+//   - MulticastLoopbackOption = 1: las copias vuelven a la propia maquina,
+//     asi otras instancias locales (y esta misma) reciben lo enviado.
+//   - MulticastTtlOption = 1: no se cruza ningun router.
 // =============================================================================
-bool UdpTransport::bind(quint16 port)
+bool UdpTransport::bind(quint16 port, const QHostAddress &address,
+                        QAbstractSocket::BindMode mode)
 {
     if (m_bound) {
         emit errorOccurred(QStringLiteral("Socket already bound to port %1")
@@ -53,8 +181,7 @@ bool UdpTransport::bind(quint16 port)
         return false;
     }
 
-    if (!m_socket.bind(QHostAddress::LocalHost, port,
-                       QAbstractSocket::ReuseAddressHint)) {
+    if (!m_socket.bind(address, port, mode)) {
         emit errorOccurred(QStringLiteral("Failed to bind port %1: %2")
                                .arg(port)
                                .arg(m_socket.errorString()));
@@ -62,9 +189,101 @@ bool UdpTransport::bind(quint16 port)
     }
 
     m_bound = true;
+    m_socket.setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+    m_socket.setSocketOption(QAbstractSocket::MulticastTtlOption, 1);
+
+#ifdef Q_OS_LINUX
+    // Pedir al kernel el timestamp de llegada de cada datagrama. Se recoge
+    // en modo batch (recvmmsg con buffer de control); si falla no es grave,
+    // simplemente se usara la hora de lectura.
+    const int on = 1;
+    ::setsockopt(int(m_socket.socketDescriptor()), SOL_SOCKET, SO_TIMESTAMPNS,
+                 &on, sizeof(on));
+#endif
+    return true;
+}
+
+// =============================================================================
+// bindMulticast() — Bind compartido + join
+// =============================================================================
+// El bind es a AnyIPv4 y no al grupo: asi el mismo socket recibe tambien
+// el unicast dirigido a este puerto (p. ej. el de un emisor que no usa
+// multicast).
+// =============================================================================
+bool UdpTransport::bindMulticast(quint16 port, const QHostAddress &group,
+                                 const QString &interfaceName)
+{
+    if (!group.isMulticast() || group.protocol() != QAbstractSocket::IPv4Protocol) {
+        emit errorOccurred(QStringLiteral("%1 is not an IPv4 multicast group")
+                               .arg(group.toString()));
+        return false;
+    }
+
+    if (!bind(port, QHostAddress(QHostAddress::AnyIPv4),
+              QAbstractSocket::ShareAddress | QAbstractSocket::ReuseAddressHint))
+        return false;
+
+    if (!joinMulticastGroup(group, interfaceName)) {
+        unbind();
+        return false;
+    }
     return true;
 }
 
+// =============================================================================
+// joinMulticastGroup() / leaveMulticastGroup()
+// =============================================================================
+// Con interfaz explicita tambien se fija como interfaz de SALIDA del
+// multicast (IP_MULTICAST_IF): lo enviado a un grupo sale por la misma
+// interfaz por la que se escucha. Para multicast dentro de la maquina sin
+// red, 'lo' sirve si tiene el flag MULTICAST (ip link set lo multicast on).
+// =============================================================================
+bool UdpTransport::joinMulticastGroup(const QHostAddress &group,
+                                      const QString &interfaceName)
+{
+    if (!m_bound) {
+        emit errorOccurred(QStringLiteral("Bind before joining %1").arg(group.toString()));
+        return false;
+    }
+    if (m_groups.contains(group))
+        return true;
+
+    bool joined = false;
+    if (interfaceName.isEmpty()) {
+        joined = m_socket.joinMulticastGroup(group);
+    } else {
+        const QNetworkInterface iface = QNetworkInterface::interfaceFromName(interfaceName);
+        if (!iface.isValid()) {
+            emit errorOccurred(QStringLiteral("Unknown network interface %1").arg(interfaceName));
+            return false;
+        }
+        joined = m_socket.joinMulticastGroup(group, iface);
+        if (joined)
+            m_socket.setMulticastInterface(iface);
+    }
+
+    if (!joined) {
+        emit errorOccurred(QStringLiteral("Failed to join %1: %2")
+                               .arg(group.toString(), m_socket.errorString()));
+        return false;
+    }
+
+    m_groups.append(group);
+    return true;
+}
+
+bool UdpTransport::leaveMulticastGroup(const QHostAddress &group)
+{
+    if (!m_groups.removeOne(group))
+        return false;
+    return m_socket.leaveMulticastGroup(group);
+}
+
+QList<QHostAddress> UdpTransport::multicastGroups() const
+{
+    return m_groups;
+}
+
 // =============================================================================
 // unbind() — Cerrar el socket y liberar el puerto
 // =============================================================================
@@ -73,10 +292,18 @@ void UdpTransport::unbind()
     if (!m_bound)
         return;
 
+    // Cerrar el socket abandona tambien sus grupos multicast
     m_socket.close();
+    m_groups.clear();
     m_bound = false;
 }
 
+qint64 UdpTransport::wallClockNs()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+}
+
 bool UdpTransport::isBound() const
 {
     return m_bound;
@@ -97,8 +324,15 @@ quint16 UdpTransport::boundPort() const
 // =============================================================================
 bool UdpTransport::sendDatagram(const QByteArray &data, quint16 destPort)
 {
-    qint64 bytesSent = m_socket.writeDatagram(
-        data, QHostAddress::LocalHost, destPort);
+    return sendDatagram(QByteArrayView(data), QHostAddress(QHostAddress::LocalHost),
+                        destPort);
+}
+
+bool UdpTransport::sendDatagram(QByteArrayView data, const QHostAddress &address,
+                                quint16 destPort)
+{
+    qint64 bytesSent = m_socket.writeDatagram(data.data(), data.size(),
+                                              address, destPort);
 
     if (bytesSent == -1) {
         emit errorOccurred(QStringLiteral("Send failed: %1")
@@ -109,6 +343,226 @@ bool UdpTransport::sendDatagram(const QByteArray &data, quint16 destPort)
     return true;
 }
 
+// =============================================================================
+// sendDatagrams() — Envio por lotes a localhost:destPort
+// =============================================================================
+// Caso particular de sendToAll() con un unico destino.
+// =============================================================================
+int UdpTransport::sendDatagrams(const QByteArrayView *frames, int count,
+                                quint16 destPort)
+{
+    UdpDestination local;
+    local.address = QHostAddress(QHostAddress::LocalHost);
+    local.port = destPort;
+    return int(sendToAll(frames, count, &local, 1));
+}
+
+void UdpTransport::setSendStallMs(int ms)
+{
+    m_sendStallMs = qMax(0, ms);
+}
+
+int UdpTransport::sendStallMs() const
+{
+    return m_sendStallMs;
+}
+
+bool UdpTransport::sendWouldBlock() const
+{
+    return m_sendWouldBlock;
+}
+
+// =============================================================================
+// Lista de destinos
+// =============================================================================
+int UdpTransport::addDestination(const QHostAddress &address, quint16 port)
+{
+    for (std::size_t i = 0; i < m_destinations.size(); ++i) {
+        if (m_destinations[i].address == address && m_destinations[i].port == port)
+            return int(i);
+    }
+
+    UdpDestination dest;
+    dest.address = address;
+    dest.port = port;
+    m_destinations.push_back(dest);
+    return int(m_destinations.size()) - 1;
+}
+
+bool UdpTransport::removeDestination(int index)
+{
+    if (index < 0 || index >= int(m_destinations.size()))
+        return false;
+    m_destinations.erase(m_destinations.begin() + index);
+    return true;
+}
+
+void UdpTransport::clearDestinations()
+{
+    m_destinations.clear();
+}
+
+void UdpTransport::resetDestinationCounters()
+{
+    for (UdpDestination &dest : m_destinations) {
+        dest.sentDatagrams = 0;
+        dest.sentBytes = 0;
+        dest.failedDatagrams = 0;
+    }
+}
+
+const std::vector<UdpDestination> &UdpTransport::destinations() const
+{
+    return m_destinations;
+}
+
+int UdpTransport::destinationCount() const
+{
+    return int(m_destinations.size());
+}
+
+// =============================================================================
+// fanOut() — Una trama (o un lote) a todos los destinos
+// =============================================================================
+// sendToAll() devuelve cuantos mensajes salieron en orden trama-mayor, asi
+// que el reparto por destino es aritmetico:
+//   tramas completas = sent / D
+//   la trama siguiente solo llego a los (sent % D) primeros destinos
+// =============================================================================
+int UdpTransport::fanOut(QByteArrayView frame)
+{
+    return fanOut(&frame, 1);
+}
+
+int UdpTransport::fanOut(const QByteArrayView *frames, int count)
+{
+    const int destCount = int(m_destinations.size());
+    if (destCount == 0 || count <= 0)
+        return 0;
+
+    const qint64 sent = sendToAll(frames, count, m_destinations.data(), destCount);
+    const int fullFrames = int(sent / destCount);
+    const int partial = int(sent % destCount);
+
+    quint64 fullBytes = 0;
+    for (int f = 0; f < fullFrames; ++f)
+        fullBytes += quint64(frames[f].size());
+
+    for (int d = 0; d < destCount; ++d) {
+        UdpDestination &dest = m_destinations[std::size_t(d)];
+        const bool gotPartial = d < partial;
+        const quint64 frameCount = quint64(fullFrames) + (gotPartial ? 1 : 0);
+        dest.sentDatagrams += frameCount;
+        dest.sentBytes += fullBytes + (gotPartial ? quint64(frames[fullFrames].size()) : 0);
+        dest.failedDatagrams += quint64(count) - frameCount;
+    }
+    return fullFrames;
+}
+
+// =============================================================================
+// sendToAll() — Envio por lotes con sendmmsg()
+// =============================================================================
+// sendmmsg(fd, msgs, n, flags) es el equivalente de recvmmsg() para envio:
+// cada mmsghdr describe un datagrama (destino + iovec con sus bytes).
+// El mensaje m es la trama m / D hacia el destino m % D. Los iovec apuntan
+// directamente a los bytes del llamador y los sockaddr se construyen una
+// vez por llamada: no se copia nada, ni siquiera con varios destinos.
+//
+// El socket de QUdpSocket es NO bloqueante. Si el buffer de envio del
+// kernel se llena, sendmmsg() devuelve EAGAIN: esperamos con poll() a que
+// haya hueco (POLLOUT) un maximo de m_sendStallMs y, si no lo hay, nos
+// rendimos y devolvemos lo enviado hasta el momento. Con m_sendStallMs = 0
+// no se espera ni se avisa: se marca m_sendWouldBlock y el llamador
+// reintenta cuando quiera.
+//
+// Un destino que el kernel rechaza (p. ej. ENETUNREACH para un grupo sin
+// ruta) corta el envio en ese mensaje, igual que el fallback portable.
+// =============================================================================
+qint64 UdpTransport::sendToAll(const QByteArrayView *frames, int count,
+                               const UdpDestination *dests, int destCount)
+{
+    m_sendWouldBlock = false;
+    const qint64 total = qint64(count) * destCount;
+    if (total <= 0)
+        return 0;
+
+#ifdef Q_OS_LINUX
+    bool allIpv4 = true;
+    for (int d = 0; d < destCount; ++d)
+        allIpv4 &= dests[d].address.protocol() == QAbstractSocket::IPv4Protocol;
+
+    const int fd = int(m_socket.socketDescriptor());
+    if (fd != -1 && allIpv4
+        && m_socket.localAddress().protocol() != QAbstractSocket::IPv6Protocol) {
+        constexpr int kMaxPerCall = 1024;   // UIO_MAXIOV
+
+        std::vector<sockaddr_in> addrs(std::size_t(destCount));
+        for (int d = 0; d < destCount; ++d) {
+            addrs[d].sin_family = AF_INET;
+            addrs[d].sin_port = htons(dests[d].port);
+            addrs[d].sin_addr.s_addr = htonl(dests[d].address.toIPv4Address());
+        }
+
+        const int chunk = int(qMin<qint64>(total, kMaxPerCall));
+        std::vector<mmsghdr> headers(std::size_t(chunk));
+        std::vector<iovec> iovecs(std::size_t(chunk));
+
+        qint64 sent = 0;
+        while (sent < total) {
+            const int n = int(qMin<qint64>(chunk, total - sent));
+            for (int i = 0; i < n; ++i) {
+                const qint64 m = sent + i;
+                const QByteArrayView frame = frames[m / destCount];
+                iovecs[i].iov_base = const_cast<char *>(frame.data());
+                iovecs[i].iov_len = std::size_t(frame.size());
+                std::memset(&headers[i], 0, sizeof(mmsghdr));
+                headers[i].msg_hdr.msg_name = &addrs[std::size_t(m % destCount)];
+                headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                headers[i].msg_hdr.msg_iov = &iovecs[i];
+                headers[i].msg_hdr.msg_iovlen = 1;
+            }
+
+            const int result = ::sendmmsg(fd, headers.data(), unsigned(n), 0);
+            if (result > 0) {
+                sent += result;
+                continue;
+            }
+            if (result == -1 && errno == EINTR)
+                continue;
+            if (result == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                if (m_sendStallMs <= 0) {
+                    m_sendWouldBlock = true;
+                    break;
+                }
+                pollfd pfd{ fd, POLLOUT, 0 };
+                if (::poll(&pfd, 1, m_sendStallMs) > 0)
+                    continue;
+            }
+
+            emit errorOccurred(QStringLiteral("Batch send stopped after %1 of %2 datagrams")
+                                   .arg(sent)
+                                   .arg(total));
+            break;
+        }
+        return sent;
+    }
+#endif
+
+    // --- Fallback portable: un writeDatagram() por mensaje ---
+    qint64 sent = 0;
+    for (; sent < total; ++sent) {
+        const QByteArrayView frame = frames[sent / destCount];
+        const UdpDestination &dest = dests[sent % destCount];
+        if (m_socket.writeDatagram(frame.data(), frame.size(),
+                                   dest.address, dest.port) == -1) {
+            emit errorOccurred(QStringLiteral("Send failed: %1")
+                                   .arg(m_socket.errorString()));
+            break;
+        }
+    }
+    return sent;
+}
+
 // =============================================================================
 // onReadyRead() — Slot que procesa datagramas entrantes
 // =============================================================================
@@ -127,9 +581,137 @@ bool UdpTransport::sendDatagram(const QByteArray &data, quint16 destPort)
 // =============================================================================
 void UdpTransport::onReadyRead()
 {
+    if (m_batchSize > 0) {
+        readBatch();
+        return;
+    }
+
     while (m_socket.hasPendingDatagrams()) {
         QNetworkDatagram datagram = m_socket.receiveDatagram();
         emit datagramReceived(datagram.data(),
                               static_cast<quint16>(datagram.senderPort()));
     }
 }
+
+// =============================================================================
+// readBatch() — Vaciar la cola del socket por lotes
+// =============================================================================
+// LINUX (recvmmsg):
+//   recvmmsg(fd, headers, N, MSG_DONTWAIT) lee hasta N datagramas en una
+//   sola llamada al sistema, cada uno en su slot. Devuelve cuantos leyo
+//   (0..N) o -1 con errno = EAGAIN si la cola esta vacia. Mientras el lote
+//   salga lleno, puede haber mas datos: repetimos.
+//
+//   RE-ARMADO DE QUdpSocket: QUdpSocket (sin buffer para UDP) solo vuelve a
+//   emitir readyRead despues de que alguien lea un datagrama A TRAVES DE
+//   QUdpSocket. Como recvmmsg lee "por debajo", terminamos siempre con una
+//   llamada a receiveDatagram(): si la cola ya esta vacia no devuelve nada
+//   pero re-habilita la notificacion; si justo llego un datagrama, lo
+//   entregamos como un lote de 1 para no perderlo.
+//
+// OTRAS PLATAFORMAS:
+//   Mismo API y mismos slots, rellenados con receiveDatagram(). Se ahorra
+//   la emision por datagrama aunque no la llamada al sistema.
+// =============================================================================
+void UdpTransport::readBatch()
+{
+    if (!m_batch || m_batch->capacity() != m_batchSize)
+        m_batch = std::make_unique<UdpBatchBuffers>(m_batchSize);
+
+    UdpBatchBuffers &batch = *m_batch;
+    const int capacity = batch.capacity();
+
+#ifdef Q_OS_LINUX
+    int truncated = 0;
+    while (m_bound) {
+        for (int i = 0; i < capacity; ++i) {
+            msghdr &header = batch.headers[i].msg_hdr;
+            header.msg_namelen = sizeof(sockaddr_storage);
+            header.msg_control = batch.controls[i].data;
+            header.msg_controllen = sizeof(ControlBuffer::data);
+            header.msg_flags = 0;
+        }
+
+        const int fd = int(m_socket.socketDescriptor());
+        int received = 0;
+        do {
+            received = ::recvmmsg(fd, batch.headers.data(), unsigned(capacity),
+                                   MSG_DONTWAIT, nullptr);
+        } while (received == -1 && errno == EINTR);
+
+        if (received <= 0)
+            break;  // EAGAIN: cola vacia (u otro error: lo vera QUdpSocket)
+
+        const qint64 readNs = wallClockNs();
+        for (int i = 0; i < received; ++i) {
+            auto &header = batch.headers[i];
+            if (header.msg_hdr.msg_flags & MSG_TRUNC)
+                ++truncated;
+            const int len = qMin(int(header.msg_len), kBatchSlotSize);
+            const qint64 kernelNs = kernelTimestampOf(header.msg_hdr);
+            batch.views[i] = { QByteArrayView(batch.slot(i), len),
+                               senderPortOf(batch.addrs[i]),
+                               kernelNs ? kernelNs : readNs };
+        }
+        emitBatch(received);
+
+        if (received < capacity)
+            break;
+    }
+
+    if (truncated > 0) {
+        emit errorOccurred(QStringLiteral("%1 datagram(s) truncated to %2 bytes")
+                               .arg(truncated)
+                               .arg(kBatchSlotSize));
+    }
+
+    // --- Re-armar la notificacion de QUdpSocket ---
+    if (!m_bound)
+        return;
+    QNetworkDatagram tail = m_socket.receiveDatagram(kBatchSlotSize);
+    if (tail.isValid()) {
+        const QByteArray data = tail.data();
+        std::memcpy(batch.slot(0), data.constData(), std::size_t(data.size()));
+        batch.views[0] = { QByteArrayView(batch.slot(0), data.size()),
+                           static_cast<quint16>(tail.senderPort()),
+                           wallClockNs() };
+        emitBatch(1);
+    }
+#else
+    while (m_bound && m_socket.hasPendingDatagrams()) {
+        int count = 0;
+        while (count < capacity && m_socket.hasPendingDatagrams()) {
+            QNetworkDatagram datagram = m_socket.receiveDatagram(kBatchSlotSize);
+            const QByteArray data = datagram.data();
+            std::memcpy(batch.slot(count), data.constData(), std::size_t(data.size()));
+            batch.views[count] = { QByteArrayView(batch.slot(count), data.size()),
+                                   static_cast<quint16>(datagram.senderPort()),
+                                   wallClockNs() };
+            ++count;
+        }
+        emitBatch(count);
+    }
+#endif
+}
+
+// =============================================================================
+// emitBatch() — Entregar un lote a los receptores
+// =============================================================================
+// Primero la senal de lote (sin copias). Despues, solo si alguien sigue
+// conectado a la senal clasica, el shim de compatibilidad: una copia a
+// QByteArray y una emision por datagrama, como en el modo no-batch.
+// =============================================================================
+void UdpTransport::emitBatch(int count)
+{
+    if (count <= 0)
+        return;
+
+    emit datagramsReceived(UdpDatagramSpan{ m_batch->views.data(), count });
+
+    if (isSignalConnected(m_datagramReceivedSignal)) {
+        for (int i = 0; i < count; ++i) {
+            const UdpDatagramView &view = m_batch->views[i];
+            emit datagramReceived(view.data.toByteArray(), view.senderPort);
+        }
+    }
+}
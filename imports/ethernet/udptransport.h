@@ -29,13 +29,93 @@
 //   La senal readyRead se emite cuando llegan datos, y nuestro slot los
 //   procesa inmediatamente. Para volumenes de datos en localhost esto es
 //   mas que suficiente — no necesitamos un hilo separado.
+//
+// MODO BATCH (opcional, setBatchSize(N) con N > 0):
+//   En el modo clasico cada datagrama cuesta una llamada al sistema, un
+//   QNetworkDatagram en heap y una emision de senal. Con decenas de miles
+//   de tramas por segundo ese coste domina. En modo batch:
+//     - En Linux se usa recvmmsg(): UNA llamada al sistema lee hasta N
+//       datagramas en un conjunto de N buffers preasignados (slots).
+//     - En otras plataformas se rellenan los mismos slots con
+//       receiveDatagram() (sin recvmmsg, pero con el mismo API).
+//     - Se emite UNA senal datagramsReceived() por lote, con vistas
+//       (UdpDatagramView) que apuntan a los slots: sin copias.
+//   datagramReceived() se sigue emitiendo por datagrama como shim de
+//   compatibilidad, pero SOLO si alguien esta conectado a ella.
+//
+// MULTICAST Y FAN-OUT:
+//   - bindMulticast(port, group): bind a 0.0.0.0 compartido (varias
+//     instancias en la misma maquina reciben el mismo grupo) + join.
+//   - Lista de destinos (addDestination): fanOut() envia UN buffer a todos
+//     los destinos registrados (unicast o grupos multicast) con un solo
+//     sendmmsg(), sin copiar la trama. Cada destino lleva sus contadores.
 // =============================================================================
 
 #ifndef UDPTRANSPORT_H
 #define UDPTRANSPORT_H
 
+#include <QByteArrayView>
+#include <QHostAddress>
+#include <QList>
+#include <QMetaMethod>
 #include <QObject>
 #include <QUdpSocket>
+#include <memory>
+#include <vector>
+
+// =============================================================================
+// UdpDatagramView — Un datagrama recibido en modo batch (sin copia)
+// =============================================================================
+// 'data' apunta a un slot interno de UdpTransport. Solo es valido DURANTE la
+// emision de datagramsReceived(): el siguiente lote reutiliza los slots.
+//
+// 'receivedNs' es el instante de llegada en nanosegundos desde epoch (mismo
+// reloj que UdpTransport::wallClockNs()). En Linux lo pone el KERNEL
+// (SO_TIMESTAMPNS) al recibir el paquete, asi que incluye el tiempo que el
+// datagrama espero en la cola del socket. Sin soporte, es la hora de lectura.
+// =============================================================================
+struct UdpDatagramView
+{
+    QByteArrayView data;
+    quint16 senderPort = 0;
+    qint64 receivedNs = 0;
+};
+
+// =============================================================================
+// UdpDatagramSpan — Lote de datagramas (puntero + cantidad)
+// =============================================================================
+// Equivalente minimo a std::span (C++20) para poder recorrer el lote con
+// un range-for:  for (const UdpDatagramView &d : batch) { ... }
+// =============================================================================
+struct UdpDatagramSpan
+{
+    const UdpDatagramView *first = nullptr;
+    int count = 0;
+
+    const UdpDatagramView *begin() const { return first; }
+    const UdpDatagramView *end() const { return first + count; }
+    int size() const { return count; }
+};
+
+// =============================================================================
+// UdpDestination — Un destino de la lista de fan-out
+// =============================================================================
+// 'address' puede ser unicast (127.0.0.1, otra IP local) o un grupo
+// multicast (239.x.x.x). Los contadores los actualiza fanOut():
+//   sentDatagrams / sentBytes → aceptados por el kernel para este destino
+//   failedDatagrams           → rechazados (o no intentados al abortar)
+// =============================================================================
+struct UdpDestination
+{
+    QHostAddress address;
+    quint16 port = 0;
+
+    quint64 sentDatagrams = 0;
+    quint64 sentBytes = 0;
+    quint64 failedDatagrams = 0;
+};
+
+struct UdpBatchBuffers;
 
 class UdpTransport : public QObject
 {
@@ -48,14 +128,37 @@ public:
     // =========================================================================
     // bind() — Empezar a escuchar datagramas en un puerto
     // =========================================================================
-    // Llama a QUdpSocket::bind(QHostAddress::LocalHost, port).
-    // LocalHost (127.0.0.1) restringe la escucha a conexiones locales.
-    // Retorna true si el bind fue exitoso, false si el puerto ya esta en uso.
+    // Llama a QUdpSocket::bind(address, port, mode).
+    // Por defecto LocalHost (127.0.0.1) restringe la escucha a conexiones
+    // locales. Retorna true si el bind fue exitoso, false si el puerto ya
+    // esta en uso.
     //
     // NOTA: Un socket UDP puede enviar Y recibir por el mismo puerto.
     // Si bind() es exitoso, podemos tanto enviar como recibir.
     // =========================================================================
-    bool bind(quint16 port);
+    bool bind(quint16 port,
+              const QHostAddress &address = QHostAddress(QHostAddress::LocalHost),
+              QAbstractSocket::BindMode mode = QAbstractSocket::ReuseAddressHint);
+
+    // =========================================================================
+    // bindMulticast() — Escuchar un grupo multicast
+    // =========================================================================
+    // Bind a AnyIPv4:port con ShareAddress (SO_REUSEADDR): varias instancias
+    // en la misma maquina pueden escuchar el mismo grupo y puerto, y TODAS
+    // reciben cada datagrama (a diferencia del unicast, donde solo uno lo
+    // recibiria). Despues se une al grupo en 'interfaceName' (vacio = la
+    // interfaz que elija el kernel segun su tabla de rutas).
+    //
+    // Si el join falla se deshace el bind y se retorna false.
+    // =========================================================================
+    bool bindMulticast(quint16 port, const QHostAddress &group,
+                       const QString &interfaceName = QString());
+
+    // Unirse / salir de grupos adicionales con el socket ya bindeado
+    bool joinMulticastGroup(const QHostAddress &group,
+                            const QString &interfaceName = QString());
+    bool leaveMulticastGroup(const QHostAddress &group);
+    QList<QHostAddress> multicastGroups() const;
 
     // =========================================================================
     // unbind() — Dejar de escuchar
@@ -81,11 +184,114 @@ public:
     // =========================================================================
     bool sendDatagram(const QByteArray &data, quint16 destPort);
 
+    // Igual, pero a cualquier direccion (unicast o grupo multicast)
+    bool sendDatagram(QByteArrayView data, const QHostAddress &address, quint16 destPort);
+
+    // =========================================================================
+    // sendDatagrams() — Enviar muchos datagramas de una vez (batch TX)
+    // =========================================================================
+    // 'frames' apunta a 'count' QByteArrayView consecutivas (puntero +
+    // cantidad, como UdpDatagramSpan). Cada vista es un datagrama
+    // independiente; normalmente todas apuntan a un mismo buffer contiguo
+    // (arena) preparado por el llamador.
+    //
+    // En Linux se usa sendmmsg(): una llamada al sistema envia hasta 1024
+    // datagramas. En otras plataformas (o si el socket aun no existe) se
+    // cae a un bucle de writeDatagram().
+    //
+    // Retorna cuantos datagramas se enviaron. Puede ser menor que
+    // 'count' si el buffer de envio del SO se llena y no se vacia a tiempo
+    // (UDP descarta, no bloquea indefinidamente).
+    // =========================================================================
+    int sendDatagrams(const QByteArrayView *frames, int count, quint16 destPort);
+
+    // =========================================================================
+    // setSendStallMs() — Cuanto esperar con el buffer de envio lleno
+    // =========================================================================
+    // Con el buffer del SO lleno, sendDatagrams()/fanOut() esperan hueco
+    // (poll POLLOUT) hasta 'ms' milisegundos antes de rendirse. Con 0 no
+    // esperan: devuelven lo que cupo y sendWouldBlock() lo indica, para que
+    // el llamador reintente mas tarde sin bloquear su hilo (las rafagas del
+    // hilo de GUI). Solo afecta al camino sendmmsg() de Linux.
+    // =========================================================================
+    static constexpr int kDefaultSendStallMs = 50;
+    void setSendStallMs(int ms);
+    int sendStallMs() const;
+    // true si el ultimo envio se corto porque el buffer estaba lleno
+    bool sendWouldBlock() const;
+
+    // =========================================================================
+    // Lista de destinos (fan-out)
+    // =========================================================================
+    // addDestination() devuelve el indice del destino (el existente si ya
+    // estaba registrado). Los indices se desplazan al quitar uno.
+    // =========================================================================
+    int addDestination(const QHostAddress &address, quint16 port);
+    bool removeDestination(int index);
+    void clearDestinations();
+    void resetDestinationCounters();
+    const std::vector<UdpDestination> &destinations() const;
+    int destinationCount() const;
+
+    // =========================================================================
+    // fanOut() — Enviar cada trama a TODOS los destinos registrados
+    // =========================================================================
+    // Las tramas se codifican una vez; aqui solo se multiplican los
+    // mmsghdr: cada trama genera un mensaje por destino, todos con un
+    // iovec que apunta a los MISMOS bytes del llamador. Con 4 destinos y
+    // 256 tramas son 1024 mensajes en un solo sendmmsg().
+    //
+    // Orden de envio: trama-mayor (trama 0 a todos, trama 1 a todos, ...).
+    // Retorna cuantas tramas llegaron al kernel para TODOS los destinos;
+    // si el envio se corta a mitad de una trama, los destinos que ya la
+    // recibieron la cuentan en sentDatagrams y el resto en failedDatagrams.
+    // =========================================================================
+    int fanOut(QByteArrayView frame);
+    int fanOut(const QByteArrayView *frames, int count);
+
+    // =========================================================================
+    // setBatchSize() — Activar/desactivar el modo batch de recepcion
+    // =========================================================================
+    // size = 0 → modo clasico (un datagramReceived por datagrama).
+    // size > 0 → se leen hasta 'size' datagramas por llamada al sistema y
+    //            se emite datagramsReceived() una vez por lote.
+    //
+    // Puede cambiarse en cualquier momento (incluso con el socket bindeado):
+    // los buffers se (re)asignan en la siguiente lectura, nunca durante la
+    // emision de un lote.
+    // =========================================================================
+    void setBatchSize(int size);
+    int batchSize() const;
+
+    // Tamano de cada slot del modo batch. Los datagramas mas grandes se
+    // truncan (MSG_TRUNC, notificado con errorOccurred). Debe cubrir el
+    // datagrama mas largo que se espera: una trama STANAG ocupa como mucho
+    // 12 + 56 + 4 = 72 bytes, y sendBurst empaqueta hasta 64 tramas por
+    // datagrama (4608 bytes). EthernetController lo comprueba con un
+    // static_assert.
+    static constexpr int kBatchSlotSize = 8192;
+
+    // Reloj de pared en ns (CLOCK_REALTIME), el mismo que usa el kernel para
+    // los timestamps de recepcion. Permite medir latencia socket → consumidor
+    // restando wallClockNs() - UdpDatagramView::receivedNs.
+    static qint64 wallClockNs();
+
 signals:
     // Emitida cuando llega un datagrama. Incluye los datos y el puerto
     // del emisor para poder identificar quien lo envio.
+    // En modo batch solo se emite si hay algun receptor conectado.
     void datagramReceived(const QByteArray &data, quint16 senderPort);
 
+    // =========================================================================
+    // datagramsReceived() — Lote de datagramas (solo en modo batch)
+    // =========================================================================
+    // Las vistas apuntan a buffers internos que se reutilizan en el siguiente
+    // lote, por eso esta senal SOLO debe conectarse con conexion directa
+    // (receptor en el mismo hilo, que es el comportamiento por defecto de
+    // AutoConnection). Quien necesite conservar los datos debe copiarlos.
+    // =========================================================================
+    void datagramsReceived(UdpDatagramSpan batch);
+
     // Emitida cuando ocurre un error de socket (puerto en uso, etc.)
     void errorOccurred(const QString &error);
 
@@ -104,8 +310,30 @@ private slots:
     void onReadyRead();
 
 private:
+    // Lectura en modo batch (recvmmsg en Linux). Ver udptransport.cpp.
+    void readBatch();
+    void emitBatch(int count);
+
+    // Envio comun de sendDatagrams() y fanOut(): 'count' tramas x
+    // 'destCount' destinos en orden trama-mayor. Retorna los mensajes
+    // enviados (prefijo de ese orden).
+    qint64 sendToAll(const QByteArrayView *frames, int count,
+                     const UdpDestination *dests, int destCount);
+
     QUdpSocket m_socket;
     bool m_bound = false;
+    std::vector<UdpDestination> m_destinations;
+    int m_sendStallMs = kDefaultSendStallMs;
+    bool m_sendWouldBlock = false;
+    QList<QHostAddress> m_groups;       // Grupos multicast unidos
+
+    // --- Modo batch ---
+    // Los buffers (slots + estructuras de recvmmsg) se definen en el .cpp
+    // para no arrastrar cabeceras de sockets POSIX a quien incluya este .h.
+    int m_batchSize = 0;
+    std::unique_ptr<UdpBatchBuffers> m_batch;
+    const QMetaMethod m_datagramReceivedSignal =
+        QMetaMethod::fromSignal(&UdpTransport::datagramReceived);
 };
 
 #endif // UDPTRANSPORT_H
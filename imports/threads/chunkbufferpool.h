@@ -0,0 +1,110 @@
+// ============================================================================
+// chunkbufferpool.h - Buffers reutilizables para los chunks del Generador
+// ============================================================================
+//
+// Cada chunk nuevo era un QByteArray(len, Qt::Uninitialized): una reserva
+// de memoria por chunk en el Hilo 1 y su liberacion en el hilo que suelte
+// la ultima referencia (Filtro o Colector).
+//
+// PATRON: pool circular de QByteArray ya reservados (MaxChunkBytes).
+//   take(size, fill):
+//     1. Siguiente hueco del pool.
+//     2. Si el pool es su UNICO dueno (isDetached()), ninguna etapa lo
+//        usa ya: se redimensiona dentro de su capacidad y se rellena EN
+//        SITIO. Sin reserva de memoria (acierto).
+//     3. Si alguna etapa aun lo referencia, se prueban los siguientes
+//        (hasta probeSlots huecos en total) y se usa el primero libre.
+//     4. Si ninguno esta libre, se sustituye el primero por uno nuevo
+//        (fallo) y el viejo vive hasta que esa etapa lo suelte.
+//     5. Se devuelve una copia: +1 al contador de referencias, sin copiar
+//        bytes. El chunk viaja asi Generador -> Filtro -> Colector y,
+//        cuando la ultima etapa lo suelta, el hueco vuelve a estar libre.
+//
+// Los chunks no se liberan en el orden en que se crearon: con N Filtros,
+// un shard lento retiene sus chunks (en su cola o, si coincidieron, en el
+// ReorderBuffer) mientras los de los demas ya se soltaron. Con un turno
+// estricto cada hueco retenido era un fallo aunque el siguiente estuviera
+// libre; mirar unos pocos mas lo evita.
+//
+// El pool debe cubrir los chunks en vuelo (colas + lote actual): con
+// menos huecos, los fallos lo delatan (hits() / misses()).
+//
+// Un solo hilo (el del Generador). hits()/misses() se leen desde el
+// principal: son atomicos.
+// ============================================================================
+
+#ifndef CHUNKBUFFERPOOL_H
+#define CHUNKBUFFERPOOL_H
+
+#include <QByteArray>
+#include <atomic>
+#include <vector>
+
+class ChunkBufferPool
+{
+public:
+    static constexpr qsizetype MaxChunkBytes = 128;
+    // ~40 MB de buffers. Con colas enormes el pool no las cubre enteras:
+    // se notara en misses(), no en la memoria.
+    static constexpr int MaxSlots = 1 << 18;
+    // Huecos que take() mira antes de reservar. 1 = turno estricto.
+    static constexpr int DefaultProbeSlots = 8;
+
+    void reset(int slots, int probeSlots = DefaultProbeSlots)
+    {
+        m_slots.assign(std::size_t(qBound(1, slots, MaxSlots)), QByteArray());
+        for (QByteArray &slot : m_slots)
+            slot.reserve(MaxChunkBytes);
+        m_probeSlots = std::size_t(qBound(1, probeSlots, int(m_slots.size())));
+        m_next = 0;
+        m_hits.store(0, std::memory_order_relaxed);
+        m_misses.store(0, std::memory_order_relaxed);
+    }
+
+    int slots() const { return int(m_slots.size()); }
+
+    // fill(char *data, qsizetype size) escribe los bytes del chunk
+    template <typename Fn>
+    QByteArray take(qsizetype size, Fn &&fill)
+    {
+        if (m_slots.empty())
+            reset(1);
+
+        // isDetached() es una lectura del contador: probar es barato
+        std::size_t index = m_next;
+        bool found = false;
+        for (std::size_t probe = 0; probe < m_probeSlots; ++probe) {
+            const std::size_t candidate = (m_next + probe) % m_slots.size();
+            if (m_slots[candidate].isDetached() && m_slots[candidate].capacity() >= size) {
+                index = candidate;
+                found = true;
+                break;
+            }
+        }
+        QByteArray &slot = m_slots[index];
+        m_next = index + 1 == m_slots.size() ? 0 : index + 1;
+
+        if (found) {
+            m_hits.store(m_hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        } else {
+            slot = QByteArray();
+            slot.reserve(qMax(size, MaxChunkBytes));
+            m_misses.store(m_misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+        slot.resize(size);
+        fill(slot.data(), size);
+        return slot;
+    }
+
+    quint64 hits() const { return m_hits.load(std::memory_order_relaxed); }
+    quint64 misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<QByteArray> m_slots;
+    std::size_t m_next = 0;
+    std::size_t m_probeSlots = DefaultProbeSlots;
+    std::atomic<quint64> m_hits{0};
+    std::atomic<quint64> m_misses{0};
+};
+
+#endif // CHUNKBUFFERPOOL_H
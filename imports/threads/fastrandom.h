@@ -0,0 +1,98 @@
+// ============================================================================
+// fastrandom.h - Generador pseudoaleatorio rapido (xoshiro256**)
+// ============================================================================
+//
+// El Generador rellenaba cada chunk con std::uniform_int_distribution<int>
+// sobre std::mt19937: una llamada a la distribucion POR BYTE, y mt19937
+// arrastra 2.5 KB de estado que regenera cada 624 salidas.
+//
+// xoshiro256** (Blackman & Vigna) tiene 32 bytes de estado y da 64 bits
+// por llamada con un punado de desplazamientos y multiplicaciones:
+//
+//   fill(dst, n): 8 bytes por next(), copiados con memcpy (el compilador
+//                 lo convierte en un store de 64 bits). Un chunk de 100
+//                 bytes son 13 llamadas, no 100.
+//   below(n):     entero en [0, n) con multiplicacion + desplazamiento
+//                 (Lemire), sin division ni bucle de rechazo. El sesgo es
+//                 de n / 2^32: despreciable para longitudes de chunk.
+//
+// La semilla pasa por SplitMix64, como recomiendan los autores: convierte
+// una semilla cualquiera (incluso 0) en un estado bien mezclado.
+//
+// NO es criptografico. Un objeto por hilo (no es thread-safe).
+// ============================================================================
+
+#ifndef FASTRANDOM_H
+#define FASTRANDOM_H
+
+#include <QtGlobal>
+#include <cstring>
+
+// SplitMix64: un contador con una buena funcion de mezcla
+class SplitMix64
+{
+public:
+    explicit SplitMix64(quint64 seed) : m_state(seed) {}
+
+    quint64 next()
+    {
+        quint64 z = (m_state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+private:
+    quint64 m_state;
+};
+
+class Xoshiro256
+{
+public:
+    explicit Xoshiro256(quint64 seed = 0x5EEDull)
+    {
+        SplitMix64 mix(seed);
+        for (quint64 &word : m_s)
+            word = mix.next();
+    }
+
+    quint64 next()
+    {
+        const quint64 result = rotl(m_s[1] * 5, 7) * 9;
+        const quint64 t = m_s[1] << 17;
+        m_s[2] ^= m_s[0];
+        m_s[3] ^= m_s[1];
+        m_s[1] ^= m_s[2];
+        m_s[0] ^= m_s[3];
+        m_s[2] ^= t;
+        m_s[3] = rotl(m_s[3], 45);
+        return result;
+    }
+
+    // [0, bound) con los 32 bits altos (los de mejor calidad)
+    quint32 below(quint32 bound)
+    {
+        return quint32(((next() >> 32) * quint64(bound)) >> 32);
+    }
+
+    void fill(char *dst, qsizetype size)
+    {
+        while (size >= qsizetype(sizeof(quint64))) {
+            const quint64 word = next();
+            std::memcpy(dst, &word, sizeof(word));
+            dst += sizeof(word);
+            size -= qsizetype(sizeof(word));
+        }
+        if (size > 0) {
+            const quint64 word = next();
+            std::memcpy(dst, &word, std::size_t(size));
+        }
+    }
+
+private:
+    static quint64 rotl(quint64 x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    quint64 m_s[4];
+};
+
+#endif // FASTRANDOM_H
@@ -0,0 +1,262 @@
+// ============================================================================
+// patternmatcher.cpp - Automata de Aho-Corasick con anclas literales
+// ============================================================================
+
+#include "patternmatcher.h"
+#include <deque>
+
+namespace {
+
+int hexNibble(QChar c)
+{
+    const ushort u = c.toUpper().unicode();
+    if (u >= '0' && u <= '9')
+        return u - '0';
+    if (u >= 'A' && u <= 'F')
+        return u - 'A' + 10;
+    return -1;
+}
+
+// Tramo mas largo de bytes con mascara FF: [start, start + length)
+void longestLiteralRun(const QByteArray &mask, int &start, int &length)
+{
+    start = 0;
+    length = 0;
+    int runStart = 0;
+    for (int i = 0; i <= mask.size(); ++i) {
+        const bool literal = i < mask.size() && quint8(mask[i]) == 0xFF;
+        if (literal)
+            continue;
+        if (i - runStart > length) {
+            start = runStart;
+            length = i - runStart;
+        }
+        runStart = i + 1;
+    }
+}
+
+bool matchesAt(const PatternMatcher::Pattern &p, const char *data)
+{
+    for (int i = 0; i < p.bytes.size(); ++i) {
+        const quint8 m = quint8(p.mask[i]);
+        if ((quint8(data[i]) & m) != (quint8(p.bytes[i]) & m))
+            return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ============================================================================
+// Patrones: construccion y parseo
+// ============================================================================
+
+PatternMatcher::Pattern PatternMatcher::literal(const QByteArray &bytes)
+{
+    return { bytes, QByteArray(bytes.size(), char(0xFF)) };
+}
+
+// Cada byte son dos nibbles; '?' en un nibble lo deja fuera de la mascara.
+// Los espacios son opcionales: "DEAD" == "DE AD".
+bool PatternMatcher::parse(const QString &spec, Pattern &out)
+{
+    QString compact = spec;
+    compact.remove(QLatin1Char(' '));
+    if (compact.isEmpty() || compact.size() % 2 != 0)
+        return false;
+
+    Pattern p;
+    p.bytes.reserve(compact.size() / 2);
+    p.mask.reserve(compact.size() / 2);
+    for (int i = 0; i < compact.size(); i += 2) {
+        quint8 value = 0;
+        quint8 mask = 0;
+        for (int n = 0; n < 2; ++n) {
+            const QChar c = compact.at(i + n);
+            const int shift = n == 0 ? 4 : 0;
+            if (c == QLatin1Char('?'))
+                continue;
+            const int nibble = hexNibble(c);
+            if (nibble < 0)
+                return false;
+            value |= quint8(nibble << shift);
+            mask |= quint8(0x0F << shift);
+        }
+        p.bytes.append(char(value));
+        p.mask.append(char(mask));
+    }
+
+    out = p;
+    return true;
+}
+
+QString PatternMatcher::toString(const Pattern &pattern)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    QString text;
+    text.reserve(pattern.bytes.size() * 3);
+    for (int i = 0; i < pattern.bytes.size(); ++i) {
+        if (i > 0)
+            text.append(QLatin1Char(' '));
+        const quint8 value = quint8(pattern.bytes[i]);
+        const quint8 mask = quint8(pattern.mask[i]);
+        text.append((mask & 0xF0) ? QLatin1Char(digits[value >> 4]) : QLatin1Char('?'));
+        text.append((mask & 0x0F) ? QLatin1Char(digits[value & 0x0F]) : QLatin1Char('?'));
+    }
+    return text;
+}
+
+// ============================================================================
+// Automata
+// ============================================================================
+
+PatternMatcher::PatternMatcher()
+{
+    setPatterns({});
+}
+
+// ============================================================================
+// setPatterns() - Trie + enlaces de fallo + tabla de transiciones completa
+// ============================================================================
+// 1. Trie con las anclas: m_delta = -1 donde no hay arista.
+// 2. BFS desde la raiz. Para cada estado s y byte c:
+//      - si existe la arista s -c-> t: fail(t) = delta(fail(s), c)
+//      - si no existe: delta(s, c) = delta(fail(s), c)
+//    Al procesar en anchura, fail(s) siempre esta completo antes que s.
+// 3. dictLink(t) = fail(t) si fail(t) tiene salida propia, si no el
+//    dictLink de fail(t): encadena todas las salidas de los sufijos.
+// ============================================================================
+void PatternMatcher::setPatterns(const QList<Pattern> &patterns)
+{
+    m_patterns = patterns;
+    m_fullyLiteral.assign(std::size_t(patterns.size()), false);
+    m_delta.assign(256, -1);
+    m_depth.assign(1, 0);
+    m_firstOutput.assign(1, -1);
+    m_outputs.clear();
+    m_unanchored.clear();
+
+    // ─── 1. Trie de anclas ──────────────────────────────────────────
+    // En orden inverso: cada Output se inserta al principio de la lista de
+    // su estado, asi que la lista queda con el indice mas bajo primero.
+    for (int index = int(patterns.size()) - 1; index >= 0; --index) {
+        const Pattern &p = patterns.at(index);
+        int anchorStart = 0;
+        int anchorLength = 0;
+        longestLiteralRun(p.mask, anchorStart, anchorLength);
+
+        if (anchorLength == 0) {
+            m_unanchored.push_back(index);
+            continue;
+        }
+        m_fullyLiteral[std::size_t(index)] = anchorLength == p.bytes.size();
+
+        int state = 0;
+        for (int i = anchorStart; i < anchorStart + anchorLength; ++i) {
+            const std::size_t slot = std::size_t(state) * 256 + quint8(p.bytes[i]);
+            if (m_delta[slot] < 0) {
+                m_delta[slot] = qint32(m_depth.size());
+                m_depth.push_back(m_depth[std::size_t(state)] + 1);
+                m_firstOutput.push_back(-1);
+                m_delta.resize(m_delta.size() + 256, -1);
+            }
+            state = m_delta[slot];
+        }
+
+        m_outputs.push_back({ index, anchorStart, m_firstOutput[std::size_t(state)] });
+        m_firstOutput[std::size_t(state)] = qint32(m_outputs.size() - 1);
+    }
+
+    // ─── 2 y 3. Fallos, transiciones completas y enlaces de salida ──
+    const std::size_t states = m_depth.size();
+    std::vector<qint32> fail(states, 0);
+    m_dictLink.assign(states, 0);
+    m_hasOutput.assign(states, 0);
+
+    std::deque<qint32> queue;
+    for (int c = 0; c < 256; ++c) {
+        qint32 &next = m_delta[std::size_t(c)];
+        if (next < 0) {
+            next = 0;
+        } else {
+            fail[std::size_t(next)] = 0;
+            queue.push_back(next);
+        }
+    }
+
+    while (!queue.empty()) {
+        const qint32 s = queue.front();
+        queue.pop_front();
+
+        const qint32 f = fail[std::size_t(s)];
+        m_dictLink[std::size_t(s)] = m_firstOutput[std::size_t(f)] >= 0
+                                         ? f : m_dictLink[std::size_t(f)];
+        m_hasOutput[std::size_t(s)] = m_firstOutput[std::size_t(s)] >= 0
+                                      || m_dictLink[std::size_t(s)] != 0;
+
+        for (int c = 0; c < 256; ++c) {
+            qint32 &next = m_delta[std::size_t(s) * 256 + std::size_t(c)];
+            const qint32 viaFail = m_delta[std::size_t(f) * 256 + std::size_t(c)];
+            if (next < 0) {
+                next = viaFail;
+            } else {
+                fail[std::size_t(next)] = viaFail;
+                queue.push_back(next);
+            }
+        }
+    }
+}
+
+// ============================================================================
+// findFirst() - Una transicion por byte
+// ============================================================================
+PatternMatcher::Match PatternMatcher::findFirst(const char *data, int size) const
+{
+    const qint32 *delta = m_delta.data();
+    const char *hasOutput = m_hasOutput.data();
+    const auto *bytes = reinterpret_cast<const quint8 *>(data);
+
+    qint32 state = 0;
+    for (int i = 0; i < size; ++i) {
+        state = delta[std::size_t(state) * 256 + bytes[i]];
+        if (hasOutput[state]) {
+            const Match match = verify(state, i, data, size);
+            if (match.isValid())
+                return match;
+        }
+    }
+
+    // Patrones sin bytes exactos: fuerza bruta (son raros)
+    for (int index : m_unanchored) {
+        const Pattern &p = m_patterns.at(index);
+        for (int offset = 0; offset + p.bytes.size() <= size; ++offset) {
+            if (matchesAt(p, data + offset))
+                return { index, offset };
+        }
+    }
+    return {};
+}
+
+// Recorre las salidas del estado y de sus sufijos (m_dictLink). El ancla
+// termina en 'end'; de ahi se deduce donde empezaria el patron completo.
+PatternMatcher::Match PatternMatcher::verify(int state, int end,
+                                             const char *data, int size) const
+{
+    for (qint32 s = state; s != 0; s = m_dictLink[std::size_t(s)]) {
+        const int anchorLength = m_depth[std::size_t(s)];
+        for (qint32 o = m_firstOutput[std::size_t(s)]; o >= 0;
+             o = m_outputs[std::size_t(o)].next) {
+            const Output &out = m_outputs[std::size_t(o)];
+            const int start = end + 1 - anchorLength - out.anchorOffset;
+
+            if (m_fullyLiteral[std::size_t(out.pattern)])
+                return { out.pattern, start };
+
+            const Pattern &p = m_patterns.at(out.pattern);
+            if (start >= 0 && start + p.bytes.size() <= size
+                && matchesAt(p, data + start))
+                return { out.pattern, start };
+        }
+    }
+    return {};
+}
@@ -0,0 +1,107 @@
+// ============================================================================
+// patternmatcher.h - Busqueda de muchos patrones de bytes en una pasada
+// ============================================================================
+//
+// PROBLEMA: FilterWorker buscaba UN patron con QByteArray::contains(). Con
+// N patrones eso son N recorridos del chunk por cada chunk: el coste crece
+// linealmente con el numero de patrones.
+//
+// SOLUCION: automata de Aho-Corasick.
+//   - Los patrones se insertan en un trie (un estado por prefijo).
+//   - Cada estado tiene un enlace de "fallo": el sufijo mas largo de su
+//     prefijo que tambien es prefijo de algun patron (como en KMP).
+//   - Se precalcula la tabla completa de transiciones (estado x byte):
+//     el recorrido es UNA lectura de tabla por byte, sin ramas ni vuelta
+//     atras, con 1 o con 1000 patrones.
+//
+//   Trie de {AB, BC}:          Recorrido de "xABC":
+//     0 -A-> 1 -B-> 2 [AB]       x: 0   A: 1   B: 2 -> AB en offset 1
+//     0 -B-> 3 -C-> 4 [BC]
+//
+// PATRONES CON MASCARA (comodines):
+//   Cada byte del patron lleva una mascara: FF = byte exacto, 00 = "??"
+//   (cualquier byte), F0 = "D?" (solo el nibble alto). Aho-Corasick solo
+//   sabe de bytes exactos, asi que se inserta en el automata el TRAMO
+//   literal mas largo del patron (su "ancla") y, cuando el ancla aparece,
+//   se verifica el patron completo con su mascara en esa posicion.
+//
+// SINTAXIS (parse):  "DE AD BE EF"   "DEADBEEF"   "DE ?? BE EF"   "D? AD"
+//
+// RESULTADO: findFirst() devuelve el primer patron cuya ancla termina
+// antes en el chunk, y el offset donde EMPIEZA la coincidencia.
+//
+// Solo lectura tras setPatterns(): findFirst() es const y puede usarse
+// desde varios hilos a la vez sobre el mismo automata.
+// ============================================================================
+
+#ifndef PATTERNMATCHER_H
+#define PATTERNMATCHER_H
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <vector>
+
+class PatternMatcher
+{
+public:
+    struct Pattern {
+        QByteArray bytes;
+        QByteArray mask;   // Mismo tamano que bytes; 0xFF = byte exacto
+    };
+
+    struct Match {
+        int pattern = -1;   // Indice en la lista de setPatterns()
+        int offset = -1;    // Inicio de la coincidencia en el chunk
+        bool isValid() const { return pattern >= 0; }
+    };
+
+    // Patron literal (mascara todo FF)
+    static Pattern literal(const QByteArray &bytes);
+    // Hex con espacios opcionales; "??" o "?" por nibble = comodin.
+    // false si el texto no es un patron valido (o esta vacio).
+    static bool parse(const QString &spec, Pattern &out);
+    // Inverso de parse(): "DE ?? BE EF"
+    static QString toString(const Pattern &pattern);
+
+    PatternMatcher();
+
+    // Construye el automata. Sustituye a los patrones anteriores.
+    void setPatterns(const QList<Pattern> &patterns);
+
+    int patternCount() const { return int(m_patterns.size()); }
+    int stateCount() const { return int(m_depth.size()); }
+
+    Match findFirst(const char *data, int size) const;
+    Match findFirst(const QByteArray &data) const
+    {
+        return findFirst(data.constData(), int(data.size()));
+    }
+
+private:
+    // Patron asociado a un estado terminal del automata
+    struct Output {
+        int pattern;
+        int anchorOffset;   // Posicion del ancla dentro del patron
+        int next;           // Siguiente Output del mismo estado (-1 = fin)
+    };
+
+    Match verify(int state, int end, const char *data, int size) const;
+
+    QList<Pattern> m_patterns;
+    std::vector<bool> m_fullyLiteral;     // El ancla ES el patron entero
+
+    // Tabla densa de transiciones: m_delta[estado * 256 + byte]
+    std::vector<qint32> m_delta;
+    std::vector<qint32> m_depth;          // Longitud del prefijo del estado
+    std::vector<qint32> m_firstOutput;    // Lista de Output propios (-1)
+    std::vector<qint32> m_dictLink;       // Siguiente estado con salida (0)
+    std::vector<char> m_hasOutput;        // Propia o via m_dictLink
+    std::vector<Output> m_outputs;
+
+    // Patrones sin ningun byte exacto: coinciden en el offset 0 de
+    // cualquier chunk suficientemente largo
+    std::vector<int> m_unanchored;
+};
+
+#endif // PATTERNMATCHER_H
@@ -0,0 +1,871 @@
+// ============================================================================
+// pipelinebenchmark.cpp - Implementacion de la comparativa de transportes
+// ============================================================================
+
+#include "pipelinebenchmark.h"
+#include "chunkbufferpool.h"
+#include "fastrandom.h"
+#include "pipelinechannel.h"
+#include "patternmatcher.h"
+#include "pipelineworkers.h"
+#include "recordstore.h"
+#include "threadplacement.h"
+#include <QThread>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <random>
+
+// ============================================================================
+// TransportProbe
+// ============================================================================
+
+TransportProbe::TransportProbe(int expected, const QElapsedTimer *clock,
+                               QSemaphore *done)
+    : m_expected(expected)
+    , m_clock(clock)
+    , m_done(done)
+{
+    // Reservado antes de medir: el consumidor no reserva mientras recibe
+    m_latencies.reserve(std::size_t(expected));
+}
+
+// Se ejecuta en el hilo consumidor. Resta el instante de envio (primeros
+// 8 bytes del chunk) y avisa al productor al recibir el ultimo.
+void TransportProbe::receive(const QByteArray &chunk)
+{
+    qint64 sentNs = 0;
+    std::memcpy(&sentNs, chunk.constData(), sizeof(sentNs));
+    m_latencies.push_back(m_clock->nsecsElapsed() - sentNs);
+
+    if (int(m_latencies.size()) == m_expected)
+        m_done->release();
+}
+
+void TransportProbe::drainInput()
+{
+    m_input->drain([this](PipelineChunk &chunk) { receive(chunk.data); });
+}
+
+// ============================================================================
+// ReorderProbe
+// ============================================================================
+
+ReorderProbe::ReorderProbe(quint64 expected, QSemaphore *done)
+    : m_expected(expected)
+    , m_done(done)
+{
+}
+
+void ReorderProbe::setInputs(const QList<PipelineChannel *> &channels)
+{
+    m_inputs = channels;
+    m_reorder.reset(int(channels.size()));
+}
+
+// Se ejecuta en el hilo consumidor, con un aviso por cola y rafaga
+void ReorderProbe::drainInput()
+{
+    auto release = [this](PipelineChunk &chunk) {
+        m_ordered = m_ordered && (!m_any || chunk.sequence > m_lastSequence);
+        m_any = true;
+        m_lastSequence = chunk.sequence;
+        ++m_matches;
+    };
+    for (PipelineChannel *input : std::as_const(m_inputs))
+        input->drain([&](PipelineChunk &chunk) { m_reorder.offer(std::move(chunk), release); });
+
+    if (!m_finished && m_reorder.next() >= m_expected) {
+        m_finished = true;
+        m_done->release();
+    }
+}
+
+// ============================================================================
+// Medicion de un transporte
+// ============================================================================
+
+namespace {
+
+struct TransportResult
+{
+    double chunksPerSec = 0.0;
+    double p50Us = 0.0;
+    double p99Us = 0.0;
+    double maxUs = 0.0;
+    quint64 wakeups = 0;
+    int capacity = 0;
+};
+
+// Percentil sobre una copia ordenada parcialmente (nth_element, O(n))
+double percentileNs(std::vector<qint64> values, double q)
+{
+    if (values.empty())
+        return 0.0;
+    const std::size_t k = std::min(values.size() - 1,
+                                   std::size_t(q * double(values.size() - 1) + 0.5));
+    std::nth_element(values.begin(), values.begin() + std::ptrdiff_t(k), values.end());
+    return double(values[k]);
+}
+
+double percentileUs(std::vector<qint64> values, double q)
+{
+    return percentileNs(std::move(values), q) / 1000.0;
+}
+
+TransportResult measure(bool useRing, int chunks, int ringCapacity)
+{
+    QElapsedTimer clock;
+    QSemaphore done;
+
+    QThread consumerThread;
+    consumerThread.setObjectName(QStringLiteral("BenchmarkConsumer"));
+
+    TransportProbe source(0, &clock, &done);
+    auto *sink = new TransportProbe(chunks, &clock, &done);
+    PipelineChannel channel(ringCapacity);
+
+    if (useRing) {
+        channel.setConsumer(sink, "drainInput");
+        sink->setInput(&channel);
+    }
+    sink->moveToThread(&consumerThread);
+    // Conexion cross-thread: QueuedConnection automatica, como en el pipeline
+    QObject::connect(&source, &TransportProbe::chunkSent,
+                     sink, &TransportProbe::receive);
+    consumerThread.start();
+
+    clock.start();
+    for (int i = 0; i < chunks; ++i) {
+        QByteArray chunk(PipelineBenchmark::ChunkSize, '\0');
+        const qint64 now = clock.nsecsElapsed();
+        std::memcpy(chunk.data(), &now, sizeof(now));
+
+        if (useRing)
+            channel.push(PipelineChunk{ std::move(chunk) });
+        else
+            emit source.chunkSent(chunk);
+    }
+    done.acquire();
+    const qint64 elapsedNs = clock.nsecsElapsed();
+
+    consumerThread.quit();
+    consumerThread.wait();
+
+    TransportResult result;
+    result.chunksPerSec = elapsedNs > 0 ? double(chunks) * 1e9 / double(elapsedNs) : 0.0;
+    result.p50Us = percentileUs(sink->latencies(), 0.50);
+    result.p99Us = percentileUs(sink->latencies(), 0.99);
+    result.maxUs = percentileUs(sink->latencies(), 1.0);
+    // Con signal/slot cada chunk es un evento encolado
+    result.wakeups = useRing ? channel.wakeups() : quint64(chunks);
+    result.capacity = channel.capacity();
+
+    // El hilo ya termino: se puede destruir desde aqui
+    delete sink;
+    return result;
+}
+
+} // namespace
+
+// ============================================================================
+// compareTransports()
+// ============================================================================
+
+QVariantMap PipelineBenchmark::compareTransports(int chunks, int ringCapacity)
+{
+    chunks = qMax(chunks, 1);
+
+    // Calentamiento: primera creacion de hilos y paginas del ring
+    measure(false, qMin(chunks, 1000), ringCapacity);
+    measure(true, qMin(chunks, 1000), ringCapacity);
+
+    const TransportResult sig = measure(false, chunks, ringCapacity);
+    const TransportResult ring = measure(true, chunks, ringCapacity);
+
+    QVariantMap result;
+    result[QStringLiteral("chunks")] = chunks;
+    result[QStringLiteral("ringCapacity")] = ring.capacity;
+    result[QStringLiteral("speedup")] =
+        sig.chunksPerSec > 0.0 ? ring.chunksPerSec / sig.chunksPerSec : 0.0;
+
+    result[QStringLiteral("signalChunksPerSec")] = sig.chunksPerSec;
+    result[QStringLiteral("signalP50Us")] = sig.p50Us;
+    result[QStringLiteral("signalP99Us")] = sig.p99Us;
+    result[QStringLiteral("signalMaxUs")] = sig.maxUs;
+    result[QStringLiteral("signalWakeups")] = sig.wakeups;
+
+    result[QStringLiteral("ringChunksPerSec")] = ring.chunksPerSec;
+    result[QStringLiteral("ringP50Us")] = ring.p50Us;
+    result[QStringLiteral("ringP99Us")] = ring.p99Us;
+    result[QStringLiteral("ringMaxUs")] = ring.maxUs;
+    result[QStringLiteral("ringWakeups")] = ring.wakeups;
+    return result;
+}
+
+// ============================================================================
+// compareMatchers()
+// ============================================================================
+
+QVariantList PipelineBenchmark::compareMatchers(int chunks)
+{
+    chunks = qMax(chunks, 1);
+    static constexpr int CorpusSize = 4096;
+    static constexpr int PatternLength = 4;
+    static const int patternCounts[] = { 1, 4, 16, 64, 256, 1000 };
+
+    std::mt19937 rng(0x5EED);
+    std::uniform_int_distribution<int> lenDist(1, 100);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+
+    // Corpus base: como GeneratorWorker::generate()
+    QList<QByteArray> base;
+    base.reserve(CorpusSize);
+    for (int i = 0; i < CorpusSize; ++i) {
+        QByteArray data(lenDist(rng), Qt::Uninitialized);
+        for (char &b : data)
+            b = char(byteDist(rng));
+        base.append(data);
+    }
+
+    QVariantList rows;
+    for (int count : patternCounts) {
+        QList<QByteArray> literals;
+        QList<PatternMatcher::Pattern> patterns;
+        for (int p = 0; p < count; ++p) {
+            QByteArray bytes(PatternLength, Qt::Uninitialized);
+            for (char &b : bytes)
+                b = char(byteDist(rng));
+            literals.append(bytes);
+            patterns.append(PatternMatcher::literal(bytes));
+        }
+
+        // Sembrar un patron en 1 de cada 8 chunks para que haya aciertos
+        QList<QByteArray> corpus = base;
+        for (int i = 0; i < CorpusSize; i += 8) {
+            QByteArray &data = corpus[i];
+            if (data.size() < PatternLength)
+                continue;
+            const QByteArray &lit = literals.at(int(rng() % quint32(count)));
+            const int at = int(rng() % quint32(data.size() - PatternLength + 1));
+            std::memcpy(data.data() + at, lit.constData(), PatternLength);
+        }
+
+        QElapsedTimer timer;
+        timer.start();
+        PatternMatcher matcher;
+        matcher.setPatterns(patterns);
+        const qint64 buildNs = timer.nsecsElapsed();
+
+        auto containsAny = [&literals](const QByteArray &data) {
+            for (const QByteArray &lit : literals) {
+                if (data.contains(lit))
+                    return true;
+            }
+            return false;
+        };
+
+        // Sin cronometro: ambos metodos deben aceptar los mismos chunks
+        int hits = 0;
+        bool agree = true;
+        for (const QByteArray &data : corpus) {
+            const bool naive = containsAny(data);
+            agree = agree && naive == matcher.findFirst(data).isValid();
+            hits += naive ? 1 : 0;
+        }
+
+        // Los resultados se acumulan en 'sink' para que el optimizador no
+        // elimine el trabajo medido
+        quint64 sink = 0;
+        const int naiveChunks = qMax(1000, chunks / count);
+        timer.restart();
+        for (int i = 0; i < naiveChunks; ++i)
+            sink += containsAny(corpus.at(i % CorpusSize)) ? 1 : 0;
+        const qint64 naiveNs = timer.nsecsElapsed();
+
+        timer.restart();
+        for (int i = 0; i < chunks; ++i)
+            sink += quint64(matcher.findFirst(corpus.at(i % CorpusSize)).pattern + 1);
+        const qint64 matcherNs = timer.nsecsElapsed();
+
+        const double naiveRate = naiveNs > 0 ? double(naiveChunks) * 1e9 / double(naiveNs) : 0.0;
+        const double matcherRate = matcherNs > 0 ? double(chunks) * 1e9 / double(matcherNs) : 0.0;
+
+        QVariantMap row;
+        row[QStringLiteral("patterns")] = count;
+        row[QStringLiteral("states")] = matcher.stateCount();
+        row[QStringLiteral("buildUs")] = double(buildNs) / 1000.0;
+        row[QStringLiteral("hitRate")] = double(hits) / double(CorpusSize);
+        row[QStringLiteral("agree")] = agree;
+        row[QStringLiteral("containsChunksPerSec")] = naiveRate;
+        row[QStringLiteral("matcherChunksPerSec")] = matcherRate;
+        row[QStringLiteral("speedup")] = naiveRate > 0.0 ? matcherRate / naiveRate : 0.0;
+        // El sink se devuelve para que el trabajo tenga un efecto observable
+        row[QStringLiteral("checksum")] = sink;
+        rows.append(row);
+    }
+    return rows;
+}
+
+// ============================================================================
+// compareFilterScaling()
+// ============================================================================
+
+namespace {
+
+struct ScalingResult
+{
+    double chunksPerSec = 0.0;
+    bool ordered = false;
+    int matches = 0;
+};
+
+ScalingResult measureScaling(const QList<QByteArray> &corpus, int chunks,
+                             const QStringList &patterns, int workers)
+{
+    static constexpr int QueueCapacity = 1024;
+    QSemaphore done;
+
+    std::vector<std::unique_ptr<PipelineChannel>> inputs;
+    std::vector<std::unique_ptr<PipelineChannel>> outputs;
+    std::vector<std::unique_ptr<QThread>> threads;
+    QList<FilterWorker *> filters;
+    QList<PipelineChannel *> probeInputs;
+
+    QThread probeThread;
+    probeThread.setObjectName(QStringLiteral("BenchmarkCollector"));
+    auto *probe = new ReorderProbe(quint64(chunks), &done);
+
+    for (int i = 0; i < workers; ++i) {
+        inputs.push_back(std::make_unique<PipelineChannel>(QueueCapacity));
+        outputs.push_back(std::make_unique<PipelineChannel>(QueueCapacity));
+
+        auto *filter = new FilterWorker();
+        filter->setFilterPatterns(patterns);
+        // Tambien con N = 1: el probe necesita ver pasar todos los sequence
+        filter->setProgressMarkers(true);
+        filter->setInput(inputs.back().get());
+        filter->setOutput(outputs.back().get());
+        inputs.back()->setConsumer(filter, "drainInput");
+        outputs.back()->setConsumer(probe, "drainInput");
+
+        threads.push_back(std::make_unique<QThread>());
+        threads.back()->setObjectName(QStringLiteral("BenchmarkFilter-%1").arg(i));
+        filter->moveToThread(threads.back().get());
+        filters.append(filter);
+        probeInputs.append(outputs.back().get());
+    }
+    probe->setInputs(probeInputs);
+    probe->moveToThread(&probeThread);
+
+    probeThread.start();
+    for (int i = 0; i < workers; ++i) {
+        threads[std::size_t(i)]->start();
+        QMetaObject::invokeMethod(filters.at(i), "start", Qt::QueuedConnection);
+    }
+
+    QElapsedTimer clock;
+    clock.start();
+    for (int i = 0; i < chunks; ++i) {
+        PipelineChunk chunk;
+        chunk.data = corpus.at(i % corpus.size());
+        chunk.sequence = quint64(i);
+        inputs[std::size_t(i % workers)]->push(std::move(chunk));
+    }
+    done.acquire();
+    const qint64 elapsedNs = clock.nsecsElapsed();
+
+    for (const auto &thread : threads) {
+        thread->quit();
+        thread->wait();
+    }
+    probeThread.quit();
+    probeThread.wait();
+
+    ScalingResult result;
+    result.chunksPerSec = elapsedNs > 0 ? double(chunks) * 1e9 / double(elapsedNs) : 0.0;
+    result.ordered = probe->ordered();
+    result.matches = probe->matches();
+
+    // Los hilos ya terminaron: se pueden destruir desde aqui
+    qDeleteAll(filters);
+    delete probe;
+    return result;
+}
+
+} // namespace
+
+QVariantList PipelineBenchmark::compareFilterScaling(int chunks, const QStringList &patterns,
+                                                     int maxWorkers)
+{
+    chunks = qMax(chunks, 1);
+    maxWorkers = qMax(maxWorkers, 1);
+    static constexpr int CorpusSize = 1024;
+
+    std::mt19937 rng(0x5EED);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    QList<QByteArray> corpus;
+    corpus.reserve(CorpusSize);
+    for (int i = 0; i < CorpusSize; ++i) {
+        QByteArray data(ScalingChunkSize, Qt::Uninitialized);
+        for (char &b : data)
+            b = char(byteDist(rng));
+        corpus.append(data);
+    }
+
+    QList<int> counts;
+    for (int n = 1; n < maxWorkers; n *= 2)
+        counts.append(n);
+    counts.append(maxWorkers);
+
+    // Calentamiento: primera creacion de hilos y del automata
+    measureScaling(corpus, qMin(chunks, 1000), patterns, 1);
+
+    QVariantList rows;
+    double baseRate = 0.0;
+    for (int workers : std::as_const(counts)) {
+        const ScalingResult r = measureScaling(corpus, chunks, patterns, workers);
+        if (workers == 1)
+            baseRate = r.chunksPerSec;
+        const double speedup = baseRate > 0.0 ? r.chunksPerSec / baseRate : 0.0;
+
+        QVariantMap row;
+        row[QStringLiteral("workers")] = workers;
+        row[QStringLiteral("chunksPerSec")] = r.chunksPerSec;
+        row[QStringLiteral("speedup")] = speedup;
+        row[QStringLiteral("efficiency")] = speedup / double(workers);
+        row[QStringLiteral("ordered")] = r.ordered;
+        row[QStringLiteral("matches")] = r.matches;
+        rows.append(row);
+    }
+    return rows;
+}
+
+// ============================================================================
+// compareGenerators()
+// ============================================================================
+
+namespace {
+
+struct GeneratorResult
+{
+    double chunksPerSec = 0.0;
+    double megabytesPerSec = 0.0;
+    double allocationsPerChunk = 0.0;
+    quint64 checksum = 0;
+};
+
+// Los ultimos 'inFlight' chunks siguen vivos (como en la cola del Filtro):
+// sin esto el pool acertaria siempre. La suma del primer byte evita que
+// el compilador descarte el trabajo. Las reservas se cuentan solo dentro
+// del bucle: la ventana y el pool ya estan creados.
+template <typename Make>
+GeneratorResult measureGenerator(int chunks, int inFlight,
+                                 PipelineBenchmark::AllocationProbe probe, Make &&make)
+{
+    std::vector<QByteArray> window(std::size_t(qMax(inFlight, 1)));
+    GeneratorResult result;
+    qint64 bytes = 0;
+
+    const quint64 allocationsBefore = probe ? probe() : 0;
+    QElapsedTimer clock;
+    clock.start();
+    for (int i = 0; i < chunks; ++i) {
+        QByteArray data = make();
+        bytes += data.size();
+        result.checksum += quint8(data.at(0));
+        window[std::size_t(i) % window.size()] = std::move(data);
+    }
+    const qint64 elapsedNs = clock.nsecsElapsed();
+    if (probe)
+        result.allocationsPerChunk = double(probe() - allocationsBefore) / double(chunks);
+
+    if (elapsedNs > 0) {
+        result.chunksPerSec = double(chunks) * 1e9 / double(elapsedNs);
+        result.megabytesPerSec = double(bytes) * 1e3 / double(elapsedNs);
+    }
+    return result;
+}
+
+} // namespace
+
+QVariantList PipelineBenchmark::compareGenerators(int chunks, int inFlight,
+                                                  AllocationProbe probe)
+{
+    chunks = qMax(chunks, 1);
+    inFlight = qMax(inFlight, 1);
+
+    // Antes: una llamada a la distribucion por byte y un QByteArray nuevo
+    std::mt19937 mt(0x5EED);
+    std::uniform_int_distribution<int> lenDist(1, 100);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    const GeneratorResult before = measureGenerator(chunks, inFlight, probe, [&]() {
+        const int len = lenDist(mt);
+        QByteArray data(len, Qt::Uninitialized);
+        for (int i = 0; i < len; ++i)
+            data[i] = static_cast<char>(byteDist(mt));
+        return data;
+    });
+
+    // Ahora: 8 bytes por llamada y buffers reutilizados
+    Xoshiro256 rng(0x5EED);
+    ChunkBufferPool pool;
+    pool.reset(inFlight + 1);
+    const GeneratorResult after = measureGenerator(chunks, inFlight, probe, [&]() {
+        const qsizetype len = 1 + qsizetype(rng.below(100));
+        return pool.take(len, [&rng](char *data, qsizetype size) { rng.fill(data, size); });
+    });
+
+    auto row = [chunks, probe](const QString &method, const GeneratorResult &r, double baseRate) {
+        QVariantMap map;
+        map[QStringLiteral("method")] = method;
+        map[QStringLiteral("chunks")] = chunks;
+        map[QStringLiteral("chunksPerSec")] = r.chunksPerSec;
+        map[QStringLiteral("megabytesPerSec")] = r.megabytesPerSec;
+        if (probe)
+            map[QStringLiteral("allocationsPerChunk")] = r.allocationsPerChunk;
+        map[QStringLiteral("speedup")] = baseRate > 0.0 ? r.chunksPerSec / baseRate : 0.0;
+        map[QStringLiteral("checksum")] = double(r.checksum);
+        return map;
+    };
+    return {
+        row(QStringLiteral("mt19937 per byte"), before, before.chunksPerSec),
+        row(QStringLiteral("xoshiro256** + pool"), after, before.chunksPerSec)
+    };
+}
+
+// ============================================================================
+// compareHandoffs()
+// ============================================================================
+
+namespace {
+
+struct HandoffResult
+{
+    double chunksPerSec = 0.0;
+    quint64 chunks = 0;
+    int matches = 0;
+    double poolHitRate = 0.0;
+    // Reservas de heap de cada hilo durante la ejecucion (solo con probe)
+    quint64 generatorAllocations = 0;
+    quint64 filterAllocations = 0;
+    quint64 collectorAllocations = 0;
+};
+
+// probe() en el hilo del worker. BlockingQueued espera a que ese hilo
+// atienda antes todo lo que ya tenia encolado: sirve tambien de barrera.
+quint64 readProbe(QObject *worker, PipelineBenchmark::AllocationProbe probe)
+{
+    quint64 value = 0;
+    QMetaObject::invokeMethod(worker, [&value, probe]() {
+        if (probe)
+            value = probe();
+    }, Qt::BlockingQueuedConnection);
+    return value;
+}
+
+// Generador, Filtro y Colector de verdad, cada uno en su QThread y
+// cableados como en ThreadPipeline::start() con el transporte 'kind' y la
+// politica Block (no se descarta nada). El Generador corre en modo libre
+// hasta que el Filtro ha visto 'chunks' chunks; despues se para y se
+// espera a que lo que queda en las colas llegue al Colector.
+//
+// Las lecturas finales de probe() siguen el orden del pipeline: cuando
+// vuelve la del Filtro, todo lo que mando al Colector esta ya en su cola
+// (o en su event loop), por delante de la lectura del Colector.
+HandoffResult measureHandoff(int chunks, int queueCapacity, PipelineChannel::Kind kind,
+                             PipelineBenchmark::AllocationProbe probe)
+{
+    static constexpr int BatchSize = 256;
+    PipelineChannel filterInput(queueCapacity, PipelineChannel::Overflow::Block, kind);
+    PipelineChannel collectorInput(queueCapacity, PipelineChannel::Overflow::Block, kind);
+    RecordStore store;
+
+    QThread generatorThread;
+    QThread filterThread;
+    QThread collectorThread;
+    generatorThread.setObjectName(QStringLiteral("BenchmarkGenerator"));
+    filterThread.setObjectName(QStringLiteral("BenchmarkFilter"));
+    collectorThread.setObjectName(QStringLiteral("BenchmarkCollector"));
+
+    auto *generator = new GeneratorWorker();
+    auto *filter = new FilterWorker();
+    auto *collector = new CollectorWorker();
+    // Pool como en ThreadPipeline::start(): un lote y el doble de las colas
+    generator->setFreeRunning(true, BatchSize);
+    generator->setPoolSlots(BatchSize + 2 * (2 * queueCapacity));
+    // Un byte 00: coincide ~1 de cada 5 chunks de 1-100 bytes
+    filter->setFilterPatterns({ QStringLiteral("00") });
+
+    generator->moveToThread(&generatorThread);
+    filter->moveToThread(&filterThread);
+    collector->moveToThread(&collectorThread);
+
+    filter->setInput(&filterInput);
+    filter->setOutput(&collectorInput);
+    generator->setOutputs({ &filterInput });
+    collector->setInputs({ &collectorInput });
+    collector->setStore(&store);
+    if (kind == PipelineChannel::Kind::Ring) {
+        filterInput.setConsumer(filter, "drainInput");
+        collectorInput.setConsumer(collector, "drainInput");
+    } else {
+        QObject::connect(generator, &GeneratorWorker::dataGenerated,
+                         filter, &FilterWorker::processData);
+        QObject::connect(filter, &FilterWorker::dataMatched,
+                         collector, &CollectorWorker::collectData);
+    }
+
+    generatorThread.start();
+    filterThread.start();
+    collectorThread.start();
+    QMetaObject::invokeMethod(filter, "start", Qt::QueuedConnection);
+    QMetaObject::invokeMethod(collector, "start", Qt::QueuedConnection);
+
+    HandoffResult result;
+    const quint64 generatorBefore = readProbe(generator, probe);
+    const quint64 filterBefore = readProbe(filter, probe);
+    const quint64 collectorBefore = readProbe(collector, probe);
+
+    QElapsedTimer clock;
+    clock.start();
+    QMetaObject::invokeMethod(generator, "start", Qt::QueuedConnection);
+    while (filter->processedCount() < chunks)
+        QThread::usleep(100);
+    QMetaObject::invokeMethod(generator, "stop", Qt::BlockingQueuedConnection);
+    result.generatorAllocations = readProbe(generator, probe) - generatorBefore;
+
+    // Parado el Generador, cada take() del pool es un chunk generado
+    result.chunks = generator->poolHits() + generator->poolMisses();
+    while (quint64(filter->processedCount()) < result.chunks)
+        QThread::usleep(100);
+    result.filterAllocations = readProbe(filter, probe) - filterBefore;
+    result.collectorAllocations = readProbe(collector, probe) - collectorBefore;
+    const qint64 elapsedNs = clock.nsecsElapsed();
+
+    for (QThread *thread : { &generatorThread, &filterThread, &collectorThread }) {
+        thread->quit();
+        thread->wait();
+    }
+
+    result.chunksPerSec = elapsedNs > 0 ? double(result.chunks) * 1e9 / double(elapsedNs) : 0.0;
+    result.matches = filter->matchedCount();
+    result.poolHitRate = result.chunks > 0
+        ? double(generator->poolHits()) / double(result.chunks) : 0.0;
+
+    // Los hilos ya terminaron: se pueden destruir desde aqui
+    delete generator;
+    delete filter;
+    delete collector;
+    return result;
+}
+
+} // namespace
+
+QVariantList PipelineBenchmark::compareHandoffs(int chunks, int queueCapacity,
+                                                AllocationProbe probe)
+{
+    chunks = qMax(chunks, 1);
+    queueCapacity = qMax(queueCapacity, 1);
+
+    struct Transport
+    {
+        QString name;
+        PipelineChannel::Kind kind;
+    };
+    const Transport transports[] = {
+        { QStringLiteral("signal/slot"), PipelineChannel::Kind::SignalCount },
+        { QStringLiteral("SPSC rings"), PipelineChannel::Kind::Ring }
+    };
+
+    // Calentamiento: primera creacion de hilos, del automata y del pool
+    for (const Transport &transport : transports)
+        measureHandoff(qMin(chunks, 1000), queueCapacity, transport.kind, nullptr);
+
+    QVariantList rows;
+    double baseRate = 0.0;
+    for (const Transport &transport : transports) {
+        const HandoffResult r = measureHandoff(chunks, queueCapacity, transport.kind, probe);
+        if (rows.isEmpty())
+            baseRate = r.chunksPerSec;
+
+        QVariantMap row;
+        row[QStringLiteral("method")] = transport.name;
+        row[QStringLiteral("chunks")] = double(r.chunks);
+        row[QStringLiteral("matches")] = r.matches;
+        row[QStringLiteral("chunksPerSec")] = r.chunksPerSec;
+        row[QStringLiteral("speedup")] = baseRate > 0.0 ? r.chunksPerSec / baseRate : 0.0;
+        row[QStringLiteral("poolHitRate")] = r.poolHitRate;
+        if (probe) {
+            const double chunkCount = double(qMax<quint64>(r.chunks, 1));
+            const quint64 total = r.generatorAllocations + r.filterAllocations
+                + r.collectorAllocations;
+            row[QStringLiteral("generatorAllocationsPerChunk")] =
+                double(r.generatorAllocations) / chunkCount;
+            row[QStringLiteral("filterAllocationsPerChunk")] =
+                double(r.filterAllocations) / chunkCount;
+            row[QStringLiteral("collectorAllocationsPerChunk")] =
+                double(r.collectorAllocations) / chunkCount;
+            row[QStringLiteral("allocationsPerChunk")] = double(total) / chunkCount;
+        }
+        rows.append(row);
+    }
+    return rows;
+}
+
+// ============================================================================
+// comparePlacements()
+// ============================================================================
+
+namespace {
+
+// Cada contador en su propia linea de cache: si compartieran linea, el
+// benchmark mediria falso compartir, no el traspaso entre CPUs
+struct alignas(64) PingPongSlot
+{
+    std::atomic<quint64> value{0};
+};
+
+struct PlacementResult
+{
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double maxNs = 0.0;
+    double roundTripsPerSec = 0.0;
+    bool pinned = true;
+    QString error;
+};
+
+// Espera activa corta y luego cede la CPU: con los dos hilos en la misma
+// CPU, girar sin ceder retendria al otro hasta agotar el quantum
+void waitFor(const std::atomic<quint64> &slot, quint64 value)
+{
+    int spins = 0;
+    while (slot.load(std::memory_order_acquire) != value) {
+        if (++spins == 256) {
+            QThread::yieldCurrentThread();
+            spins = 0;
+        }
+    }
+}
+
+PlacementResult measurePingPong(int roundTrips, int cpuA, int cpuB)
+{
+    PingPongSlot ping;
+    PingPongSlot pong;
+    QSemaphore ready;
+    const int warmup = qMin(roundTrips / 10, 10000);
+    const quint64 total = quint64(roundTrips + warmup);
+    std::vector<qint64> latencies;
+    latencies.reserve(std::size_t(roundTrips));
+    ThreadPlacement::Result placedA;
+    ThreadPlacement::Result placedB;
+
+    auto place = [](int cpu, ThreadPlacement::Result &placed) {
+        if (cpu < 0)
+            return;
+        ThreadPlacement::Settings settings;
+        settings.cpu = cpu;
+        placed = ThreadPlacement::apply(settings);
+    };
+
+    std::unique_ptr<QThread> echo(QThread::create([&]() {
+        place(cpuB, placedB);
+        ready.release();
+        for (quint64 i = 1; i <= total; ++i) {
+            waitFor(ping.value, i);
+            pong.value.store(i, std::memory_order_release);
+        }
+    }));
+    QElapsedTimer clock;
+    qint64 elapsedNs = 0;
+    std::unique_ptr<QThread> pinger(QThread::create([&]() {
+        place(cpuA, placedA);
+        ready.acquire();
+        clock.start();
+        qint64 measuredFrom = 0;
+        for (quint64 i = 1; i <= total; ++i) {
+            if (i == quint64(warmup) + 1)
+                measuredFrom = clock.nsecsElapsed();
+            const qint64 sentNs = clock.nsecsElapsed();
+            ping.value.store(i, std::memory_order_release);
+            waitFor(pong.value, i);
+            if (i > quint64(warmup))
+                latencies.push_back(clock.nsecsElapsed() - sentNs);
+        }
+        elapsedNs = clock.nsecsElapsed() - measuredFrom;
+    }));
+    echo->setObjectName(QStringLiteral("PlacementEcho"));
+    pinger->setObjectName(QStringLiteral("PlacementPinger"));
+    echo->start();
+    pinger->start();
+    pinger->wait();
+    echo->wait();
+
+    PlacementResult result;
+    result.p50Ns = percentileNs(latencies, 0.50);
+    result.p99Ns = percentileNs(latencies, 0.99);
+    result.maxNs = latencies.empty()
+        ? 0.0 : double(*std::max_element(latencies.begin(), latencies.end()));
+    if (elapsedNs > 0)
+        result.roundTripsPerSec = double(roundTrips) * 1e9 / double(elapsedNs);
+    result.pinned = placedA.ok && placedB.ok;
+    result.error = QStringList({placedA.error, placedB.error}).join(QLatin1Char(' ')).trimmed();
+    return result;
+}
+
+} // namespace
+
+QVariantList PipelineBenchmark::comparePlacements(int roundTrips)
+{
+    roundTrips = qMax(roundTrips, 1);
+
+    // Candidatas dentro del cpuset del proceso, relativas a la primera
+    const QList<int> cpus = ThreadPlacement::allowedCpus();
+    const int base = cpus.first();
+    const int baseNode = ThreadPlacement::numaNodeOf(base);
+    const int sibling = ThreadPlacement::smtSiblingOf(base);
+    int otherCore = -1;
+    int otherNode = -1;
+    for (int cpu : cpus) {
+        if (cpu == base || cpu == sibling || ThreadPlacement::smtSiblingOf(cpu) == base)
+            continue;
+        const int node = ThreadPlacement::numaNodeOf(cpu);
+        if (otherCore < 0 && node == baseNode)
+            otherCore = cpu;
+        if (otherNode < 0 && node >= 0 && node != baseNode)
+            otherNode = cpu;
+    }
+
+    struct Case { QString placement; int cpuA; int cpuB; };
+    QList<Case> cases;
+    cases.append({QStringLiteral("unpinned"), -1, -1});
+    cases.append({QStringLiteral("same CPU"), base, base});
+    if (sibling >= 0 && cpus.contains(sibling))
+        cases.append({QStringLiteral("SMT sibling"), base, sibling});
+    if (otherCore >= 0)
+        cases.append({QStringLiteral("other core"), base, otherCore});
+    if (otherNode >= 0)
+        cases.append({QStringLiteral("other NUMA node"), base, otherNode});
+
+    QVariantList rows;
+    for (const Case &c : std::as_const(cases)) {
+        const PlacementResult r = measurePingPong(roundTrips, c.cpuA, c.cpuB);
+        QVariantMap map;
+        map[QStringLiteral("placement")] = c.placement;
+        map[QStringLiteral("cpuA")] = c.cpuA;
+        map[QStringLiteral("cpuB")] = c.cpuB;
+        map[QStringLiteral("nodeA")] = ThreadPlacement::numaNodeOf(c.cpuA);
+        map[QStringLiteral("nodeB")] = ThreadPlacement::numaNodeOf(c.cpuB);
+        map[QStringLiteral("roundTrips")] = roundTrips;
+        map[QStringLiteral("p50Ns")] = r.p50Ns;
+        map[QStringLiteral("p99Ns")] = r.p99Ns;
+        map[QStringLiteral("maxNs")] = r.maxNs;
+        map[QStringLiteral("roundTripsPerSec")] = r.roundTripsPerSec;
+        map[QStringLiteral("pinned")] = r.pinned;
+        map[QStringLiteral("error")] = r.error;
+        rows.append(map);
+    }
+    return rows;
+}
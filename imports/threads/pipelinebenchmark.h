@@ -0,0 +1,245 @@
+// ============================================================================
+// pipelinebenchmark.h - Comparativa signal/slot vs ring SPSC entre hilos
+// ============================================================================
+//
+// PATRON: Clase utilitaria con metodos estaticos. Devuelve un QVariantMap
+// que ThreadPipeline reenvia tal cual a QML:
+//
+//   var r = pipeline.runTransportBenchmark(200000)
+//   r.signalChunksPerSec   // emit -> QueuedConnection -> slot
+//   r.ringChunksPerSec     // PipelineChannel (ring SPSC + timbre)
+//   r.speedup              // ring / signal
+//   r.signalP99Us          // latencia productor -> consumidor (p99)
+//   r.signalWakeups        // eventos Qt encolados (uno por chunk)
+//   r.ringWakeups          // eventos Qt encolados (uno por rafaga)
+//
+//   var rows = pipeline.runMatcherBenchmark(100000)
+//   rows[i].patterns                // 1, 4, 16, 64, 256, 1000
+//   rows[i].containsChunksPerSec    // un QByteArray::contains() por patron
+//   rows[i].matcherChunksPerSec     // PatternMatcher (Aho-Corasick)
+//
+//   var rows = pipeline.runFilterScalingBenchmark(200000)
+//   rows[i].workers                 // 1, 2, 4... hasta los nucleos
+//   rows[i].chunksPerSec            // agregado, ya reordenado
+//   rows[i].ordered                 // el Colector recibio en orden
+//
+//   var rows = pipeline.runGeneratorBenchmark(1000000)
+//   rows[i].method                  // "mt19937 per byte", "xoshiro256** + pool"
+//   rows[i].chunksPerSec            // chunks de 1-100 bytes generados
+//   rows[i].megabytesPerSec         // bytes aleatorios por segundo
+//
+//   var rows = pipeline.runHandoffBenchmark(1000000)
+//   rows[i].method                  // "signal/slot", "SPSC rings"
+//   rows[i].chunksPerSec            // Generador -> Filtro -> Colector reales
+//   rows[i].poolHitRate             // chunks con buffer reutilizado
+//
+//   var rows = pipeline.runPlacementBenchmark(100000)
+//   rows[i].placement               // "unpinned", "same CPU", "SMT sibling"...
+//   rows[i].p50Ns / p99Ns           // ida y vuelta entre dos hilos
+//
+// METODOLOGIA:
+//   - Productor: el hilo que llama (el de QML). Consumidor: un QThread
+//     propio con su event loop, igual que los workers del pipeline.
+//   - Cada chunk (64 bytes, un QByteArray nuevo en ambos modos) lleva en
+//     sus primeros 8 bytes el instante de envio (QElapsedTimer, reloj
+//     monotono compartido). El consumidor resta y guarda la latencia.
+//   - El tiempo total va del primer envio a que el consumidor recibe el
+//     ultimo chunk (QSemaphore).
+//
+// OJO al comparar latencias: la cola de eventos de Qt no tiene limite,
+// asi que con signal/slot el productor se adelanta y la latencia crece
+// con la cola. El ring tiene capacidad fija y frena al productor.
+//
+// Se ejecuta de forma SINCRONA: la UI se congela mientras mide. No usa
+// los hilos del pipeline, puede lanzarse con el pipeline parado.
+// ============================================================================
+
+#ifndef PIPELINEBENCHMARK_H
+#define PIPELINEBENCHMARK_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QList>
+#include <QSemaphore>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+#include <vector>
+#include "reorderbuffer.h"
+
+class PipelineChannel;
+
+// ============================================================================
+// TransportProbe - Extremo (emisor o receptor) del benchmark
+// ============================================================================
+// Un probe en el hilo que llama emite chunkSent(); otro, movido al hilo
+// consumidor, lo recibe en receive() (signal/slot) o en drainInput()
+// (ring). Necesita Q_OBJECT para la signal, por eso vive en un header.
+
+class TransportProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    TransportProbe(int expected, const QElapsedTimer *clock, QSemaphore *done);
+
+    void setInput(PipelineChannel *channel) { m_input = channel; }
+    const std::vector<qint64> &latencies() const { return m_latencies; }
+
+public slots:
+    void receive(const QByteArray &chunk);
+    void drainInput();
+
+signals:
+    void chunkSent(const QByteArray &chunk);
+
+private:
+    int m_expected = 0;
+    const QElapsedTimer *m_clock = nullptr;
+    QSemaphore *m_done = nullptr;
+    PipelineChannel *m_input = nullptr;
+    std::vector<qint64> m_latencies;
+};
+
+// ============================================================================
+// ReorderProbe - Colector del benchmark de escalado
+// ============================================================================
+// Vacia las colas de N FilterWorker reales, reordena con ReorderBuffer
+// igual que CollectorWorker y comprueba que las coincidencias salen en
+// orden de sequence. Avisa cuando ha visto pasar todos los chunks.
+
+class ReorderProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReorderProbe(quint64 expected, QSemaphore *done);
+
+    void setInputs(const QList<PipelineChannel *> &channels);
+    bool ordered() const { return m_ordered; }
+    int matches() const { return m_matches; }
+
+public slots:
+    void drainInput();
+
+private:
+    quint64 m_expected = 0;
+    QSemaphore *m_done = nullptr;
+    QList<PipelineChannel *> m_inputs;
+    ReorderBuffer m_reorder;
+    bool m_ordered = true;
+    bool m_finished = false;
+    bool m_any = false;
+    quint64 m_lastSequence = 0;
+    int m_matches = 0;
+};
+
+class PipelineBenchmark
+{
+public:
+    // Tamano de cada chunk de prueba (incluye los 8 bytes del timestamp)
+    static constexpr int ChunkSize = 64;
+
+    // Reservas de heap hechas hasta ahora por el hilo que llama. La app no
+    // sustituye malloc() y no tiene como contarlas: solo se la pasa el
+    // benchmark de consola (benchmarks/pipelinebench.cpp), que enlaza
+    // AllocationCounter::threadAllocations.
+    using AllocationProbe = quint64 (*)();
+
+    // ========================================================================
+    // compareTransports() - QueuedConnection vs PipelineChannel
+    // ========================================================================
+    // Envia 'chunks' chunks a otro hilo con cada transporte y devuelve:
+    //   { chunks, ringCapacity, speedup,
+    //     signalChunksPerSec, signalP50Us, signalP99Us, signalMaxUs,
+    //     signalWakeups,
+    //     ringChunksPerSec, ringP50Us, ringP99Us, ringMaxUs, ringWakeups }
+    // ========================================================================
+    static QVariantMap compareTransports(int chunks, int ringCapacity);
+
+    // ========================================================================
+    // compareMatchers() - contains() por patron vs PatternMatcher
+    // ========================================================================
+    // Corpus fijo de chunks aleatorios de 1-100 bytes (como el Generador),
+    // con un patron del conjunto sembrado en ~1 de cada 8. Para 1, 4, 16,
+    // 64, 256 y 1000 patrones de 4 bytes devuelve una fila:
+    //   { patterns, states, buildUs, hitRate, agree,
+    //     containsChunksPerSec, matcherChunksPerSec, speedup, checksum }
+    // 'agree' confirma que ambos metodos aceptan exactamente los mismos
+    // chunks. contains() mide menos chunks con muchos patrones
+    // (chunks / patrones, minimo 1000) para no congelar la UI.
+    // ========================================================================
+    static QVariantList compareMatchers(int chunks);
+
+    // ========================================================================
+    // compareFilterScaling() - 1, 2, 4... FilterWorker en paralelo
+    // ========================================================================
+    // El hilo que llama reparte 'chunks' chunks de ScalingChunkSize bytes
+    // por sequence % N entre N FilterWorker reales (rings SPSC, Block) con
+    // 'patterns'; un ReorderProbe los recoge y reordena. Filas para N =
+    // 1, 2, 4... hasta maxWorkers (incluido):
+    //   { workers, chunksPerSec, speedup, efficiency, ordered, matches }
+    // speedup es respecto a N = 1; efficiency = speedup / N.
+    // ========================================================================
+    static constexpr int ScalingChunkSize = 1024;
+    static QVariantList compareFilterScaling(int chunks, const QStringList &patterns,
+                                             int maxWorkers);
+
+    // ========================================================================
+    // compareGenerators() - Coste de fabricar los chunks del Generador
+    // ========================================================================
+    // En el hilo que llama, sin colas: solo construir 'chunks' chunks de
+    // 1-100 bytes aleatorios, manteniendo vivos los ultimos 'inFlight'
+    // (como los retendria la cola del Filtro). Dos filas:
+    //   { method, chunks, chunksPerSec, megabytesPerSec, speedup, checksum }
+    //   "mt19937 per byte":     el generate() original (QByteArray nuevo)
+    //   "xoshiro256** + pool":  fastrandom.h + ChunkBufferPool (inFlight+1
+    //                           huecos, reutilizados en regimen)
+    // Con 'probe' cada fila anade allocationsPerChunk: la diferencia de
+    // probe() antes y despues del bucle, medida igual en las dos filas.
+    // ========================================================================
+    static QVariantList compareGenerators(int chunks, int inFlight,
+                                          AllocationProbe probe = nullptr);
+
+    // ========================================================================
+    // compareHandoffs() - De Generador a Colector con los workers reales
+    // ========================================================================
+    // GeneratorWorker, FilterWorker y CollectorWorker en tres QThreads
+    // propios, cableados como ThreadPipeline::start() (politica Block, un
+    // Filtro, patron 00: ~1 de cada 5 chunks coincide). Una fila por
+    // transporte, "signal/slot" y "SPSC rings":
+    //   { method, chunks, matches, chunksPerSec, speedup, poolHitRate }
+    // chunks es lo que genero de verdad: algo mas de lo pedido, lo que
+    // habia en las colas al parar.
+    // Con 'probe' cada hilo lee su contador al empezar y al terminar y la
+    // fila anade las reservas por chunk de cada etapa y su suma:
+    //   generatorAllocationsPerChunk, filterAllocationsPerChunk,
+    //   collectorAllocationsPerChunk, allocationsPerChunk
+    // ========================================================================
+    static QVariantList compareHandoffs(int chunks, int queueCapacity,
+                                        AllocationProbe probe = nullptr);
+
+    // ========================================================================
+    // comparePlacements() - Latencia entre hilos segun donde corren
+    // ========================================================================
+    // Ping-pong entre dos QThreads propios (el hilo que llama no se fija a
+    // ninguna CPU): uno escribe un contador en su linea de cache y espera
+    // a que el otro lo devuelva en la suya. Cada ida y vuelta son dos
+    // traspasos de linea de cache, lo mismo que paga un chunk al cruzar
+    // una cola entre etapas. Una fila por colocacion disponible:
+    //   "unpinned"        el planificador decide (como sin ajustes)
+    //   "same CPU"        los dos hilos en una CPU: cambio de contexto
+    //   "SMT sibling"     dos CPUs logicas del mismo nucleo (L1/L2 comun)
+    //   "other core"      otro nucleo del mismo nodo (L3 comun)
+    //   "other NUMA node" la linea cruza el enlace entre sockets
+    // Columnas:
+    //   { placement, cpuA, cpuB, nodeA, nodeB, roundTrips,
+    //     p50Ns, p99Ns, maxNs, roundTripsPerSec, pinned, error }
+    // Las filas sin CPUs que las representen (una sola CPU, sin SMT, un
+    // solo nodo) no aparecen.
+    // ========================================================================
+    static QVariantList comparePlacements(int roundTrips);
+};
+
+#endif // PIPELINEBENCHMARK_H
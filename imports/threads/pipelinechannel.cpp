@@ -0,0 +1,181 @@
+// ============================================================================
+// pipelinechannel.cpp - Implementacion del canal acotado
+// ============================================================================
+
+#include "pipelinechannel.h"
+#include <QMetaObject>
+
+// El ring se dimensiona al doble de la capacidad logica: el hueco extra
+// aloja los chunks que DropOldest ya ha condenado (ver cabecera). En modo
+// SignalCount no se usa y se queda en el minimo.
+PipelineChannel::PipelineChannel(int capacity, Overflow policy, Kind kind)
+    : m_capacity(qMax(capacity, 1))
+    , m_policy(policy)
+    , m_kind(kind)
+    , m_ring(kind == Kind::Ring ? std::size_t(m_capacity) * 2 : 2)
+    , m_batch(kind == Kind::Ring ? BatchSize : 0)
+{
+}
+
+void PipelineChannel::setConsumer(QObject *consumer, const char *drainSlot)
+{
+    m_consumer = consumer;
+    m_drainSlot = drainSlot;
+}
+
+// Chunks en la cola fisica (incluye los pendientes de descartar)
+std::size_t PipelineChannel::queued() const
+{
+    if (m_kind == Kind::Ring)
+        return m_ring.sizeApprox();
+    return std::size_t(qMax<qint64>(m_inFlight.load(std::memory_order_acquire), 0));
+}
+
+qint64 PipelineChannel::logicalDepth() const
+{
+    return qint64(queued()) - m_debt.load(std::memory_order_acquire);
+}
+
+int PipelineChannel::depth() const
+{
+    return int(qBound<qint64>(0, logicalDepth(), m_capacity));
+}
+
+// ============================================================================
+// waitUntil() / notifySpace() - Espera del productor con la cola llena
+// ============================================================================
+// ready() se revisa con el mutex tomado y DESPUES de publicar la espera:
+// si el consumidor libero hueco antes, ready() lo ve; si lo libera despues,
+// vera m_producerWaiting y su wakeAll() llegara con el productor ya dormido
+// (wait() suelta el mutex atomicamente). Ver la cabecera.
+// ============================================================================
+template <typename Ready>
+bool PipelineChannel::waitUntil(Ready ready)
+{
+    QMutexLocker lock(&m_spaceMutex);
+    m_producerWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    bool ok = true;
+    while (!ready()) {
+        if (m_closed.load(std::memory_order_acquire)) {
+            ok = false;
+            break;
+        }
+        m_spaceFreed.wait(&m_spaceMutex);
+    }
+    m_producerWaiting.store(false, std::memory_order_relaxed);
+    return ok;
+}
+
+void PipelineChannel::notifySpace()
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!m_producerWaiting.load(std::memory_order_relaxed))
+        return;
+    QMutexLocker lock(&m_spaceMutex);
+    m_spaceFreed.wakeAll();
+}
+
+// ============================================================================
+// reserve() - Politica de desbordamiento (hilo productor)
+// ============================================================================
+bool PipelineChannel::reserve()
+{
+    for (;;) {
+        const std::size_t physical = queued();
+        const qint64 logical = logicalDepth();
+
+        if (logical < m_capacity) {
+            // El productor es el unico que escribe el pico
+            if (logical + 1 > m_peak.load(std::memory_order_relaxed))
+                m_peak.store(int(logical + 1), std::memory_order_relaxed);
+            return true;
+        }
+
+        switch (m_policy) {
+        case Overflow::DropNewest:
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+
+        case Overflow::DropOldest:
+            // Cabe en el ring (o en el doble de la capacidad, en eventos
+            // en vuelo): se encola y el consumidor descartara el mas antiguo
+            if (physical < (m_kind == Kind::Ring ? m_ring.capacity()
+                                                 : std::size_t(m_capacity) * 2)) {
+                m_debt.fetch_add(1, std::memory_order_acq_rel);
+                return true;
+            }
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+
+        case Overflow::Block:
+            if (!waitUntil([this] { return logicalDepth() < m_capacity; }))
+                return false;
+            break;
+        }
+    }
+}
+
+// Solo el consumidor resta deuda, asi que leer > 0 y restar es seguro
+bool PipelineChannel::payDebt()
+{
+    if (m_debt.load(std::memory_order_acquire) <= 0)
+        return false;
+    m_debt.fetch_sub(1, std::memory_order_acq_rel);
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+// push() corre en el hilo productor. El chunk se MUEVE al ring: no hay
+// copia ni evento Qt salvo el aviso de la primera posicion de la rafaga.
+bool PipelineChannel::push(PipelineChunk &&chunk)
+{
+    if (!reserve())
+        return false;
+
+    // reserve() ya garantiza hueco fisico; esto solo cubre un ring lleno
+    // de chunks condenados por DropOldest que el consumidor aun no vacio
+    while (!m_ring.tryPush(std::move(chunk))) {
+        if (!waitUntil([this] { return m_ring.sizeApprox() < m_ring.capacity(); }))
+            return false;
+    }
+
+    requestDrain();
+    return true;
+}
+
+bool PipelineChannel::admit()
+{
+    if (!reserve())
+        return false;
+    m_inFlight.fetch_add(1, std::memory_order_acq_rel);
+    return true;
+}
+
+bool PipelineChannel::accept()
+{
+    m_inFlight.fetch_sub(1, std::memory_order_acq_rel);
+    notifySpace();
+    return !payDebt();
+}
+
+// Con el mutex tomado: un productor que acaba de ver m_closed == false ya
+// esta dentro de wait() cuando llega el wakeAll()
+void PipelineChannel::close()
+{
+    m_closed.store(true, std::memory_order_release);
+    QMutexLocker lock(&m_spaceMutex);
+    m_spaceFreed.wakeAll();
+}
+
+// Encola drainInput() en el event loop del consumidor (QueuedConnection:
+// se ejecuta en SU hilo, nunca en el del productor).
+void PipelineChannel::requestDrain()
+{
+    if (m_wakePending.exchange(true, std::memory_order_acq_rel))
+        return;
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    QMetaObject::invokeMethod(m_consumer, m_drainSlot.constData(),
+                              Qt::QueuedConnection);
+}
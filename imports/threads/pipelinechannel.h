@@ -0,0 +1,201 @@
+// ============================================================================
+// pipelinechannel.h - Cola acotada entre dos etapas del pipeline
+// ============================================================================
+//
+// Cada salto del pipeline (Generator -> Filter, Filter -> Collector) tiene
+// un PipelineChannel. Hace dos trabajos:
+//
+//   1. ACOTAR la cola: como mucho capacity() chunks pendientes. Al llenarse
+//      se aplica la politica de desbordamiento (Overflow):
+//        Block      -> el productor DUERME hasta que haya hueco
+//        DropOldest -> se descarta el chunk mas antiguo de la cola
+//        DropNewest -> se descarta el chunk que se intentaba encolar
+//      depth(), peakDepth() y dropped() permiten VER la saturacion.
+//
+//   2. TRANSPORTAR el chunk, segun el Kind:
+//        Ring        -> el chunk viaja por el SpscRing (ver abajo)
+//        SignalCount -> el chunk viaja por signal/slot; el canal solo
+//                       cuenta los que estan "en vuelo" en la cola de
+//                       eventos (admit() al emitir, accept() al recibir)
+//
+// ─── Kind::Ring: ring SPSC + "timbre" ──────────────────────────────────
+//
+//   Productor (Hilo A)                     Consumidor (Hilo B)
+//   ──────────────────                     ───────────────────
+//   push(chunk)                            drainInput()  [slot]
+//     ring.tryPush(chunk)                    wakePending = false
+//     si wakePending era false:              while (lote = popBatch(64))
+//       wakePending = true                       procesar lote
+//       invokeMethod(consumer, "drainInput")
+//
+// Solo se encola UN evento Qt por rafaga, no uno por dato: mientras el
+// consumidor no haya empezado a vaciar, los push siguientes solo mueven
+// el dato al ring. Con signal/slot cada chunk es un QMetaCallEvent.
+//
+// ORDEN DE MEMORIA DEL TIMBRE:
+//   Ambos lados usan exchange() (acq_rel) sobre wakePending. Si el
+//   productor ve "true" (no avisa), el consumidor aun no ha hecho su
+//   exchange(false): cuando lo haga, leera el valor del productor y vera
+//   tambien su push. Si el productor ve "false", avisa. Nunca se pierde
+//   un dato en el ring sin un drainInput() pendiente.
+//
+// JUSTICIA:
+//   drain() procesa como mucho MaxBatchesPerWakeup lotes y, si queda
+//   algo, vuelve a encolarse. Asi un productor rapido no monopoliza el
+//   hilo consumidor y sus otros eventos (setFilterPattern, quit) corren.
+//
+// ─── Block: espera real, no un spin ────────────────────────────────────
+// Con la cola llena el productor duerme en una QWaitCondition. El
+// consumidor la despierta al liberar hueco (tras cada lote de drain() o en
+// accept()) y close() la despierta para que push() falle. Con un spin, un
+// productor SCHED_FIFO en la misma CPU que su consumidor (ThreadPlacement)
+// no le dejaria correr nunca.
+//
+// El consumidor solo toma el mutex si hay alguien esperando
+// (m_producerWaiting), asi que sin contencion el coste es una barrera y una
+// lectura atomica por lote. Las dos barreras seq_cst (productor: tras
+// marcar la espera y antes de revisar la cola; consumidor: tras liberar y
+// antes de leer la marca) garantizan que al menos uno ve al otro: o el
+// productor ve el hueco, o el consumidor ve la espera y despierta.
+//
+// ─── DropOldest sin tocar el lado del consumidor ───────────────────────
+// El productor de una cola SPSC no puede sacar elementos (eso es del
+// consumidor), y un evento Qt ya encolado no se puede retirar. Solucion:
+// una "deuda". Con la cola llena, el productor suma 1 a m_debt y encola
+// igualmente; el consumidor, antes de procesar cada chunk, paga la deuda
+// descartandolo. Como los chunks salen en orden, lo descartado es siempre
+// lo mas antiguo. El ring tiene el DOBLE de huecos que la capacidad
+// logica para que quepan los chunks pendientes de descartar; si ni asi
+// caben (consumidor parado), se descarta el nuevo. Con SignalCount se
+// aplica el mismo limite a los eventos en vuelo: un Generador sin QTimer
+// podria llenar la cola de eventos del Filtro sin fin.
+// ============================================================================
+
+#ifndef PIPELINECHANNEL_H
+#define PIPELINECHANNEL_H
+
+#include <QMutex>
+#include <QObject>
+#include <QWaitCondition>
+#include <atomic>
+#include <vector>
+#include "pipelinechunk.h"
+#include "spscring.h"
+
+class PipelineChannel
+{
+public:
+    static constexpr int BatchSize = 64;
+    static constexpr int MaxBatchesPerWakeup = 16;
+
+    enum class Kind { Ring, SignalCount };
+    // Mismo orden que ThreadPipeline::OverflowPolicy
+    enum class Overflow { Block, DropOldest, DropNewest };
+
+    PipelineChannel(int capacity, Overflow policy = Overflow::Block,
+                    Kind kind = Kind::Ring);
+
+    PipelineChannel(const PipelineChannel &) = delete;
+    PipelineChannel &operator=(const PipelineChannel &) = delete;
+
+    // Kind::Ring: slot (sin argumentos) del consumidor que vacia el canal.
+    // Se llama antes de arrancar los hilos.
+    void setConsumer(QObject *consumer, const char *drainSlot);
+
+    // ─── Lado productor ─────────────────────────────────────────────
+    // Kind::Ring: mueve el chunk al ring. false si se descarto (politica
+    // DropNewest o canal cerrado mientras esperaba).
+    bool push(PipelineChunk &&chunk);
+
+    // Kind::SignalCount: llamar antes de emitir. false = no emitir.
+    bool admit();
+
+    // ─── Lado consumidor ────────────────────────────────────────────
+    // Kind::Ring: saca lotes y llama process(PipelineChunk &) para cada chunk
+    template <typename Fn>
+    void drain(Fn &&process);
+
+    // Kind::SignalCount: llamar al recibir. false = descartar el chunk.
+    bool accept();
+
+    // Desbloquea a un productor en espera y rechaza los push siguientes
+    void close();
+
+    Kind kind() const { return m_kind; }
+    int capacity() const { return m_capacity; }
+
+    // ─── Contadores (seguros desde cualquier hilo) ──────────────────
+    int depth() const;
+    int peakDepth() const { return m_peak.load(std::memory_order_relaxed); }
+    quint64 dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    // Eventos drainInput() encolados (uno por rafaga)
+    quint64 wakeups() const { return m_wakeups.load(std::memory_order_relaxed); }
+
+private:
+    // Aplica la politica. false = descartar el chunk entrante
+    bool reserve();
+    // Chunks pendientes descontando la deuda de DropOldest
+    qint64 logicalDepth() const;
+    // Productor (Block): dormir hasta que ready() se cumpla. false = cerrado
+    template <typename Ready>
+    bool waitUntil(Ready ready);
+    // Consumidor: despertar al productor si esta esperando hueco
+    void notifySpace();
+    // Consumidor: true si este chunk paga deuda de DropOldest
+    bool payDebt();
+    std::size_t queued() const;
+    // Encola drainInput() salvo que ya haya uno pendiente
+    void requestDrain();
+
+    const int m_capacity;
+    const Overflow m_policy;
+    const Kind m_kind;
+
+    SpscRing<PipelineChunk> m_ring;
+    QObject *m_consumer = nullptr;
+    QByteArray m_drainSlot;
+
+    // Kind::SignalCount: chunks emitidos y aun no recibidos
+    std::atomic<qint64> m_inFlight{0};
+    // DropOldest: chunks encolados que el consumidor debe descartar
+    std::atomic<qint64> m_debt{0};
+
+    std::atomic<bool> m_wakePending{false};
+    std::atomic<bool> m_closed{false};
+    std::atomic<quint64> m_wakeups{0};
+    std::atomic<quint64> m_dropped{0};
+    std::atomic<int> m_peak{0};
+
+    // Block: el productor duerme aqui con la cola llena
+    QMutex m_spaceMutex;
+    QWaitCondition m_spaceFreed;
+    std::atomic<bool> m_producerWaiting{false};
+
+    // Buffer de lote: solo lo toca el consumidor
+    std::vector<PipelineChunk> m_batch;
+};
+
+template <typename Fn>
+void PipelineChannel::drain(Fn &&process)
+{
+    // Primero se baja el timbre: un push posterior volvera a avisar
+    m_wakePending.exchange(false, std::memory_order_acq_rel);
+
+    for (int round = 0; round < MaxBatchesPerWakeup; ++round) {
+        const std::size_t n = m_ring.popBatch(m_batch.data(), m_batch.size());
+        if (n == 0)
+            return;
+        notifySpace();
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!payDebt())
+                process(m_batch[i]);
+            m_batch[i] = PipelineChunk();   // Suelta la referencia ya
+        }
+    }
+
+    // Quedan datos: otra vuelta por el event loop
+    if (m_ring.sizeApprox() > 0)
+        requestDrain();
+}
+
+#endif // PIPELINECHANNEL_H
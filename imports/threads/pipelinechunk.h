@@ -0,0 +1,58 @@
+// ============================================================================
+// pipelinechunk.h - Unidad de datos que recorre el pipeline
+// ============================================================================
+//
+// Hasta ahora cada salto pasaba un QByteArray pelado. El Filtro necesita
+// contarle al Colector QUE patron encontro y DONDE, asi que el dato viaja
+// envuelto en un struct pequeno:
+//
+//   Generator  -> data, sequence, createdNs, enqueuedNs
+//   Filter     -> + matchPattern, matchOffset, enqueuedNs de nuevo
+//   Collector  <- lo guarda todo, en orden de sequence
+//
+// sequence numera los chunks en el orden en que los genero el Generador.
+// Con varios Filtros en paralelo cada uno termina a su ritmo: el Colector
+// usa sequence para devolverlos al orden original (ver ReorderBuffer).
+//
+// Un chunk SIN coincidencia (matchPattern < 0) que llega al Colector es un
+// MARCADOR DE PROGRESO: "este Filtro ya proceso hasta 'sequence'". No lleva
+// datos; solo lo emiten los Filtros en paralelo.
+//
+// createdNs y enqueuedNs son marcas de pipelineClockNs(): con ellas cada
+// etapa mide su espera en cola y la latencia extremo a extremo (ver
+// PipelineMetrics).
+//
+// Es un tipo valor barato de copiar (QByteArray es implicitly shared: una
+// copia es +1 a un contador) y se mueve por los rings sin copias.
+//
+// VIDA DE data: el Generador lo saca de su ChunkBufferPool y los bytes no
+// se copian ni se reservan de nuevo en todo el camino. Filtro y Colector
+// solo suman y restan referencias; cuando la ultima etapa lo suelta, el
+// hueco del pool vuelve a estar libre. El Colector copia las coincidencias
+// a la arena de RecordStore: un registro vive mucho mas que un chunk y, si
+// retuviera el buffer, el pool tendria que reservar otro.
+//
+// Q_DECLARE_METATYPE lo registra en el sistema de tipos de Qt: las
+// conexiones QueuedConnection necesitan poder copiar los argumentos para
+// encolarlos en el event loop del otro hilo.
+// ============================================================================
+
+#ifndef PIPELINECHUNK_H
+#define PIPELINECHUNK_H
+
+#include <QByteArray>
+#include <QMetaType>
+
+struct PipelineChunk
+{
+    QByteArray data;
+    quint64 sequence = 0;    // Orden de generacion (0, 1, 2...)
+    int matchPattern = -1;   // Indice del patron que encontro el Filtro
+    int matchOffset = -1;    // Byte de data donde empieza la coincidencia
+    qint64 createdNs = 0;    // El Generador empezo a construirlo
+    qint64 enqueuedNs = 0;   // Entro en la cola de la etapa actual
+};
+
+Q_DECLARE_METATYPE(PipelineChunk)
+
+#endif // PIPELINECHUNK_H
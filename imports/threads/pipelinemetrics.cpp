@@ -0,0 +1,147 @@
+// ============================================================================
+// pipelinemetrics.cpp - Implementacion de las metricas por etapa
+// ============================================================================
+
+#include "pipelinemetrics.h"
+#include <QJsonArray>
+
+void StageMetrics::reset()
+{
+    itemsBase = items.load(std::memory_order_relaxed);
+    service.reset();
+    queueWait.reset();
+}
+
+PipelineMetrics::PipelineMetrics()
+{
+    reset(1);
+}
+
+void PipelineMetrics::reset(int filterWorkers)
+{
+    m_filters.clear();
+    for (int i = 0; i < qMax(filterWorkers, 1); ++i)
+        m_filters.push_back(std::make_unique<StageMetrics>());
+    clear();
+}
+
+// Los workers pueden estar escribiendo: nada de lo que ellos escriben se
+// toca desde aqui (base de items en el lector, reset diferido en los
+// histogramas), asi que ninguna muestra en vuelo resucita valores viejos.
+void PipelineMetrics::clear()
+{
+    m_generator.reset();
+    for (const auto &filter : m_filters)
+        filter->reset();
+    m_collector.reset();
+    m_endToEnd.reset();
+
+    m_lastSampleNs = pipelineClockNs();
+    for (int stage = 0; stage < StageCount; ++stage) {
+        m_lastItems[stage] = 0;
+        m_itemsPerSec[stage] = 0.0;
+    }
+}
+
+QString PipelineMetrics::stageName(int stage)
+{
+    switch (stage) {
+    case Generator: return QStringLiteral("generator");
+    case Filter:    return QStringLiteral("filter");
+    default:        return QStringLiteral("collector");
+    }
+}
+
+quint64 PipelineMetrics::items(int stage) const
+{
+    if (stage == Generator)
+        return m_generator.itemCount();
+    if (stage == Collector)
+        return m_collector.itemCount();
+
+    quint64 total = 0;
+    for (const auto &filter : m_filters)
+        total += filter->itemCount();
+    return total;
+}
+
+// Los Filtros en paralelo se presentan como UNA etapa: histogramas sumados
+PipelineMetrics::StageSnapshot PipelineMetrics::snapshot(int stage) const
+{
+    StageSnapshot result;
+    result.items = items(stage);
+    if (stage == Filter) {
+        for (const auto &filter : m_filters) {
+            result.service.merge(filter->service.snapshot());
+            result.queueWait.merge(filter->queueWait.snapshot());
+        }
+    } else {
+        const StageMetrics &metrics = stage == Generator ? m_generator : m_collector;
+        result.service = metrics.service.snapshot();
+        result.queueWait = metrics.queueWait.snapshot();
+    }
+    return result;
+}
+
+void PipelineMetrics::sample()
+{
+    const qint64 nowNs = pipelineClockNs();
+    const qint64 intervalNs = nowNs - m_lastSampleNs;
+    if (intervalNs <= 0)
+        return;
+    m_lastSampleNs = nowNs;
+
+    for (int stage = 0; stage < StageCount; ++stage) {
+        const quint64 now = items(stage);
+        const quint64 delta = now >= m_lastItems[stage] ? now - m_lastItems[stage] : now;
+        m_itemsPerSec[stage] = double(delta) * 1e9 / double(intervalNs);
+        m_lastItems[stage] = now;
+    }
+}
+
+void PipelineMetrics::clearRates()
+{
+    for (double &rate : m_itemsPerSec)
+        rate = 0.0;
+}
+
+QVariantList PipelineMetrics::stages() const
+{
+    QVariantList list;
+    for (int stage = 0; stage < StageCount; ++stage) {
+        const StageSnapshot s = snapshot(stage);
+        QVariantMap map;
+        map[QStringLiteral("stage")] = stageName(stage);
+        map[QStringLiteral("items")] = double(s.items);
+        map[QStringLiteral("itemsPerSec")] = m_itemsPerSec[stage];
+        map[QStringLiteral("service")] = s.service.toVariantMap();
+        map[QStringLiteral("queueWait")] = s.queueWait.toVariantMap();
+        list.append(map);
+    }
+    return list;
+}
+
+QVariantMap PipelineMetrics::endToEndStats() const
+{
+    return m_endToEnd.snapshot().toVariantMap();
+}
+
+QJsonObject PipelineMetrics::toJson() const
+{
+    QJsonArray stageList;
+    for (int stage = 0; stage < StageCount; ++stage) {
+        const StageSnapshot s = snapshot(stage);
+        QJsonObject json;
+        json[QStringLiteral("stage")] = stageName(stage);
+        json[QStringLiteral("items")] = double(s.items);
+        json[QStringLiteral("itemsPerSec")] = m_itemsPerSec[stage];
+        s.service.writeJson(json, QStringLiteral("service"));
+        s.queueWait.writeJson(json, QStringLiteral("queueWait"));
+        stageList.append(json);
+    }
+
+    QJsonObject json;
+    json[QStringLiteral("stages")] = stageList;
+    m_endToEnd.snapshot().writeJson(json, QStringLiteral("endToEnd"));
+    return json;
+}
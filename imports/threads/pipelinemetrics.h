@@ -0,0 +1,126 @@
+// ============================================================================
+// pipelinemetrics.h - Latencia y rendimiento de cada etapa del pipeline
+// ============================================================================
+//
+// Los contadores de ThreadPipeline dicen CUANTO paso por cada etapa, no
+// CUANTO TARDO. Para eso cada chunk lleva dos marcas del mismo reloj
+// monotono (pipelineClockNs(), comun a todos los hilos):
+//
+//   createdNs:  el Generador empieza a construirlo
+//   enqueuedNs: se deja en la cola de la etapa siguiente (se reescribe en
+//               cada salto)
+//
+// y cada etapa registra, en SU hilo:
+//
+//   Generator   service = construir el chunk
+//   Filter      queueWait = sacarlo de la cola - enqueuedNs
+//               service   = buscar los patrones
+//   Collector   queueWait = llegada - enqueuedNs        (solo coincidencias)
+//               service   = guardarlo en el RecordStore
+//               endToEnd  = guardado - createdNs        (incluye la espera
+//                                                         en el ReorderBuffer)
+//
+//   [Generator] --cola--> [Filter] --cola--> [Collector]
+//   |service|   |wait|    |service| |wait|   |service|
+//   |<------------------- endToEnd ------------------>|
+//
+// HILOS: cada StageMetrics tiene un unico escritor (con N Filtros hay N).
+// ThreadPipeline los crea antes de arrancar los hilos y los lee a 10 Hz
+// (sample()); los Filtros se agregan sumando sus histogramas.
+// ============================================================================
+
+#ifndef PIPELINEMETRICS_H
+#define PIPELINEMETRICS_H
+
+#include <QJsonObject>
+#include <QString>
+#include <QVariantList>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "stagehistogram.h"
+
+// Reloj monotono comun a todos los hilos (un QElapsedTimer es por objeto)
+inline qint64 pipelineClockNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct StageMetrics
+{
+    std::atomic<quint64> items{0};
+    StageHistogram service;
+    StageHistogram queueWait;
+
+    // Solo desde el hilo de la etapa
+    void countItem()
+    {
+        items.store(items.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    // Solo desde el hilo lector. items nunca se pone a 0 (el escritor hace
+    // load + store y pisaria el 0): reset() guarda la base y itemCount()
+    // la resta. Los histogramas aplican su propio reset diferido.
+    quint64 itemCount() const { return items.load(std::memory_order_relaxed) - itemsBase; }
+    void reset();
+
+    quint64 itemsBase = 0;
+};
+
+class PipelineMetrics
+{
+public:
+    enum Stage { Generator, Filter, Collector, StageCount };
+
+    PipelineMetrics();
+
+    // Hilo principal, con los workers parados: un StageMetrics por Filtro
+    void reset(int filterWorkers);
+    // Vacia los histogramas sin parar el pipeline
+    void clear();
+
+    StageMetrics *generator() { return &m_generator; }
+    StageMetrics *filter(int index) { return m_filters.at(std::size_t(index)).get(); }
+    StageMetrics *collector() { return &m_collector; }
+    StageHistogram *endToEnd() { return &m_endToEnd; }
+
+    // Hilo principal (timer de muestreo): items/s desde la muestra anterior
+    void sample();
+    // Pipeline parado: items/s a 0, los histogramas se conservan
+    void clearRates();
+
+    // [{ stage, items, itemsPerSec, service: {...}, queueWait: {...} }]
+    // service/queueWait: ver StageHistogram::Snapshot::toVariantMap()
+    QVariantList stages() const;
+    QVariantMap endToEndStats() const;
+    // { stages: [{ stage, items, itemsPerSec, serviceP50Ns..., queueWaitP50Ns... }],
+    //   endToEndSamples, endToEndP50Ns, ... }
+    QJsonObject toJson() const;
+
+    // "generator", "filter", "collector"
+    static QString stageName(int stage);
+
+private:
+    struct StageSnapshot {
+        quint64 items = 0;
+        StageHistogram::Snapshot service;
+        StageHistogram::Snapshot queueWait;
+    };
+
+    StageSnapshot snapshot(int stage) const;
+    quint64 items(int stage) const;
+
+    StageMetrics m_generator;
+    std::vector<std::unique_ptr<StageMetrics>> m_filters;
+    StageMetrics m_collector;
+    StageHistogram m_endToEnd;
+
+    // Estado del muestreo (solo hilo principal)
+    qint64 m_lastSampleNs = 0;
+    quint64 m_lastItems[StageCount] = {};
+    double m_itemsPerSec[StageCount] = {};
+};
+
+#endif // PIPELINEMETRICS_H
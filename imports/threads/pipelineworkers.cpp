@@ -8,19 +8,26 @@
 // Flujo del pipeline:
 //   GeneratorWorker::generate()  [Hilo 1]
 //        |
-//        | emit dataGenerated(data)  -- signal cross-thread (QueuedConnection) -->
+//        | emit dataGenerated(chunk) -- signal cross-thread (QueuedConnection) -->
 //        v
 //   FilterWorker::processData()  [Hilo 2]
 //        |
-//        | emit dataMatched(data)    -- signal cross-thread (QueuedConnection) -->
+//        | emit dataMatched(chunk)   -- signal cross-thread (QueuedConnection) -->
 //        v
 //   CollectorWorker::collectData()  [Hilo 3]
+//
+// Con N Filtros el Generador reparte por sequence % N y el Colector
+// recibe de los N, reordenando con ReorderBuffer antes de guardar.
 // ============================================================================
 
 #include "pipelineworkers.h"
+#include "pipelinechannel.h"
+#include "pipelinemetrics.h"
+#include "recordstore.h"
+#include "segmentlog.h"
+#include <QMetaObject>
+#include <QRandomGenerator>
 #include <QThread>
-#include <QMutexLocker>
-#include <QVariantMap>
 
 // ============================================================================
 // GeneratorWorker - Produce datos aleatorios en el Hilo 1
@@ -29,6 +36,7 @@
 GeneratorWorker::GeneratorWorker(QObject *parent)
     : QObject(parent)
     , m_timer(this)   // Parent timer to worker so moveToThread() moves both
+    , m_rng(QRandomGenerator::global()->generate64())
 {
     m_timer.setInterval(m_interval);
     // Esta conexion timer->generate es DIRECTA (mismo hilo).
@@ -42,6 +50,7 @@ GeneratorWorker::GeneratorWorker(QObject *parent)
 void GeneratorWorker::start()
 {
     m_count = 0;
+    m_sequence = 0;
     // QThread::currentThreadId() devuelve el ID del hilo ACTUAL de ejecucion,
     // que aqui es el Hilo 1 (no el principal), confirmando que moveToThread funciono.
     emit threadIdReady(QStringLiteral("0x%1")
@@ -54,30 +63,79 @@ void GeneratorWorker::stop()
     m_timer.stop();
 }
 
+// En modo libre el intervalo se guarda pero el timer sigue a 0 ms
 void GeneratorWorker::setInterval(int ms)
 {
     m_interval = ms;
-    m_timer.setInterval(ms);
+    if (!m_freeRunning)
+        m_timer.setInterval(ms);
+}
+
+void GeneratorWorker::setFreeRunning(bool enabled, int batchSize)
+{
+    m_freeRunning = enabled;
+    m_batchSize = enabled ? qMax(batchSize, 1) : 1;
+    m_timer.setInterval(enabled ? 0 : m_interval);
 }
 
 // generate() se llama cada vez que el QTimer dispara (en el Hilo 1).
-// Crea un array de bytes aleatorio y emite dataGenerated(), que cruza
-// al Hilo 2 via QueuedConnection automatica.
+// Genera un chunk (o un lote en modo libre) y lo envia al Filtro; con
+// signal/slot la llamada cruza al Hilo 2 via QueuedConnection automatica.
+//
+// countChanged() va por QueuedConnection al hilo principal: en modo libre
+// se emite una vez por lote, no cada 50 chunks.
 void GeneratorWorker::generate()
 {
-    std::uniform_int_distribution<int> lenDist(1, 100);
-    std::uniform_int_distribution<int> byteDist(0, 255);
+    for (int i = 0; i < m_batchSize; ++i)
+        generateChunk();
 
-    int len = lenDist(m_rng);
-    QByteArray data(len, Qt::Uninitialized);
-    for (int i = 0; i < len; ++i)
-        data[i] = static_cast<char>(byteDist(m_rng));
+    if (m_freeRunning || m_count % 50 == 0)
+        emit countChanged(m_count);
+}
 
-    emit dataGenerated(data);
+// El chunk sale con dos marcas de tiempo: cuando se empezo a construir
+// (createdNs, para la latencia extremo a extremo) y cuando entra en la
+// cola del Filtro (enqueuedNs, para su espera en cola).
+void GeneratorWorker::generateChunk()
+{
+    PipelineChunk chunk;
+    chunk.createdNs = pipelineClockNs();
+    const qsizetype len = 1 + qsizetype(m_rng.below(100));
+    chunk.data = m_pool.take(len, [this](char *data, qsizetype size) {
+        m_rng.fill(data, size);
+    });
+    chunk.sequence = m_sequence++;
+    chunk.enqueuedNs = pipelineClockNs();
+    if (m_metrics) {
+        m_metrics->service.record(chunk.enqueuedNs - chunk.createdNs);
+        m_metrics->countItem();
+    }
 
+    dispatch(std::move(chunk));
     ++m_count;
-    if (m_count % 50 == 0)
-        emit countChanged(m_count);
+}
+
+// Reparto por turno: sequence % N. Es determinista, asi el Colector sabe
+// de que Filtro tiene que llegar cada sequence (ver ReorderBuffer).
+void GeneratorWorker::dispatch(PipelineChunk &&chunk)
+{
+    const int shard = m_outputs.isEmpty()
+        ? 0 : int(chunk.sequence % quint64(m_outputs.size()));
+    PipelineChannel *output = m_outputs.value(shard);
+
+    // Con la cola del Filtro llena, la politica decide (ver PipelineChannel)
+    if (output && output->kind() == PipelineChannel::Kind::Ring) {
+        output->push(std::move(chunk));
+        return;
+    }
+    if (output && !output->admit())
+        return;
+
+    if (m_receivers.size() > 1)
+        QMetaObject::invokeMethod(m_receivers.at(shard), "processData",
+            Qt::QueuedConnection, Q_ARG(PipelineChunk, chunk));
+    else
+        emit dataGenerated(chunk);
 }
 
 // ============================================================================
@@ -87,12 +145,16 @@ void GeneratorWorker::generate()
 FilterWorker::FilterWorker(QObject *parent)
     : QObject(parent)
 {
+    // Patron por defecto: {00 01 02}
+    m_matcher.setPatterns({ PatternMatcher::literal(QByteArray("\x00\x01\x02", 3)) });
 }
 
 void FilterWorker::start()
 {
-    m_processedCount = 0;
-    m_matchedCount = 0;
+    m_processedCount.store(0, std::memory_order_relaxed);
+    m_matchedCount.store(0, std::memory_order_relaxed);
+    m_busyNs.store(0, std::memory_order_relaxed);
+    m_clock.start();
     emit threadIdReady(QStringLiteral("0x%1")
         .arg(reinterpret_cast<quintptr>(QThread::currentThreadId()), 0, 16));
 }
@@ -101,24 +163,104 @@ void FilterWorker::start()
 // dataGenerated(). Qt encolo la llamada automaticamente porque emisor
 // (Hilo 1) y receptor (Hilo 2) estan en hilos diferentes.
 //
-// El filtro busca si los datos contienen el patron m_pattern.
-// Solo los datos que coinciden se reenvian al Colector via dataMatched().
-void FilterWorker::processData(const QByteArray &data)
+// Con una cola acotada, accept() puede mandar descartar el chunk: es el
+// mas antiguo y la politica DropOldest ya lo habia condenado.
+void FilterWorker::processData(const PipelineChunk &chunk)
+{
+    if (m_input && !m_input->accept())
+        return;
+
+    const qint64 begin = m_clock.nsecsElapsed();
+    filterChunk(chunk);
+    // Cola vacia: el Colector no debe esperar al siguiente chunk para
+    // saber que este no coincidio
+    if (!m_input || m_input->depth() == 0)
+        flushProgress();
+    m_busyNs.fetch_add(m_clock.nsecsElapsed() - begin, std::memory_order_relaxed);
+}
+
+// El filtro recorre el chunk UNA vez con el automata de todos los patrones.
+// Solo los datos que coinciden se reenvian al Colector via dataMatched(),
+// anotando el patron y el offset de la coincidencia.
+//
+// Una coincidencia ya dice al Colector hasta donde llego este Filtro. Los
+// chunks sin coincidencia solo se cuentan; con marcadores activos, cada
+// ProgressInterval se manda un marcador para que el Colector no retenga
+// las coincidencias de los demas Filtros indefinidamente.
+//
+// Con metricas, dos lecturas del reloj por chunk: al sacarlo de la cola
+// (espera = ahora - enqueuedNs) y al terminar la busqueda (servicio). La
+// segunda es tambien el enqueuedNs de la coincidencia en la cola del
+// Colector.
+void FilterWorker::filterChunk(const PipelineChunk &chunk)
 {
-    ++m_processedCount;
+    const qint64 begin = m_metrics ? pipelineClockNs() : 0;
+    m_processedCount.fetch_add(1, std::memory_order_relaxed);
+    m_lastSequence = chunk.sequence;
 
-    if (data.contains(m_pattern)) {
-        ++m_matchedCount;
-        emit dataMatched(data);
+    const PatternMatcher::Match match = m_matcher.findFirst(chunk.data);
+    qint64 end = 0;
+    if (m_metrics) {
+        end = pipelineClockNs();
+        m_metrics->queueWait.record(begin - chunk.enqueuedNs);
+        m_metrics->service.record(end - begin);
+        m_metrics->countItem();
     }
 
-    if (m_processedCount % 50 == 0)
-        emit statsChanged(m_processedCount, m_matchedCount);
+    if (match.isValid()) {
+        m_matchedCount.fetch_add(1, std::memory_order_relaxed);
+        PipelineChunk matched = chunk;   // Copia = +1 referencia al QByteArray
+        matched.matchPattern = match.pattern;
+        matched.matchOffset = match.offset;
+        matched.enqueuedNs = end;
+        forward(std::move(matched));
+        m_unreported = 0;
+    } else if (m_progressMarkers && ++m_unreported >= ProgressInterval) {
+        flushProgress();
+    }
+}
+
+void FilterWorker::forward(PipelineChunk &&chunk)
+{
+    if (m_output && m_output->kind() == PipelineChannel::Kind::Ring)
+        m_output->push(std::move(chunk));
+    else if (!m_output || m_output->admit())
+        emit dataMatched(chunk);
 }
 
-void FilterWorker::setFilterPattern(const QByteArray &pattern)
+void FilterWorker::flushProgress()
 {
-    m_pattern = pattern;
+    if (!m_progressMarkers || m_unreported == 0)
+        return;
+    PipelineChunk marker;
+    marker.sequence = m_lastSequence;
+    forward(std::move(marker));
+    m_unreported = 0;
+}
+
+// drainInput() lo encola PipelineChannel en el Hilo 2 (uno por rafaga).
+// Vacia el ring por lotes pasando cada chunk por el mismo filterChunk().
+// Al acabar la rafaga se avisa del progreso (un marcador, no uno por chunk).
+void FilterWorker::drainInput()
+{
+    const qint64 begin = m_clock.nsecsElapsed();
+    m_input->drain([this](PipelineChunk &chunk) { filterChunk(chunk); });
+    flushProgress();
+    m_busyNs.fetch_add(m_clock.nsecsElapsed() - begin, std::memory_order_relaxed);
+}
+
+// Reconstruir el automata cuesta microsegundos por patron: se hace aqui,
+// en el Hilo 2, entre dos chunks. Nunca hay un automata a medias.
+void FilterWorker::setFilterPatterns(const QStringList &patterns)
+{
+    QList<PatternMatcher::Pattern> parsed;
+    parsed.reserve(patterns.size());
+    for (const QString &spec : patterns) {
+        PatternMatcher::Pattern pattern;
+        if (PatternMatcher::parse(spec, pattern))
+            parsed.append(pattern);
+    }
+    m_matcher.setPatterns(parsed);
 }
 
 // ============================================================================
@@ -130,6 +272,12 @@ CollectorWorker::CollectorWorker(QObject *parent)
 {
 }
 
+void CollectorWorker::setInputs(const QList<PipelineChannel *> &channels)
+{
+    m_inputs = channels;
+    m_reorder.reset(int(channels.size()));
+}
+
 void CollectorWorker::start()
 {
     emit threadIdReady(QStringLiteral("0x%1")
@@ -138,56 +286,56 @@ void CollectorWorker::start()
 
 // collectData() se ejecuta en el Hilo 3. Almacena el dato filtrado
 // con un timestamp UTC.
-//
-// USO DE QMutex:
-// QMutexLocker bloquea el mutex al crearse y lo desbloquea al destruirse
-// (patron RAII). Esto protege m_records porque otros hilos pueden llamar
-// a recordCount() o getRecords() en cualquier momento.
-//
-// Nota: hacemos lock.unlock() ANTES de emitir signals para minimizar el
-// tiempo que el mutex esta bloqueado. Las signals no acceden a m_records,
-// asi que no necesitan el mutex.
-void CollectorWorker::collectData(const QByteArray &data)
+void CollectorWorker::collectData(const PipelineChunk &chunk)
 {
-    QMutexLocker lock(&m_mutex);
-
-    if (m_records.size() >= MaxRecords)
-        m_records.removeFirst();
-
-    m_records.append({data, QDateTime::currentDateTimeUtc()});
-    int count = m_records.size();
-    lock.unlock();
-
-    QString timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODateWithMs);
-    QString hex = data.toHex(' ').left(120);
-    emit recordAdded(timestamp, hex, data.size());
-    emit recordCountChanged(count);
+    // Cada chunk llego por la cola de su Filtro: sequence % N
+    PipelineChannel *input = m_inputs.isEmpty()
+        ? nullptr : m_inputs.at(int(chunk.sequence % quint64(m_inputs.size())));
+    if (input && !input->accept())
+        return;
+    deliver(PipelineChunk(chunk));
 }
 
-// Estos metodos se llaman desde el hilo principal (QML). Por eso necesitan
-// QMutexLocker para acceder a m_records de forma thread-safe.
-int CollectorWorker::recordCount() const
+// Con un solo Filtro los chunks ya llegan en orden: se guardan directamente.
+// La espera en cola se mide aqui, a la llegada: lo que la coincidencia pase
+// despues en el ReorderBuffer solo cuenta en la latencia extremo a extremo.
+void CollectorWorker::deliver(PipelineChunk &&chunk)
 {
-    QMutexLocker lock(&m_mutex);
-    return m_records.size();
+    if (m_metrics && chunk.matchPattern >= 0)
+        m_metrics->queueWait.record(pipelineClockNs() - chunk.enqueuedNs);
+
+    if (m_reorder.shards() <= 1) {
+        if (chunk.matchPattern >= 0)
+            storeChunk(chunk);
+        return;
+    }
+    m_reorder.offer(std::move(chunk), [this](PipelineChunk &ready) { storeChunk(ready); });
+    m_reorderPending.store(int(m_reorder.pending()), std::memory_order_relaxed);
 }
 
-QVariantList CollectorWorker::getRecords() const
+// RecordStore::append() toma su propio mutex y no reserva memoria: copia
+// los bytes a la arena. No hay signal por registro; el modelo se entera en
+// su siguiente refresh().
+void CollectorWorker::storeChunk(const PipelineChunk &chunk)
 {
-    QMutexLocker lock(&m_mutex);
-    QVariantList list;
-    for (const auto &r : m_records) {
-        QVariantMap map;
-        map[QStringLiteral("timestamp")] = r.timestamp.toString(Qt::ISODateWithMs);
-        map[QStringLiteral("hex")] = r.data.toHex(' ').left(120);
-        map[QStringLiteral("size")] = r.data.size();
-        list.append(map);
+    if (!m_store)
+        return;
+    const qint64 begin = m_metrics ? pipelineClockNs() : 0;
+    m_store->append(chunk);
+    if (m_log)
+        m_log->append(chunk);
+    if (m_metrics) {
+        const qint64 end = pipelineClockNs();
+        m_metrics->service.record(end - begin);
+        m_endToEnd->record(end - chunk.createdNs);
+        m_metrics->countItem();
     }
-    return list;
 }
 
-void CollectorWorker::clearRecords()
+// Cada cola avisa por su cuenta, pero basta con vaciarlas todas: un aviso
+// que llegue despues solo encontrara su cola vacia.
+void CollectorWorker::drainInput()
 {
-    QMutexLocker lock(&m_mutex);
-    m_records.clear();
+    for (PipelineChannel *input : std::as_const(m_inputs))
+        input->drain([this](PipelineChunk &chunk) { deliver(std::move(chunk)); });
 }
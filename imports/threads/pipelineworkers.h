@@ -29,6 +29,23 @@
 // En este pipeline tenemos 3 workers, cada uno en su propio hilo:
 //   [Generador] --signal--> [Filtro] --signal--> [Colector]
 //     Hilo 1                  Hilo 2               Hilo 3
+//
+// FILTROS EN PARALELO (ThreadPipeline::filterWorkers > 1):
+//   El Filtro es la etapa cara, asi que puede haber N, cada uno en su
+//   hilo. El Generador numera los chunks (sequence) y los reparte por
+//   turno; el Colector los devuelve al orden original (ReorderBuffer).
+//
+//                 +--> [Filtro 0] --+
+//   [Generador] --+--> [Filtro 1] --+--> [Colector + ReorderBuffer]
+//                 +--> [Filtro N-1] +
+//
+// COLAS ACOTADAS (PipelineChannel):
+//   setOutput(s)()/setInput(s)() enlazan cada salto con un PipelineChannel
+//   que limita los chunks pendientes y aplica la politica de
+//   desbordamiento.
+//   Con ThreadPipeline::SignalSlot el chunk sigue viajando por signal (el
+//   canal solo cuenta); con ThreadPipeline::SpscRings viaja por el ring y
+//   el consumidor recibe un drainInput() por rafaga.
 // ============================================================================
 
 #ifndef PIPELINEWORKERS_H
@@ -36,11 +53,22 @@
 
 #include <QObject>
 #include <QByteArray>
-#include <QDateTime>
+#include <QElapsedTimer>
 #include <QList>
-#include <QMutex>
+#include <QStringList>
 #include <QTimer>
-#include <random>
+#include <atomic>
+#include "chunkbufferpool.h"
+#include "fastrandom.h"
+#include "patternmatcher.h"
+#include "pipelinechunk.h"
+#include "reorderbuffer.h"
+
+class PipelineChannel;
+class RecordStore;
+class SegmentLog;
+class StageHistogram;
+struct StageMetrics;
 
 // ============================================================================
 // GeneratorWorker - Hilo 1: Generador de datos
@@ -52,6 +80,17 @@
 // Cuando hacemos moveToThread() sobre el worker, Qt mueve automaticamente
 // todos los hijos tambien. Esto es CRITICO porque QTimer debe vivir en el
 // mismo hilo que su padre para funcionar correctamente.
+//
+// MODO LIBRE (setFreeRunning): con un QTimer de intervalo N ms el pipeline
+// nunca pasa de ~1000 chunks/s y el cuello de botella es el timer. En modo
+// libre el timer tiene intervalo 0 (salta en cada vuelta del event loop) y
+// cada disparo genera un LOTE de batchSize chunks. Entre lotes el event
+// loop atiende stop(), setInterval() y quit(). Con la politica Block, la
+// cola llena del Filtro frena al Generador.
+//
+// Los bytes salen de un xoshiro256** (8 bytes por llamada, ver
+// fastrandom.h) y se escriben en buffers de un ChunkBufferPool: sin
+// reservas de memoria mientras el pool cubra los chunks en vuelo.
 
 class GeneratorWorker : public QObject
 {
@@ -60,6 +99,23 @@ class GeneratorWorker : public QObject
 public:
     explicit GeneratorWorker(QObject *parent = nullptr);
 
+    // Colas acotadas hacia los Filtros, una por Filtro: el chunk con
+    // sequence s va a la cola s % N (modo ring: sustituye a dataGenerated)
+    void setOutputs(const QList<PipelineChannel *> &channels) { m_outputs = channels; }
+    // Modo signal/slot con varios Filtros: una signal llegaria a todos, asi
+    // que se invoca processData() directamente en el Filtro que toca
+    void setShardReceivers(const QList<QObject *> &receivers) { m_receivers = receivers; }
+    // Antes de start(): lotes de batchSize chunks sin esperar al QTimer
+    void setFreeRunning(bool enabled, int batchSize);
+    // Huecos del pool: deben cubrir los chunks en vuelo (colas + lote)
+    void setPoolSlots(int slots) { m_pool.reset(slots); }
+
+    // ─── Pool (seguros desde cualquier hilo) ────────────────────────
+    quint64 poolHits() const { return m_pool.hits(); }
+    quint64 poolMisses() const { return m_pool.misses(); }
+    // Tiempo de construir cada chunk y chunks generados (ver PipelineMetrics)
+    void setMetrics(StageMetrics *metrics) { m_metrics = metrics; }
+
 public slots:
     void start();
     void stop();
@@ -69,7 +125,7 @@ signals:
     // Esta signal cruza la frontera de hilos: se emite en el Hilo 1
     // y se recibe en el Hilo 2 (FilterWorker::processData).
     // Qt usa QueuedConnection automaticamente -> thread-safe.
-    void dataGenerated(const QByteArray &data);
+    void dataGenerated(const PipelineChunk &chunk);
     void countChanged(int count);
     void threadIdReady(const QString &threadId);
 
@@ -77,20 +133,38 @@ private slots:
     void generate();
 
 private:
+    void generateChunk();
+    // Envia el chunk al Filtro de su shard (sequence % N)
+    void dispatch(PipelineChunk &&chunk);
+
     QTimer m_timer;
-    std::mt19937 m_rng{std::random_device{}()};
+    QList<PipelineChannel *> m_outputs;
+    QList<QObject *> m_receivers;
+    StageMetrics *m_metrics = nullptr;
+    Xoshiro256 m_rng;
+    ChunkBufferPool m_pool;
+    quint64 m_sequence = 0;
     int m_count = 0;
     int m_interval = 10;
+    bool m_freeRunning = false;
+    int m_batchSize = 1;
 };
 
 // ============================================================================
 // FilterWorker - Hilo 2: Filtro de datos
 // ============================================================================
-// Recibe arrays de bytes, busca un patron objetivo, y reenvia los que coinciden.
+// Recibe arrays de bytes, busca un conjunto de patrones (PatternMatcher,
+// Aho-Corasick: una pasada por chunk con 1 o 1000 patrones) y reenvia los
+// que coinciden anotando que patron coincidio y en que offset.
 // El slot processData() se invoca via QueuedConnection cross-thread:
 // el Generador emite dataGenerated() en el Hilo 1, y Qt encola la llamada
 // a processData() en el event loop del Hilo 2. Asi el filtrado ocurre en
 // un hilo separado sin bloquear ni al generador ni al GUI.
+//
+// Con varios Filtros en paralelo, cada uno avisa al Colector de hasta
+// donde ha llegado aunque no encuentre nada (marcadores de progreso, ver
+// ReorderBuffer). Sus contadores son atomicos: ThreadPipeline los muestrea
+// desde el hilo principal para calcular la carga de cada Filtro.
 
 class FilterWorker : public QObject
 {
@@ -99,21 +173,54 @@ class FilterWorker : public QObject
 public:
     explicit FilterWorker(QObject *parent = nullptr);
 
+    // Maximo de chunks sin coincidencia antes de un marcador de progreso
+    static constexpr int ProgressInterval = 64;
+
+    // Colas acotadas de entrada y salida
+    void setInput(PipelineChannel *channel) { m_input = channel; }
+    void setOutput(PipelineChannel *channel) { m_output = channel; }
+    // Solo hacen falta con varios Filtros (el Colector tiene que reordenar)
+    void setProgressMarkers(bool enabled) { m_progressMarkers = enabled; }
+    // Espera en cola y tiempo de busqueda por chunk. Sin metricas (los
+    // benchmarks) no se lee el reloj.
+    void setMetrics(StageMetrics *metrics) { m_metrics = metrics; }
+
+    // ─── Contadores (seguros desde cualquier hilo) ──────────────────
+    int processedCount() const { return m_processedCount.load(std::memory_order_relaxed); }
+    int matchedCount() const { return m_matchedCount.load(std::memory_order_relaxed); }
+    // Tiempo dentro de processData()/drainInput(): carga = busy / reloj
+    qint64 busyNs() const { return m_busyNs.load(std::memory_order_relaxed); }
+
 public slots:
     void start();
-    void processData(const QByteArray &data);
-    void setFilterPattern(const QByteArray &pattern);
+    void processData(const PipelineChunk &chunk);
+    void drainInput();
+    // Patrones en texto (ver PatternMatcher::parse); los invalidos se ignoran
+    void setFilterPatterns(const QStringList &patterns);
 
 signals:
     // Signal cross-thread: Hilo 2 -> Hilo 3
-    void dataMatched(const QByteArray &data);
-    void statsChanged(int processed, int matched);
+    // Tambien lleva los marcadores de progreso (matchPattern < 0)
+    void dataMatched(const PipelineChunk &chunk);
     void threadIdReady(const QString &threadId);
 
 private:
-    QByteArray m_pattern{"\x00\x01\x02", 3};
-    int m_processedCount = 0;
-    int m_matchedCount = 0;
+    void filterChunk(const PipelineChunk &chunk);
+    void forward(PipelineChunk &&chunk);
+    // Marcador con el ultimo sequence procesado, si hay algo sin avisar
+    void flushProgress();
+
+    PipelineChannel *m_input = nullptr;
+    PipelineChannel *m_output = nullptr;
+    StageMetrics *m_metrics = nullptr;
+    PatternMatcher m_matcher;
+    QElapsedTimer m_clock;
+    bool m_progressMarkers = false;
+    int m_unreported = 0;
+    quint64 m_lastSequence = 0;
+    std::atomic<int> m_processedCount{0};
+    std::atomic<int> m_matchedCount{0};
+    std::atomic<qint64> m_busyNs{0};
 };
 
 // ============================================================================
@@ -121,14 +228,19 @@ private:
 // ============================================================================
 // Recolecta datos que pasaron el filtro y los almacena con timestamp.
 //
-// PROTECCION CON QMutex:
-// La lista m_records se escribe desde el Hilo 3 (collectData) pero se LEE
-// desde el hilo principal/QML (getRecords, recordCount, clearRecords).
-// Las signals cross-thread son thread-safe automaticamente, pero el acceso
-// directo a datos compartidos (como leer m_records desde otro hilo) SI
-// necesita proteccion con mutex.
+// DATOS COMPARTIDOS:
+// Los registros se escriben en un RecordStore (de ThreadPipeline) desde el
+// Hilo 3 y se LEEN desde el hilo principal (RecordListModel). Las signals
+// cross-thread son thread-safe automaticamente, pero el acceso directo a
+// datos compartidos SI necesita proteccion: el QMutex vive en RecordStore.
+// Por eso el Colector ya no emite una signal por registro; el modelo lee el
+// store cuando le toca refrescar.
+//
+// Con varios Filtros recibe de N colas y pasa todo por un ReorderBuffer:
+// los registros se guardan en el orden en que se generaron.
 //
-// "mutable QMutex" permite usar el mutex en metodos const (como recordCount).
+// Si hay un SegmentLog abierto, cada registro se anade ademas al log en
+// disco (un memcpy a un segmento mapeado, ver SegmentLog).
 
 class CollectorWorker : public QObject
 {
@@ -137,28 +249,42 @@ class CollectorWorker : public QObject
 public:
     explicit CollectorWorker(QObject *parent = nullptr);
 
-    int recordCount() const;
-    QVariantList getRecords() const;
-    void clearRecords();
+    // Donde se guardan las coincidencias (propiedad de ThreadPipeline)
+    void setStore(RecordStore *store) { m_store = store; }
+    // Copia persistente en disco; no escribe mientras este cerrado
+    void setLog(SegmentLog *log) { m_log = log; }
+    // Espera en cola, tiempo de guardado y latencia extremo a extremo
+    void setMetrics(StageMetrics *metrics, StageHistogram *endToEnd)
+    {
+        m_metrics = metrics;
+        m_endToEnd = endToEnd;
+    }
+
+    // Colas acotadas de entrada, una por Filtro (en orden de shard)
+    void setInputs(const QList<PipelineChannel *> &channels);
+    // Coincidencias retenidas esperando a un Filtro mas lento
+    int reorderPending() const { return m_reorderPending.load(std::memory_order_relaxed); }
 
 public slots:
     void start();
-    void collectData(const QByteArray &data);
+    void collectData(const PipelineChunk &chunk);
+    void drainInput();
 
 signals:
-    void recordAdded(const QString &timestamp, const QString &hexData, int size);
-    void recordCountChanged(int count);
     void threadIdReady(const QString &threadId);
 
 private:
-    struct Record {
-        QByteArray data;
-        QDateTime timestamp;
-    };
-
-    mutable QMutex m_mutex;
-    QList<Record> m_records;
-    static constexpr int MaxRecords = 500;
+    // Reordena (si hay varios Filtros) y guarda las coincidencias
+    void deliver(PipelineChunk &&chunk);
+    void storeChunk(const PipelineChunk &chunk);
+
+    QList<PipelineChannel *> m_inputs;
+    ReorderBuffer m_reorder;
+    std::atomic<int> m_reorderPending{0};
+    RecordStore *m_store = nullptr;
+    SegmentLog *m_log = nullptr;
+    StageMetrics *m_metrics = nullptr;
+    StageHistogram *m_endToEnd = nullptr;
 };
 
 #endif // PIPELINEWORKERS_H
@@ -0,0 +1,135 @@
+// ============================================================================
+// recordlistmodel.cpp - Implementacion del modelo de registros
+// ============================================================================
+
+#include "recordlistmodel.h"
+#include <QDateTime>
+#include <QTimeZone>
+
+RecordListModel::RecordListModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+    m_generation = m_store.window().generation;
+}
+
+int RecordListModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+int RecordListModel::count() const { return m_rows; }
+int RecordListModel::capacity() const { return m_store.capacity(); }
+
+// ============================================================================
+// data() - Formateo perezoso: solo para filas que QML pide
+// ============================================================================
+QVariant RecordListModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows)
+        return {};
+
+    const quint64 id = m_total - 1 - quint64(index.row());
+    if (role == HexDataRole)
+        return m_store.hex(id, HexPreviewBytes);
+
+    RecordStore::Record record;
+    const bool live = m_store.record(id, record);
+    switch (role) {
+    case TimestampRole:
+        if (!live)
+            return QString();
+        return QDateTime::fromMSecsSinceEpoch(record.timestampMs, QTimeZone::UTC)
+            .toString(Qt::ISODateWithMs);
+    case ByteSizeRole:
+        return record.size;
+    case PatternIndexRole:
+        return record.pattern;
+    case MatchOffsetRole:
+        return record.offset;
+    case SequenceRole:
+        return qint64(record.sequence);
+    default:
+        return {};
+    }
+}
+
+QHash<int, QByteArray> RecordListModel::roleNames() const
+{
+    return {
+        { TimestampRole,    "timestamp" },
+        { HexDataRole,      "hexData" },
+        { ByteSizeRole,     "byteSize" },
+        { PatternIndexRole, "patternIndex" },
+        { MatchOffsetRole,  "matchOffset" },
+        { SequenceRole,     "sequence" }
+    };
+}
+
+// ============================================================================
+// refresh() - Publicar la ventana nueva en bloque
+// ============================================================================
+// Filas publicadas: ids [m_total - m_rows, m_total). Store ahora: ids
+// [total - count, total).
+// 1. Los ids publicados que el store ya descarto son las ultimas filas:
+//    un solo beginRemoveRows().
+// 2. Las filas que faltan son los ids nuevos, arriba: un solo
+//    beginInsertRows(0, n - 1).
+// Tras clear() o un cambio de capacidad (otra generation) los ids no son
+// comparables: se reinicia el modelo.
+// ============================================================================
+void RecordListModel::refresh()
+{
+    const RecordStore::Window now = m_store.window();
+    if (now.generation == m_generation && now.total == m_total)
+        return;
+
+    const int previousRows = m_rows;
+
+    if (now.generation != m_generation) {
+        beginResetModel();
+        m_generation = now.generation;
+        m_total = now.total;
+        m_rows = now.count;
+        endResetModel();
+    } else {
+        const quint64 oldFirst = m_total - quint64(m_rows);
+        const quint64 newFirst = now.total - quint64(now.count);
+        const int evicted = newFirst > oldFirst
+            ? int(qMin<quint64>(quint64(m_rows), newFirst - oldFirst)) : 0;
+        if (evicted > 0) {
+            beginRemoveRows(QModelIndex(), m_rows - evicted, m_rows - 1);
+            m_rows -= evicted;
+            endRemoveRows();
+        }
+
+        const int inserted = now.count - m_rows;
+        if (inserted > 0) {
+            beginInsertRows(QModelIndex(), 0, inserted - 1);
+            m_total = now.total;
+            m_rows = now.count;
+            endInsertRows();
+        }
+        m_total = now.total;
+    }
+
+    if (m_rows != previousRows)
+        emit countChanged();
+}
+
+// La capacidad se puede cambiar con el pipeline en marcha: el store la
+// aplica bajo su mutex y el siguiente refresh() reinicia el modelo.
+void RecordListModel::setCapacity(int capacity)
+{
+    capacity = qBound(1, capacity, MaxCapacity);
+    if (capacity == m_store.capacity())
+        return;
+    m_store.reset(capacity);
+    refresh();
+    emit capacityChanged();
+}
+
+void RecordListModel::clear()
+{
+    m_store.clear();
+    refresh();
+}
@@ -0,0 +1,91 @@
+// ============================================================================
+// recordlistmodel.h - Registros del Colector como QAbstractListModel
+// ============================================================================
+//
+// Sustituye al ListModel de RecordsCard, que se rellenaba con un
+// recordsModel.insert(0, ...) por cada signal recordAdded: un evento Qt,
+// un hex ya formateado y una llamada JS por coincidencia.
+//
+// PATRON: vista sobre un RecordStore (ring + arena) que escribe el Colector.
+//   - El Colector solo llama a RecordStore::append(): ninguna signal por
+//     registro.
+//   - refresh() (una vez por tick del muestreo de ThreadPipeline) compara
+//     la ventana de ids vivos con la anterior y publica con UN
+//     beginRemoveRows() lo descartado y UN beginInsertRows() lo nuevo.
+//   - data() lee del store bajo demanda: el hex y el texto del timestamp
+//     solo se generan para las filas que un delegate esta mostrando.
+//
+// ORDEN: la fila 0 es el registro MAS RECIENTE (como el ListModel anterior).
+//   fila r -> id (m_total - 1 - r)
+//
+// Entre dos refresh() el Colector puede descartar registros que aun son
+// filas del modelo (las ultimas): data() devuelve valores vacios para
+// ellas y el siguiente refresh() las quita.
+//
+// ROLES (mismos nombres que el ListModel anterior, el delegate no cambia):
+//   timestamp, hexData, byteSize, patternIndex, matchOffset, sequence
+// ============================================================================
+
+#ifndef RECORDLISTMODEL_H
+#define RECORDLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QtQml/qqmlregistration.h>
+#include "recordstore.h"
+
+class RecordListModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("RecordListModel is provided by ThreadPipeline.records")
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    // Registros guardados como maximo. Cambiarla descarta los actuales.
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+
+public:
+    // Bytes del chunk que se muestran en hex (como el antiguo left(120))
+    static constexpr int HexPreviewBytes = 40;
+    static constexpr int MaxCapacity = 5000000;
+
+    enum Roles {
+        TimestampRole = Qt::UserRole + 1,
+        HexDataRole,
+        ByteSizeRole,
+        PatternIndexRole,
+        MatchOffsetRole,
+        SequenceRole
+    };
+
+    explicit RecordListModel(QObject *parent = nullptr);
+
+    // ─── QAbstractListModel ─────────────────────────────────────────
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // El Colector escribe aqui (desde su hilo)
+    RecordStore *store() { return &m_store; }
+
+    // Publica lo que el Colector escribio desde el ultimo refresh()
+    void refresh();
+
+    int count() const;
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    Q_INVOKABLE void clear();
+
+signals:
+    void countChanged();
+    void capacityChanged();
+
+private:
+    RecordStore m_store;
+    // Ventana publicada: filas = ids [m_total - m_rows, m_total)
+    quint64 m_total = 0;
+    int m_rows = 0;
+    quint64 m_generation = 0;
+};
+
+#endif // RECORDLISTMODEL_H
@@ -0,0 +1,219 @@
+// ============================================================================
+// recordlogmodel.cpp - Implementacion del modelo de registros en disco
+// ============================================================================
+
+#include "recordlogmodel.h"
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QTimeZone>
+#include <limits>
+
+RecordLogModel::RecordLogModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_path(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)
+             + QStringLiteral("/threads-records"))
+{
+    m_generation = m_log.window().generation;
+}
+
+int RecordLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rows;
+}
+
+int RecordLogModel::count() const { return m_rows; }
+bool RecordLogModel::enabled() const { return m_enabled; }
+QString RecordLogModel::path() const { return m_path; }
+int RecordLogModel::segmentMegabytes() const { return m_segmentMegabytes; }
+int RecordLogModel::maxSegments() const { return m_maxSegments; }
+int RecordLogModel::segmentCount() const { return m_segmentCount; }
+double RecordLogModel::diskBytes() const { return double(m_diskBytes); }
+double RecordLogModel::firstTimestampMs() const { return double(m_firstTimestampMs); }
+double RecordLogModel::lastTimestampMs() const { return double(m_lastTimestampMs); }
+QString RecordLogModel::errorString() const { return m_error; }
+
+// ============================================================================
+// data() - Lectura perezosa del mapeo
+// ============================================================================
+QVariant RecordLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= m_rows)
+        return {};
+
+    const quint64 id = m_first + quint64(index.row());
+    if (role == RecordIdRole)
+        return double(id);
+    if (role == HexDataRole)
+        return m_log.hex(id, HexPreviewBytes);
+
+    SegmentLog::Record record;
+    const bool live = m_log.record(id, record);
+    switch (role) {
+    case TimestampRole:
+        if (!live)
+            return QString();
+        return QDateTime::fromMSecsSinceEpoch(record.timestampMs, QTimeZone::UTC)
+            .toString(Qt::ISODateWithMs);
+    case ByteSizeRole:
+        return record.size;
+    case PatternIndexRole:
+        return record.pattern;
+    case MatchOffsetRole:
+        return record.offset;
+    case SequenceRole:
+        return qint64(record.sequence);
+    default:
+        return {};
+    }
+}
+
+QHash<int, QByteArray> RecordLogModel::roleNames() const
+{
+    return {
+        { RecordIdRole,     "recordId" },
+        { TimestampRole,    "timestamp" },
+        { HexDataRole,      "hexData" },
+        { ByteSizeRole,     "byteSize" },
+        { PatternIndexRole, "patternIndex" },
+        { MatchOffsetRole,  "matchOffset" },
+        { SequenceRole,     "sequence" }
+    };
+}
+
+// ============================================================================
+// refresh() - Publicar la ventana nueva en bloque
+// ============================================================================
+// Filas publicadas: ids [m_first, m_first + m_rows). Log ahora: ids
+// [first, total).
+// 1. Lo que la retencion borro son las primeras filas: un solo
+//    beginRemoveRows(0, n - 1).
+// 2. Lo nuevo va al final: un solo beginInsertRows().
+// Tras open(), close() o purge() (otra generation) se reinicia el modelo.
+// Un QAbstractListModel cuenta filas con int: mas de 2^31 registros en
+// disco se muestran hasta ese limite.
+// ============================================================================
+void RecordLogModel::refresh()
+{
+    const SegmentLog::Window now = m_log.window();
+    const int rows = int(qMin<quint64>(now.total - now.first,
+                                       quint64(std::numeric_limits<int>::max())));
+    const int previousRows = m_rows;
+
+    if (now.generation != m_generation) {
+        beginResetModel();
+        m_generation = now.generation;
+        m_first = now.first;
+        m_rows = rows;
+        endResetModel();
+    } else if (now.first != m_first || rows != m_rows) {
+        if (now.first > m_first) {
+            const int removed = int(qMin<quint64>(quint64(m_rows), now.first - m_first));
+            if (removed > 0) {
+                beginRemoveRows(QModelIndex(), 0, removed - 1);
+                m_first += quint64(removed);
+                m_rows -= removed;
+                endRemoveRows();
+            }
+            m_first = now.first;
+        }
+        if (rows > m_rows) {
+            beginInsertRows(QModelIndex(), m_rows, rows - 1);
+            m_rows = rows;
+            endInsertRows();
+        }
+    }
+
+    if (m_rows != previousRows)
+        emit countChanged();
+
+    if (m_enabled != m_log.isOpen()) {
+        m_enabled = m_log.isOpen();
+        emit enabledChanged();
+    }
+
+    const int segmentCount = m_log.segmentCount();
+    const qint64 diskBytes = m_log.diskBytes();
+    const qint64 firstMs = m_log.firstTimestampMs();
+    const qint64 lastMs = m_log.lastTimestampMs();
+    const QString error = m_log.errorString();
+    if (segmentCount != m_segmentCount || diskBytes != m_diskBytes
+        || firstMs != m_firstTimestampMs || lastMs != m_lastTimestampMs || error != m_error) {
+        m_segmentCount = segmentCount;
+        m_diskBytes = diskBytes;
+        m_firstTimestampMs = firstMs;
+        m_lastTimestampMs = lastMs;
+        m_error = error;
+        emit statsChanged();
+    }
+}
+
+// ─── Configuracion ─────────────────────────────────────────────────
+
+// open() recupera lo que haya en el directorio: lo de ejecuciones
+// anteriores (o de otra sesion de la aplicacion) vuelve a ser visible.
+// Un fallo queda en errorString (SegmentLog lo conserva).
+bool RecordLogModel::reopen()
+{
+    const bool ok = m_log.open(m_path, qint64(m_segmentMegabytes) << 20, m_maxSegments);
+    refresh();
+    return ok;
+}
+
+void RecordLogModel::setEnabled(bool enabled)
+{
+    if (enabled == m_log.isOpen())
+        return;
+    if (enabled) {
+        reopen();
+    } else {
+        m_log.close();
+        refresh();
+    }
+}
+
+void RecordLogModel::setPath(const QString &path)
+{
+    if (path.isEmpty() || path == m_path)
+        return;
+    m_path = path;
+    emit configChanged();
+    if (m_log.isOpen())
+        reopen();
+}
+
+void RecordLogModel::setSegmentMegabytes(int megabytes)
+{
+    megabytes = qBound(1, megabytes, 1024);
+    if (megabytes == m_segmentMegabytes)
+        return;
+    m_segmentMegabytes = megabytes;
+    emit configChanged();
+}
+
+// La retencion se aplica en el momento (puede borrar segmentos)
+void RecordLogModel::setMaxSegments(int segments)
+{
+    segments = qBound(1, segments, 100000);
+    if (segments == m_maxSegments)
+        return;
+    m_maxSegments = segments;
+    m_log.setMaxSegments(segments);
+    refresh();
+    emit configChanged();
+}
+
+int RecordLogModel::rowForTime(double ms) const
+{
+    if (m_rows == 0)
+        return -1;
+    const quint64 id = m_log.idForTime(qint64(ms));
+    if (id <= m_first)
+        return 0;
+    return int(qMin<quint64>(id - m_first, quint64(m_rows - 1)));
+}
+
+void RecordLogModel::purge()
+{
+    m_log.purge();
+    refresh();
+}
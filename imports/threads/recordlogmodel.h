@@ -0,0 +1,129 @@
+// ============================================================================
+// recordlogmodel.h - Registros guardados en disco como QAbstractListModel
+// ============================================================================
+//
+// Vista perezosa sobre un SegmentLog, para repasar despues millones de
+// coincidencias. Mismo patron que RecordListModel:
+//   - El Colector solo llama a SegmentLog::append(): ninguna signal.
+//   - refresh() (tick de 10 Hz de ThreadPipeline) publica en bloque lo
+//     que la retencion borro y lo que se anadio.
+//   - data() lee del mapeo bajo demanda: solo las filas visibles se
+//     formatean, y filas seguidas se leen con el cursor del log (O(1)).
+//
+// ORDEN: cronologico, la fila 0 es el registro MAS ANTIGUO que sigue en
+// disco. Los nuevos entran abajo y la retencion borra arriba: las filas
+// que se estan mirando no se desplazan.
+//   fila r -> id (first + r)
+//
+// CONFIGURACION:
+//   enabled          abre (o crea) el log en path y lo recupera; el
+//                    Colector escribe mientras este abierto.
+//   path             directorio de los segmentos (se aplica al reabrir)
+//   segmentMegabytes tamano de cada segmento (se aplica al reabrir)
+//   maxSegments      retencion: se borran los mas antiguos
+//
+// ROLES: recordId, timestamp, hexData, byteSize, patternIndex,
+// matchOffset, sequence (los de RecordListModel mas el id en disco).
+// ============================================================================
+
+#ifndef RECORDLOGMODEL_H
+#define RECORDLOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QtQml/qqmlregistration.h>
+#include "segmentlog.h"
+
+class RecordLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_UNCREATABLE("RecordLogModel is provided by ThreadPipeline.recordLog")
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(bool enabled READ enabled WRITE setEnabled NOTIFY enabledChanged)
+    Q_PROPERTY(QString path READ path WRITE setPath NOTIFY configChanged)
+    Q_PROPERTY(int segmentMegabytes READ segmentMegabytes WRITE setSegmentMegabytes NOTIFY configChanged)
+    Q_PROPERTY(int maxSegments READ maxSegments WRITE setMaxSegments NOTIFY configChanged)
+    // Se actualizan en cada refresh()
+    Q_PROPERTY(int segmentCount READ segmentCount NOTIFY statsChanged)
+    Q_PROPERTY(double diskBytes READ diskBytes NOTIFY statsChanged)
+    Q_PROPERTY(double firstTimestampMs READ firstTimestampMs NOTIFY statsChanged)
+    Q_PROPERTY(double lastTimestampMs READ lastTimestampMs NOTIFY statsChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY statsChanged)
+
+public:
+    static constexpr int HexPreviewBytes = 40;
+
+    enum Roles {
+        RecordIdRole = Qt::UserRole + 1,
+        TimestampRole,
+        HexDataRole,
+        ByteSizeRole,
+        PatternIndexRole,
+        MatchOffsetRole,
+        SequenceRole
+    };
+
+    explicit RecordLogModel(QObject *parent = nullptr);
+
+    // ─── QAbstractListModel ─────────────────────────────────────────
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    // El Colector escribe aqui (desde su hilo)
+    SegmentLog *log() { return &m_log; }
+
+    // Publica lo que el Colector escribio desde el ultimo refresh()
+    void refresh();
+
+    int count() const;
+    bool enabled() const;
+    void setEnabled(bool enabled);
+    QString path() const;
+    void setPath(const QString &path);
+    int segmentMegabytes() const;
+    void setSegmentMegabytes(int megabytes);
+    int maxSegments() const;
+    void setMaxSegments(int segments);
+    int segmentCount() const;
+    double diskBytes() const;
+    double firstTimestampMs() const;
+    double lastTimestampMs() const;
+    QString errorString() const;
+
+    // Fila del primer registro con timestamp >= ms (para positionViewAtIndex)
+    Q_INVOKABLE int rowForTime(double ms) const;
+    // Borra los segmentos del disco
+    Q_INVOKABLE void purge();
+
+signals:
+    void countChanged();
+    void enabledChanged();
+    void configChanged();
+    void statsChanged();
+
+private:
+    bool reopen();
+
+    SegmentLog m_log;
+    QString m_path;
+    int m_segmentMegabytes = int(SegmentLog::DefaultSegmentBytes >> 20);
+    int m_maxSegments = SegmentLog::DefaultMaxSegments;
+
+    // Ventana publicada: filas = ids [m_first, m_first + m_rows)
+    quint64 m_first = 0;
+    int m_rows = 0;
+    quint64 m_generation = 0;
+    // El log se cierra solo si no puede crear un segmento (disco lleno)
+    bool m_enabled = false;
+
+    // Estadisticas muestreadas en refresh()
+    int m_segmentCount = 0;
+    qint64 m_diskBytes = 0;
+    qint64 m_firstTimestampMs = 0;
+    qint64 m_lastTimestampMs = 0;
+    QString m_error;
+};
+
+#endif // RECORDLOGMODEL_H
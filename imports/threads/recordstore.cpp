@@ -0,0 +1,146 @@
+// ============================================================================
+// recordstore.cpp - Implementacion del ring de registros con arena
+// ============================================================================
+
+#include "recordstore.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+RecordStore::RecordStore(int capacity)
+{
+    reset(capacity);
+}
+
+void RecordStore::reset(int capacity)
+{
+    capacity = qMax(capacity, 1);
+    QMutexLocker lock(&m_mutex);
+    m_slots.assign(std::size_t(capacity), Record());
+    m_arenaSize = std::size_t(capacity) * ArenaBytesPerRecord;
+    m_arena.reset(new char[m_arenaSize]);
+    m_writePos = 0;
+    m_total = 0;
+    m_count = 0;
+    ++m_generation;
+}
+
+void RecordStore::clear()
+{
+    QMutexLocker lock(&m_mutex);
+    m_writePos = 0;
+    m_count = 0;
+    ++m_generation;
+}
+
+// El registro mas antiguo es el id total - count: basta con olvidarlo
+void RecordStore::evictOldest()
+{
+    --m_count;
+}
+
+// ============================================================================
+// append() - Hueco en la arena descartando lo mas antiguo
+// ============================================================================
+// Los registros vivos ocupan un tramo circular de la arena que empieza en
+// el mas antiguo y termina en m_writePos. El sitio libre esta justo
+// delante de m_writePos, hasta el mas antiguo. Para escribir 'size' bytes:
+//   - Si no caben antes del final de la arena: se descartan los registros
+//     que quedan entre m_writePos y el final (son los mas antiguos) y se
+//     vuelve al principio.
+//   - Mientras el mas antiguo empiece dentro del tramo que se va a
+//     escribir, se descarta.
+// Cada vuelta descarta un registro o da la vuelta a la arena: O(1)
+// amortizado, porque cada registro se descarta una sola vez.
+// ============================================================================
+void RecordStore::append(const PipelineChunk &chunk)
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QMutexLocker lock(&m_mutex);
+    const std::size_t size = std::min(std::size_t(chunk.data.size()), m_arenaSize);
+    const std::size_t capacity = m_slots.size();
+
+    if (std::size_t(m_count) == capacity)
+        evictOldest();
+
+    while (m_count > 0) {
+        const Record &oldest = m_slots[std::size_t((m_total - quint64(m_count)) % capacity)];
+        if (m_writePos + size > m_arenaSize) {
+            if (oldest.arenaOffset >= m_writePos)
+                evictOldest();
+            else
+                m_writePos = 0;
+            continue;
+        }
+        if (oldest.arenaOffset >= m_writePos && oldest.arenaOffset < m_writePos + size) {
+            evictOldest();
+            continue;
+        }
+        break;
+    }
+    if (m_count == 0 && m_writePos + size > m_arenaSize)
+        m_writePos = 0;
+
+    std::memcpy(m_arena.get() + m_writePos, chunk.data.constData(), size);
+
+    Record &slot = m_slots[std::size_t(m_total % capacity)];
+    slot.timestampMs = now;
+    slot.sequence = chunk.sequence;
+    slot.arenaOffset = m_writePos;
+    slot.size = int(size);
+    slot.pattern = chunk.matchPattern;
+    slot.offset = chunk.matchOffset;
+
+    m_writePos += size;
+    ++m_total;
+    ++m_count;
+}
+
+// ─── Lectura ───────────────────────────────────────────────────────
+
+RecordStore::Window RecordStore::window() const
+{
+    QMutexLocker lock(&m_mutex);
+    return { m_total, m_count, m_generation };
+}
+
+int RecordStore::count() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_count;
+}
+
+int RecordStore::capacity() const
+{
+    QMutexLocker lock(&m_mutex);
+    return int(m_slots.size());
+}
+
+bool RecordStore::isLive(quint64 id) const
+{
+    return id < m_total && id >= m_total - quint64(m_count);
+}
+
+bool RecordStore::record(quint64 id, Record &out) const
+{
+    QMutexLocker lock(&m_mutex);
+    if (!isLive(id))
+        return false;
+    out = m_slots[std::size_t(id % m_slots.size())];
+    return true;
+}
+
+// fromRawData() no copia: toHex() lee directamente de la arena
+QString RecordStore::hex(quint64 id, int maxBytes) const
+{
+    QMutexLocker lock(&m_mutex);
+    if (!isLive(id))
+        return {};
+    const Record &r = m_slots[std::size_t(id % m_slots.size())];
+    const QByteArray view = QByteArray::fromRawData(m_arena.get() + r.arenaOffset,
+                                                    qMin(r.size, maxBytes));
+    return QString::fromLatin1(view.toHex(' '));
+}
@@ -0,0 +1,109 @@
+// ============================================================================
+// recordstore.h - Registros del Colector: ring de cabeceras + arena de bytes
+// ============================================================================
+//
+// Antes el Colector guardaba cada coincidencia en un QList<Record>: al
+// llegar a 500, removeFirst() desplazaba la lista entera (O(n)) y cada
+// registro reservaba su QDateTime y su copia de los datos bajo el mutex.
+//
+// RecordStore reserva TODO al construirse y no vuelve a reservar:
+//
+//   m_slots (capacity cabeceras, ring)      m_arena (bytes, circular)
+//   ┌────┬────┬────┬────┬────┐              ┌──────────────────────────┐
+//   │ r3 │ r4 │ r0 │ r1 │ r2 │              │ r1 r1 │ r2 │ r3 r3 │ r4 │ │
+//   └────┴────┴────┴────┴────┘              └──────────────────────────┘
+//          head ^ (mas antiguo)               ^ cada cabecera apunta aqui
+//
+//   - append(): copia los datos a la arena detras del ultimo registro y
+//     escribe la cabecera en el hueco siguiente. O(1): si falta sitio (en
+//     el ring o en la arena) se descartan los registros mas antiguos, que
+//     son justo los que ocupan el espacio siguiente.
+//   - Los datos de un registro son SIEMPRE contiguos: si no caben al final
+//     de la arena, se empieza de nuevo desde el principio.
+//   - Los timestamps se guardan como milisegundos (qint64). El texto se
+//     genera al leer, igual que el hex.
+//
+// IDENTIFICADORES:
+//   Cada registro tiene un id absoluto (0, 1, 2... en orden de llegada).
+//   window() dice que ids siguen vivos: [total - count, total). El modelo
+//   (RecordListModel) los usa para calcular filas insertadas/eliminadas
+//   sin copiar nada.
+//
+// HILOS:
+//   Escribe el Colector (su hilo); leen el modelo y ThreadPipeline (hilo
+//   principal). Un QMutex protege todo, como antes, pero ahora la seccion
+//   critica es un memcpy de unos bytes, sin reservas de memoria.
+// ============================================================================
+
+#ifndef RECORDSTORE_H
+#define RECORDSTORE_H
+
+#include <QMutex>
+#include <QString>
+#include <memory>
+#include <vector>
+#include "pipelinechunk.h"
+
+class RecordStore
+{
+public:
+    static constexpr int DefaultCapacity = 500;
+    // Arena por registro: los chunks del Generador miden 1-100 bytes. Si
+    // llegan mas grandes, caben menos registros que 'capacity'.
+    static constexpr int ArenaBytesPerRecord = 64;
+
+    struct Record
+    {
+        qint64 timestampMs = 0;     // QDateTime::currentMSecsSinceEpoch()
+        quint64 sequence = 0;
+        std::size_t arenaOffset = 0;
+        int size = 0;
+        int pattern = -1;
+        int offset = -1;
+    };
+
+    // Ids vivos: [total - count, total). generation cambia con clear() y
+    // reset(): los ids anteriores dejan de ser comparables.
+    struct Window
+    {
+        quint64 total = 0;
+        int count = 0;
+        quint64 generation = 0;
+    };
+
+    explicit RecordStore(int capacity = DefaultCapacity);
+
+    RecordStore(const RecordStore &) = delete;
+    RecordStore &operator=(const RecordStore &) = delete;
+
+    // Cambia la capacidad; descarta los registros
+    void reset(int capacity);
+    void clear();
+
+    // Hilo del Colector. O(1), sin reservas de memoria.
+    void append(const PipelineChunk &chunk);
+
+    // ─── Lectura (cualquier hilo) ───────────────────────────────────
+    Window window() const;
+    int count() const;
+    int capacity() const;
+    // false si el registro ya se descarto
+    bool record(quint64 id, Record &out) const;
+    // Los primeros maxBytes en hex ("DE AD BE EF"); vacio si ya no existe
+    QString hex(quint64 id, int maxBytes) const;
+
+private:
+    bool isLive(quint64 id) const;
+    void evictOldest();
+
+    mutable QMutex m_mutex;
+    std::vector<Record> m_slots;
+    std::unique_ptr<char[]> m_arena;   // Sin inicializar: paginas bajo demanda
+    std::size_t m_arenaSize = 0;
+    std::size_t m_writePos = 0;
+    quint64 m_total = 0;
+    int m_count = 0;
+    quint64 m_generation = 0;
+};
+
+#endif // RECORDSTORE_H
@@ -0,0 +1,99 @@
+// ============================================================================
+// reorderbuffer.h - Devuelve al orden original la salida de N Filtros
+// ============================================================================
+//
+// Con varios FilterWorker en paralelo, el Generador reparte por turno:
+// el chunk con sequence s va al Filtro s % N (un "shard" por Filtro).
+// Cada Filtro procesa SU shard en orden, pero los Filtros no se esperan
+// entre si: al Colector le llegan las coincidencias entremezcladas.
+//
+//   Generador:  0 1 2 3 4 5 6 7 ...         (N = 2)
+//   Filtro 0:   0   2   4   6               -> coincide 4
+//   Filtro 1:     1   3   5   7             -> coincide 1, 7
+//   Colector recibe, p.ej.: 1 (F1), 7 (F1), 4 (F0)  -> debe entregar 1, 4, 7
+//
+// Lo que SI se garantiza es el orden DENTRO de cada shard (un solo hilo
+// emisor por shard y una cola FIFO por salto). ReorderBuffer lo aprovecha:
+//
+//   - Por shard guarda las coincidencias pendientes (FIFO) y 'done', el
+//     primer sequence que ese Filtro aun no ha procesado. Cualquier cosa
+//     que llega del shard (coincidencia o marcador de progreso) sube done.
+//   - Avanza m_next mientras pueda decidir sobre el: su dueno es el shard
+//     m_next % N. Si la cabeza de ese shard es m_next, se entrega. Si no,
+//     pero done ya paso de m_next, ese chunk no coincidio (o se descarto
+//     por la politica de la cola): se salta.
+//
+// Los Filtros mandan marcadores de progreso (ver PipelineChunk) cuando se
+// quedan sin trabajo o cada pocos chunks sin coincidencia. Sin ellos, un
+// shard sin coincidencias bloquearia la entrega de todos los demas.
+//
+// Vive en el hilo del Colector: no necesita atomicos ni mutex. Header-only
+// (como SpscRing) porque offer() recibe una lambda.
+// ============================================================================
+
+#ifndef REORDERBUFFER_H
+#define REORDERBUFFER_H
+
+#include <deque>
+#include <vector>
+#include "pipelinechunk.h"
+
+class ReorderBuffer
+{
+public:
+    // Vacia el buffer y empieza a esperar sequence 0
+    void reset(int shards)
+    {
+        m_shards.assign(std::size_t(shards < 1 ? 1 : shards), Shard());
+        m_next = 0;
+        m_pending = 0;
+    }
+
+    int shards() const { return int(m_shards.size()); }
+    // Siguiente sequence por entregar
+    quint64 next() const { return m_next; }
+    // Coincidencias retenidas esperando a un shard mas lento
+    std::size_t pending() const { return m_pending; }
+
+    // Anota un chunk recibido (coincidencia o marcador) y llama
+    // release(PipelineChunk &) con cada coincidencia que ya esta en orden
+    template <typename Fn>
+    void offer(PipelineChunk &&chunk, Fn &&release);
+
+private:
+    struct Shard {
+        std::deque<PipelineChunk> matches;
+        quint64 done = 0;
+    };
+
+    std::vector<Shard> m_shards{ Shard() };
+    quint64 m_next = 0;
+    std::size_t m_pending = 0;
+};
+
+template <typename Fn>
+void ReorderBuffer::offer(PipelineChunk &&chunk, Fn &&release)
+{
+    const std::size_t count = m_shards.size();
+    Shard &from = m_shards[std::size_t(chunk.sequence % count)];
+    if (chunk.sequence + 1 > from.done)
+        from.done = chunk.sequence + 1;
+    if (chunk.matchPattern >= 0) {
+        from.matches.push_back(std::move(chunk));
+        ++m_pending;
+    }
+
+    for (;;) {
+        Shard &owner = m_shards[std::size_t(m_next % count)];
+        if (!owner.matches.empty() && owner.matches.front().sequence == m_next) {
+            release(owner.matches.front());
+            owner.matches.pop_front();
+            --m_pending;
+        } else if (owner.done <= m_next) {
+            return;   // El dueno aun no ha llegado aqui
+        }
+        ++m_next;
+    }
+}
+
+#endif // REORDERBUFFER_H
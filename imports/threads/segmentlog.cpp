@@ -0,0 +1,596 @@
+// ============================================================================
+// segmentlog.cpp - Implementacion del log de segmentos mapeados
+// ============================================================================
+
+#include "segmentlog.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QDir>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+namespace {
+
+constexpr char kMagic[8] = { 'Q', 'T', 'R', 'E', 'C', 'L', 'O', 'G' };
+constexpr quint32 kVersion = 1;
+
+// Posiciones dentro de la cabecera del segmento
+constexpr int kVersionAt = 8;
+constexpr int kHeaderBytesAt = 12;
+constexpr int kFirstIdAt = 16;
+constexpr int kCreatedAt = 24;
+constexpr int kCountAt = 32;
+constexpr int kEndAt = 40;
+
+// Posiciones dentro de un registro
+constexpr int kTimestampAt = 4;
+constexpr int kSequenceAt = 12;
+constexpr int kPatternAt = 20;
+constexpr int kOffsetAt = 24;
+
+constexpr int kIndexEntryBytes = 24;
+
+// El mapeo no garantiza alineacion: todo se lee y escribe con memcpy
+template <typename T>
+T load(const uchar *at)
+{
+    T value;
+    std::memcpy(&value, at, sizeof(T));
+    return value;
+}
+
+template <typename T>
+void store(uchar *at, T value)
+{
+    std::memcpy(at, &value, sizeof(T));
+}
+
+QString segmentName(quint64 firstId)
+{
+    return QStringLiteral("%1.seg").arg(firstId, 20, 10, QLatin1Char('0'));
+}
+
+QString indexPathFor(const QString &segmentPath)
+{
+    return segmentPath.left(segmentPath.size() - 4) + QStringLiteral(".idx");
+}
+
+} // namespace
+
+SegmentLog::~SegmentLog()
+{
+    close();
+}
+
+// ============================================================================
+// open() - Recuperar los segmentos del directorio
+// ============================================================================
+// Los nombres llevan el primer id con ceros a la izquierda: el orden
+// alfabetico es el de los ids. Un segmento ilegible se ignora (queda en
+// errorString()); si falta uno intermedio, solo se usa el tramo contiguo
+// mas reciente.
+// ============================================================================
+bool SegmentLog::open(const QString &dir, qint64 segmentBytes, int maxSegments, QString *error)
+{
+    QMutexLocker lock(&m_mutex);
+    resetLocked();
+    m_error.clear();
+
+    if (!QDir().mkpath(dir)) {
+        m_error = QStringLiteral("Cannot create %1").arg(dir);
+        if (error)
+            *error = m_error;
+        return false;
+    }
+    m_dir = dir;
+    // Hueco minimo para un registro de chunk grande mas la cabecera
+    m_segmentBytes = qMax<qint64>(segmentBytes, 64 * 1024);
+    m_maxSegments = qMax(maxSegments, 1);
+
+    const QStringList files = QDir(dir).entryList({ QStringLiteral("*.seg") },
+                                                  QDir::Files, QDir::Name);
+    for (const QString &name : files) {
+        QString segmentError;
+        std::unique_ptr<Segment> segment = openSegment(QDir(dir).filePath(name), &segmentError);
+        if (!segment) {
+            m_error = segmentError;
+            continue;
+        }
+        if (!m_segments.empty()) {
+            Segment &previous = *m_segments.back();
+            if (segment->firstId != previous.firstId + previous.count) {
+                for (const auto &stale : m_segments)
+                    closeSegment(*stale);
+                m_segments.clear();
+            } else if (!previous.sealed) {
+                // Murio antes de sellarlo y ya existe el siguiente
+                seal(previous);
+            }
+        }
+        m_segments.push_back(std::move(segment));
+    }
+
+    if (!m_segments.empty()) {
+        const Segment &last = *m_segments.back();
+        m_total = last.firstId + last.count;
+        m_lastTimestampMs = last.lastTimestampMs;
+    } else {
+        m_total = 0;
+        m_lastTimestampMs = 0;
+    }
+    enforceRetention();
+    m_open.store(true, std::memory_order_release);
+    return true;
+}
+
+void SegmentLog::close()
+{
+    QMutexLocker lock(&m_mutex);
+    resetLocked();
+}
+
+// Los ficheros se quedan en disco: el siguiente open() los recupera
+void SegmentLog::resetLocked()
+{
+    m_open.store(false, std::memory_order_release);
+    for (const auto &segment : m_segments)
+        closeSegment(*segment);
+    m_segments.clear();
+    m_cursor = Cursor();
+    ++m_generation;
+}
+
+void SegmentLog::purge()
+{
+    QMutexLocker lock(&m_mutex);
+    for (const auto &segment : m_segments)
+        removeSegment(*segment);
+    m_segments.clear();
+    m_cursor = Cursor();
+    m_error.clear();
+    ++m_generation;
+}
+
+void SegmentLog::setMaxSegments(int segments)
+{
+    QMutexLocker lock(&m_mutex);
+    m_maxSegments = qMax(segments, 1);
+    enforceRetention();
+}
+
+// ─── Segmentos ─────────────────────────────────────────────────────
+
+std::unique_ptr<SegmentLog::Segment> SegmentLog::openSegment(const QString &file, QString *error)
+{
+    auto segment = std::make_unique<Segment>();
+    segment->file.setFileName(file);
+    if (!segment->file.open(QIODevice::ReadWrite)) {
+        *error = segment->file.errorString();
+        return nullptr;
+    }
+    segment->mapSize = segment->file.size();
+    if (segment->mapSize < HeaderBytes + RecordHeaderBytes) {
+        *error = QStringLiteral("%1 is too small to be a record segment").arg(file);
+        return nullptr;
+    }
+    segment->map = segment->file.map(0, segment->mapSize);
+    if (!segment->map) {
+        *error = segment->file.errorString();
+        return nullptr;
+    }
+
+    const uchar *header = segment->map;
+    if (std::memcmp(header, kMagic, sizeof(kMagic)) != 0
+        || load<quint32>(header + kVersionAt) != kVersion
+        || load<quint32>(header + kHeaderBytesAt) != quint32(HeaderBytes)) {
+        *error = QStringLiteral("%1 is not a record segment").arg(file);
+        closeSegment(*segment);
+        return nullptr;
+    }
+    segment->firstId = load<quint64>(header + kFirstIdAt);
+    const quint64 sealedCount = load<quint64>(header + kCountAt);
+    const qint64 sealedEnd = qint64(load<quint64>(header + kEndAt));
+    segment->sealed = sealedCount > 0 && sealedEnd >= HeaderBytes
+                      && sealedEnd <= segment->mapSize;
+    segment->end = segment->sealed ? sealedEnd : segment->mapSize;
+
+    segment->indexFile.setFileName(indexPathFor(file));
+    if (!recover(*segment, error)) {
+        closeSegment(*segment);
+        return nullptr;
+    }
+    return segment;
+}
+
+// ============================================================================
+// recover() - Indice y final de un segmento existente
+// ============================================================================
+// Se aceptan las entradas del .idx mientras cuadren con el segmento; desde
+// la ultima valida se recorre registro a registro hasta el final (length 0
+// o fuera de limites). En un segmento sellado es un tramo de como mucho
+// IndexInterval registros; en el activo, lo que se escribio tras la ultima
+// entrada. El .idx se reescribe entero: una entrada cada 256 registros.
+// ============================================================================
+bool SegmentLog::recover(Segment &segment, QString *error)
+{
+    const qint64 limit = segment.end;
+    segment.index.clear();
+    if (segment.indexFile.open(QIODevice::ReadOnly)) {
+        const QByteArray bytes = segment.indexFile.readAll();
+        segment.indexFile.close();
+        const auto *raw = reinterpret_cast<const uchar *>(bytes.constData());
+        for (qsizetype at = 0; at + kIndexEntryBytes <= bytes.size(); at += kIndexEntryBytes) {
+            IndexEntry entry;
+            entry.id = load<quint64>(raw + at);
+            entry.timestampMs = load<qint64>(raw + at + 8);
+            entry.offset = load<quint64>(raw + at + 16);
+            const quint64 expectedId = segment.firstId
+                + quint64(segment.index.size()) * IndexInterval;
+            if (entry.id != expectedId || qint64(entry.offset) < HeaderBytes
+                || qint64(entry.offset) + RecordHeaderBytes > limit)
+                break;
+            const uchar *record = segment.map + entry.offset;
+            if (load<quint32>(record) < quint32(RecordHeaderBytes)
+                || load<qint64>(record + kTimestampAt) != entry.timestampMs)
+                break;
+            segment.index.push_back(entry);
+        }
+    }
+
+    quint64 id = segment.index.empty() ? segment.firstId : segment.index.back().id;
+    qint64 pos = segment.index.empty() ? HeaderBytes : qint64(segment.index.back().offset);
+    qint64 lastTimestamp = 0;
+    while (pos + RecordHeaderBytes <= limit) {
+        const quint32 length = load<quint32>(segment.map + pos);
+        if (length < quint32(RecordHeaderBytes) || pos + qint64(length) > limit)
+            break;
+        lastTimestamp = load<qint64>(segment.map + pos + kTimestampAt);
+        if (id - segment.firstId == quint64(segment.index.size()) * IndexInterval)
+            segment.index.push_back({ id, lastTimestamp, quint64(pos) });
+        pos += length;
+        ++id;
+    }
+
+    segment.count = id - segment.firstId;
+    segment.end = pos;
+    segment.lastTimestampMs = lastTimestamp;
+    segment.firstTimestampMs = segment.count > 0
+        ? load<qint64>(segment.map + HeaderBytes + kTimestampAt) : 0;
+
+    if (!segment.indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *error = segment.indexFile.errorString();
+        return false;
+    }
+    const std::vector<IndexEntry> entries = std::move(segment.index);
+    segment.index.clear();
+    for (const IndexEntry &entry : entries)
+        addIndexEntry(segment, entry);
+    if (segment.sealed)
+        segment.indexFile.close();
+    return true;
+}
+
+// El fichero se crea a su tamano final, con los bloques reservados, y se
+// mapea. Si algo falla se borra lo creado: open() tomaria un .seg vacio
+// por un segmento roto.
+std::unique_ptr<SegmentLog::Segment> SegmentLog::createSegment(quint64 firstId, QString *error)
+{
+    auto segment = std::make_unique<Segment>();
+    const QString path = QDir(m_dir).filePath(segmentName(firstId));
+    segment->file.setFileName(path);
+    segment->indexFile.setFileName(indexPathFor(path));
+    auto fail = [this, &segment, error](const QString &reason) {
+        *error = reason;
+        removeSegment(*segment);
+        return nullptr;
+    };
+
+    if (!segment->file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+        return fail(segment->file.errorString());
+#ifdef Q_OS_LINUX
+    // posix_fallocate() devuelve el error, no lo deja en errno
+    const int result = posix_fallocate(segment->file.handle(), 0, m_segmentBytes);
+    if (result != 0) {
+        return fail(QStringLiteral("Cannot reserve %1 bytes for %2: %3")
+                        .arg(m_segmentBytes).arg(path, qt_error_string(result)));
+    }
+#else
+    if (!segment->file.resize(m_segmentBytes))
+        return fail(segment->file.errorString());
+#endif
+    segment->mapSize = m_segmentBytes;
+    segment->map = segment->file.map(0, segment->mapSize);
+    if (!segment->map)
+        return fail(segment->file.errorString());
+    if (!segment->indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return fail(segment->indexFile.errorString());
+
+    uchar *header = segment->map;
+    std::memcpy(header, kMagic, sizeof(kMagic));
+    store<quint32>(header + kVersionAt, kVersion);
+    store<quint32>(header + kHeaderBytesAt, quint32(HeaderBytes));
+    store<quint64>(header + kFirstIdAt, firstId);
+    store<qint64>(header + kCreatedAt, QDateTime::currentMSecsSinceEpoch());
+    segment->firstId = firstId;
+    return segment;
+}
+
+void SegmentLog::addIndexEntry(Segment &segment, const IndexEntry &entry)
+{
+    segment.index.push_back(entry);
+    if (!segment.indexFile.isOpen())
+        return;
+    uchar raw[kIndexEntryBytes];
+    store<quint64>(raw, entry.id);
+    store<qint64>(raw + 8, entry.timestampMs);
+    store<quint64>(raw + 16, entry.offset);
+    segment.indexFile.write(reinterpret_cast<const char *>(raw), kIndexEntryBytes);
+}
+
+// Cabecera completa: open() ya no necesitara recorrerlo entero
+void SegmentLog::seal(Segment &segment)
+{
+    store<quint64>(segment.map + kCountAt, segment.count);
+    store<quint64>(segment.map + kEndAt, quint64(segment.end));
+    segment.sealed = true;
+    segment.indexFile.close();
+}
+
+void SegmentLog::closeSegment(Segment &segment)
+{
+    if (segment.map)
+        segment.file.unmap(segment.map);
+    segment.map = nullptr;
+    segment.file.close();
+    segment.indexFile.close();
+}
+
+void SegmentLog::removeSegment(Segment &segment)
+{
+    closeSegment(segment);
+    segment.file.remove();
+    segment.indexFile.remove();
+}
+
+// Nunca borra el segmento activo: m_maxSegments >= 1
+void SegmentLog::enforceRetention()
+{
+    if (int(m_segments.size()) <= m_maxSegments)
+        return;
+    const auto excess = std::ptrdiff_t(m_segments.size()) - m_maxSegments;
+    for (auto it = m_segments.begin(); it != m_segments.begin() + excess; ++it)
+        removeSegment(**it);
+    m_segments.erase(m_segments.begin(), m_segments.begin() + excess);
+    m_cursor = Cursor();
+}
+
+// Sella el activo y abre el siguiente. Si no se puede (disco lleno,
+// permisos), el log se cierra: reintentarlo en cada append() costaria
+// varias llamadas al sistema por registro.
+bool SegmentLog::roll()
+{
+    if (!m_segments.empty() && !m_segments.back()->sealed)
+        seal(*m_segments.back());
+
+    QString error;
+    std::unique_ptr<Segment> segment = createSegment(m_total, &error);
+    if (!segment) {
+        m_error = error;
+        m_open.store(false, std::memory_order_release);
+        return false;
+    }
+    m_segments.push_back(std::move(segment));
+    enforceRetention();
+    return true;
+}
+
+// ============================================================================
+// append() - Un registro al final del segmento activo
+// ============================================================================
+// Cuerpo primero y length al final: mientras length valga 0 el registro
+// no existe para recover(). La barrera de compilador impide que el
+// compilador adelante ese store.
+// ============================================================================
+void SegmentLog::append(const PipelineChunk &chunk)
+{
+    if (!isOpen())
+        return;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QMutexLocker lock(&m_mutex);
+    if (!isOpen())
+        return;
+
+    const qint64 size = qMin<qint64>(chunk.data.size(),
+                                     m_segmentBytes - HeaderBytes - RecordHeaderBytes);
+    const qint64 length = RecordHeaderBytes + size;
+    if (m_segments.empty() || m_segments.back()->sealed
+        || m_segments.back()->end + length > m_segments.back()->mapSize) {
+        if (!roll())
+            return;
+    }
+    Segment &active = *m_segments.back();
+
+    // Timestamps monotonos: la busqueda por tiempo es binaria
+    const qint64 timestamp = qMax(now, m_lastTimestampMs);
+    uchar *record = active.map + active.end;
+    store<qint64>(record + kTimestampAt, timestamp);
+    store<quint64>(record + kSequenceAt, chunk.sequence);
+    store<qint32>(record + kPatternAt, chunk.matchPattern);
+    store<qint32>(record + kOffsetAt, chunk.matchOffset);
+    std::memcpy(record + RecordHeaderBytes, chunk.data.constData(), std::size_t(size));
+    std::atomic_signal_fence(std::memory_order_release);
+    store<quint32>(record, quint32(length));
+
+    if (active.count % IndexInterval == 0)
+        addIndexEntry(active, { m_total, timestamp, quint64(active.end) });
+    if (active.count == 0)
+        active.firstTimestampMs = timestamp;
+    active.lastTimestampMs = timestamp;
+    active.end += length;
+    ++active.count;
+    ++m_total;
+    m_lastTimestampMs = timestamp;
+}
+
+// ─── Lectura ───────────────────────────────────────────────────────
+
+SegmentLog::Window SegmentLog::window() const
+{
+    QMutexLocker lock(&m_mutex);
+    const quint64 first = m_segments.empty() ? m_total : m_segments.front()->firstId;
+    return { first, m_total, m_generation };
+}
+
+const SegmentLog::Segment *SegmentLog::segmentFor(quint64 id) const
+{
+    if (m_segments.empty() || id >= m_total || id < m_segments.front()->firstId)
+        return nullptr;
+    auto it = std::upper_bound(m_segments.begin(), m_segments.end(), id,
+                               [](quint64 value, const std::unique_ptr<Segment> &segment) {
+        return value < segment->firstId;
+    });
+    return (it - 1)->get();
+}
+
+// Desde el cursor si 'id' esta poco por delante (filas seguidas), si no
+// desde la entrada del indice que le toca
+const uchar *SegmentLog::locate(quint64 id, const Segment **found) const
+{
+    const Segment *segment = segmentFor(id);
+    if (!segment)
+        return nullptr;
+
+    quint64 at = segment->firstId;
+    qint64 pos = HeaderBytes;
+    if (m_cursor.segment == segment && m_cursor.id <= id
+        && id - m_cursor.id < quint64(IndexInterval)) {
+        at = m_cursor.id;
+        pos = m_cursor.offset;
+    } else if (!segment->index.empty()) {
+        const std::size_t entry = std::min<std::size_t>(
+            std::size_t((id - segment->firstId) / IndexInterval), segment->index.size() - 1);
+        at = segment->index[entry].id;
+        pos = qint64(segment->index[entry].offset);
+    }
+    while (at < id) {
+        pos += load<quint32>(segment->map + pos);
+        ++at;
+    }
+
+    m_cursor = { segment, id, pos };
+    if (found)
+        *found = segment;
+    return segment->map + pos;
+}
+
+bool SegmentLog::record(quint64 id, Record &out) const
+{
+    QMutexLocker lock(&m_mutex);
+    const uchar *record = locate(id);
+    if (!record)
+        return false;
+    out.timestampMs = load<qint64>(record + kTimestampAt);
+    out.sequence = load<quint64>(record + kSequenceAt);
+    out.size = int(load<quint32>(record)) - RecordHeaderBytes;
+    out.pattern = load<qint32>(record + kPatternAt);
+    out.offset = load<qint32>(record + kOffsetAt);
+    return true;
+}
+
+// fromRawData() no copia: toHex() lee directamente del mapeo
+QString SegmentLog::hex(quint64 id, int maxBytes) const
+{
+    QMutexLocker lock(&m_mutex);
+    const uchar *record = locate(id);
+    if (!record)
+        return {};
+    const int size = int(load<quint32>(record)) - RecordHeaderBytes;
+    const QByteArray view = QByteArray::fromRawData(
+        reinterpret_cast<const char *>(record + RecordHeaderBytes), qMin(size, maxBytes));
+    return QString::fromLatin1(view.toHex(' '));
+}
+
+// ============================================================================
+// idForTime() - Busqueda por tiempo con el indice disperso
+// ============================================================================
+// 1. Primer segmento cuyo ultimo registro es >= ms (hay pocos: lineal).
+// 2. Dentro, la ultima entrada del indice con timestamp < ms (binaria).
+// 3. Desde ahi, registro a registro: como mucho IndexInterval saltos.
+// ============================================================================
+quint64 SegmentLog::idForTime(qint64 ms) const
+{
+    QMutexLocker lock(&m_mutex);
+    auto it = std::find_if(m_segments.begin(), m_segments.end(),
+                           [ms](const std::unique_ptr<Segment> &segment) {
+        return segment->count > 0 && segment->lastTimestampMs >= ms;
+    });
+    if (it == m_segments.end())
+        return m_total;
+
+    const Segment &segment = **it;
+    auto entry = std::lower_bound(segment.index.begin(), segment.index.end(), ms,
+                                  [](const IndexEntry &e, qint64 value) {
+        return e.timestampMs < value;
+    });
+    if (entry != segment.index.begin())
+        --entry;
+
+    quint64 id = entry->id;
+    qint64 pos = qint64(entry->offset);
+    const quint64 end = segment.firstId + segment.count;
+    for (; id < end; ++id) {
+        if (load<qint64>(segment.map + pos + kTimestampAt) >= ms)
+            return id;
+        pos += load<quint32>(segment.map + pos);
+    }
+    return end;
+}
+
+qint64 SegmentLog::firstTimestampMs() const
+{
+    QMutexLocker lock(&m_mutex);
+    for (const auto &segment : m_segments) {
+        if (segment->count > 0)
+            return segment->firstTimestampMs;
+    }
+    return 0;
+}
+
+qint64 SegmentLog::lastTimestampMs() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_segments.empty() ? 0 : m_lastTimestampMs;
+}
+
+int SegmentLog::segmentCount() const
+{
+    QMutexLocker lock(&m_mutex);
+    return int(m_segments.size());
+}
+
+qint64 SegmentLog::diskBytes() const
+{
+    QMutexLocker lock(&m_mutex);
+    qint64 bytes = 0;
+    for (const auto &segment : m_segments)
+        bytes += segment->end + qint64(segment->index.size()) * kIndexEntryBytes;
+    return bytes;
+}
+
+QString SegmentLog::path() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_dir;
+}
+
+QString SegmentLog::errorString() const
+{
+    QMutexLocker lock(&m_mutex);
+    return m_error;
+}
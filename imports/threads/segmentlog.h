@@ -0,0 +1,193 @@
+// ============================================================================
+// segmentlog.h - Registros del Colector en disco: log de segmentos mapeados
+// ============================================================================
+//
+// RecordStore solo guarda los ultimos N registros en RAM y se pierde al
+// cerrar la aplicacion. SegmentLog los guarda TODOS en disco para poder
+// analizarlos despues, sin frenar al Colector:
+//
+//   <dir>/00000000000000000000.seg   registros 0 .. 1'999'999 (sellado)
+//   <dir>/00000000000000000000.idx   indice disperso de ese segmento
+//   <dir>/00000000000002000000.seg   registros 2'000'000 .. (activo)
+//   <dir>/00000000000002000000.idx
+//
+// Cada segmento se crea con su tamano final y con el disco ya reservado
+// (posix_fallocate() en Linux) y se mapea con QFile::map(). append() es un
+// memcpy al mapeo bajo el mutex: ni write() ni fsync() por registro. Las
+// paginas sucias las escribe el SO cuando quiere.
+//
+// POR QUE RESERVAR: en un fichero disperso el disco se ocupa al escribir
+// cada pagina, y escribir en un mapeo no devuelve errores: con el disco
+// lleno el kernel mata el proceso con SIGBUS dentro del memcpy. Con los
+// bloques reservados al crear, el disco lleno es un error de rotacion: el
+// segmento activo se sella, el log se cierra y errorString() lo cuenta.
+// Fuera de Linux solo hay QFile::resize() y el fichero puede quedar
+// disperso.
+//
+// FORMATO DE UN SEGMENTO (enteros en el orden de bytes de la maquina):
+//   cabecera (HeaderBytes):
+//     "QTRECLOG" | version u32 | HeaderBytes u32 | firstId u64 |
+//     createdMs i64 | recordCount u64 | endOffset u64
+//     recordCount y endOffset valen 0 hasta que el segmento se sella.
+//   registros, uno detras de otro:
+//     length u32 | timestampMs i64 | sequence u64 | pattern i32 |
+//     offset i32 | datos (length - RecordHeaderBytes bytes)
+//     length cuenta el registro entero. length = 0 marca el final: el
+//     fichero nace a ceros y append() escribe length EL ULTIMO, asi que un
+//     registro a medias (el proceso murio escribiendo) no se ve.
+//
+// INDICE DISPERSO (.idx): una entrada { id, timestampMs, offset } cada
+// IndexInterval registros. Sirve para las dos busquedas del lector:
+//   - por id:     entrada (id - firstId) / IndexInterval y como mucho
+//                 IndexInterval - 1 saltos de 'length'.
+//   - por tiempo: los timestamps nunca bajan (se fuerzan monotonos), asi
+//                 que se busca en binario sobre las entradas y luego se
+//                 avanza registro a registro.
+// El .idx se escribe con QFile (con buffer). Si falta o esta corto, open()
+// lo reconstruye recorriendo el segmento.
+//
+// ROTACION Y RETENCION: si un registro no cabe en el segmento activo, se
+// sella (cabecera completa) y se abre otro que empieza en el id siguiente.
+// Con mas de maxSegments segmentos se borra el mas antiguo.
+//
+// DURABILIDAD: sobrevive a que el proceso muera (las paginas ya estan en la
+// cache del SO) pero no a un corte de corriente: no hay fsync. open() sobre
+// un directorio existente continua con los ids donde se quedaron.
+//
+// HILOS: escribe el Colector (su hilo); leen el modelo (hilo principal).
+// Un QMutex protege todo, como en RecordStore.
+// ============================================================================
+
+#ifndef SEGMENTLOG_H
+#define SEGMENTLOG_H
+
+#include <QFile>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "pipelinechunk.h"
+
+class SegmentLog
+{
+public:
+    static constexpr qint64 DefaultSegmentBytes = 64ll << 20;
+    static constexpr int DefaultMaxSegments = 64;
+    static constexpr int IndexInterval = 256;
+    static constexpr int HeaderBytes = 64;
+    static constexpr int RecordHeaderBytes = 28;
+
+    struct Record
+    {
+        qint64 timestampMs = 0;
+        quint64 sequence = 0;
+        int size = 0;
+        int pattern = -1;
+        int offset = -1;
+    };
+
+    // Ids en disco: [first, total). generation cambia con open(), close()
+    // y purge(): los ids anteriores dejan de ser comparables.
+    struct Window
+    {
+        quint64 first = 0;
+        quint64 total = 0;
+        quint64 generation = 0;
+    };
+
+    SegmentLog() = default;
+    ~SegmentLog();
+
+    SegmentLog(const SegmentLog &) = delete;
+    SegmentLog &operator=(const SegmentLog &) = delete;
+
+    // Abre (o crea) el log en 'dir' y recupera los segmentos que haya
+    bool open(const QString &dir, qint64 segmentBytes, int maxSegments,
+              QString *error = nullptr);
+    void close();
+    bool isOpen() const { return m_open.load(std::memory_order_acquire); }
+    // Borra todos los segmentos; los ids siguen donde estaban
+    void purge();
+    void setMaxSegments(int segments);
+
+    // Hilo del Colector. Sin efecto con el log cerrado.
+    void append(const PipelineChunk &chunk);
+
+    // ─── Lectura (cualquier hilo) ───────────────────────────────────
+    Window window() const;
+    bool record(quint64 id, Record &out) const;
+    // Los primeros maxBytes en hex ("DE AD BE EF"); vacio si no existe
+    QString hex(quint64 id, int maxBytes) const;
+    // Primer id con timestampMs >= ms (total si no hay ninguno)
+    quint64 idForTime(qint64 ms) const;
+    // Timestamps del primer y del ultimo registro (0 si esta vacio)
+    qint64 firstTimestampMs() const;
+    qint64 lastTimestampMs() const;
+    int segmentCount() const;
+    // Bytes escritos (registros + cabeceras + indices), no lo reservado
+    // por los segmentos
+    qint64 diskBytes() const;
+    QString path() const;
+    // Ultimo error de escritura (disco lleno, permisos...) o vacio
+    QString errorString() const;
+
+private:
+    struct IndexEntry
+    {
+        quint64 id = 0;
+        qint64 timestampMs = 0;
+        quint64 offset = 0;
+    };
+
+    struct Segment
+    {
+        QFile file;
+        QFile indexFile;
+        uchar *map = nullptr;
+        qint64 mapSize = 0;
+        quint64 firstId = 0;
+        quint64 count = 0;
+        qint64 end = HeaderBytes;     // Siguiente byte libre
+        qint64 firstTimestampMs = 0;
+        qint64 lastTimestampMs = 0;
+        bool sealed = false;
+        std::vector<IndexEntry> index;
+    };
+
+    // Posicion del ultimo registro leido: leer filas seguidas es O(1)
+    struct Cursor
+    {
+        const Segment *segment = nullptr;
+        quint64 id = 0;
+        qint64 offset = 0;
+    };
+
+    std::unique_ptr<Segment> openSegment(const QString &file, QString *error);
+    std::unique_ptr<Segment> createSegment(quint64 firstId, QString *error);
+    bool recover(Segment &segment, QString *error);
+    void addIndexEntry(Segment &segment, const IndexEntry &entry);
+    void seal(Segment &segment);
+    void closeSegment(Segment &segment);
+    void removeSegment(Segment &segment);
+    void enforceRetention();
+    bool roll();
+    // Registro 'id' -> su segmento y offset; con el mutex tomado
+    const uchar *locate(quint64 id, const Segment **segment = nullptr) const;
+    const Segment *segmentFor(quint64 id) const;
+    void resetLocked();
+
+    mutable QMutex m_mutex;
+    std::atomic<bool> m_open{false};
+    QString m_dir;
+    qint64 m_segmentBytes = DefaultSegmentBytes;
+    int m_maxSegments = DefaultMaxSegments;
+    std::vector<std::unique_ptr<Segment>> m_segments;
+    quint64 m_total = 0;
+    qint64 m_lastTimestampMs = 0;
+    quint64 m_generation = 0;
+    QString m_error;
+    mutable Cursor m_cursor;
+};
+
+#endif // SEGMENTLOG_H
@@ -0,0 +1,125 @@
+// ============================================================================
+// spscring.h - Ring buffer lock-free de un productor y un consumidor
+// ============================================================================
+//
+// PATRON: Cola SPSC (single-producer / single-consumer) de capacidad fija.
+// Es la alternativa de "produccion" a encolar cada dato como evento Qt:
+//
+//   Signal/slot cross-thread: cada emit crea un QMetaCallEvent en heap,
+//   copia los argumentos y lo mete en la cola de eventos del hilo receptor
+//   (con su mutex). Un evento por dato.
+//
+//   Ring SPSC: el dato se mueve a un hueco ya reservado del array. Solo dos
+//   indices atomicos, sin mutex y sin memoria dinamica por dato. El
+//   consumidor puede sacar muchos de golpe (popBatch).
+//
+// Como funciona:
+//   m_head -> lo escribe SOLO el productor (siguiente hueco a llenar)
+//   m_tail -> lo escribe SOLO el consumidor (siguiente hueco a leer)
+//   elementos = head - tail (los indices solo crecen, sin wrap)
+//   hueco     = indice & (capacidad - 1)   (capacidad potencia de 2)
+//
+//   El orden release/acquire garantiza que el consumidor ve el elemento
+//   completo antes que el head que lo publica. Cada lado cachea el indice
+//   del otro y solo relee el atomico cuando su copia dice lleno/vacio.
+//   alignas(64) separa los indices en lineas de cache distintas (evita
+//   false sharing entre los dos hilos).
+//
+// A diferencia de imports/ethernet/spscqueue.h, la capacidad se elige en
+// tiempo de ejecucion (la configura ThreadPipeline).
+//
+// Un SOLO productor y un SOLO consumidor. Con mas hilos NO es seguro.
+// ============================================================================
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+template <typename T>
+class SpscRing
+{
+public:
+    // La capacidad se redondea a la siguiente potencia de 2 (minimo 2)
+    explicit SpscRing(std::size_t capacity)
+    {
+        std::size_t rounded = 2;
+        while (rounded < capacity)
+            rounded <<= 1;
+        m_capacity = rounded;
+        m_mask = rounded - 1;
+        m_slots = std::make_unique<T[]>(rounded);
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    // ─── Lado productor ─────────────────────────────────────────────
+    // false si el ring esta lleno (el elemento NO se ha movido).
+    bool tryPush(T &&item)
+    {
+        const std::size_t head = m_head.load(std::memory_order_relaxed);
+        if (head - m_cachedTail == m_capacity) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head - m_cachedTail == m_capacity)
+                return false;
+        }
+
+        m_slots[head & m_mask] = std::move(item);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // ─── Lado consumidor ────────────────────────────────────────────
+    bool tryPop(T &item)
+    {
+        return popBatch(&item, 1) == 1;
+    }
+
+    // Saca hasta 'max' elementos de golpe: una lectura de head y una
+    // escritura de tail para todo el lote. Devuelve cuantos saco.
+    std::size_t popBatch(T *out, std::size_t max)
+    {
+        const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+        std::size_t available = m_cachedHead - tail;
+        if (available < max) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            available = m_cachedHead - tail;
+        }
+
+        const std::size_t count = available < max ? available : max;
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = std::move(m_slots[(tail + i) & m_mask]);
+
+        if (count > 0)
+            m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Numero aproximado de elementos (exacto solo si nadie opera a la vez)
+    std::size_t sizeApprox() const
+    {
+        return m_head.load(std::memory_order_acquire)
+               - m_tail.load(std::memory_order_acquire);
+    }
+
+    std::size_t capacity() const { return m_capacity; }
+
+private:
+    std::size_t m_capacity = 0;
+    std::size_t m_mask = 0;
+    std::unique_ptr<T[]> m_slots;
+
+    // ─── Lado productor ─────────────────────────────────────────────
+    alignas(64) std::atomic<std::size_t> m_head{0};
+    std::size_t m_cachedTail = 0;
+
+    // ─── Lado consumidor ────────────────────────────────────────────
+    alignas(64) std::atomic<std::size_t> m_tail{0};
+    std::size_t m_cachedHead = 0;
+};
+
+#endif // SPSCRING_H
@@ -0,0 +1,94 @@
+// ============================================================================
+// stagehistogram.cpp - Implementacion del histograma de latencias por etapa
+// ============================================================================
+
+#include "stagehistogram.h"
+
+StageHistogram::StageHistogram()
+{
+    clear();
+}
+
+void StageHistogram::clear()
+{
+    for (std::atomic<quint64> &bucket : m_buckets)
+        bucket.store(0, std::memory_order_relaxed);
+    m_maxNs.store(0, std::memory_order_relaxed);
+}
+
+// Un solo escritor: load + store relaxed basta (nadie mas incrementa). El
+// vaciado pendiente se aplica aqui, en el hilo que escribe; el release de
+// m_resetApplied publica las cubetas ya a 0 al lector.
+void StageHistogram::record(qint64 ns)
+{
+    const quint32 requested = m_resetRequested.load(std::memory_order_acquire);
+    if (requested != m_resetApplied.load(std::memory_order_relaxed)) {
+        clear();
+        m_resetApplied.store(requested, std::memory_order_release);
+    }
+
+    const quint64 value = ns > 0 ? quint64(ns) : 0;
+    std::atomic<quint64> &bucket = m_buckets[std::size_t(Buckets::index(value))];
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (qint64(value) > m_maxNs.load(std::memory_order_relaxed))
+        m_maxNs.store(qint64(value), std::memory_order_relaxed);
+}
+
+void StageHistogram::reset()
+{
+    m_resetRequested.fetch_add(1, std::memory_order_release);
+}
+
+// count sale de sumar las cubetas: siempre cuadra con ellas
+StageHistogram::Snapshot StageHistogram::snapshot() const
+{
+    Snapshot result;
+    if (m_resetApplied.load(std::memory_order_acquire)
+        != m_resetRequested.load(std::memory_order_relaxed))
+        return result;   // Reset pedido y aun sin aplicar: todo cuenta como 0
+
+    for (int i = 0; i < kBucketCount; ++i) {
+        const quint64 n = m_buckets[std::size_t(i)].load(std::memory_order_relaxed);
+        result.buckets[std::size_t(i)] = n;
+        result.count += n;
+    }
+    result.maxNs = m_maxNs.load(std::memory_order_relaxed);
+    return result;
+}
+
+// ─── Snapshot ──────────────────────────────────────────────────────
+
+void StageHistogram::Snapshot::merge(const Snapshot &other)
+{
+    for (int i = 0; i < kBucketCount; ++i)
+        buckets[std::size_t(i)] += other.buckets[std::size_t(i)];
+    count += other.count;
+    maxNs = qMax(maxNs, other.maxNs);
+}
+
+qint64 StageHistogram::Snapshot::percentileNs(double percentile) const
+{
+    return Buckets::percentile(buckets, count, maxNs, percentile);
+}
+
+QVariantMap StageHistogram::Snapshot::toVariantMap() const
+{
+    QVariantMap result;
+    result[QStringLiteral("samples")] = double(count);
+    result[QStringLiteral("p50Ns")] = double(percentileNs(50.0));
+    result[QStringLiteral("p90Ns")] = double(percentileNs(90.0));
+    result[QStringLiteral("p99Ns")] = double(percentileNs(99.0));
+    result[QStringLiteral("p999Ns")] = double(percentileNs(99.9));
+    result[QStringLiteral("maxNs")] = double(maxNs);
+    return result;
+}
+
+void StageHistogram::Snapshot::writeJson(QJsonObject &json, const QString &prefix) const
+{
+    json[prefix + QStringLiteral("Samples")] = double(count);
+    json[prefix + QStringLiteral("P50Ns")] = double(percentileNs(50.0));
+    json[prefix + QStringLiteral("P90Ns")] = double(percentileNs(90.0));
+    json[prefix + QStringLiteral("P99Ns")] = double(percentileNs(99.0));
+    json[prefix + QStringLiteral("P999Ns")] = double(percentileNs(99.9));
+    json[prefix + QStringLiteral("MaxNs")] = double(maxNs);
+}
@@ -0,0 +1,84 @@
+// ============================================================================
+// stagehistogram.h - Histograma de latencias de una etapa (estilo HDR)
+// ============================================================================
+//
+// Mismo esquema de cubetas que LatencyHistogram (modulo ethernet), con dos
+// diferencias que impone el pipeline:
+//   - NANOSEGUNDOS: filtrar un chunk de 100 bytes cuesta decenas de ns; en
+//     microsegundos todo caeria en la cubeta 0.
+//   - UN ESCRITOR, UN LECTOR EN OTRO HILO: la etapa registra en su hilo y
+//     ThreadPipeline lee desde el hilo principal a 10 Hz. Los contadores
+//     son std::atomic con memory_order_relaxed; como solo escribe un hilo,
+//     record() hace load + store (sin RMW, sin lock).
+//
+// CUBETAS: LogLinearBuckets<40> (imports/common), las mismas que
+// LatencyHistogram en nanosegundos: 304 cubetas hasta 2^40 ns (~18 min).
+//
+// RESET DESDE EL LECTOR: si el hilo principal pusiera las cubetas a 0, un
+// record() a medias (load ... store) devolveria el valor viejo + 1. Por eso
+// reset() solo PIDE el vaciado subiendo una generacion; el escritor lo
+// aplica en su siguiente record(), antes de contar, y publica la generacion
+// aplicada. Mientras no la haya aplicado, snapshot() devuelve un Snapshot
+// vacio: nunca mezcla datos de antes y de despues del reset.
+//
+// LECTURA: snapshot() copia las cubetas a un Snapshot (valor normal). Los
+// Snapshot de varios Filtros se suman con merge() y de ahi salen los
+// percentiles, que devuelven el limite SUPERIOR de la cubeta (estimacion
+// pesimista). Un snapshot tomado mientras la etapa escribe puede llevar
+// una muestra de menos: nunca un valor roto.
+// ============================================================================
+
+#ifndef STAGEHISTOGRAM_H
+#define STAGEHISTOGRAM_H
+
+#include <QJsonObject>
+#include <QVariantMap>
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+#include "loglinearbuckets.h"
+
+class StageHistogram
+{
+    using Buckets = LogLinearBuckets<40>;      // hasta 2^40 ns
+    static constexpr int kBucketCount = Buckets::kBucketCount;
+
+public:
+    struct Snapshot
+    {
+        Buckets::Counts buckets{};
+        quint64 count = 0;
+        qint64 maxNs = 0;
+
+        void merge(const Snapshot &other);
+        // Percentil en [0, 100] -> nanosegundos (limite superior de su cubeta)
+        qint64 percentileNs(double percentile) const;
+        // { samples, p50Ns, p90Ns, p99Ns, p999Ns, maxNs }
+        QVariantMap toVariantMap() const;
+        // Las mismas claves con un prefijo: "serviceP99Ns"...
+        void writeJson(QJsonObject &json, const QString &prefix) const;
+    };
+
+    StageHistogram();
+
+    StageHistogram(const StageHistogram &) = delete;
+    StageHistogram &operator=(const StageHistogram &) = delete;
+
+    // Solo desde el hilo de la etapa (negativas cuentan como 0)
+    void record(qint64 ns);
+    // Desde el hilo lector: lo aplica el escritor en su siguiente record()
+    void reset();
+
+    Snapshot snapshot() const;
+
+private:
+    // Solo el escritor (o el constructor, antes de que haya escritor)
+    void clear();
+
+    std::array<std::atomic<quint64>, kBucketCount> m_buckets;
+    std::atomic<qint64> m_maxNs{0};
+    std::atomic<quint32> m_resetRequested{0};   // Lo sube el lector
+    std::atomic<quint32> m_resetApplied{0};     // Lo iguala el escritor
+};
+
+#endif // STAGEHISTOGRAM_H
@@ -12,22 +12,58 @@
 //   7. Al parar: detener productor, quit() event loops, wait() hilos
 //   8. Workers se eliminan automaticamente via finished -> deleteLater
 //
-// CADENA DEL PIPELINE:
+// CADENA DEL PIPELINE (transport == SignalSlot):
 //   Generator::dataGenerated --> Filter::processData --> Collector::collectData
 //   Todas son conexiones cross-thread con QueuedConnection automatica.
+//
+// CADENA DEL PIPELINE (transport == SpscRings):
+//   Generator --m_filterInputs--> Filter --m_collectorInputs--> Collector
+//   Un PipelineChannel por cola: ring SPSC + un drainInput() por rafaga.
+//
+// En ambos modos cada salto esta acotado (capacidad + OverflowPolicy):
+// el Generador no puede adelantarse sin limite al Filtro.
+//
+// FILTROS EN PARALELO (filterWorkers = N > 1):
+//   Generator --sequence % N--> Filter[i] --> Collector (ReorderBuffer)
+//   N hilos de Filtro, N colas de entrada y N colas hacia el Colector.
+//   Sigue habiendo un solo productor y un solo consumidor por cola.
+//
+// COLOCACION (setStagePlacement):
+//   Cada hilo se fija a su CPU y politica al arrancar, desde si mismo
+//   (QThread::started). Sin ajustes no se toca nada: decide el sistema.
 // ============================================================================
 
 #include "threadpipeline.h"
 #include "pipelineworkers.h"
+#include "pipelinechannel.h"
+#include "pipelinebenchmark.h"
+#include "patternmatcher.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaEnum>
 #include <QMetaObject>
 
 ThreadPipeline::ThreadPipeline(QObject *parent)
     : QObject(parent)
+    , m_records(this)   // Con parent: QML nunca toma su ownership
+    , m_recordLog(this)
 {
     // Nombres para depuracion: aparecen en herramientas como QThread::objectName()
     m_generatorThread.setObjectName(QStringLiteral("GeneratorThread"));
-    m_filterThread.setObjectName(QStringLiteral("FilterThread"));
     m_collectorThread.setObjectName(QStringLiteral("CollectorThread"));
+
+    // Las profundidades cambian con cada chunk: en vez de una signal por
+    // cambio, el hilo principal las muestrea a 10 Hz mientras corre.
+    m_queueSampler.setInterval(100);
+    connect(&m_queueSampler, &QTimer::timeout, this, &ThreadPipeline::sampleQueues);
+    connect(&m_queueSampler, &QTimer::timeout, this, &ThreadPipeline::sampleFilters);
+    connect(&m_queueSampler, &QTimer::timeout, this, &ThreadPipeline::sampleMetrics);
+    // Los registros tambien: un refresh() publica en bloque todo lo que el
+    // Colector guardo en los ultimos 100 ms
+    connect(&m_queueSampler, &QTimer::timeout, &m_records, &RecordListModel::refresh);
+    connect(&m_queueSampler, &QTimer::timeout, &m_recordLog, &RecordLogModel::refresh);
+    connect(&m_records, &RecordListModel::countChanged,
+            this, &ThreadPipeline::recordCountChanged);
 }
 
 // El destructor asegura que los hilos se detengan limpiamente.
@@ -47,12 +83,11 @@ int ThreadPipeline::generatedCount() const { return m_generatedCount; }
 int ThreadPipeline::processedCount() const { return m_processedCount; }
 int ThreadPipeline::matchedCount() const { return m_matchedCount; }
 
-int ThreadPipeline::recordCount() const
-{
-    // recordCount() accede al CollectorWorker que vive en otro hilo.
-    // Es seguro porque CollectorWorker::recordCount() usa QMutexLocker.
-    return m_collector ? m_collector->recordCount() : 0;
-}
+// Filas publicadas por el modelo (no lo que el Colector lleva guardado en
+// este instante): asi el contador y la lista de QML siempre coinciden.
+int ThreadPipeline::recordCount() const { return m_records.count(); }
+RecordListModel *ThreadPipeline::records() { return &m_records; }
+RecordLogModel *ThreadPipeline::recordLog() { return &m_recordLog; }
 
 QString ThreadPipeline::mainThreadId() const
 {
@@ -83,7 +118,235 @@ void ThreadPipeline::setGenerationInterval(int ms)
 
 QString ThreadPipeline::filterPatternHex() const
 {
-    return m_filterPattern.toHex(' ');
+    return m_filterPatterns.join(QStringLiteral(" | "));
+}
+
+QStringList ThreadPipeline::filterPatterns() const { return m_filterPatterns; }
+
+ThreadPipeline::Transport ThreadPipeline::transport() const { return m_transport; }
+
+// El transporte se elige al crear los workers: cambiarlo con el pipeline
+// en marcha solo tiene efecto en el siguiente start().
+void ThreadPipeline::setTransport(Transport transport)
+{
+    if (m_transport == transport)
+        return;
+    m_transport = transport;
+    emit transportChanged();
+}
+
+ThreadPipeline::GeneratorMode ThreadPipeline::generatorMode() const { return m_generatorMode; }
+
+void ThreadPipeline::setGeneratorMode(GeneratorMode mode)
+{
+    if (m_generatorMode == mode)
+        return;
+    m_generatorMode = mode;
+    emit generatorModeChanged();
+}
+
+int ThreadPipeline::generatorBatchSize() const { return m_generatorBatchSize; }
+
+void ThreadPipeline::setGeneratorBatchSize(int chunks)
+{
+    chunks = qBound(1, chunks, 65536);
+    if (m_generatorBatchSize == chunks)
+        return;
+    m_generatorBatchSize = chunks;
+    emit generatorModeChanged();
+}
+
+double ThreadPipeline::generatorPoolHitRate() const { return m_generatorPoolHitRate; }
+
+ThreadPipeline::OverflowPolicy ThreadPipeline::overflowPolicy() const { return m_overflowPolicy; }
+
+void ThreadPipeline::setOverflowPolicy(OverflowPolicy policy)
+{
+    if (m_overflowPolicy == policy)
+        return;
+    m_overflowPolicy = policy;
+    emit overflowPolicyChanged();
+}
+
+int ThreadPipeline::filterQueueCapacity() const { return m_filterQueueCapacity; }
+int ThreadPipeline::collectorQueueCapacity() const { return m_collectorQueueCapacity; }
+
+void ThreadPipeline::setFilterQueueCapacity(int capacity)
+{
+    capacity = qBound(1, capacity, MaxQueueCapacity);
+    if (m_filterQueueCapacity == capacity)
+        return;
+    m_filterQueueCapacity = capacity;
+    emit queueCapacityChanged();
+}
+
+void ThreadPipeline::setCollectorQueueCapacity(int capacity)
+{
+    capacity = qBound(1, capacity, MaxQueueCapacity);
+    if (m_collectorQueueCapacity == capacity)
+        return;
+    m_collectorQueueCapacity = capacity;
+    emit queueCapacityChanged();
+}
+
+int ThreadPipeline::filterQueueDepth() const { return m_filterQueue.depth; }
+int ThreadPipeline::filterQueuePeak() const { return m_filterQueue.peak; }
+int ThreadPipeline::filterDropped() const { return int(m_filterQueue.dropped); }
+int ThreadPipeline::collectorQueueDepth() const { return m_collectorQueue.depth; }
+int ThreadPipeline::collectorQueuePeak() const { return m_collectorQueue.peak; }
+int ThreadPipeline::collectorDropped() const { return int(m_collectorQueue.dropped); }
+
+int ThreadPipeline::filterWorkers() const { return m_filterWorkers; }
+
+void ThreadPipeline::setFilterWorkers(int workers)
+{
+    workers = qBound(1, workers, maxFilterWorkers());
+    if (m_filterWorkers == workers)
+        return;
+    m_filterWorkers = workers;
+    emit filterWorkersChanged();
+}
+
+// Mas Filtros que nucleos solo anade cambios de contexto
+int ThreadPipeline::maxFilterWorkers() const
+{
+    return qMax(QThread::idealThreadCount(), 1);
+}
+
+QVariantList ThreadPipeline::filterWorkerStats() const
+{
+    QVariantList list;
+    for (std::size_t i = 0; i < m_filterStats.size(); ++i) {
+        const FilterStats &s = m_filterStats[i];
+        QVariantMap map;
+        map[QStringLiteral("index")] = int(i);
+        map[QStringLiteral("threadId")] = s.threadId;
+        map[QStringLiteral("processed")] = s.processed;
+        map[QStringLiteral("matched")] = s.matched;
+        map[QStringLiteral("chunksPerSec")] = s.chunksPerSec;
+        map[QStringLiteral("load")] = s.load;
+        map[QStringLiteral("queueDepth")] = s.queueDepth;
+        list.append(map);
+    }
+    return list;
+}
+
+double ThreadPipeline::filterThroughput() const { return m_filterThroughput; }
+int ThreadPipeline::reorderPending() const { return m_reorderPending; }
+QVariantList ThreadPipeline::stageMetrics() const { return m_metrics.stages(); }
+QVariantMap ThreadPipeline::endToEndLatency() const { return m_metrics.endToEndStats(); }
+
+QVariantList ThreadPipeline::stagePlacement() const
+{
+    QVariantList list;
+    for (int stage = 0; stage < PipelineMetrics::StageCount; ++stage) {
+        const StagePlacement &placement = m_placement[std::size_t(stage)];
+        QVariantMap map;
+        map[QStringLiteral("stage")] = PipelineMetrics::stageName(stage);
+        map[QStringLiteral("cpu")] = placement.settings.cpu;
+        map[QStringLiteral("policy")] = int(placement.settings.policy);
+        map[QStringLiteral("priority")] = placement.settings.priority;
+        map[QStringLiteral("threads")] = placement.threads;
+        list.append(map);
+    }
+    return list;
+}
+
+int ThreadPipeline::cpuCount() const { return ThreadPlacement::cpuCount(); }
+QList<int> ThreadPipeline::allowedCpus() const { return ThreadPlacement::allowedCpus(); }
+bool ThreadPipeline::placementSupported() const { return ThreadPlacement::supported(); }
+
+// Como el resto de la configuracion, vale para el siguiente start()
+void ThreadPipeline::setStagePlacement(int stage, int cpu, SchedulingPolicy policy, int priority)
+{
+    if (stage < 0 || stage >= PipelineMetrics::StageCount)
+        return;
+    ThreadPlacement::Settings &settings = m_placement[std::size_t(stage)].settings;
+    settings.cpu = ThreadPlacement::allowedCpus().contains(cpu) ? cpu : -1;
+    settings.policy = static_cast<ThreadPlacement::Policy>(policy);
+    settings.priority = priority;
+    emit stagePlacementChanged();
+}
+
+// sampleQueues() corre en el hilo principal (QTimer). Los contadores del
+// canal son atomicos: leerlos desde aqui es seguro sin mutex.
+// Con varios Filtros se resume cada salto con su cola mas llena (depth y
+// peak se comparan con la capacidad, que es por cola) y la suma de los
+// descartes.
+void ThreadPipeline::sampleQueues()
+{
+    auto sample = [](const std::vector<std::unique_ptr<PipelineChannel>> &channels,
+                     QueueStats &stats) {
+        if (channels.empty())
+            return;
+        QueueStats total;
+        for (const auto &channel : channels) {
+            total.depth = qMax(total.depth, channel->depth());
+            total.peak = qMax(total.peak, channel->peakDepth());
+            total.dropped += channel->dropped();
+        }
+        stats = total;
+    };
+    sample(m_filterInputs, m_filterQueue);
+    sample(m_collectorInputs, m_collectorQueue);
+    emit queueStatsChanged();
+}
+
+// sampleFilters() lee los contadores atomicos de cada FilterWorker. Tasa
+// y carga salen de la diferencia con la muestra anterior: chunks/s y la
+// fraccion del intervalo que el hilo paso filtrando (1.0 = saturado).
+void ThreadPipeline::sampleFilters()
+{
+    if (m_filters.isEmpty())
+        return;
+
+    const qint64 nowNs = m_sampleClock.nsecsElapsed();
+    const qint64 intervalNs = nowNs - m_lastSampleNs;
+    m_lastSampleNs = nowNs;
+
+    int processed = 0;
+    int matched = 0;
+    double throughput = 0.0;
+    for (int i = 0; i < m_filters.size(); ++i) {
+        const FilterWorker *filter = m_filters.at(i);
+        FilterStats &s = m_filterStats[std::size_t(i)];
+
+        const int nowProcessed = filter->processedCount();
+        const qint64 nowBusyNs = filter->busyNs();
+        if (intervalNs > 0) {
+            s.chunksPerSec = double(nowProcessed - s.processed) * 1e9 / double(intervalNs);
+            s.load = qBound(0.0, double(nowBusyNs - s.busyNs) / double(intervalNs), 1.0);
+        }
+        s.processed = nowProcessed;
+        s.matched = filter->matchedCount();
+        s.busyNs = nowBusyNs;
+        s.queueDepth = m_filterInputs[std::size_t(i)]->depth();
+
+        processed += s.processed;
+        matched += s.matched;
+        throughput += s.chunksPerSec;
+    }
+
+    m_filterThroughput = throughput;
+    m_reorderPending = m_collector ? m_collector->reorderPending() : 0;
+    m_processedCount = processed;
+    m_matchedCount = matched;
+    emit processedCountChanged();
+    emit matchedCountChanged();
+    emit filterStatsChanged();
+}
+
+// sampleMetrics() solo calcula items/s: los percentiles se sacan de los
+// histogramas cuando QML lee stageMetrics (una vez por metricsChanged).
+void ThreadPipeline::sampleMetrics()
+{
+    m_metrics.sample();
+    if (m_generator) {
+        const quint64 hits = m_generator->poolHits();
+        const quint64 total = hits + m_generator->poolMisses();
+        m_generatorPoolHitRate = total > 0 ? double(hits) / double(total) : 0.0;
+    }
+    emit metricsChanged();
 }
 
 // ============================================================================
@@ -108,6 +371,14 @@ void ThreadPipeline::start()
     m_generatedCount = 0;
     m_processedCount = 0;
     m_matchedCount = 0;
+    m_filterQueue = QueueStats();
+    m_collectorQueue = QueueStats();
+    m_filterThroughput = 0.0;
+    m_reorderPending = 0;
+    m_filterStats.assign(std::size_t(m_filterWorkers), FilterStats());
+    // Cada ejecucion mide desde cero. Antes de arrancar los hilos: reset()
+    // crea un StageMetrics por Filtro y ningun worker los usa todavia.
+    m_metrics.reset(m_filterWorkers);
     emit generatedCountChanged();
     emit processedCountChanged();
     emit matchedCountChanged();
@@ -115,28 +386,98 @@ void ThreadPipeline::start()
     // Paso 1: Crear workers sin parent (required for moveToThread)
     // Si tuvieran parent, moveToThread() fallaria con un warning porque
     // Qt no permite mover un objeto que tiene parent en otro hilo.
+    const int shards = m_filterWorkers;
     m_generator = new GeneratorWorker();
-    m_filter = new FilterWorker();
+    for (int i = 0; i < shards; ++i)
+        m_filters.append(new FilterWorker());
     m_collector = new CollectorWorker();
 
     // Paso 2: Apply config BEFORE moveToThread (safe: still on main thread)
     m_generator->setInterval(m_generationInterval);
-    m_filter->setFilterPattern(m_filterPattern);
+    // Pool: un lote entero mas todo lo que cabe en las colas (el doble de
+    // la capacidad, por los chunks pendientes de descartar con DropOldest)
+    const bool freeRunning = m_generatorMode == FreeRunning;
+    m_generator->setFreeRunning(freeRunning, m_generatorBatchSize);
+    const qint64 inFlight = (freeRunning ? m_generatorBatchSize : 1)
+        + qint64(shards) * 2 * (qint64(m_filterQueueCapacity) + m_collectorQueueCapacity);
+    m_generator->setPoolSlots(int(qMin<qint64>(inFlight, ChunkBufferPool::MaxSlots)));
+    m_generatorPoolHitRate = 0.0;
+    m_generator->setMetrics(m_metrics.generator());
+    for (int i = 0; i < shards; ++i) {
+        FilterWorker *filter = m_filters.at(i);
+        filter->setFilterPatterns(m_filterPatterns);
+        // Con un solo Filtro los chunks ya llegan en orden al Colector
+        filter->setProgressMarkers(shards > 1);
+        filter->setMetrics(m_metrics.filter(i));
+    }
+    m_collector->setMetrics(m_metrics.collector(), m_metrics.endToEnd());
 
     // Paso 3: Move workers to their threads
     // Despues de esto, los slots de cada worker se ejecutan en su hilo.
     m_generator->moveToThread(&m_generatorThread);
-    m_filter->moveToThread(&m_filterThread);
+    for (int i = 0; i < shards; ++i) {
+        auto thread = std::make_unique<QThread>();
+        thread->setObjectName(QStringLiteral("FilterThread-%1").arg(i));
+        m_filters.at(i)->moveToThread(thread.get());
+        m_filterThreads.push_back(std::move(thread));
+    }
     m_collector->moveToThread(&m_collectorThread);
 
     // Paso 4: Cadena del pipeline (Generator -> Filter -> Collector)
     // Estas conexiones son automaticamente QueuedConnection porque emisor
     // y receptor viven en hilos diferentes. Qt serializa los argumentos
     // (QByteArray se copia) y los encola en el event loop del receptor.
-    connect(m_generator, &GeneratorWorker::dataGenerated,
-            m_filter, &FilterWorker::processData);
-    connect(m_filter, &FilterWorker::dataMatched,
-            m_collector, &CollectorWorker::collectData);
+    //
+    // Cada salto tiene ademas un PipelineChannel que acota la cola. En modo
+    // SpscRings el chunk viaja por el ring del canal; en SignalSlot viaja
+    // por la signal y el canal solo cuenta los que estan en vuelo. Se
+    // enlazan aqui, antes de arrancar los hilos: despues nadie cambia los
+    // punteros.
+    //
+    // Con N Filtros hay N canales en cada salto, uno por Filtro: cada cola
+    // sigue teniendo un unico productor y un unico consumidor.
+    const auto policy = static_cast<PipelineChannel::Overflow>(m_overflowPolicy);
+    const auto kind = m_transport == SpscRings ? PipelineChannel::Kind::Ring
+                                               : PipelineChannel::Kind::SignalCount;
+    QList<PipelineChannel *> filterInputs;
+    QList<PipelineChannel *> collectorInputs;
+    QList<QObject *> receivers;
+    for (FilterWorker *filter : std::as_const(m_filters)) {
+        m_filterInputs.push_back(
+            std::make_unique<PipelineChannel>(m_filterQueueCapacity, policy, kind));
+        m_collectorInputs.push_back(
+            std::make_unique<PipelineChannel>(m_collectorQueueCapacity, policy, kind));
+        PipelineChannel *input = m_filterInputs.back().get();
+        PipelineChannel *output = m_collectorInputs.back().get();
+
+        filter->setInput(input);
+        filter->setOutput(output);
+        filterInputs.append(input);
+        collectorInputs.append(output);
+        receivers.append(filter);
+
+        if (m_transport == SpscRings) {
+            input->setConsumer(filter, "drainInput");
+            output->setConsumer(m_collector, "drainInput");
+        } else {
+            connect(filter, &FilterWorker::dataMatched,
+                    m_collector, &CollectorWorker::collectData);
+        }
+    }
+    m_generator->setOutputs(filterInputs);
+    m_collector->setInputs(collectorInputs);
+    m_collector->setStore(m_records.store());
+    m_collector->setLog(m_recordLog.log());
+
+    // Signal/slot: con un Filtro, la signal de siempre; con varios, el
+    // Generador invoca processData() en el Filtro de cada chunk
+    if (m_transport == SignalSlot) {
+        if (shards == 1)
+            connect(m_generator, &GeneratorWorker::dataGenerated,
+                    m_filters.first(), &FilterWorker::processData);
+        else
+            m_generator->setShardReceivers(receivers);
+    }
 
     // Actualizaciones de contadores: workers (hilos de fondo) -> pipeline (hilo principal)
     // Tambien son QueuedConnection automaticas. Las lambdas se ejecutan en
@@ -147,21 +488,11 @@ void ThreadPipeline::start()
         m_generatedCount = count;
         emit generatedCountChanged();
     });
-    connect(m_filter, &FilterWorker::statsChanged,
-            this, [this](int processed, int matched) {
-        m_processedCount = processed;
-        m_matchedCount = matched;
-        emit processedCountChanged();
-        emit matchedCountChanged();
-    });
-    connect(m_collector, &CollectorWorker::recordCountChanged,
-            this, [this]() {
-        emit recordCountChanged();
-    });
-
-    // Record added -> forward to QML
-    connect(m_collector, &CollectorWorker::recordAdded,
-            this, &ThreadPipeline::recordAdded);
+    // Los contadores de los Filtros no van por signal: sampleFilters() lee
+    // sus atomicos a 10 Hz y calcula de paso la carga de cada uno.
+    // Los registros tampoco: el Colector los escribe en m_records.store()
+    // (y en m_recordLog.log() si esta abierto) y los modelos los publican
+    // en su refresh().
 
     // Thread ID reporting
     connect(m_generator, &GeneratorWorker::threadIdReady,
@@ -169,11 +500,18 @@ void ThreadPipeline::start()
         m_generatorThreadId = id;
         emit generatorThreadIdChanged();
     });
-    connect(m_filter, &FilterWorker::threadIdReady,
-            this, [this](const QString &id) {
-        m_filterThreadId = id;
-        emit filterThreadIdChanged();
-    });
+    for (int i = 0; i < shards; ++i) {
+        connect(m_filters.at(i), &FilterWorker::threadIdReady,
+                this, [this, i](const QString &id) {
+            if (std::size_t(i) < m_filterStats.size())
+                m_filterStats[std::size_t(i)].threadId = id;
+            // filterThreadId (ThreadInfoCard) muestra el primer Filtro
+            if (i == 0) {
+                m_filterThreadId = id;
+                emit filterThreadIdChanged();
+            }
+        });
+    }
     connect(m_collector, &CollectorWorker::threadIdReady,
             this, [this](const QString &id) {
         m_collectorThreadId = id;
@@ -186,23 +524,42 @@ void ThreadPipeline::start()
     // del hilo del objeto (que ya termino), y Qt maneja la destruccion
     // pendiente correctamente.
     connect(&m_generatorThread, &QThread::finished, m_generator, &QObject::deleteLater);
-    connect(&m_filterThread, &QThread::finished, m_filter, &QObject::deleteLater);
+    for (int i = 0; i < shards; ++i)
+        connect(m_filterThreads[std::size_t(i)].get(), &QThread::finished,
+                m_filters.at(i), &QObject::deleteLater);
     connect(&m_collectorThread, &QThread::finished, m_collector, &QObject::deleteLater);
 
+    // CPU y politica de cada hilo: se aplican al arrancar (ver placeThread)
+    ++m_placementRun;
+    for (StagePlacement &placement : m_placement)
+        placement.threads.clear();
+    placeThread(&m_generatorThread, m_generator, PipelineMetrics::Generator, 0);
+    for (int i = 0; i < shards; ++i)
+        placeThread(m_filterThreads[std::size_t(i)].get(), m_filters.at(i),
+                    PipelineMetrics::Filter, i);
+    placeThread(&m_collectorThread, m_collector, PipelineMetrics::Collector, 0);
+    emit stagePlacementChanged();
+
     // Paso 5: Iniciar hilos - consumidores primero, productor al final.
     // Asi el Colector y Filtro ya tienen su event loop corriendo cuando
     // el Generador empiece a producir datos.
     m_collectorThread.start();
-    m_filterThread.start();
+    for (const auto &thread : m_filterThreads)
+        thread->start();
     m_generatorThread.start();
 
     // Paso 6: Invocar start() en cada worker en su event loop.
     // QMetaObject::invokeMethod con QueuedConnection es la forma segura
     // de llamar un slot en un objeto que vive en otro hilo.
     QMetaObject::invokeMethod(m_collector, "start", Qt::QueuedConnection);
-    QMetaObject::invokeMethod(m_filter, "start", Qt::QueuedConnection);
+    for (FilterWorker *filter : std::as_const(m_filters))
+        QMetaObject::invokeMethod(filter, "start", Qt::QueuedConnection);
     QMetaObject::invokeMethod(m_generator, "start", Qt::QueuedConnection);
 
+    m_sampleClock.start();
+    m_lastSampleNs = 0;
+    m_queueSampler.start();
+
     m_running = true;
     emit runningChanged();
 }
@@ -224,6 +581,7 @@ void ThreadPipeline::stop()
         QMetaObject::invokeMethod(m_generator, "stop", Qt::QueuedConnection);
 
     // Flush final counts
+    m_queueSampler.stop();
     emit generatedCountChanged();
     emit processedCountChanged();
     emit matchedCountChanged();
@@ -247,12 +605,31 @@ void ThreadPipeline::stop()
 
 void ThreadPipeline::cleanupThreads()
 {
+    // Con Block, un productor puede estar esperando hueco en una cola
+    // llena: close() lo libera para que su hilo vuelva al event loop y
+    // atienda quit().
+    for (const auto &channel : m_filterInputs)
+        channel->close();
+    for (const auto &channel : m_collectorInputs)
+        channel->close();
+
     // Quit event loops and wait for threads to finish
     m_generatorThread.quit();
     m_generatorThread.wait();
 
-    m_filterThread.quit();
-    m_filterThread.wait();
+    // Ultima lectura de los Filtros mientras existen: tras su wait()
+    // deleteLater() ya los habra destruido
+    sampleFilters();
+    m_filterThroughput = 0.0;
+    for (FilterStats &s : m_filterStats) {
+        s.chunksPerSec = 0.0;
+        s.load = 0.0;
+    }
+
+    for (const auto &thread : m_filterThreads) {
+        thread->quit();
+        thread->wait();
+    }
 
     m_collectorThread.quit();
     m_collectorThread.wait();
@@ -260,31 +637,211 @@ void ThreadPipeline::cleanupThreads()
     // Workers are deleted by QThread::finished -> deleteLater
     // Ponemos los punteros a null para evitar dangling pointers.
     m_generator = nullptr;
-    m_filter = nullptr;
+    m_filters.clear();
     m_collector = nullptr;
+    m_filterThreads.clear();
+
+    // Ningun hilo toca ya los canales: ultima muestra (los descartes
+    // quedan visibles con el pipeline parado) y se destruyen
+    sampleQueues();
+    m_records.refresh();
+    m_recordLog.refresh();
+    m_metrics.clearRates();
+    emit filterStatsChanged();
+    emit metricsChanged();
+    m_filterInputs.clear();
+    m_collectorInputs.clear();
+}
+
+// ============================================================================
+// placeThread() - Fijar CPU y politica de un hilo al arrancar
+// ============================================================================
+// pthread_setaffinity_np() y pthread_setschedparam() se llaman desde el
+// propio hilo: QThread::started se emite EN el hilo nuevo, antes de su
+// event loop, asi que una DirectConnection ejecuta la lambda alli. El
+// contexto es el worker: la conexion muere con el al terminar el hilo.
+// El resultado vuelve al hilo principal con una QueuedConnection.
+
+void ThreadPipeline::placeThread(QThread *thread, QObject *worker, int stage, int index)
+{
+    ThreadPlacement::Settings settings = m_placement[std::size_t(stage)].settings;
+    const QString name = thread->objectName();
+    QVariantMap pending;
+    pending[QStringLiteral("name")] = name;
+    pending[QStringLiteral("cpu")] = -1;
+    pending[QStringLiteral("numaNode")] = -1;
+    pending[QStringLiteral("ok")] = true;
+    m_placement[std::size_t(stage)].threads.append(pending);
+    if (settings.isDefault())
+        return;
+
+    // Los Filtros se reparten por el cpuset, no por 0..cpuCount-1: con
+    // CPUs permitidas {2, 3, 6, 7} y cpu 3, van a 3, 6, 7, 2...
+    if (settings.cpu >= 0) {
+        const QList<int> allowed = ThreadPlacement::allowedCpus();
+        const int first = qMax(allowed.indexOf(settings.cpu), 0);
+        settings.cpu = allowed.at((first + index) % allowed.size());
+    }
+    const int run = m_placementRun;
+    connect(thread, &QThread::started, worker, [this, settings, stage, index, name, run]() {
+        const ThreadPlacement::Result result = ThreadPlacement::apply(settings);
+        QMetaObject::invokeMethod(this, [this, result, stage, index, name, run]() {
+            QVariantList &threads = m_placement[std::size_t(stage)].threads;
+            if (run != m_placementRun || index >= threads.size())
+                return;
+            QVariantMap map;
+            map[QStringLiteral("name")] = name;
+            map[QStringLiteral("cpu")] = result.cpu;
+            map[QStringLiteral("numaNode")] = result.numaNode;
+            map[QStringLiteral("summary")] = result.summary;
+            map[QStringLiteral("error")] = result.error;
+            map[QStringLiteral("ok")] = result.ok;
+            threads[index] = map;
+            emit stagePlacementChanged();
+        }, Qt::QueuedConnection);
+    }, Qt::DirectConnection);
 }
 
 // ─── Actions ───────────────────────────────────────────────────────
 
+// RecordStore tiene su propio mutex: se puede vaciar con el Colector en
+// marcha, y refresh() reinicia el modelo (recordCountChanged via countChanged)
 void ThreadPipeline::clear()
 {
-    if (m_collector)
-        m_collector->clearRecords();
-    emit recordCountChanged();
+    m_records.clear();
 }
 
 // setFilterPattern() recibe un array desde QML (QVariantList) y lo convierte
-// a QByteArray para el FilterWorker. Usa invokeMethod con QueuedConnection
-// porque el worker vive en otro hilo.
+// en un unico patron literal para el FilterWorker.
 void ThreadPipeline::setFilterPattern(const QVariantList &bytes)
 {
     QByteArray pattern;
     for (const auto &v : bytes)
         pattern.append(static_cast<char>(v.toInt()));
 
-    m_filterPattern = pattern;
-    if (m_filter)
-        QMetaObject::invokeMethod(m_filter, "setFilterPattern",
-            Qt::QueuedConnection, Q_ARG(QByteArray, pattern));
+    setFilterPatterns({ PatternMatcher::toString(PatternMatcher::literal(pattern)) });
+}
+
+// setFilterPatterns() valida en el hilo principal (para poder devolver el
+// error a QML) y normaliza el texto ("dead??ef" -> "DE AD ?? EF"). El
+// FilterWorker recibe la lista con invokeMethod + QueuedConnection porque
+// vive en otro hilo, y construye alli su automata.
+bool ThreadPipeline::setFilterPatterns(const QStringList &patterns)
+{
+    QStringList normalized;
+    for (const QString &spec : patterns) {
+        if (spec.trimmed().isEmpty())
+            continue;
+        PatternMatcher::Pattern pattern;
+        if (!PatternMatcher::parse(spec, pattern))
+            return false;
+        normalized.append(PatternMatcher::toString(pattern));
+    }
+    if (normalized.isEmpty())
+        return false;
+
+    m_filterPatterns = normalized;
+    for (FilterWorker *filter : std::as_const(m_filters))
+        QMetaObject::invokeMethod(filter, "setFilterPatterns",
+            Qt::QueuedConnection, Q_ARG(QStringList, normalized));
     emit filterPatternChanged();
+    return true;
+}
+
+// ============================================================================
+// runTransportBenchmark() - Signal/slot vs ring SPSC
+// ============================================================================
+// Sincrono y con sus propios hilos (ver PipelineBenchmark): no necesita
+// el pipeline en marcha. Devuelve el QVariantMap tal cual a QML.
+
+QVariantMap ThreadPipeline::runTransportBenchmark(int chunks)
+{
+    return PipelineBenchmark::compareTransports(chunks, m_filterQueueCapacity);
+}
+
+// ============================================================================
+// runMatcherBenchmark() - Coste del filtro segun el numero de patrones
+// ============================================================================
+
+QVariantList ThreadPipeline::runMatcherBenchmark(int chunks)
+{
+    return PipelineBenchmark::compareMatchers(chunks);
+}
+
+// ============================================================================
+// runFilterScalingBenchmark() - Cuanto escala el filtrado con N hilos
+// ============================================================================
+// Mide con los patrones activos: con muchos patrones o comodines el
+// Filtro trabaja mas por chunk y el paralelismo rinde mas.
+
+QVariantList ThreadPipeline::runFilterScalingBenchmark(int chunks)
+{
+    return PipelineBenchmark::compareFilterScaling(chunks, m_filterPatterns,
+                                                   maxFilterWorkers());
+}
+
+// ============================================================================
+// runGeneratorBenchmark() - Cuantos chunks/s puede producir el Generador
+// ============================================================================
+// Mantiene vivos tantos chunks como caben en la cola del Filtro, como
+// haria el pipeline, para que el pool tenga que esperar a que se liberen.
+
+QVariantList ThreadPipeline::runGeneratorBenchmark(int chunks)
+{
+    return PipelineBenchmark::compareGenerators(chunks, m_filterQueueCapacity);
+}
+
+// ============================================================================
+// runHandoffBenchmark() - El camino completo con cada transporte
+// ============================================================================
+// Workers y hilos propios, no los del pipeline: puede lanzarse parado.
+// Las dos colas con la capacidad de la del Filtro.
+
+QVariantList ThreadPipeline::runHandoffBenchmark(int chunks)
+{
+    return PipelineBenchmark::compareHandoffs(chunks, m_filterQueueCapacity);
+}
+
+// ============================================================================
+// runPlacementBenchmark() - Coste de cruzar entre CPUs
+// ============================================================================
+// Usa sus propios hilos: la colocacion del pipeline no cambia.
+
+QVariantList ThreadPipeline::runPlacementBenchmark(int roundTrips)
+{
+    return PipelineBenchmark::comparePlacements(roundTrips);
+}
+
+// ============================================================================
+// metricsSnapshotJson() - Metricas y configuracion de la ejecucion
+// ============================================================================
+// La configuracion va junto a las metricas: dos lineas de un log de
+// regresion solo son comparables si se midieron igual.
+
+QString ThreadPipeline::metricsSnapshotJson(bool indented)
+{
+    QJsonObject json = m_metrics.toJson();
+    json[QStringLiteral("timestampNs")] = QString::number(pipelineClockNs());
+    json[QStringLiteral("running")] = m_running;
+    json[QStringLiteral("transport")] = QString::fromLatin1(
+        QMetaEnum::fromType<Transport>().valueToKey(m_transport));
+    json[QStringLiteral("overflowPolicy")] = QString::fromLatin1(
+        QMetaEnum::fromType<OverflowPolicy>().valueToKey(m_overflowPolicy));
+    json[QStringLiteral("filterWorkers")] = int(m_filterStats.size());
+    json[QStringLiteral("generationIntervalMs")] = m_generationInterval;
+    json[QStringLiteral("generatorMode")] = QString::fromLatin1(
+        QMetaEnum::fromType<GeneratorMode>().valueToKey(m_generatorMode));
+    json[QStringLiteral("generatorBatchSize")] = m_generatorBatchSize;
+    json[QStringLiteral("generatorPoolHitRate")] = m_generatorPoolHitRate;
+    json[QStringLiteral("placement")] = QJsonArray::fromVariantList(stagePlacement());
+
+    const QJsonDocument doc(json);
+    return QString::fromUtf8(doc.toJson(indented ? QJsonDocument::Indented
+                                                 : QJsonDocument::Compact));
+}
+
+void ThreadPipeline::resetMetrics()
+{
+    m_metrics.clear();
+    emit metricsChanged();
 }
@@ -30,18 +30,63 @@
 
 #include <QObject>
 #include <QThread>
+#include <QTimer>
 #include <QByteArray>
+#include <QElapsedTimer>
+#include <QList>
+#include <QStringList>
+#include <QVariantMap>
 #include <QtQml/qqmlregistration.h>
+#include "pipelinemetrics.h"
+#include "recordlistmodel.h"
+#include "recordlogmodel.h"
+#include "threadplacement.h"
+#include <array>
+#include <memory>
+#include <vector>
 
 class GeneratorWorker;
 class FilterWorker;
 class CollectorWorker;
+class PipelineChannel;
 
 class ThreadPipeline : public QObject
 {
     Q_OBJECT
     QML_ELEMENT
 
+public:
+    // ─── Transporte entre etapas ────────────────────────────────────
+    // SignalSlot: una QueuedConnection por salto (un evento Qt por chunk).
+    // SpscRings:  un PipelineChannel por salto (ring SPSC + timbre).
+    // Q_ENUM lo hace visible en QML: ThreadPipeline.SpscRings
+    enum Transport { SignalSlot, SpscRings };
+    Q_ENUM(Transport)
+
+    // ─── Politica con la cola de una etapa llena ────────────────────
+    // Block: el productor espera. DropOldest / DropNewest: se descarta el
+    // chunk mas antiguo de la cola / el que llega (ver PipelineChannel).
+    enum OverflowPolicy { Block, DropOldest, DropNewest };
+    Q_ENUM(OverflowPolicy)
+
+    // Tope de filterQueueCapacity / collectorQueueCapacity. El ring de
+    // cada canal reserva el doble de huecos (~6 MB por canal en el tope).
+    static constexpr int MaxQueueCapacity = 65536;
+
+    // ─── Ritmo del Generador ────────────────────────────────────────
+    // TimerTicks: un chunk por disparo del QTimer (generationInterval).
+    // FreeRunning: lotes de generatorBatchSize chunks sin esperar; solo
+    // frenan las colas (ver GeneratorWorker).
+    enum GeneratorMode { TimerTicks, FreeRunning };
+    Q_ENUM(GeneratorMode)
+
+    // ─── Planificacion de los hilos de una etapa ────────────────────
+    // SchedOther: normal (priority = nice). SchedFifo: tiempo real
+    // (priority 1..99). SchedIdle: solo con CPUs ociosas. Ver ThreadPlacement.
+    enum SchedulingPolicy { SchedOther, SchedFifo, SchedIdle };
+    Q_ENUM(SchedulingPolicy)
+
+private:
     // ─── Propiedades expuestas a QML ────────────────────────────────
     // Cada Q_PROPERTY necesita al minimo READ y NOTIFY.
     // READ: funcion que devuelve el valor actual.
@@ -53,12 +98,80 @@ class ThreadPipeline : public QObject
     Q_PROPERTY(int processedCount READ processedCount NOTIFY processedCountChanged)
     Q_PROPERTY(int matchedCount READ matchedCount NOTIFY matchedCountChanged)
     Q_PROPERTY(int recordCount READ recordCount NOTIFY recordCountChanged)
+    // Registros del Colector (modelo C++, se refresca a 10 Hz)
+    Q_PROPERTY(RecordListModel *records READ records CONSTANT)
+    // Todos los registros en disco (SegmentLog), tambien los de ejecuciones
+    // anteriores. recordLog.enabled = true para que el Colector escriba.
+    Q_PROPERTY(RecordLogModel *recordLog READ recordLog CONSTANT)
     Q_PROPERTY(QString mainThreadId READ mainThreadId CONSTANT)
     Q_PROPERTY(QString generatorThreadId READ generatorThreadId NOTIFY generatorThreadIdChanged)
     Q_PROPERTY(QString filterThreadId READ filterThreadId NOTIFY filterThreadIdChanged)
     Q_PROPERTY(QString collectorThreadId READ collectorThreadId NOTIFY collectorThreadIdChanged)
     Q_PROPERTY(int generationInterval READ generationInterval WRITE setGenerationInterval NOTIFY generationIntervalChanged)
     Q_PROPERTY(QString filterPatternHex READ filterPatternHex NOTIFY filterPatternChanged)
+    Q_PROPERTY(QStringList filterPatterns READ filterPatterns NOTIFY filterPatternChanged)
+    // Se aplica en el siguiente start()
+    Q_PROPERTY(Transport transport READ transport WRITE setTransport NOTIFY transportChanged)
+    // Modo y lote se aplican en el siguiente start(). generatorPoolHitRate:
+    // fraccion de chunks escritos en un buffer reutilizado (1.0 = ninguna
+    // reserva de memoria), muestreada junto a las metricas.
+    Q_PROPERTY(GeneratorMode generatorMode READ generatorMode WRITE setGeneratorMode NOTIFY generatorModeChanged)
+    Q_PROPERTY(int generatorBatchSize READ generatorBatchSize WRITE setGeneratorBatchSize NOTIFY generatorModeChanged)
+    Q_PROPERTY(double generatorPoolHitRate READ generatorPoolHitRate NOTIFY metricsChanged)
+
+    // ─── Colas acotadas por etapa ───────────────────────────────────
+    // Capacidad y politica se aplican en el siguiente start(). Profundidad,
+    // pico y descartes se muestrean cada 100 ms (queueStatsChanged).
+    // La capacidad se acota a 1..MaxQueueCapacity.
+    Q_PROPERTY(OverflowPolicy overflowPolicy READ overflowPolicy WRITE setOverflowPolicy NOTIFY overflowPolicyChanged)
+    Q_PROPERTY(int filterQueueCapacity READ filterQueueCapacity WRITE setFilterQueueCapacity NOTIFY queueCapacityChanged)
+    Q_PROPERTY(int collectorQueueCapacity READ collectorQueueCapacity WRITE setCollectorQueueCapacity NOTIFY queueCapacityChanged)
+    Q_PROPERTY(int filterQueueDepth READ filterQueueDepth NOTIFY queueStatsChanged)
+    Q_PROPERTY(int filterQueuePeak READ filterQueuePeak NOTIFY queueStatsChanged)
+    Q_PROPERTY(int filterDropped READ filterDropped NOTIFY queueStatsChanged)
+    Q_PROPERTY(int collectorQueueDepth READ collectorQueueDepth NOTIFY queueStatsChanged)
+    Q_PROPERTY(int collectorQueuePeak READ collectorQueuePeak NOTIFY queueStatsChanged)
+    Q_PROPERTY(int collectorDropped READ collectorDropped NOTIFY queueStatsChanged)
+
+    // ─── Etapa de filtrado en paralelo ──────────────────────────────
+    // filterWorkers se aplica en el siguiente start(). Con N > 1 cada
+    // Filtro tiene su hilo y sus colas (capacidad por Filtro) y el
+    // Colector reordena por sequence. Las estadisticas se muestrean junto
+    // a las de las colas:
+    //   filterWorkerStats: [{ index, threadId, processed, matched,
+    //                         chunksPerSec, load, queueDepth }]
+    //   filterThroughput:  suma de chunksPerSec de todos los Filtros
+    //   reorderPending:    coincidencias retenidas en el Colector
+    Q_PROPERTY(int filterWorkers READ filterWorkers WRITE setFilterWorkers NOTIFY filterWorkersChanged)
+    Q_PROPERTY(int maxFilterWorkers READ maxFilterWorkers CONSTANT)
+    Q_PROPERTY(QVariantList filterWorkerStats READ filterWorkerStats NOTIFY filterStatsChanged)
+    Q_PROPERTY(double filterThroughput READ filterThroughput NOTIFY filterStatsChanged)
+    Q_PROPERTY(int reorderPending READ reorderPending NOTIFY filterStatsChanged)
+
+    // ─── Latencia y rendimiento por etapa ───────────────────────────
+    // Se muestrean cada 100 ms (metricsChanged), ver PipelineMetrics:
+    //   stageMetrics:    [{ stage, items, itemsPerSec,
+    //                       service:   { samples, p50Ns, p90Ns, p99Ns, p999Ns, maxNs },
+    //                       queueWait: { ... } }]   generator, filter, collector
+    //   endToEndLatency: { samples, p50Ns, ... } de la generacion al registro
+    Q_PROPERTY(QVariantList stageMetrics READ stageMetrics NOTIFY metricsChanged)
+    Q_PROPERTY(QVariantMap endToEndLatency READ endToEndLatency NOTIFY metricsChanged)
+
+    // ─── Colocacion de los hilos (CPU, politica, prioridad) ─────────
+    // setStagePlacement() se aplica en el siguiente start(): cada hilo se
+    // coloca a si mismo al arrancar (QThread::started). Las CPUs son las
+    // de allowedCpus (el cpuset del proceso, no 0..cpuCount-1): con N
+    // Filtros y una CPU fijada, el Filtro i va a la i-esima CPU permitida
+    // a partir de ella.
+    //   stagePlacement: [{ stage, cpu, policy, priority,
+    //                      threads: [{ name, cpu, numaNode, summary,
+    //                                  error, ok }] }]
+    // threads queda vacio hasta el primer start() y refleja lo que el
+    // sistema acepto (SCHED_FIFO sin permisos se queda en SCHED_OTHER).
+    Q_PROPERTY(QVariantList stagePlacement READ stagePlacement NOTIFY stagePlacementChanged)
+    Q_PROPERTY(int cpuCount READ cpuCount CONSTANT)
+    Q_PROPERTY(QList<int> allowedCpus READ allowedCpus CONSTANT)
+    Q_PROPERTY(bool placementSupported READ placementSupported CONSTANT)
 
 public:
     explicit ThreadPipeline(QObject *parent = nullptr);
@@ -70,6 +183,8 @@ public:
     int processedCount() const;
     int matchedCount() const;
     int recordCount() const;
+    RecordListModel *records();
+    RecordLogModel *recordLog();
     QString mainThreadId() const;
     QString generatorThreadId() const;
     QString filterThreadId() const;
@@ -77,12 +192,81 @@ public:
     int generationInterval() const;
     void setGenerationInterval(int ms);
     QString filterPatternHex() const;
+    QStringList filterPatterns() const;
+    Transport transport() const;
+    void setTransport(Transport transport);
+    GeneratorMode generatorMode() const;
+    void setGeneratorMode(GeneratorMode mode);
+    int generatorBatchSize() const;
+    void setGeneratorBatchSize(int chunks);
+    double generatorPoolHitRate() const;
+    OverflowPolicy overflowPolicy() const;
+    void setOverflowPolicy(OverflowPolicy policy);
+    int filterQueueCapacity() const;
+    void setFilterQueueCapacity(int capacity);
+    int collectorQueueCapacity() const;
+    void setCollectorQueueCapacity(int capacity);
+    int filterQueueDepth() const;
+    int filterQueuePeak() const;
+    int filterDropped() const;
+    int collectorQueueDepth() const;
+    int collectorQueuePeak() const;
+    int collectorDropped() const;
+    int filterWorkers() const;
+    void setFilterWorkers(int workers);
+    int maxFilterWorkers() const;
+    QVariantList filterWorkerStats() const;
+    double filterThroughput() const;
+    int reorderPending() const;
+    QVariantList stageMetrics() const;
+    QVariantMap endToEndLatency() const;
+    QVariantList stagePlacement() const;
+    int cpuCount() const;
+    QList<int> allowedCpus() const;
+    bool placementSupported() const;
 
     // ─── Metodos invocables desde QML ───────────────────────────────
     Q_INVOKABLE void start();
     Q_INVOKABLE void stop();
     Q_INVOKABLE void clear();
     Q_INVOKABLE void setFilterPattern(const QVariantList &bytes);
+    // Varios patrones a la vez: "DE AD ?? EF" (ver PatternMatcher::parse).
+    // false si alguno no es valido; entonces no cambia nada.
+    Q_INVOKABLE bool setFilterPatterns(const QStringList &patterns);
+    // stage: 0 generator, 1 filter, 2 collector. cpu = -1 para no fijarla;
+    // una CPU que no este en allowedCpus tambien la deja sin fijar
+    Q_INVOKABLE void setStagePlacement(int stage, int cpu, SchedulingPolicy policy, int priority);
+
+    // Comparativa signal/slot vs ring SPSC (ver PipelineBenchmark)
+    Q_INVOKABLE QVariantMap runTransportBenchmark(int chunks);
+    // contains() por patron vs Aho-Corasick, de 1 a 1000 patrones
+    Q_INVOKABLE QVariantList runMatcherBenchmark(int chunks);
+    // Rendimiento agregado con 1, 2, 4... Filtros y los patrones activos
+    Q_INVOKABLE QVariantList runFilterScalingBenchmark(int chunks);
+    // Generacion de chunks: mt19937 por byte vs xoshiro256** + pool
+    Q_INVOKABLE QVariantList runGeneratorBenchmark(int chunks);
+    // Generador -> Filtro -> Colector en hilos: signal/slot vs rings
+    Q_INVOKABLE QVariantList runHandoffBenchmark(int chunks);
+    // Ida y vuelta entre dos hilos: misma CPU, SMT, otro nucleo, otro nodo
+    Q_INVOKABLE QVariantList runPlacementBenchmark(int roundTrips);
+
+    // ========================================================================
+    // metricsSnapshotJson() - Metricas por etapa en JSON (regresiones)
+    // ========================================================================
+    // { "timestampNs", "running", "transport", "overflowPolicy",
+    //   "filterWorkers", "generationIntervalMs", "generatorMode",
+    //   "generatorBatchSize", "generatorPoolHitRate",
+    //   "placement": [ { stage, cpu, policy, priority, threads: [...] } ],
+    //   "stages": [ { stage, items, itemsPerSec,
+    //                 serviceSamples, serviceP50Ns, serviceP90Ns, serviceP99Ns,
+    //                 serviceP999Ns, serviceMaxNs,
+    //                 queueWaitSamples, queueWaitP50Ns, ... }, ... ],
+    //   "endToEndSamples", "endToEndP50Ns", ... "endToEndMaxNs" }
+    // 'indented' = false -> una sola linea (una por ejecucion en un log).
+    // ========================================================================
+    Q_INVOKABLE QString metricsSnapshotJson(bool indented = false);
+    // Vaciar los histogramas sin parar el pipeline
+    Q_INVOKABLE void resetMetrics();
 
 signals:
     void runningChanged();
@@ -95,36 +279,105 @@ signals:
     void collectorThreadIdChanged();
     void generationIntervalChanged();
     void filterPatternChanged();
-    // Signal reenviada desde CollectorWorker para que QML reciba registros
-    void recordAdded(const QString &timestamp, const QString &hexData, int size);
+    void transportChanged();
+    void generatorModeChanged();
+    void overflowPolicyChanged();
+    void queueCapacityChanged();
+    void queueStatsChanged();
+    void filterWorkersChanged();
+    void filterStatsChanged();
+    void metricsChanged();
+    void stagePlacementChanged();
 
 private:
+    // Estado de una cola muestreado en el hilo principal
+    struct QueueStats {
+        int depth = 0;
+        int peak = 0;
+        quint64 dropped = 0;
+    };
+
+    // Estado de un Filtro; las tasas salen de la diferencia entre muestras
+    struct FilterStats {
+        QString threadId;
+        int processed = 0;
+        int matched = 0;
+        qint64 busyNs = 0;
+        double chunksPerSec = 0.0;
+        double load = 0.0;
+        int queueDepth = 0;
+    };
+
+    // Ajustes de una etapa y lo que cada uno de sus hilos consiguio
+    struct StagePlacement {
+        ThreadPlacement::Settings settings;
+        QVariantList threads;
+    };
+
     void cleanupThreads();
+    void placeThread(QThread *thread, QObject *worker, int stage, int index);
+    void sampleQueues();
+    void sampleFilters();
+    void sampleMetrics();
 
     bool m_running = false;
     int m_generatedCount = 0;
     int m_processedCount = 0;
     int m_matchedCount = 0;
     int m_generationInterval = 10;
-    QByteArray m_filterPattern{"\x00\x01\x02", 3};
+    Transport m_transport = SignalSlot;
+    GeneratorMode m_generatorMode = TimerTicks;
+    int m_generatorBatchSize = 4096;
+    double m_generatorPoolHitRate = 0.0;
+    OverflowPolicy m_overflowPolicy = Block;
+    int m_filterQueueCapacity = 1024;
+    int m_collectorQueueCapacity = 1024;
+    QueueStats m_filterQueue;
+    QueueStats m_collectorQueue;
+    QTimer m_queueSampler;
+    int m_filterWorkers = 1;
+    std::vector<FilterStats> m_filterStats;
+    double m_filterThroughput = 0.0;
+    int m_reorderPending = 0;
+    QElapsedTimer m_sampleClock;
+    qint64 m_lastSampleNs = 0;
+    QStringList m_filterPatterns{QStringLiteral("00 01 02")};
+    // Lo escribe el Colector (RecordStore) y lo lee QML. Vive mas que los
+    // workers: los registros siguen visibles con el pipeline parado.
+    RecordListModel m_records;
+    // Igual, pero en disco: el log sigue abierto (y legible) entre start()
+    RecordLogModel m_recordLog;
+    // Escriben los workers (cada etapa lo suyo); se lee a 10 Hz
+    PipelineMetrics m_metrics;
+    // Indexado por PipelineMetrics::Stage. m_placementRun descarta los
+    // resultados que lleguen tarde de una ejecucion anterior.
+    std::array<StagePlacement, PipelineMetrics::StageCount> m_placement;
+    int m_placementRun = 0;
 
     QString m_generatorThreadId;
     QString m_filterThreadId;
     QString m_collectorThreadId;
 
-    // ─── Los 3 QThreads del pipeline ────────────────────────────────
+    // ─── Los QThreads del pipeline ──────────────────────────────────
     // Cada QThread gestiona un event loop en segundo plano.
     // Los workers se mueven a estos hilos con moveToThread().
+    // Los de los Filtros se crean en start(): su numero es filterWorkers.
     QThread m_generatorThread;
-    QThread m_filterThread;
+    std::vector<std::unique_ptr<QThread>> m_filterThreads;
     QThread m_collectorThread;
 
     // ─── Punteros a los workers ─────────────────────────────────────
     // Se crean con new SIN parent (requisito de moveToThread).
     // Se destruyen automaticamente via QThread::finished -> deleteLater.
     GeneratorWorker *m_generator = nullptr;
-    FilterWorker *m_filter = nullptr;
+    QList<FilterWorker *> m_filters;
     CollectorWorker *m_collector = nullptr;
+
+    // ─── Colas acotadas de cada salto (entrada del Filtro/Colector) ─
+    // Una por Filtro en cada salto. Las posee el pipeline: se destruyen
+    // despues de wait(), cuando ya ningun hilo las usa.
+    std::vector<std::unique_ptr<PipelineChannel>> m_filterInputs;
+    std::vector<std::unique_ptr<PipelineChannel>> m_collectorInputs;
 };
 
 #endif // THREADPIPELINE_H
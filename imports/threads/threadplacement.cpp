@@ -0,0 +1,212 @@
+// ============================================================================
+// threadplacement.cpp - Implementacion de la colocacion de hilos
+// ============================================================================
+
+#include "threadplacement.h"
+#include <QDir>
+#include <QFile>
+#include <QStringList>
+#include <QThread>
+
+#ifdef Q_OS_LINUX
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+#ifdef Q_OS_LINUX
+static QString errnoText(int error)
+{
+    return QString::fromLocal8Bit(std::strerror(error));
+}
+
+// "0-3,8,10-11" -> la primera CPU distinta de 'cpu'
+static int firstOtherCpu(const QByteArray &list, int cpu)
+{
+    for (const QByteArray &range : list.trimmed().split(',')) {
+        const QList<QByteArray> bounds = range.split('-');
+        bool ok = false;
+        const int from = bounds.first().toInt(&ok);
+        if (!ok)
+            continue;
+        const int to = bounds.size() > 1 ? bounds.last().toInt() : from;
+        for (int c = from; c <= to; ++c) {
+            if (c != cpu)
+                return c;
+        }
+    }
+    return -1;
+}
+
+static QString cpuDir(int cpu)
+{
+    return QStringLiteral("/sys/devices/system/cpu/cpu%1").arg(cpu);
+}
+#endif
+
+bool ThreadPlacement::supported()
+{
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+int ThreadPlacement::cpuCount()
+{
+#ifdef Q_OS_LINUX
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online > 0)
+        return int(online);
+#endif
+    return qMax(QThread::idealThreadCount(), 1);
+}
+
+QList<int> ThreadPlacement::allowedCpus()
+{
+    QList<int> cpus;
+#ifdef Q_OS_LINUX
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &set))
+                cpus.append(cpu);
+        }
+    }
+#endif
+    if (cpus.isEmpty()) {
+        for (int cpu = 0; cpu < cpuCount(); ++cpu)
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+
+int ThreadPlacement::currentCpu()
+{
+#ifdef Q_OS_LINUX
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+// Cada CPU tiene un enlace "nodeN" a su nodo en sysfs
+int ThreadPlacement::numaNodeOf(int cpu)
+{
+#ifdef Q_OS_LINUX
+    if (cpu < 0)
+        return -1;
+    const QStringList nodes = QDir(cpuDir(cpu)).entryList({QStringLiteral("node*")},
+                                                          QDir::Dirs | QDir::System);
+    for (const QString &node : nodes) {
+        bool ok = false;
+        const int index = node.mid(4).toInt(&ok);
+        if (ok)
+            return index;
+    }
+#else
+    Q_UNUSED(cpu)
+#endif
+    return -1;
+}
+
+int ThreadPlacement::smtSiblingOf(int cpu)
+{
+#ifdef Q_OS_LINUX
+    QFile file(cpuDir(cpu) + QStringLiteral("/topology/thread_siblings_list"));
+    if (cpu >= 0 && file.open(QIODevice::ReadOnly))
+        return firstOtherCpu(file.readAll(), cpu);
+#else
+    Q_UNUSED(cpu)
+#endif
+    return -1;
+}
+
+QString ThreadPlacement::policyName(Policy policy)
+{
+    switch (policy) {
+    case Fifo: return QStringLiteral("SCHED_FIFO");
+    case Idle: return QStringLiteral("SCHED_IDLE");
+    default:   return QStringLiteral("SCHED_OTHER");
+    }
+}
+
+// ============================================================================
+// apply() - Afinidad, politica y prioridad del hilo que llama
+// ============================================================================
+// Orden: primero la CPU (el hilo migra en el momento), luego la politica.
+// Un fallo no deshace lo anterior: Result dice que quedo aplicado.
+
+ThreadPlacement::Result ThreadPlacement::apply(const Settings &settings)
+{
+    Result result;
+    QStringList errors;
+
+#ifdef Q_OS_LINUX
+    const pthread_t self = pthread_self();
+
+    if (settings.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(settings.cpu, &set);
+        const int rc = pthread_setaffinity_np(self, sizeof(set), &set);
+        if (rc != 0)
+            errors << QStringLiteral("cpu %1: %2").arg(settings.cpu).arg(errnoText(rc));
+    }
+
+    sched_param param{};
+    int policy = SCHED_OTHER;
+    if (settings.policy == Fifo) {
+        policy = SCHED_FIFO;
+        param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO), settings.priority,
+                                      sched_get_priority_max(SCHED_FIFO));
+    } else if (settings.policy == Idle) {
+        policy = SCHED_IDLE;
+    }
+    const int rc = pthread_setschedparam(self, policy, &param);
+    if (rc != 0)
+        errors << QStringLiteral("%1: %2").arg(policyName(settings.policy), errnoText(rc));
+
+    // Con SCHED_OTHER la prioridad es el nice del hilo (por TID en Linux)
+    if (rc == 0 && settings.policy == Other && settings.priority != 0) {
+        const int nice = qBound(-20, settings.priority, 19);
+        if (setpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid)), nice) != 0)
+            errors << QStringLiteral("nice %1: %2").arg(nice).arg(errnoText(errno));
+    }
+
+    int appliedPolicy = SCHED_OTHER;
+    sched_param applied{};
+    pthread_getschedparam(self, &appliedPolicy, &applied);
+    const QString policyText = appliedPolicy == SCHED_FIFO
+        ? QStringLiteral("SCHED_FIFO %1").arg(applied.sched_priority)
+        : appliedPolicy == SCHED_IDLE
+            ? QStringLiteral("SCHED_IDLE")
+            : QStringLiteral("SCHED_OTHER nice %1")
+                  .arg(getpriority(PRIO_PROCESS, id_t(syscall(SYS_gettid))));
+#else
+    // Sin afinidad: la politica se aproxima con la prioridad de Qt
+    if (settings.cpu >= 0)
+        errors << QStringLiteral("CPU affinity not supported on this platform");
+    QThread *thread = QThread::currentThread();
+    if (settings.policy == Fifo)
+        thread->setPriority(QThread::TimeCriticalPriority);
+    else if (settings.policy == Idle)
+        thread->setPriority(QThread::IdlePriority);
+    const QString policyText = policyName(settings.policy);
+#endif
+
+    result.cpu = currentCpu();
+    result.numaNode = numaNodeOf(result.cpu);
+    result.summary = result.numaNode >= 0
+        ? QStringLiteral("cpu %1 (node %2), %3").arg(result.cpu).arg(result.numaNode).arg(policyText)
+        : QStringLiteral("cpu %1, %2").arg(result.cpu).arg(policyText);
+    result.error = errors.join(QStringLiteral("; "));
+    result.ok = errors.isEmpty();
+    return result;
+}
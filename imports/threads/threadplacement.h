@@ -0,0 +1,74 @@
+// ============================================================================
+// threadplacement.h - CPU, politica y prioridad de un hilo del pipeline
+// ============================================================================
+//
+// Por defecto el planificador mueve los hilos del pipeline entre nucleos
+// cuando quiere: cada migracion enfria las caches y un chunk que cruza de
+// un nodo NUMA a otro paga el viaje de la linea de cache por el enlace.
+//
+// PATRON: el hilo se coloca A SI MISMO. apply() se llama desde el propio
+// hilo (ThreadPipeline lo conecta a QThread::started con DirectConnection,
+// antes de que arranque su event loop):
+//
+//   Settings { cpu, policy, priority }
+//     cpu:      -1 = sin fijar; si no, pthread_setaffinity_np() a esa CPU
+//     policy:   Other -> SCHED_OTHER, priority = nice (-20..19)
+//               Fifo  -> SCHED_FIFO, priority = 1..99 (tiempo real)
+//               Idle  -> SCHED_IDLE, solo corre con CPUs ociosas
+//
+// Nada es fatal: cada ajuste que el sistema rechace (SCHED_FIFO o nice < 0
+// sin CAP_SYS_NICE, una CPU fuera del cpuset...) se anota en Result.error
+// y el hilo sigue con lo que tenia. Fuera de Linux solo se aplica la
+// prioridad de Qt equivalente y la CPU se ignora.
+//
+// TOPOLOGIA (Linux, /sys/devices/system/cpu): numaNodeOf() y
+// smtSiblingOf() permiten elegir CPUs del mismo nucleo fisico, de otro
+// nucleo o de otro nodo NUMA (ver PipelineBenchmark::comparePlacements).
+// ============================================================================
+
+#ifndef THREADPLACEMENT_H
+#define THREADPLACEMENT_H
+
+#include <QList>
+#include <QString>
+
+class ThreadPlacement
+{
+public:
+    enum Policy { Other, Fifo, Idle };
+
+    struct Settings
+    {
+        int cpu = -1;
+        Policy policy = Other;
+        int priority = 0;
+
+        bool isDefault() const { return cpu < 0 && policy == Other && priority == 0; }
+    };
+
+    struct Result
+    {
+        bool ok = true;
+        int cpu = -1;        // CPU donde corre el hilo tras aplicar
+        int numaNode = -1;
+        QString summary;     // "cpu 2 (node 0), SCHED_FIFO 10"
+        QString error;       // vacio si todo se aplico
+    };
+
+    // Aplica 'settings' al hilo que llama
+    static Result apply(const Settings &settings);
+
+    static bool supported();
+    static int cpuCount();
+    // CPUs en las que el proceso puede correr (su cpuset), en orden
+    static QList<int> allowedCpus();
+    static int currentCpu();
+    // -1 si no se conoce (sin NUMA o fuera de Linux)
+    static int numaNodeOf(int cpu);
+    // Otra CPU logica del mismo nucleo fisico (SMT), o -1
+    static int smtSiblingOf(int cpu);
+
+    static QString policyName(Policy policy);
+};
+
+#endif // THREADPLACEMENT_H